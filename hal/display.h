@@ -54,6 +54,47 @@ void hal_display_draw_pixel(int32_t x, int32_t y, uint16_t color);
  */
 void hal_display_flush(void);
 
+/**
+ * @brief Makes the shadow framebuffer the single source of truth
+ *
+ * When enabled, all HAL drawing (clear, draw_pixel, canvas_draw, fast_blit,
+ * fast_blit_transparent, unlock_surface) writes only to the PSRAM shadow
+ * framebuffer and records the damaged rectangles. hal_display_flush() then
+ * pushes just those rectangles to the panel. Drawing through the raw
+ * Arduino_GFX object from hal_display_get_gfx() bypasses this mode.
+ *
+ * Disabling the mode flushes pending damage first.
+ *
+ * @param enable true to draw into the shadow framebuffer, false to draw directly
+ * @return true on success, false if no shadow framebuffer is available
+ */
+bool hal_display_set_shadow_primary(bool enable);
+
+/**
+ * @brief Reports whether shadow-primary mode is on
+ *
+ * While it is off, the shadow framebuffer is only a mirror: pixels drawn
+ * through the raw Arduino_GFX object may be missing from it, so pushing a
+ * region of it to the panel can overwrite them with stale ones.
+ *
+ * @return true if HAL drawing goes to the shadow framebuffer
+ */
+bool hal_display_is_shadow_primary(void);
+
+/**
+ * @brief Enables tile-hash damage detection for shadow-primary flushes
+ *
+ * When enabled, hal_display_flush() rehashes the 16x16 tiles under the
+ * recorded damage and sends only tiles whose content changed since the
+ * previous flush, coalesced into rectangles (see display_tiles.h). Helps
+ * components that redraw large regions without tracking what changed;
+ * costs one read of every damaged pixel per flush.
+ *
+ * @param enable true to filter damage through tile hashes, false to send it as recorded
+ * @return true on success, false if no shadow framebuffer is available
+ */
+bool hal_display_set_tile_hashing(bool enable);
+
 /**
  * @brief Returns the width of the active display in pixels
  *
@@ -138,11 +179,97 @@ void hal_display_canvas_draw(hal_canvas_handle_t canvas, int32_t x, int32_t y);
  */
 void hal_display_canvas_fill(hal_canvas_handle_t canvas, uint16_t color);
 
+// Direct Surface Access API
+// Exposes the raw pixel memory behind a canvas (or the shadow framebuffer) so
+// software rasterizers and compositors can write pixels without going through
+// Arduino_GFX or casting canvas handles to concrete driver types.
+
+/**
+ * @brief Pixel layout of a locked surface
+ */
+typedef enum {
+    HAL_PIXEL_FORMAT_RGB565 = 0,    ///< 16-bit RGB565, CPU (little-endian) byte order, as Arduino_GFX canvases store it
+    HAL_PIXEL_FORMAT_RGB565_BE = 1  ///< 16-bit RGB565, big-endian byte order, as SPI/QSPI panels expect it on the wire
+} hal_pixel_format_t;
+
+/**
+ * @brief Description of a locked pixel surface
+ *
+ * Pixel (x, y) lives at pixels[y * stride + x]. The stride is expressed in
+ * pixels, not bytes, and is always >= width.
+ */
+typedef struct {
+    uint16_t* pixels;           ///< Base address of row 0
+    int32_t width;              ///< Width in pixels
+    int32_t height;             ///< Height in pixels
+    int32_t stride;             ///< Distance between rows, in pixels
+    hal_pixel_format_t format;  ///< Pixel layout
+} hal_surface_t;
+
+/**
+ * @brief Locks a canvas (or the shadow framebuffer) for direct pixel access
+ *
+ * Pass nullptr to lock the main display's shadow framebuffer. The returned
+ * memory stays valid until the matching hal_display_unlock_surface() call.
+ * Only one lock per surface may be outstanding at a time.
+ *
+ * @param canvas The canvas to lock, or nullptr for the shadow framebuffer
+ * @param out_surface Receives the surface description (untouched on failure)
+ * @return true if the surface is backed by addressable memory, false otherwise
+ */
+bool hal_display_lock_surface(hal_canvas_handle_t canvas, hal_surface_t* out_surface);
+
+/**
+ * @brief Releases a surface locked with hal_display_lock_surface()
+ *
+ * The damaged rectangle declares which pixels were written while locked.
+ * For the shadow framebuffer, the damaged region is pushed to the panel
+ * (or queued for the next hal_display_flush() in shadow-primary mode).
+ * For canvases, it is bookkeeping only (the canvas is presented later via
+ * a blit). Pass w or h <= 0 when nothing was modified.
+ *
+ * @param canvas The canvas that was locked, or nullptr for the shadow framebuffer
+ * @param x Left edge of the damaged region
+ * @param y Top edge of the damaged region
+ * @param w Width of the damaged region
+ * @param h Height of the damaged region
+ */
+void hal_display_unlock_surface(hal_canvas_handle_t canvas,
+                                int32_t x, int32_t y, int32_t w, int32_t h);
+
+/**
+ * @brief Returns the pixel format the panel consumes without conversion
+ *
+ * The shadow framebuffer is kept in this format, and surfaces in this format
+ * are sent by hal_display_blit_surface() with no per-pixel work. Convert
+ * colors with hal_color_to_format() (display_format.h) once, not per pixel.
+ *
+ * @return The panel's native pixel format
+ */
+hal_pixel_format_t hal_display_get_native_format(void);
+
+/**
+ * @brief Blits a surface to the display, honouring its pixel format
+ *
+ * When surface->format matches hal_display_get_native_format(), rows are sent
+ * to the panel as raw bytes (zero-transform); otherwise each pixel is
+ * converted on the way out, as hal_display_fast_blit() does. The stride of
+ * the surface is respected, so sub-rectangles of larger buffers can be sent.
+ * In shadow-primary mode the pixels are copied into the shadow framebuffer
+ * and the region is queued for the next flush.
+ *
+ * @param x The top-left X-coordinate on the destination display
+ * @param y The top-left Y-coordinate on the destination display
+ * @param surface The pixels to send
+ */
+void hal_display_blit_surface(int16_t x, int16_t y, const hal_surface_t* surface);
+
 /**
  * @brief Fast DMA-accelerated blit from memory buffer to display
  *
- * Transfers a rectangular block of RGB565 pixel data from a memory buffer
- * to the display using hardware acceleration (DMA or bulk transfer).
+ * Transfers a rectangular block of CPU-order RGB565 pixel data
+ * (HAL_PIXEL_FORMAT_RGB565) from a memory buffer to the display using
+ * hardware acceleration (DMA or bulk transfer).
  * This function MUST NOT use pixel-by-pixel loops.
  *
  * @param x The top-left X-coordinate on the destination display
@@ -170,6 +297,24 @@ void hal_display_fast_blit(int16_t x, int16_t y, int16_t w, int16_t h, const uin
 void hal_display_fast_blit_transparent(int16_t x, int16_t y, int16_t w, int16_t h,
                                        const uint16_t* data, uint16_t transparent_color);
 
+/**
+ * @brief Blits a run-length encoded sprite
+ *
+ * Consumes the run stream described in display_rle.h directly: only opaque
+ * runs are transferred and no chroma-key comparisons are made. In
+ * shadow-primary mode the runs are copied into the shadow framebuffer and
+ * their bounding box is queued for the next flush; otherwise each run is
+ * sent to the panel (one address window per run, within a single
+ * transaction) and mirrored to the shadow framebuffer.
+ *
+ * @param x The top-left X-coordinate on the destination display
+ * @param y The top-left Y-coordinate on the destination display
+ * @param w The width of the sprite
+ * @param h The height of the sprite (number of encoded scanlines)
+ * @param rle Pointer to the encoded run stream
+ */
+void hal_display_blit_rle(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* rle);
+
 /**
  * @brief Reads a single pixel from the display shadow buffer
  *
@@ -0,0 +1,99 @@
+/**
+ * @file display_damage.cpp
+ * @brief Display damage tracking (board-independent)
+ *
+ * Compiled for every environment, including native tests.
+ */
+
+#include "display_damage.h"
+
+// Returns true if a and b overlap or share an edge
+static bool rectsTouch(const hal_rect_t& a, const hal_rect_t& b) {
+    return a.x <= b.x + b.w && b.x <= a.x + a.w &&
+           a.y <= b.y + b.h && b.y <= a.y + a.h;
+}
+
+static bool rectContains(const hal_rect_t& outer, const hal_rect_t& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y &&
+           inner.x + inner.w <= outer.x + outer.w &&
+           inner.y + inner.h <= outer.y + outer.h;
+}
+
+static hal_rect_t rectUnion(const hal_rect_t& a, const hal_rect_t& b) {
+    int32_t x0 = (a.x < b.x) ? a.x : b.x;
+    int32_t y0 = (a.y < b.y) ? a.y : b.y;
+    int32_t x1 = (a.x + a.w > b.x + b.w) ? a.x + a.w : b.x + b.w;
+    int32_t y1 = (a.y + a.h > b.y + b.h) ? a.y + a.h : b.y + b.h;
+    hal_rect_t r = { x0, y0, x1 - x0, y1 - y0 };
+    return r;
+}
+
+static void removeAt(hal_damage_t* damage, int32_t index) {
+    damage->rects[index] = damage->rects[damage->count - 1];
+    damage->count--;
+}
+
+void hal_damage_reset(hal_damage_t* damage) {
+    damage->count = 0;
+}
+
+void hal_damage_add(hal_damage_t* damage, int32_t x, int32_t y, int32_t w, int32_t h) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    hal_rect_t r = { x, y, w, h };
+
+    // Fast path: already covered (common for per-pixel writes)
+    for (int32_t i = 0; i < damage->count; i++) {
+        if (rectContains(damage->rects[i], r)) {
+            return;
+        }
+    }
+
+    // Absorb every rectangle the new one touches; growing r can make it touch
+    // rectangles that were previously disjoint, so rescan until stable
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (int32_t i = 0; i < damage->count; i++) {
+            if (rectsTouch(damage->rects[i], r)) {
+                r = rectUnion(damage->rects[i], r);
+                removeAt(damage, i);
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    if (damage->count < HAL_DAMAGE_MAX_RECTS) {
+        damage->rects[damage->count++] = r;
+        return;
+    }
+
+    // Full: merge into the rectangle whose area grows the least
+    int32_t best = 0;
+    int64_t best_growth = INT64_MAX;
+    for (int32_t i = 0; i < damage->count; i++) {
+        hal_rect_t u = rectUnion(damage->rects[i], r);
+        int64_t growth = static_cast<int64_t>(u.w) * u.h -
+                         static_cast<int64_t>(damage->rects[i].w) * damage->rects[i].h;
+        if (growth < best_growth) {
+            best_growth = growth;
+            best = i;
+        }
+    }
+    hal_rect_t u = rectUnion(damage->rects[best], r);
+    removeAt(damage, best);
+
+    // The grown rectangle may now touch others; re-add through the merge path
+    hal_damage_add(damage, u.x, u.y, u.w, u.h);
+}
+
+int32_t hal_damage_area(const hal_damage_t* damage) {
+    int32_t area = 0;
+    for (int32_t i = 0; i < damage->count; i++) {
+        area += damage->rects[i].w * damage->rects[i].h;
+    }
+    return area;
+}
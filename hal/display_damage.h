@@ -0,0 +1,80 @@
+/**
+ * @file display_damage.h
+ * @brief Hardware Abstraction Layer (HAL) - Display Damage Tracking
+ *
+ * Accumulates the rectangles of the shadow framebuffer that were written
+ * since the last flush, so display drivers can push only those regions to
+ * the panel. Shared by all board implementations; contains no hardware code.
+ *
+ * See features/hal_spec_display.md (Shadow Framebuffer Mode).
+ */
+
+#ifndef HAL_DISPLAY_DAMAGE_H
+#define HAL_DISPLAY_DAMAGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of disjoint rectangles tracked before merging kicks in */
+#define HAL_DAMAGE_MAX_RECTS 8
+
+/**
+ * @brief Axis-aligned pixel rectangle
+ */
+typedef struct {
+    int32_t x;
+    int32_t y;
+    int32_t w;
+    int32_t h;
+} hal_rect_t;
+
+/**
+ * @brief Set of damaged rectangles
+ *
+ * Rectangles never overlap or touch each other; adding a rectangle that does
+ * is merged into the existing one. When the set is full, the new rectangle is
+ * merged into whichever existing rectangle grows the least.
+ */
+typedef struct {
+    hal_rect_t rects[HAL_DAMAGE_MAX_RECTS];
+    int32_t count;
+} hal_damage_t;
+
+/**
+ * @brief Empties a damage set
+ *
+ * @param damage The damage set to reset
+ */
+void hal_damage_reset(hal_damage_t* damage);
+
+/**
+ * @brief Adds a rectangle to a damage set
+ *
+ * Rectangles with w <= 0 or h <= 0 are ignored. The caller is responsible for
+ * clipping to the surface bounds.
+ *
+ * @param damage The damage set to extend
+ * @param x Left edge
+ * @param y Top edge
+ * @param w Width
+ * @param h Height
+ */
+void hal_damage_add(hal_damage_t* damage, int32_t x, int32_t y, int32_t w, int32_t h);
+
+/**
+ * @brief Returns the total area (in pixels) covered by a damage set
+ *
+ * @param damage The damage set to measure
+ * @return int32_t Sum of rectangle areas (rectangles never overlap)
+ */
+int32_t hal_damage_area(const hal_damage_t* damage);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_DISPLAY_DAMAGE_H
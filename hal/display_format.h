@@ -0,0 +1,72 @@
+/**
+ * @file display_format.h
+ * @brief Hardware Abstraction Layer (HAL) - Pixel Format Conversion
+ *
+ * Converts RGB565 colors and pixel rows between the formats described by
+ * hal_pixel_format_t. Colors in application code (themes, constants) are
+ * always CPU-order RGB565; convert them once with hal_color_to_format()
+ * before writing into a surface of another format.
+ *
+ * See features/hal_spec_display.md (Pixel Formats).
+ */
+
+#ifndef HAL_DISPLAY_FORMAT_H
+#define HAL_DISPLAY_FORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "display.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Swaps the two bytes of a 16-bit pixel
+ */
+static inline uint16_t hal_pixel_swap16(uint16_t pixel) {
+    return (uint16_t)((pixel << 8) | (pixel >> 8));
+}
+
+/**
+ * @brief Converts a CPU-order RGB565 color to a surface's pixel format
+ *
+ * @param color RGB565 color in CPU byte order
+ * @param format Target pixel format
+ * @return The color as stored in a surface of that format
+ */
+static inline uint16_t hal_color_to_format(uint16_t color, hal_pixel_format_t format) {
+    return (format == HAL_PIXEL_FORMAT_RGB565_BE) ? hal_pixel_swap16(color) : color;
+}
+
+/**
+ * @brief Converts a pixel read from a surface back to a CPU-order RGB565 color
+ *
+ * @param pixel Pixel value as stored in the surface
+ * @param format Pixel format of the surface
+ * @return RGB565 color in CPU byte order
+ */
+static inline uint16_t hal_color_from_format(uint16_t pixel, hal_pixel_format_t format) {
+    return (format == HAL_PIXEL_FORMAT_RGB565_BE) ? hal_pixel_swap16(pixel) : pixel;
+}
+
+/**
+ * @brief Copies a row of pixels, converting between formats
+ *
+ * Same formats degrade to memmove. dst may equal src (in-place conversion);
+ * other overlaps are not supported when the formats differ.
+ *
+ * @param dst Destination pixels
+ * @param src Source pixels
+ * @param count Number of pixels
+ * @param src_format Format of src
+ * @param dst_format Format of dst
+ */
+void hal_pixels_convert(uint16_t* dst, const uint16_t* src, size_t count,
+                        hal_pixel_format_t src_format, hal_pixel_format_t dst_format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_DISPLAY_FORMAT_H
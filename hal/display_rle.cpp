@@ -0,0 +1,58 @@
+/**
+ * @file display_rle.cpp
+ * @brief RLE sprite decoding (board-independent)
+ *
+ * Compiled for every environment, including native tests.
+ */
+
+#include "display_rle.h"
+#include "display_format.h"
+
+bool hal_rle_blit_to_surface(const hal_surface_t* target, int32_t x, int32_t y,
+                             int32_t h, const uint16_t* rle, hal_rect_t* out_written) {
+    int32_t min_x = INT32_MAX, min_y = INT32_MAX;
+    int32_t max_x = INT32_MIN, max_y = INT32_MIN;
+
+    if (target != nullptr && target->pixels != nullptr && rle != nullptr) {
+        const uint16_t* p = rle;
+        for (int32_t row = 0; row < h; row++) {
+            uint16_t runs = *p++;
+            int32_t dy = y + row;
+            bool row_visible = dy >= 0 && dy < target->height;
+            uint16_t* dst_row = row_visible ? target->pixels + dy * target->stride : nullptr;
+
+            int32_t col = 0;
+            for (uint16_t r = 0; r < runs; r++) {
+                col += *p++;
+                uint16_t len = *p++;
+                if (row_visible) {
+                    // Clip the run horizontally
+                    int32_t dx = x + col;
+                    int32_t src_off = 0;
+                    int32_t copy_w = len;
+                    if (dx < 0) { src_off = -dx; copy_w += dx; dx = 0; }
+                    if (dx + copy_w > target->width) { copy_w = target->width - dx; }
+                    if (copy_w > 0) {
+                        hal_pixels_convert(dst_row + dx, p + src_off, copy_w,
+                                           HAL_PIXEL_FORMAT_RGB565, target->format);
+                        if (dx < min_x) min_x = dx;
+                        if (dx + copy_w > max_x) max_x = dx + copy_w;
+                        if (dy < min_y) min_y = dy;
+                        max_y = dy + 1;
+                    }
+                }
+                p += len;
+                col += len;
+            }
+        }
+    }
+
+    bool wrote = max_x > min_x;
+    if (out_written != nullptr) {
+        out_written->x = wrote ? min_x : 0;
+        out_written->y = wrote ? min_y : 0;
+        out_written->w = wrote ? max_x - min_x : 0;
+        out_written->h = wrote ? max_y - min_y : 0;
+    }
+    return wrote;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file display_rle.h
+ * @brief Hardware Abstraction Layer (HAL) - Run-Length Encoded Sprites
+ *
+ * Defines the RLE sprite stream consumed by hal_display_blit_rle() and a
+ * decoder that writes it into any surface. Shared by all board
+ * implementations; contains no hardware code.
+ *
+ * Stream format (all uint16_t), one record per scanline:
+ *
+ *   [runs] [skip len px[len]] [skip len px[len]] ...
+ *
+ * `skip` counts transparent pixels before the run, measured from the end of
+ * the previous run (or the row start). A fully transparent row is a single 0.
+ * Pixels are CPU-order RGB565 (HAL_PIXEL_FORMAT_RGB565).
+ *
+ * See features/hal_spec_display.md (RLE Sprite Blit).
+ */
+
+#ifndef HAL_DISPLAY_RLE_H
+#define HAL_DISPLAY_RLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "display.h"
+#include "display_damage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Decodes an RLE sprite into a surface, clipped to its bounds
+ *
+ * Opaque runs are copied with memcpy (byte-swapped on the way when the
+ * target is HAL_PIXEL_FORMAT_RGB565_BE); transparent pixels are never
+ * touched and no chroma-key comparisons are made.
+ *
+ * @param target Destination surface
+ * @param x Destination X of the sprite's top-left corner
+ * @param y Destination Y of the sprite's top-left corner
+ * @param h Number of scanlines in the stream
+ * @param rle The encoded stream
+ * @param out_written If non-null, receives the bounding box of the pixels
+ *                    actually written (w/h are 0 if none)
+ * @return true if at least one pixel was written
+ */
+bool hal_rle_blit_to_surface(const hal_surface_t* target, int32_t x, int32_t y,
+                             int32_t h, const uint16_t* rle, hal_rect_t* out_written);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_DISPLAY_RLE_H
@@ -36,6 +36,23 @@ void hal_display_flush(void) {
     // Nothing to flush in stub
 }
 
+// Stub implementation - no shadow framebuffer to draw into
+bool hal_display_set_shadow_primary(bool enable) {
+    (void)enable;
+    return false;
+}
+
+// Stub implementation - never shadow-primary
+bool hal_display_is_shadow_primary(void) {
+    return false;
+}
+
+// Stub implementation - no shadow framebuffer to hash
+bool hal_display_set_tile_hashing(bool enable) {
+    (void)enable;
+    return false;
+}
+
 // Stub implementation - returns width based on current rotation
 int32_t hal_display_get_width_pixels(void) {
     // Swap dimensions for 90 and 270 degree rotations
@@ -89,6 +106,17 @@ void* hal_display_get_gfx(void) {
     return nullptr;  // Stub doesn't provide Arduino_GFX access
 }
 
+// Stub implementation - host order, so format conversions are no-ops in tests
+hal_pixel_format_t hal_display_get_native_format(void) {
+    return HAL_PIXEL_FORMAT_RGB565;
+}
+
+void hal_display_blit_surface(int16_t x, int16_t y, const hal_surface_t* surface) {
+    (void)x;
+    (void)y;
+    (void)surface;  // Stub doesn't support surface blitting
+}
+
 void hal_display_fast_blit(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) {
     (void)x;
     (void)y;
@@ -107,6 +135,14 @@ void hal_display_fast_blit_transparent(int16_t x, int16_t y, int16_t w, int16_t
     (void)transparent_color;  // Stub doesn't support transparent blitting
 }
 
+void hal_display_blit_rle(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* rle) {
+    (void)x;
+    (void)y;
+    (void)w;
+    (void)h;
+    (void)rle;  // Stub doesn't support RLE blitting
+}
+
 uint16_t hal_display_read_pixel(int32_t x, int32_t y) {
     (void)x;
     (void)y;
@@ -116,3 +152,18 @@ uint16_t hal_display_read_pixel(int32_t x, int32_t y) {
 void hal_display_dump_screen(void) {
     // No-op in stub - no display hardware or shadow buffer
 }
+
+bool hal_display_lock_surface(hal_canvas_handle_t canvas, hal_surface_t* out_surface) {
+    (void)canvas;
+    (void)out_surface;
+    return false;  // Stub has no addressable pixel memory
+}
+
+void hal_display_unlock_surface(hal_canvas_handle_t canvas,
+                                int32_t x, int32_t y, int32_t w, int32_t h) {
+    (void)canvas;
+    (void)x;
+    (void)y;
+    (void)w;
+    (void)h;  // Nothing was locked
+}
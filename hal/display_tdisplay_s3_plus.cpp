@@ -14,6 +14,10 @@
 #ifndef UNIT_TEST  // Only compile for target hardware
 
 #include "display.h"
+#include "display_damage.h"
+#include "display_rle.h"
+#include "display_format.h"
+#include "display_tiles.h"
 #include <Arduino.h>
 #include "Arduino_GFX_Library.h"
 
@@ -29,6 +33,7 @@
 // Display dimensions (RM67162)
 #define LCD_WIDTH       240
 #define LCD_HEIGHT      536
+#define LCD_PIXEL_FORMAT HAL_PIXEL_FORMAT_RGB565_BE  // RM67162 takes big-endian RGB565 on the wire
 
 // SPI configuration
 #define LCD_SPI_FREQ    40000000  // 40 MHz for RM67162 SPI mode
@@ -45,9 +50,105 @@ static bool g_initialized = false;
 // Canvas support
 static Arduino_Canvas *g_selected_canvas = nullptr;
 
-// Shadow framebuffer for screenshot capture (allocated in PSRAM)
+// Shadow framebuffer for screenshot capture (allocated in PSRAM), kept in
+// LCD_PIXEL_FORMAT so flushes go to the panel without per-pixel conversion
 static uint16_t* g_shadow_fb = nullptr;
 
+// Shadow-primary mode: HAL drawing writes only to g_shadow_fb and
+// hal_display_flush() pushes the accumulated damage to the panel
+static bool g_shadow_primary = false;
+static hal_damage_t g_damage;
+
+// Optional tile-hash filtering of g_damage at flush time
+static bool g_tile_hashing = false;
+static hal_tile_hashes_t g_tiles;
+
+// Clips a rectangle to the current screen; returns false if nothing is left
+static bool clipToScreen(int32_t& x, int32_t& y, int32_t& w, int32_t& h) {
+    int32_t screen_w = hal_display_get_width_pixels();
+    int32_t screen_h = hal_display_get_height_pixels();
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > screen_w) { w = screen_w - x; }
+    if (y + h > screen_h) { h = screen_h - y; }
+    return w > 0 && h > 0;
+}
+
+static void markDamage(int32_t x, int32_t y, int32_t w, int32_t h) {
+    if (clipToScreen(x, y, w, h)) {
+        hal_damage_add(&g_damage, x, y, w, h);
+    }
+}
+
+// Copies a w x h block of CPU-order pixels into the shadow framebuffer,
+// clipped to the screen and converted to LCD_PIXEL_FORMAT on the way.
+// Pixels equal to key are skipped when skip_key is set.
+static void copyToShadow(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data,
+                         bool skip_key, uint16_t key) {
+    int32_t screen_w = hal_display_get_width_pixels();
+    int32_t cx = x, cy = y, cw = w, ch = h;
+    if (!clipToScreen(cx, cy, cw, ch)) {
+        return;
+    }
+    for (int32_t row = 0; row < ch; row++) {
+        const uint16_t* src = &data[(cy - y + row) * w + (cx - x)];
+        uint16_t* dst = &g_shadow_fb[(cy + row) * screen_w + cx];
+        if (!skip_key) {
+            hal_pixels_convert(dst, src, cw, HAL_PIXEL_FORMAT_RGB565, LCD_PIXEL_FORMAT);
+            continue;
+        }
+        for (int32_t col = 0; col < cw; col++) {
+            if (src[col] != key) {
+                dst[col] = hal_color_to_format(src[col], LCD_PIXEL_FORMAT);
+            }
+        }
+    }
+}
+
+// Copies a surface of any format into the shadow framebuffer, clipped to
+// the screen; a memcpy per row when the surface is already in panel order
+static void copySurfaceToShadow(int32_t x, int32_t y, const hal_surface_t* surface) {
+    int32_t screen_w = hal_display_get_width_pixels();
+    int32_t cx = x, cy = y, cw = surface->width, ch = surface->height;
+    if (!clipToScreen(cx, cy, cw, ch)) {
+        return;
+    }
+    for (int32_t row = 0; row < ch; row++) {
+        const uint16_t* src = &surface->pixels[(cy - y + row) * surface->stride + (cx - x)];
+        uint16_t* dst = &g_shadow_fb[(cy + row) * screen_w + cx];
+        hal_pixels_convert(dst, src, cw, surface->format, LCD_PIXEL_FORMAT);
+    }
+}
+
+// Sends pixels inside an open transaction. Panel-order pixels go out as raw
+// bytes; anything else is byte-swapped by Arduino_GFX on the way.
+static void writePanelPixels(const uint16_t* pixels, uint32_t count, hal_pixel_format_t format) {
+    if (format == LCD_PIXEL_FORMAT) {
+        g_bus->writeBytes(reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(pixels)),
+                          count * sizeof(uint16_t));
+    } else {
+        g_gfx->writePixels(const_cast<uint16_t*>(pixels), count);
+    }
+}
+
+// Pushes a clipped region of the shadow framebuffer to the panel.
+// The address window auto-advances, so one window covers all rows, and the
+// shadow is already in panel order, so the bytes go out untouched.
+static void pushShadowRegion(int32_t x, int32_t y, int32_t w, int32_t h) {
+    int32_t screen_w = hal_display_get_width_pixels();
+    g_gfx->startWrite();
+    g_gfx->writeAddrWindow(x, y, w, h);
+    if (w == screen_w) {
+        writePanelPixels(&g_shadow_fb[y * screen_w], static_cast<uint32_t>(w) * static_cast<uint32_t>(h),
+                         LCD_PIXEL_FORMAT);
+    } else {
+        for (int32_t row = 0; row < h; row++) {
+            writePanelPixels(&g_shadow_fb[(y + row) * screen_w + x], static_cast<uint32_t>(w), LCD_PIXEL_FORMAT);
+        }
+    }
+    g_gfx->endWrite();
+}
+
 /**
  * @brief Wait for the TE (Tearing Effect) signal to sync with display refresh
  *
@@ -210,14 +311,24 @@ void hal_display_clear(uint16_t color) {
     if (g_selected_canvas != nullptr) {
         g_selected_canvas->fillScreen(color);
     } else {
-        g_gfx->fillScreen(color);
-        // Mirror to shadow framebuffer
+        if (!g_shadow_primary) {
+            g_gfx->fillScreen(color);
+        }
+        // Fill shadow framebuffer (memset when both bytes match, e.g. black/white)
         if (g_shadow_fb) {
             int32_t total = LCD_WIDTH * LCD_HEIGHT;
-            for (int32_t i = 0; i < total; i++) {
-                g_shadow_fb[i] = color;
+            uint16_t stored = hal_color_to_format(color, LCD_PIXEL_FORMAT);
+            if ((stored >> 8) == (stored & 0xFF)) {
+                memset(g_shadow_fb, stored & 0xFF, total * sizeof(uint16_t));
+            } else {
+                for (int32_t i = 0; i < total; i++) {
+                    g_shadow_fb[i] = stored;
+                }
             }
         }
+        if (g_shadow_primary) {
+            markDamage(0, 0, hal_display_get_width_pixels(), hal_display_get_height_pixels());
+        }
     }
 }
 
@@ -240,18 +351,86 @@ void hal_display_draw_pixel(int32_t x, int32_t y, uint16_t color) {
         return;  // Out of bounds, handle gracefully
     }
 
+    if (g_selected_canvas == nullptr && g_shadow_primary) {
+        g_shadow_fb[y * width + x] = hal_color_to_format(color, LCD_PIXEL_FORMAT);
+        hal_damage_add(&g_damage, x, y, 1, 1);
+        return;
+    }
+
     target->drawPixel(x, y, color);
 
     // Mirror to shadow framebuffer (only when drawing to main display)
     if (g_selected_canvas == nullptr && g_shadow_fb) {
-        g_shadow_fb[y * width + x] = color;
+        g_shadow_fb[y * width + x] = hal_color_to_format(color, LCD_PIXEL_FORMAT);
     }
 }
 
 void hal_display_flush(void) {
-    // The Arduino_GFX library for RM67162 writes directly to the display
-    // without buffering, so flush is a no-op for this hardware.
-    // This function exists to satisfy the HAL contract.
+    // In direct mode the Arduino_GFX library for RM67162 writes straight to
+    // the display without buffering, so there is nothing to do.
+    if (!g_shadow_primary || g_damage.count == 0) {
+        return;
+    }
+
+    // Sends the damage as recorded, or only its tiles that changed
+    const hal_rect_t* rects = g_damage.rects;
+    int32_t count = g_damage.count;
+    hal_rect_t changed[HAL_TILE_MAX_RECTS];
+    hal_surface_t fb;
+    if (g_tile_hashing && hal_display_lock_surface(nullptr, &fb)) {
+        int32_t n = hal_tile_hashes_diff(&g_tiles, &fb, &g_damage, changed, HAL_TILE_MAX_RECTS, nullptr);
+        if (n >= 0) {
+            rects = changed;
+            count = n;
+        }
+    }
+    hal_damage_reset(&g_damage);
+    if (count == 0) {
+        return;
+    }
+
+    // Wait for vertical blanking to prevent tearing
+    waitForTeSignal();
+
+    for (int32_t i = 0; i < count; i++) {
+        pushShadowRegion(rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+    }
+}
+
+bool hal_display_set_shadow_primary(bool enable) {
+    if (!enable) {
+        hal_display_flush();
+        g_shadow_primary = false;
+        return true;
+    }
+    if (!g_initialized || g_shadow_fb == nullptr) {
+        return false;  // No PSRAM framebuffer to draw into
+    }
+    // The shadow framebuffer already mirrors the panel, so no sync is needed;
+    // tile hashes may predate direct draws, so they start over
+    hal_damage_reset(&g_damage);
+    hal_tile_hashes_invalidate(&g_tiles);
+    g_shadow_primary = true;
+    return true;
+}
+
+bool hal_display_is_shadow_primary(void) {
+    return g_shadow_primary;
+}
+
+bool hal_display_set_tile_hashing(bool enable) {
+    if (!enable) {
+        g_tile_hashing = false;
+        hal_tile_hashes_free(&g_tiles);
+        return true;
+    }
+    if (!g_initialized || g_shadow_fb == nullptr) {
+        return false;  // Nothing to hash
+    }
+    // The grid is allocated and fully hashed on the next flush
+    hal_tile_hashes_invalidate(&g_tiles);
+    g_tile_hashing = true;
+    return true;
 }
 
 int32_t hal_display_get_width_pixels(void) {
@@ -343,26 +522,17 @@ void hal_display_canvas_draw(hal_canvas_handle_t canvas, int32_t x, int32_t y) {
     int16_t height = canvas_ptr->height();
 
     if (buffer != nullptr) {
+        if (g_shadow_primary) {
+            copyToShadow(x, y, width, height, buffer, false, 0);
+            markDamage(x, y, width, height);
+            return;
+        }
+
         g_gfx->draw16bitRGBBitmap(x, y, buffer, width, height);
 
         // Mirror to shadow framebuffer
         if (g_shadow_fb) {
-            int32_t screen_w = hal_display_get_width_pixels();
-            int32_t screen_h = hal_display_get_height_pixels();
-            for (int16_t row = 0; row < height; row++) {
-                int32_t dy = y + row;
-                if (dy < 0 || dy >= screen_h) continue;
-                int32_t dx = x;
-                int32_t src_off = 0;
-                int32_t copy_w = width;
-                if (dx < 0) { src_off = -dx; copy_w += dx; dx = 0; }
-                if (dx + copy_w > screen_w) { copy_w = screen_w - dx; }
-                if (copy_w > 0) {
-                    memcpy(&g_shadow_fb[dy * screen_w + dx],
-                           &buffer[row * width + src_off],
-                           copy_w * sizeof(uint16_t));
-                }
-            }
+            copyToShadow(x, y, width, height, buffer, false, 0);
         }
     }
 }
@@ -380,11 +550,57 @@ void* hal_display_get_gfx(void) {
     return static_cast<void*>(g_gfx);
 }
 
+hal_pixel_format_t hal_display_get_native_format(void) {
+    return LCD_PIXEL_FORMAT;
+}
+
+void hal_display_blit_surface(int16_t x, int16_t y, const hal_surface_t* surface) {
+    if (!g_initialized || g_gfx == nullptr || surface == nullptr || surface->pixels == nullptr) {
+        return;
+    }
+
+    int32_t w = surface->width;
+    int32_t h = surface->height;
+
+    if (g_shadow_primary) {
+        copySurfaceToShadow(x, y, surface);
+        markDamage(x, y, w, h);
+        return;
+    }
+
+    // Wait for vertical blanking to prevent tearing
+    waitForTeSignal();
+
+    // Contiguous rows go out as one transfer; panel-order surfaces are sent
+    // as raw bytes with no per-pixel conversion
+    g_gfx->startWrite();
+    g_gfx->writeAddrWindow(x, y, w, h);
+    if (surface->stride == w) {
+        writePanelPixels(surface->pixels, static_cast<uint32_t>(w) * static_cast<uint32_t>(h), surface->format);
+    } else {
+        for (int32_t row = 0; row < h; row++) {
+            writePanelPixels(&surface->pixels[row * surface->stride], static_cast<uint32_t>(w), surface->format);
+        }
+    }
+    g_gfx->endWrite();
+
+    // Mirror to shadow framebuffer
+    if (g_shadow_fb) {
+        copySurfaceToShadow(x, y, surface);
+    }
+}
+
 void hal_display_fast_blit(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) {
     if (!g_initialized || g_gfx == nullptr || data == nullptr) {
         return;
     }
 
+    if (g_shadow_primary) {
+        copyToShadow(x, y, w, h, data, false, 0);
+        markDamage(x, y, w, h);
+        return;
+    }
+
     // Wait for vertical blanking to prevent tearing
     waitForTeSignal();
 
@@ -396,22 +612,7 @@ void hal_display_fast_blit(int16_t x, int16_t y, int16_t w, int16_t h, const uin
 
     // Mirror to shadow framebuffer
     if (g_shadow_fb) {
-        int32_t screen_w = hal_display_get_width_pixels();
-        int32_t screen_h = hal_display_get_height_pixels();
-        for (int16_t row = 0; row < h; row++) {
-            int32_t dy = y + row;
-            if (dy < 0 || dy >= screen_h) continue;
-            int32_t dx = x;
-            int32_t src_off = 0;
-            int32_t copy_w = w;
-            if (dx < 0) { src_off = -dx; copy_w += dx; dx = 0; }
-            if (dx + copy_w > screen_w) { copy_w = screen_w - dx; }
-            if (copy_w > 0) {
-                memcpy(&g_shadow_fb[dy * screen_w + dx],
-                       &data[row * w + src_off],
-                       copy_w * sizeof(uint16_t));
-            }
-        }
+        copyToShadow(x, y, w, h, data, false, 0);
     }
 }
 
@@ -421,6 +622,13 @@ void hal_display_fast_blit_transparent(int16_t x, int16_t y, int16_t w, int16_t
         return;
     }
 
+    // Single pass: opaque pixels go straight into the framebuffer
+    if (g_shadow_primary) {
+        copyToShadow(x, y, w, h, data, true, transparent_color);
+        markDamage(x, y, w, h);
+        return;
+    }
+
     // Wait for vertical blanking to prevent tearing
     waitForTeSignal();
 
@@ -454,21 +662,130 @@ void hal_display_fast_blit_transparent(int16_t x, int16_t y, int16_t w, int16_t
 
     // Mirror non-transparent pixels to shadow framebuffer
     if (g_shadow_fb) {
-        int32_t screen_w = hal_display_get_width_pixels();
-        int32_t screen_h = hal_display_get_height_pixels();
-        for (int16_t row = 0; row < h; row++) {
-            int32_t dy = y + row;
-            if (dy < 0 || dy >= screen_h) continue;
-            for (int16_t col = 0; col < w; col++) {
-                int32_t dx = x + col;
-                if (dx < 0 || dx >= screen_w) continue;
-                uint16_t pixel = data[row * w + col];
-                if (pixel != transparent_color) {
-                    g_shadow_fb[dy * screen_w + dx] = pixel;
-                }
+        copyToShadow(x, y, w, h, data, true, transparent_color);
+    }
+}
+
+void hal_display_blit_rle(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* rle) {
+    if (!g_initialized || g_gfx == nullptr || rle == nullptr) {
+        return;
+    }
+
+    int32_t screen_w = hal_display_get_width_pixels();
+    int32_t screen_h = hal_display_get_height_pixels();
+    if (x >= screen_w || y >= screen_h || x + w <= 0 || y + h <= 0) {
+        return;
+    }
+
+    // Runs are memcpy'd into the framebuffer; only the bounding box of the
+    // pixels actually written becomes damage
+    if (g_shadow_primary) {
+        hal_surface_t fb;
+        hal_rect_t written;
+        if (hal_display_lock_surface(nullptr, &fb) &&
+            hal_rle_blit_to_surface(&fb, x, y, h, rle, &written)) {
+            hal_damage_add(&g_damage, written.x, written.y, written.w, written.h);
+        }
+        return;
+    }
+
+    // Wait for vertical blanking to prevent tearing
+    waitForTeSignal();
+
+    // One address window per opaque run, all inside a single transaction
+    g_gfx->startWrite();
+
+    const uint16_t* p = rle;
+    for (int32_t row = 0; row < h; row++) {
+        uint16_t runs = *p++;
+        int32_t dy = y + row;
+        int32_t col = 0;
+        for (uint16_t r = 0; r < runs; r++) {
+            col += *p++;
+            uint16_t len = *p++;
+            int32_t dx = x + col;
+            int32_t src_off = 0;
+            int32_t run_w = len;
+            if (dx < 0) { src_off = -dx; run_w += dx; dx = 0; }
+            if (dx + run_w > screen_w) { run_w = screen_w - dx; }
+            if (dy >= 0 && dy < screen_h && run_w > 0) {
+                g_gfx->writeAddrWindow(dx, dy, run_w, 1);
+                g_gfx->writePixels(const_cast<uint16_t*>(p + src_off), run_w);
             }
+            p += len;
+            col += len;
+        }
+    }
+
+    g_gfx->endWrite();
+
+    // Mirror the runs to the shadow framebuffer
+    hal_surface_t fb;
+    if (hal_display_lock_surface(nullptr, &fb)) {
+        hal_rle_blit_to_surface(&fb, x, y, h, rle, nullptr);
+    }
+}
+
+// Direct Surface Access Implementation
+
+bool hal_display_lock_surface(hal_canvas_handle_t canvas, hal_surface_t* out_surface) {
+    if (out_surface == nullptr) {
+        return false;
+    }
+
+    if (canvas != nullptr) {
+        Arduino_Canvas *canvas_ptr = static_cast<Arduino_Canvas*>(canvas);
+        uint16_t *buffer = canvas_ptr->getFramebuffer();
+        if (buffer == nullptr) {
+            return false;
         }
+        // Canvas framebuffers are allocated unrotated, so the stride is the
+        // canvas' own width
+        out_surface->pixels = buffer;
+        out_surface->width = canvas_ptr->width();
+        out_surface->height = canvas_ptr->height();
+        out_surface->stride = canvas_ptr->width();
+        out_surface->format = HAL_PIXEL_FORMAT_RGB565;
+        return true;
+    }
+
+    if (!g_initialized || g_shadow_fb == nullptr) {
+        return false;
+    }
+
+    int32_t screen_w = hal_display_get_width_pixels();
+    out_surface->pixels = g_shadow_fb;
+    out_surface->width = screen_w;
+    out_surface->height = hal_display_get_height_pixels();
+    out_surface->stride = screen_w;
+    out_surface->format = LCD_PIXEL_FORMAT;
+    return true;
+}
+
+void hal_display_unlock_surface(hal_canvas_handle_t canvas,
+                                int32_t x, int32_t y, int32_t w, int32_t h) {
+    // Canvas damage is presented later by whoever blits the canvas
+    if (canvas != nullptr) {
+        return;
+    }
+    if (!g_initialized || g_gfx == nullptr || g_shadow_fb == nullptr) {
+        return;
+    }
+
+    // In shadow-primary mode the next flush presents the region
+    if (g_shadow_primary) {
+        markDamage(x, y, w, h);
+        return;
     }
+
+    if (!clipToScreen(x, y, w, h)) {
+        return;
+    }
+
+    // Wait for vertical blanking to prevent tearing
+    waitForTeSignal();
+
+    pushShadowRegion(x, y, w, h);
 }
 
 uint16_t hal_display_read_pixel(int32_t x, int32_t y) {
@@ -476,7 +793,7 @@ uint16_t hal_display_read_pixel(int32_t x, int32_t y) {
     int32_t w = hal_display_get_width_pixels();
     int32_t h = hal_display_get_height_pixels();
     if (x < 0 || x >= w || y < 0 || y >= h) return 0;
-    return g_shadow_fb[y * w + x];
+    return hal_color_from_format(g_shadow_fb[y * w + x], LCD_PIXEL_FORMAT);
 }
 
 void hal_display_dump_screen(void) {
@@ -487,9 +804,15 @@ void hal_display_dump_screen(void) {
 
     Serial.printf("START:%d,%d\n", (int)w, (int)h);
 
-    // Write row by row, yielding to prevent watchdog timeout
+    // Write row by row, yielding to prevent watchdog timeout. The capture
+    // tool expects CPU-order pixels, so convert in small chunks.
+    uint16_t chunk[64];
     for (int32_t row = 0; row < h; row++) {
-        Serial.write((const uint8_t*)&g_shadow_fb[row * w], w * sizeof(uint16_t));
+        for (int32_t col = 0; col < w; col += 64) {
+            int32_t n = (w - col < 64) ? (w - col) : 64;
+            hal_pixels_convert(chunk, &g_shadow_fb[row * w + col], n, LCD_PIXEL_FORMAT, HAL_PIXEL_FORMAT_RGB565);
+            Serial.write((const uint8_t*)chunk, n * sizeof(uint16_t));
+        }
         yield();
     }
 
@@ -0,0 +1,228 @@
+/**
+ * @file display_tiles.cpp
+ * @brief Tile-hash damage detection (board-independent)
+ *
+ * Compiled for every environment, including native tests.
+ */
+
+#include "display_tiles.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const uint8_t TILE_DAMAGED = 1;
+static const uint8_t TILE_CHANGED = 2;
+
+// Matches the grid to the frame, reallocating only when it has to grow
+static bool reshape(hal_tile_hashes_t* tiles, int32_t cols, int32_t rows) {
+    if (tiles->hashes != nullptr && tiles->cols == cols && tiles->rows == rows) {
+        return true;
+    }
+
+    int32_t count = cols * rows;
+    if (count > tiles->capacity) {
+        free(tiles->hashes);
+        free(tiles->flags);
+        tiles->hashes = static_cast<uint32_t*>(malloc(count * sizeof(uint32_t)));
+        tiles->flags = static_cast<uint8_t*>(malloc(count));
+        if (tiles->hashes == nullptr || tiles->flags == nullptr) {
+            hal_tile_hashes_free(tiles);
+            return false;
+        }
+        tiles->capacity = count;
+    }
+
+    tiles->cols = cols;
+    tiles->rows = rows;
+    tiles->valid = false;
+    memset(tiles->flags, 0, count);
+    return true;
+}
+
+// Rectangle of a tile, clipped to the frame
+static hal_rect_t tileRect(const hal_surface_t* frame, int32_t col, int32_t row) {
+    hal_rect_t r;
+    r.x = col * HAL_TILE_SIZE;
+    r.y = row * HAL_TILE_SIZE;
+    r.w = (r.x + HAL_TILE_SIZE > frame->width) ? frame->width - r.x : HAL_TILE_SIZE;
+    r.h = (r.y + HAL_TILE_SIZE > frame->height) ? frame->height - r.y : HAL_TILE_SIZE;
+    return r;
+}
+
+static hal_rect_t rectUnion(const hal_rect_t& a, const hal_rect_t& b) {
+    int32_t x0 = (a.x < b.x) ? a.x : b.x;
+    int32_t y0 = (a.y < b.y) ? a.y : b.y;
+    int32_t x1 = (a.x + a.w > b.x + b.w) ? a.x + a.w : b.x + b.w;
+    int32_t y1 = (a.y + a.h > b.y + b.h) ? a.y + a.h : b.y + b.h;
+    hal_rect_t r = { x0, y0, x1 - x0, y1 - y0 };
+    return r;
+}
+
+// Appends a rectangle (in tile units); when full, merges it into whichever
+// rectangle grows the least
+static int32_t appendRect(hal_rect_t* rects, int32_t count, int32_t max_rects, const hal_rect_t& r) {
+    if (count < max_rects) {
+        rects[count] = r;
+        return count + 1;
+    }
+
+    int32_t best = 0;
+    int32_t best_growth = INT32_MAX;
+    for (int32_t i = 0; i < count; i++) {
+        hal_rect_t u = rectUnion(rects[i], r);
+        int32_t growth = u.w * u.h - rects[i].w * rects[i].h;
+        if (growth < best_growth) {
+            best_growth = growth;
+            best = i;
+        }
+    }
+    rects[best] = rectUnion(rects[best], r);
+    return count;
+}
+
+void hal_tile_hashes_free(hal_tile_hashes_t* tiles) {
+    if (tiles == nullptr) {
+        return;
+    }
+    free(tiles->hashes);
+    free(tiles->flags);
+    memset(tiles, 0, sizeof(*tiles));
+}
+
+void hal_tile_hashes_invalidate(hal_tile_hashes_t* tiles) {
+    if (tiles != nullptr) {
+        tiles->valid = false;
+    }
+}
+
+uint32_t hal_tile_hash(const hal_surface_t* surface, int32_t x, int32_t y, int32_t w, int32_t h) {
+    // Multiply-xorshift over 32-bit words (two pixels per step); memcpy keeps
+    // the load alias-safe and compiles to a plain read
+    uint32_t hash = 0x811C9DC5u;
+    for (int32_t row = 0; row < h; row++) {
+        const uint16_t* p = surface->pixels + (y + row) * surface->stride + x;
+        int32_t col = 0;
+        for (; col + 2 <= w; col += 2) {
+            uint32_t v;
+            memcpy(&v, p + col, sizeof(v));
+            hash = (hash ^ v) * 0x9E3779B1u;
+            hash ^= hash >> 15;
+        }
+        if (col < w) {
+            hash = (hash ^ p[col]) * 0x9E3779B1u;
+            hash ^= hash >> 15;
+        }
+    }
+    return hash;
+}
+
+int32_t hal_tile_hashes_diff(hal_tile_hashes_t* tiles, const hal_surface_t* frame,
+                             const hal_damage_t* damage, hal_rect_t* out_rects,
+                             int32_t max_rects, hal_tile_stats_t* out_stats) {
+    hal_tile_stats_t stats = { 0, 0, 0, 0 };
+    if (out_stats != nullptr) {
+        *out_stats = stats;
+    }
+    if (tiles == nullptr || frame == nullptr || frame->pixels == nullptr ||
+        damage == nullptr || out_rects == nullptr || max_rects <= 0) {
+        return 0;
+    }
+
+    int32_t cols = (frame->width + HAL_TILE_SIZE - 1) / HAL_TILE_SIZE;
+    int32_t rows = (frame->height + HAL_TILE_SIZE - 1) / HAL_TILE_SIZE;
+    if (!reshape(tiles, cols, rows)) {
+        return -1;
+    }
+
+    // Mark every tile under the damage, clipped to the frame
+    for (int32_t i = 0; i < damage->count; i++) {
+        hal_rect_t r = damage->rects[i];
+        if (r.x < 0) { r.w += r.x; r.x = 0; }
+        if (r.y < 0) { r.h += r.y; r.y = 0; }
+        if (r.x + r.w > frame->width) { r.w = frame->width - r.x; }
+        if (r.y + r.h > frame->height) { r.h = frame->height - r.y; }
+        if (r.w <= 0 || r.h <= 0) {
+            continue;
+        }
+        stats.pixels_damaged += r.w * r.h;
+        int32_t c1 = (r.x + r.w - 1) / HAL_TILE_SIZE;
+        int32_t r1 = (r.y + r.h - 1) / HAL_TILE_SIZE;
+        for (int32_t tr = r.y / HAL_TILE_SIZE; tr <= r1; tr++) {
+            for (int32_t tc = r.x / HAL_TILE_SIZE; tc <= c1; tc++) {
+                tiles->flags[tr * cols + tc] |= TILE_DAMAGED;
+            }
+        }
+    }
+
+    // Rehash damaged tiles. Without valid hashes, every tile is hashed once
+    // so later diffs can trust the whole grid; undamaged tiles already match
+    // the panel, so only damaged ones are reported.
+    for (int32_t tr = 0; tr < rows; tr++) {
+        for (int32_t tc = 0; tc < cols; tc++) {
+            int32_t idx = tr * cols + tc;
+            bool damaged = (tiles->flags[idx] & TILE_DAMAGED) != 0;
+            if (!damaged && tiles->valid) {
+                continue;
+            }
+            hal_rect_t t = tileRect(frame, tc, tr);
+            uint32_t hash = hal_tile_hash(frame, t.x, t.y, t.w, t.h);
+            if (damaged) {
+                stats.tiles_hashed++;
+                if (!tiles->valid || hash != tiles->hashes[idx]) {
+                    tiles->flags[idx] |= TILE_CHANGED;
+                    stats.tiles_changed++;
+                }
+            }
+            tiles->hashes[idx] = hash;
+        }
+    }
+    tiles->valid = true;
+
+    // Coalesce changed tiles: horizontal runs first, then extend a rectangle
+    // from the row above when the run has exactly its span (tile units)
+    int32_t count = 0;
+    for (int32_t tr = 0; tr < rows; tr++) {
+        int32_t tc = 0;
+        while (tc < cols) {
+            if ((tiles->flags[tr * cols + tc] & TILE_CHANGED) == 0) {
+                tc++;
+                continue;
+            }
+            int32_t start = tc;
+            while (tc < cols && (tiles->flags[tr * cols + tc] & TILE_CHANGED) != 0) {
+                tc++;
+            }
+
+            bool extended = false;
+            for (int32_t i = 0; i < count; i++) {
+                hal_rect_t& r = out_rects[i];
+                if (r.x == start && r.w == tc - start && r.y + r.h == tr) {
+                    r.h++;
+                    extended = true;
+                    break;
+                }
+            }
+            if (!extended) {
+                hal_rect_t run = { start, tr, tc - start, 1 };
+                count = appendRect(out_rects, count, max_rects, run);
+            }
+        }
+    }
+    memset(tiles->flags, 0, cols * rows);
+
+    // Tile units to pixels, clipped to the frame
+    for (int32_t i = 0; i < count; i++) {
+        hal_rect_t& r = out_rects[i];
+        int32_t x1 = (r.x + r.w) * HAL_TILE_SIZE;
+        int32_t y1 = (r.y + r.h) * HAL_TILE_SIZE;
+        r.x *= HAL_TILE_SIZE;
+        r.y *= HAL_TILE_SIZE;
+        r.w = ((x1 > frame->width) ? frame->width : x1) - r.x;
+        r.h = ((y1 > frame->height) ? frame->height : y1) - r.y;
+        stats.pixels_sent += r.w * r.h;
+    }
+
+    if (out_stats != nullptr) {
+        *out_stats = stats;
+    }
+    return count;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file display_tiles.h
+ * @brief Hardware Abstraction Layer (HAL) - Tile-Hash Damage Detection
+ *
+ * Keeps a 32-bit hash per HAL_TILE_SIZE x HAL_TILE_SIZE tile of the shadow
+ * framebuffer, as it was at the previous flush. At flush time only the tiles
+ * under the reported damage are rehashed, and only those whose hash changed
+ * are sent to the panel, coalesced into rectangles. Components that redraw
+ * large regions without tracking what actually changed still get partial
+ * updates. Shared by all board implementations; contains no hardware code.
+ *
+ * See features/hal_spec_display.md (Tile-Hash Damage Detection).
+ */
+
+#ifndef HAL_DISPLAY_TILES_H
+#define HAL_DISPLAY_TILES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "display.h"
+#include "display_damage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Tile edge length in pixels */
+#define HAL_TILE_SIZE 16
+
+/** Maximum number of rectangles produced per flush before merging kicks in */
+#define HAL_TILE_MAX_RECTS 32
+
+/**
+ * @brief Per-tile hashes of the last flushed frame
+ *
+ * Zero-initialize before first use. The grid is (re)shaped to the frame on
+ * the first hal_tile_hashes_diff() call and whenever the frame size changes
+ * (e.g. rotation); a reshaped or invalidated grid reports every damaged tile
+ * as changed.
+ */
+typedef struct {
+    uint32_t* hashes;   ///< cols * rows hashes, row-major
+    uint8_t* flags;     ///< Per-tile scratch used during a diff
+    int32_t cols;
+    int32_t rows;
+    int32_t capacity;   ///< Allocated tiles
+    bool valid;         ///< false until every hash reflects the panel
+} hal_tile_hashes_t;
+
+/**
+ * @brief Counters from the most recent diff, for tuning and benchmarks
+ */
+typedef struct {
+    int32_t tiles_hashed;   ///< Tiles under the damage (each hashed once)
+    int32_t tiles_changed;  ///< Tiles whose hash differed
+    int32_t pixels_damaged; ///< Area of the damage passed in
+    int32_t pixels_sent;    ///< Area of the rectangles returned
+} hal_tile_stats_t;
+
+/**
+ * @brief Frees the hash grid
+ *
+ * @param tiles The grid to release (left zeroed)
+ */
+void hal_tile_hashes_free(hal_tile_hashes_t* tiles);
+
+/**
+ * @brief Forgets every hash, so the next diff reports all damaged tiles
+ *
+ * Call whenever the panel may have been written without going through the
+ * shadow framebuffer.
+ *
+ * @param tiles The grid to invalidate
+ */
+void hal_tile_hashes_invalidate(hal_tile_hashes_t* tiles);
+
+/**
+ * @brief Hashes a rectangle of a surface
+ *
+ * @param surface The surface to read (any pixel format)
+ * @param x Left edge
+ * @param y Top edge
+ * @param w Width (must lie within the surface)
+ * @param h Height (must lie within the surface)
+ * @return uint32_t Hash of the pixels
+ */
+uint32_t hal_tile_hash(const hal_surface_t* surface, int32_t x, int32_t y, int32_t w, int32_t h);
+
+/**
+ * @brief Finds the damaged tiles that actually changed since the last diff
+ *
+ * Every tile overlapped by damage is rehashed once and its stored hash
+ * updated. Changed tiles are merged into horizontal runs, runs with the same
+ * span on consecutive tile rows into rectangles. Rectangles are clipped to
+ * the frame. When more than max_rects would be needed, the excess is merged
+ * into whichever rectangle grows the least.
+ *
+ * @param tiles Hash grid (reshaped to the frame if needed)
+ * @param frame The composed frame (normally the shadow framebuffer)
+ * @param damage Regions written since the last diff
+ * @param out_rects Receives the rectangles to send
+ * @param max_rects Capacity of out_rects
+ * @param out_stats Optional counters (may be nullptr)
+ * @return int32_t Number of rectangles written, or -1 if the grid could not
+ *         be allocated (send the damage unchanged in that case)
+ */
+int32_t hal_tile_hashes_diff(hal_tile_hashes_t* tiles, const hal_surface_t* frame,
+                             const hal_damage_t* damage, hal_rect_t* out_rects,
+                             int32_t max_rects, hal_tile_stats_t* out_stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_DISPLAY_TILES_H
@@ -38,6 +38,38 @@ bool hal_timer_init(void);
  */
 uint64_t hal_timer_get_micros(void);
 
+/**
+ * @brief Blocks until hal_timer_get_micros() reaches deadline_micros
+ *
+ * Like vTaskDelayUntil(), the deadline is absolute, so a periodic caller
+ * does not drift by the time its own work takes. Implementations should
+ * yield the CPU to other tasks for most of the wait rather than spin.
+ * Returns immediately if the deadline has passed.
+ *
+ * @param deadline_micros Absolute time, in hal_timer_get_micros() units
+ */
+void hal_timer_sleep_until(uint64_t deadline_micros);
+
+/**
+ * @brief Blocks until hal_timer_wake() is called or the deadline passes
+ *
+ * Used by the UI task to idle while nothing on screen changes. A wake that
+ * arrives while nobody is waiting is kept, so the next wait returns at once;
+ * repeated wakes before that count as one. The deadline may be a tick late.
+ *
+ * @param deadline_micros Absolute time, in hal_timer_get_micros() units
+ * @return true if woken by hal_timer_wake(), false if the deadline passed
+ */
+bool hal_timer_wait_for_wake(uint64_t deadline_micros);
+
+/**
+ * @brief Ends a hal_timer_wait_for_wake() early
+ *
+ * Safe to call from any task (e.g. the input loop posting a gesture, or a
+ * data task that has new values) and from interrupt handlers.
+ */
+void hal_timer_wake(void);
+
 #ifdef __cplusplus
 }
 #endif
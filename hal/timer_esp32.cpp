@@ -10,13 +10,71 @@
 
 #include "timer.h"
 #include <esp_timer.h>
+#include <esp_attr.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+// Spun rather than slept at the end of a wait: vTaskDelay() only has tick
+// resolution, and a task woken late loses the rest of the frame
+static const int64_t SLEEP_SPIN_MICROS = 500;
+
+// Binary semaphore: a give while nobody waits is kept for the next wait,
+// and further gives before then are absorbed
+static SemaphoreHandle_t s_wake_semaphore = nullptr;
 
 bool hal_timer_init(void) {
-    // ESP-IDF esp_timer initializes automatically, so we just return success
-    return true;
+    // ESP-IDF esp_timer initializes automatically; only the wake-up
+    // semaphore needs creating
+    if (s_wake_semaphore == nullptr) {
+        s_wake_semaphore = xSemaphoreCreateBinary();
+    }
+    return s_wake_semaphore != nullptr;
 }
 
 uint64_t hal_timer_get_micros(void) {
     // Direct wrapper around ESP-IDF's esp_timer_get_time()
     return esp_timer_get_time();
 }
+
+void hal_timer_sleep_until(uint64_t deadline_micros) {
+    const int64_t tick_micros = static_cast<int64_t>(portTICK_PERIOD_MS) * 1000;
+    int64_t remaining = static_cast<int64_t>(deadline_micros) - esp_timer_get_time();
+
+    // vTaskDelay(n) returns after n - 1 to n tick interrupts, so sleeping
+    // whole ticks short of the spin margin never overshoots the deadline
+    if (remaining > tick_micros + SLEEP_SPIN_MICROS) {
+        vTaskDelay(static_cast<TickType_t>((remaining - SLEEP_SPIN_MICROS) / tick_micros));
+    }
+
+    while (esp_timer_get_time() < static_cast<int64_t>(deadline_micros)) {
+        // Final stretch at microsecond precision
+    }
+}
+
+bool hal_timer_wait_for_wake(uint64_t deadline_micros) {
+    if (s_wake_semaphore == nullptr) {
+        hal_timer_sleep_until(deadline_micros);
+        return false;
+    }
+
+    const int64_t tick_micros = static_cast<int64_t>(portTICK_PERIOD_MS) * 1000;
+    int64_t remaining = static_cast<int64_t>(deadline_micros) - esp_timer_get_time();
+    TickType_t ticks = remaining > 0 ? static_cast<TickType_t>((remaining + tick_micros - 1) / tick_micros) : 0;
+    return xSemaphoreTake(s_wake_semaphore, ticks) == pdTRUE;
+}
+
+// In IRAM: may be called from interrupts, which can run during flash writes
+void IRAM_ATTR hal_timer_wake(void) {
+    if (s_wake_semaphore == nullptr) return;
+
+    if (xPortInIsrContext()) {
+        BaseType_t higher_priority_woken = pdFALSE;
+        xSemaphoreGiveFromISR(s_wake_semaphore, &higher_priority_woken);
+        if (higher_priority_woken == pdTRUE) {
+            portYIELD_FROM_ISR();
+        }
+    } else {
+        xSemaphoreGive(s_wake_semaphore);
+    }
+}
@@ -20,3 +20,18 @@ __attribute__((weak)) uint64_t hal_timer_get_micros(void) {
     // Stub: return 0 as no timer is available
     return 0;
 }
+
+__attribute__((weak)) void hal_timer_sleep_until(uint64_t deadline_micros) {
+    // Stub: no clock to wait on. Tests override this to advance a virtual clock.
+    (void)deadline_micros;
+}
+
+__attribute__((weak)) bool hal_timer_wait_for_wake(uint64_t deadline_micros) {
+    // Stub: nothing to wait on; report the deadline as passed
+    (void)deadline_micros;
+    return false;
+}
+
+__attribute__((weak)) void hal_timer_wake(void) {
+    // Stub: no waiter to wake
+}
@@ -3,8 +3,9 @@
  * @brief Hardware Abstraction Layer for Touch Input
  *
  * This HAL provides a standard interface for touch controller initialization
- * and raw touch coordinate polling, isolating application logic from specific
- * touch hardware (e.g., CST816).
+ * and raw touch coordinate reads, isolating application logic from specific
+ * touch hardware (e.g., CST816). On hardware the controller's INT line drives
+ * the reads, and timestamped samples are queued for the input loop.
  *
  * Specification: features/hal_spec_touch.md
  */
@@ -31,6 +32,17 @@ typedef struct {
     bool is_home_button; ///< true if virtual home button was pressed (CST816 only)
 } hal_touch_point_t;
 
+/**
+ * @brief A touch report with the time the controller signalled it
+ */
+typedef struct {
+    hal_touch_point_t point;
+    uint64_t timestamp_us;  ///< hal_timer_get_micros() at the INT edge (or the read, if polled)
+} hal_touch_sample_t;
+
+/** Samples the queue holds before new ones are dropped. */
+#define HAL_TOUCH_SAMPLE_QUEUE_SIZE 64
+
 /**
  * @brief Initialize the touch hardware
  *
@@ -44,15 +56,40 @@ bool hal_touch_init(void);
 /**
  * @brief Read the current state of the touch panel
  *
- * This function is non-blocking and returns immediately.
- * Coordinates are mapped to the display's pixel coordinate system,
- * accounting for any rotation applied to the display.
+ * Performs one controller transaction. Coordinates are mapped to the
+ * display's pixel coordinate system, accounting for any rotation applied
+ * to the display. Once hal_touch_init() has started sampling, only the
+ * sampler task calls this; everyone else consumes samples.
  *
  * @param point Pointer to hal_touch_point_t structure to fill
  * @return true if read was successful (even if not pressed), false on hardware error
  */
 bool hal_touch_read(hal_touch_point_t* point);
 
+/**
+ * @brief Take the oldest queued sample
+ *
+ * Non-blocking. Single consumer: call from one task only (the input loop).
+ * Taken samples are also recorded to an active touch trace (touch_trace.h).
+ *
+ * @param sample Filled with the sample
+ * @return true if a sample was taken, false if the queue is empty
+ */
+bool hal_touch_pop_sample(hal_touch_sample_t* sample);
+
+/**
+ * @brief Block until a sample is queued or the timeout passes
+ *
+ * @param timeout_ms Longest wait in milliseconds (0 = just check)
+ * @return true if at least one sample is queued
+ */
+bool hal_touch_wait_for_sample(uint32_t timeout_ms);
+
+/**
+ * @brief Samples lost because the queue was full
+ */
+uint32_t hal_touch_get_dropped_samples(void);
+
 #ifdef __cplusplus
 }  // extern "C"
 
@@ -18,6 +18,7 @@
 #ifndef UNIT_TEST  // Only compile for target hardware
 
 #include "touch.h"
+#include "touch_sampler.h"
 #include "input/touch_gesture_engine.h"
 #include <Arduino.h>
 #include <Wire.h>
@@ -200,6 +201,13 @@ bool hal_touch_init(void) {
     Serial.printf("[HAL Touch CST816] Display: %dx%d\n", g_display_width, g_display_height);
 
     g_touch_initialized = true;
+
+    // INT pulses low on each new report; the sampler reads and queues it
+    if (!hal_touch_start_sampler(TOUCH_INT)) {
+        Serial.println("[HAL Touch CST816] Sampler task could not be created");
+        g_touch_initialized = false;
+        return false;
+    }
     Serial.println("[HAL Touch CST816] Initialized successfully (direct I2C mode)");
     return true;
 }
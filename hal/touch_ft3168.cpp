@@ -14,6 +14,7 @@
 #ifndef UNIT_TEST  // Only compile for target hardware
 
 #include "touch.h"
+#include "touch_sampler.h"
 #include "input/touch_gesture_engine.h"
 #include <Arduino.h>
 #include <Wire.h>
@@ -86,6 +87,13 @@ bool hal_touch_init(void) {
     Serial.printf("[HAL Touch FT3168] Display: %dx%d\n", g_display_width, g_display_height);
 
     g_touch_initialized = true;
+
+    // INT pulses low on each new report; the sampler reads and queues it
+    if (!hal_touch_start_sampler(TOUCH_INT)) {
+        Serial.println("[HAL Touch FT3168] Sampler task could not be created");
+        g_touch_initialized = false;
+        return false;
+    }
     Serial.println("[HAL Touch FT3168] Initialized successfully");
     return true;
 }
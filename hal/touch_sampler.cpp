@@ -0,0 +1,153 @@
+/**
+ * @file touch_sampler.cpp
+ * @brief Interrupt-driven touch sampling and the timestamped sample queue
+ *
+ * The queue is a lock-free single-producer, single-consumer ring: the
+ * sampler task pushes, the input loop pops. Waiting for a sample uses a
+ * binary semaphore on ESP32 and a condition variable on the host.
+ *
+ * See features/hal_spec_touch.md (Interrupt-Driven Sampling).
+ */
+
+#include "touch_sampler.h"
+#include "touch_trace.h"
+#include "timer.h"
+#include "spsc_queue.h"
+#include <atomic>
+
+#ifdef ARDUINO
+    #include <Arduino.h>
+    #include <esp_attr.h>
+    #include <esp_timer.h>
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/task.h>
+    #include <freertos/semphr.h>
+#else
+    #include <chrono>
+    #include <condition_variable>
+    #include <mutex>
+#endif
+
+static SpscQueue<hal_touch_sample_t, HAL_TOUCH_SAMPLE_QUEUE_SIZE> s_samples;
+static std::atomic<uint32_t> s_dropped(0);
+
+#ifdef ARDUINO
+
+static constexpr uint32_t SAMPLER_STACK_SIZE = 4096;
+static constexpr uint32_t SAMPLER_PRIORITY = 3;  // Above the input loop
+
+static SemaphoreHandle_t s_sample_semaphore = nullptr;
+static TaskHandle_t s_sampler_task = nullptr;
+
+// Low 32 bits of esp_timer_get_time() at the last INT edge: written in one
+// store, so the task never reads half of it. Widened again in the task.
+static volatile uint32_t s_int_micros = 0;
+
+// In IRAM: may run during flash writes
+static void IRAM_ATTR touch_int_isr(void) {
+    s_int_micros = static_cast<uint32_t>(esp_timer_get_time());
+    BaseType_t higher_priority_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(s_sampler_task, &higher_priority_woken);
+    if (higher_priority_woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void sampler_task(void* arg) {
+    (void)arg;
+    bool pressed = false;
+    uint64_t last_timestamp = 0;
+    for (;;) {
+        // Idle: sleep until INT. While pressed, also poll, so a release
+        // whose INT edge was missed can't leave the finger stuck down.
+        TickType_t timeout = pressed ? pdMS_TO_TICKS(HAL_TOUCH_PRESSED_POLL_MS) : portMAX_DELAY;
+        bool edge = ulTaskNotifyTake(pdTRUE, timeout) > 0;
+
+        uint64_t now = hal_timer_get_micros();
+        uint64_t timestamp = edge
+            ? now - static_cast<uint32_t>(static_cast<uint32_t>(now) - s_int_micros)
+            : now;
+        // An edge just after a timed-out poll predates that poll's read
+        if (timestamp < last_timestamp) timestamp = last_timestamp;
+        last_timestamp = timestamp;
+
+        hal_touch_point_t point;
+        if (!hal_touch_read(&point)) continue;
+        pressed = point.is_pressed;
+        hal_touch_queue_sample(&point, timestamp);
+    }
+}
+
+bool hal_touch_start_sampler(int int_pin) {
+    if (s_sampler_task != nullptr) return true;
+
+    s_sample_semaphore = xSemaphoreCreateBinary();
+    if (s_sample_semaphore == nullptr) return false;
+    if (xTaskCreate(sampler_task, "touch", SAMPLER_STACK_SIZE, nullptr,
+                    SAMPLER_PRIORITY, &s_sampler_task) != pdPASS) {
+        vSemaphoreDelete(s_sample_semaphore);
+        s_sample_semaphore = nullptr;
+        s_sampler_task = nullptr;
+        return false;
+    }
+
+    pinMode(int_pin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(int_pin), touch_int_isr, FALLING);
+    xTaskNotifyGive(s_sampler_task);  // Initial read
+    return true;
+}
+
+bool hal_touch_queue_sample(const hal_touch_point_t* point, uint64_t timestamp_us) {
+    hal_touch_sample_t sample = { *point, timestamp_us };
+    if (!s_samples.push(sample)) {
+        s_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (s_sample_semaphore != nullptr) xSemaphoreGive(s_sample_semaphore);
+    return true;
+}
+
+bool hal_touch_wait_for_sample(uint32_t timeout_ms) {
+    if (!s_samples.isEmpty() || timeout_ms == 0) return !s_samples.isEmpty();
+    if (s_sample_semaphore == nullptr) {
+        vTaskDelay(pdMS_TO_TICKS(timeout_ms));
+    } else {
+        xSemaphoreTake(s_sample_semaphore, pdMS_TO_TICKS(timeout_ms));
+    }
+    return !s_samples.isEmpty();
+}
+
+#else
+
+static std::mutex s_wait_mutex;
+static std::condition_variable s_wait_cv;
+
+bool hal_touch_queue_sample(const hal_touch_point_t* point, uint64_t timestamp_us) {
+    hal_touch_sample_t sample = { *point, timestamp_us };
+    if (!s_samples.push(sample)) {
+        s_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(s_wait_mutex);
+    s_wait_cv.notify_one();
+    return true;
+}
+
+bool hal_touch_wait_for_sample(uint32_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(s_wait_mutex);
+    return s_wait_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                              []() { return !s_samples.isEmpty(); });
+}
+
+#endif
+
+bool hal_touch_pop_sample(hal_touch_sample_t* sample) {
+    if (sample == nullptr) return false;
+    if (!s_samples.pop(sample)) return false;
+    hal_touch_trace_record(sample);
+    return true;
+}
+
+uint32_t hal_touch_get_dropped_samples(void) {
+    return s_dropped.load(std::memory_order_relaxed);
+}
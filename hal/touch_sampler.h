@@ -0,0 +1,53 @@
+/**
+ * @file touch_sampler.h
+ * @brief Hardware Abstraction Layer (HAL) - Interrupt-Driven Touch Sampling
+ *
+ * Driver side of the touch sample queue. On hardware, the controller's INT
+ * line wakes a sampler task that reads the controller (hal_touch_read())
+ * and queues the result with the time of the INT edge. Nothing is read
+ * while no finger is down. Shared by all board implementations.
+ *
+ * See features/hal_spec_touch.md (Interrupt-Driven Sampling).
+ */
+
+#ifndef HAL_TOUCH_SAMPLER_H
+#define HAL_TOUCH_SAMPLER_H
+
+#include "touch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** While a finger is down, read at least this often even without an INT edge. */
+#define HAL_TOUCH_PRESSED_POLL_MS 20
+
+/**
+ * @brief Queue a sample for hal_touch_pop_sample()
+ *
+ * Single producer: the sampler task (or a test standing in for it).
+ * A full queue drops the sample and counts it.
+ *
+ * @param point Touch report
+ * @param timestamp_us hal_timer_get_micros() time of the report
+ * @return false if the sample was dropped
+ */
+bool hal_touch_queue_sample(const hal_touch_point_t* point, uint64_t timestamp_us);
+
+/**
+ * @brief Start the sampler task and attach the INT interrupt
+ *
+ * Called by the board's hal_touch_init() once hal_touch_read() works.
+ * The task reads once at start, so a finger already down is reported.
+ * Hardware only; on the host, tests queue samples themselves.
+ *
+ * @param int_pin GPIO of the controller's INT line (falling edge)
+ * @return false if the task could not be created
+ */
+bool hal_touch_start_sampler(int int_pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_TOUCH_SAMPLER_H
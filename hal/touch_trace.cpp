@@ -0,0 +1,147 @@
+/**
+ * @file touch_trace.cpp
+ * @brief Touch trace encoding and recording
+ *
+ * Portable: the same code records on the board and decodes on the host.
+ *
+ * See features/hal_spec_touch.md (Touch Traces).
+ */
+
+#include "touch_trace.h"
+#include <string.h>
+
+static const uint8_t TRACE_MAGIC[4] = { 'L', 'P', 'T', 'T' };
+
+static constexpr uint8_t FLAG_PRESSED = 0x01;
+static constexpr uint8_t FLAG_HOME_BUTTON = 0x02;
+
+static hal_touch_trace_write_fn s_write = nullptr;
+static void* s_write_context = nullptr;
+static hal_touch_trace_state_t s_record_state;
+
+static size_t put_varint(uint8_t* out, uint64_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = static_cast<uint8_t>(value);
+    return n;
+}
+
+// 0 if the value runs past size or past 64 bits
+static size_t get_varint(const uint8_t* data, size_t size, uint64_t* value) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < size && i < 10; i++) {
+        result |= static_cast<uint64_t>(data[i] & 0x7F) << (7 * i);
+        if ((data[i] & 0x80) == 0) {
+            *value = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+// Small steps of either sign encode in one byte
+static uint32_t zigzag(int32_t value) {
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+static int32_t unzigzag(uint64_t value) {
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+size_t hal_touch_trace_write_header(uint8_t* out, uint16_t width, uint16_t height) {
+    memcpy(out, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    out[4] = HAL_TOUCH_TRACE_VERSION;
+    out[5] = 0;
+    out[6] = static_cast<uint8_t>(width);
+    out[7] = static_cast<uint8_t>(width >> 8);
+    out[8] = static_cast<uint8_t>(height);
+    out[9] = static_cast<uint8_t>(height >> 8);
+    return HAL_TOUCH_TRACE_HEADER_SIZE;
+}
+
+bool hal_touch_trace_read_header(const uint8_t* data, size_t size,
+                                 uint16_t* width, uint16_t* height) {
+    if (data == nullptr || size < HAL_TOUCH_TRACE_HEADER_SIZE) return false;
+    if (memcmp(data, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) return false;
+    if (data[4] == 0 || data[4] > HAL_TOUCH_TRACE_VERSION) return false;
+    if (width) *width = static_cast<uint16_t>(data[6] | (data[7] << 8));
+    if (height) *height = static_cast<uint16_t>(data[8] | (data[9] << 8));
+    return true;
+}
+
+size_t hal_touch_trace_encode(hal_touch_trace_state_t* state,
+                              const hal_touch_sample_t* sample, uint8_t* out) {
+    uint64_t timestamp = sample->timestamp_us;
+    if (timestamp < state->timestamp_us) timestamp = state->timestamp_us;
+
+    size_t n = 0;
+    out[n++] = static_cast<uint8_t>((sample->point.is_pressed ? FLAG_PRESSED : 0) |
+                                    (sample->point.is_home_button ? FLAG_HOME_BUTTON : 0));
+    n += put_varint(out + n, timestamp - state->timestamp_us);
+    n += put_varint(out + n, zigzag(static_cast<int32_t>(sample->point.x) - state->x));
+    n += put_varint(out + n, zigzag(static_cast<int32_t>(sample->point.y) - state->y));
+
+    state->timestamp_us = timestamp;
+    state->x = sample->point.x;
+    state->y = sample->point.y;
+    return n;
+}
+
+size_t hal_touch_trace_decode(hal_touch_trace_state_t* state, const uint8_t* data,
+                              size_t size, hal_touch_sample_t* sample) {
+    if (size == 0) return 0;
+    uint8_t flags = data[0];
+    size_t n = 1;
+
+    uint64_t dt, dx, dy;
+    size_t used = get_varint(data + n, size - n, &dt);
+    if (used == 0) return 0;
+    n += used;
+    used = get_varint(data + n, size - n, &dx);
+    if (used == 0) return 0;
+    n += used;
+    used = get_varint(data + n, size - n, &dy);
+    if (used == 0) return 0;
+    n += used;
+
+    state->timestamp_us += dt;
+    state->x = static_cast<int16_t>(state->x + unzigzag(dx));
+    state->y = static_cast<int16_t>(state->y + unzigzag(dy));
+
+    sample->point.x = state->x;
+    sample->point.y = state->y;
+    sample->point.is_pressed = (flags & FLAG_PRESSED) != 0;
+    sample->point.is_home_button = (flags & FLAG_HOME_BUTTON) != 0;
+    sample->timestamp_us = state->timestamp_us;
+    return n;
+}
+
+bool hal_touch_trace_start(uint16_t width, uint16_t height,
+                           hal_touch_trace_write_fn write, void* context) {
+    if (write == nullptr) return false;
+    s_write = write;
+    s_write_context = context;
+    s_record_state = hal_touch_trace_state_t();
+
+    uint8_t header[HAL_TOUCH_TRACE_HEADER_SIZE];
+    write(header, hal_touch_trace_write_header(header, width, height), context);
+    return true;
+}
+
+void hal_touch_trace_stop(void) {
+    s_write = nullptr;
+    s_write_context = nullptr;
+}
+
+bool hal_touch_trace_is_recording(void) {
+    return s_write != nullptr;
+}
+
+void hal_touch_trace_record(const hal_touch_sample_t* sample) {
+    if (s_write == nullptr) return;
+    uint8_t record[HAL_TOUCH_TRACE_MAX_RECORD_SIZE];
+    s_write(record, hal_touch_trace_encode(&s_record_state, sample, record), s_write_context);
+}
@@ -0,0 +1,121 @@
+/**
+ * @file touch_trace.h
+ * @brief Hardware Abstraction Layer (HAL) - Touch Trace Recording
+ *
+ * Records the timestamped samples the input loop takes from the touch
+ * queue in a compact binary format, for replay on the host. A trace is a
+ * header followed by one variable-length record per sample:
+ *
+ *   Header (10 bytes): "LPTT", version (1), reserved (1),
+ *                      width (u16 LE), height (u16 LE)
+ *   Record (4-17 bytes): flags (1: bit 0 pressed, bit 1 home button),
+ *                        time since the previous record in us (LEB128),
+ *                        x and y change from the previous record
+ *                        (zigzag LEB128)
+ *
+ * The first record's time and position are relative to zero. A sample
+ * every 10 ms that moves a few pixels takes 5 bytes.
+ *
+ * See features/hal_spec_touch.md (Touch Traces).
+ */
+
+#ifndef HAL_TOUCH_TRACE_H
+#define HAL_TOUCH_TRACE_H
+
+#include "touch.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HAL_TOUCH_TRACE_VERSION 1
+#define HAL_TOUCH_TRACE_HEADER_SIZE 10
+
+/** Longest encoded record: flags, a 64-bit time step and two 16-bit steps. */
+#define HAL_TOUCH_TRACE_MAX_RECORD_SIZE 17
+
+/**
+ * @brief Encoder or decoder position in a trace
+ *
+ * Zero-initialize before the first record.
+ */
+typedef struct {
+    uint64_t timestamp_us;  ///< Time of the previous record
+    int16_t x;              ///< Position of the previous record
+    int16_t y;
+} hal_touch_trace_state_t;
+
+/**
+ * @brief Write a trace header
+ * @param out At least HAL_TOUCH_TRACE_HEADER_SIZE bytes
+ * @param width Screen width the samples were taken on
+ * @param height Screen height
+ * @return HAL_TOUCH_TRACE_HEADER_SIZE
+ */
+size_t hal_touch_trace_write_header(uint8_t* out, uint16_t width, uint16_t height);
+
+/**
+ * @brief Check a trace header and read the screen size
+ * @return false if the data is too short, not a trace, or a newer version
+ */
+bool hal_touch_trace_read_header(const uint8_t* data, size_t size,
+                                 uint16_t* width, uint16_t* height);
+
+/**
+ * @brief Encode one sample
+ *
+ * Samples must be in time order; an earlier timestamp is recorded as no
+ * time passing.
+ *
+ * @param out At least HAL_TOUCH_TRACE_MAX_RECORD_SIZE bytes
+ * @return Bytes written
+ */
+size_t hal_touch_trace_encode(hal_touch_trace_state_t* state,
+                              const hal_touch_sample_t* sample, uint8_t* out);
+
+/**
+ * @brief Decode one record
+ * @param data Next record (after the header, or after the previous record)
+ * @param size Bytes left in the trace
+ * @return Bytes consumed, or 0 if the record is truncated or malformed
+ */
+size_t hal_touch_trace_decode(hal_touch_trace_state_t* state, const uint8_t* data,
+                              size_t size, hal_touch_sample_t* sample);
+
+/**
+ * @brief Receives encoded trace bytes
+ *
+ * Called with the header, then with one whole record per sample.
+ */
+typedef void (*hal_touch_trace_write_fn)(const uint8_t* data, size_t length, void* context);
+
+/**
+ * @brief Start recording the samples hal_touch_pop_sample() returns
+ *
+ * Writes the header immediately. Recording runs in the consumer's task,
+ * so the sink may block (write to serial or flash) without stalling the
+ * sampler. Call start and stop from the input loop, like the pops.
+ *
+ * @return false if write is null
+ */
+bool hal_touch_trace_start(uint16_t width, uint16_t height,
+                           hal_touch_trace_write_fn write, void* context);
+
+/** Stop recording. The sink is not called again. */
+void hal_touch_trace_stop(void);
+
+bool hal_touch_trace_is_recording(void);
+
+/**
+ * @brief Encode a sample to the active recording, if any
+ *
+ * Called by hal_touch_pop_sample().
+ */
+void hal_touch_trace_record(const hal_touch_sample_t* sample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_TOUCH_TRACE_H
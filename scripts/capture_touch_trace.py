@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+"""
+Serial Touch Trace Capture for LPad
+
+Sends 'T' to start recording touch samples on the device, waits while
+you use the touch screen, then sends 'T' again and saves the binary trace
+(hal/touch_trace.h format). Optionally writes it as a C header too, for
+replay tests on the host.
+
+Requirements:
+    pip install pyserial
+
+Usage:
+    python scripts/capture_touch_trace.py                       # auto-detect port
+    python scripts/capture_touch_trace.py -p /dev/ttyACM0       # specify port
+    python scripts/capture_touch_trace.py --header menu_scroll  # also write menu_scroll.h
+"""
+
+import sys
+import time
+import argparse
+from datetime import datetime
+from pathlib import Path
+
+try:
+    import serial
+    import serial.tools.list_ports
+except ImportError:
+    print("Error: pyserial is required. Install with: pip install pyserial")
+    sys.exit(1)
+
+
+HEADER_SIZE = 10
+
+
+def find_device_port():
+    """Auto-detect the ESP32-S3 serial port."""
+    ports = serial.tools.list_ports.comports()
+    for port in ports:
+        # ESP32-S3 USB CDC (Espressif VID)
+        if port.vid == 0x303A:
+            return port.device
+        # Common USB-UART bridges
+        desc = port.description or ""
+        if any(chip in desc for chip in ("CP210", "CH340", "ESP32")):
+            return port.device
+    return None
+
+
+def read_varint(data, pos):
+    """Decode one LEB128 value; returns (value, next position)."""
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise ValueError("truncated record")
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def summarize(data):
+    """Count the samples and presses in a trace; returns a one-line summary."""
+    if len(data) < HEADER_SIZE or data[:4] != b"LPTT":
+        return "not a touch trace"
+    width = data[6] | (data[7] << 8)
+    height = data[8] | (data[9] << 8)
+
+    pos = HEADER_SIZE
+    samples = 0
+    presses = 0
+    pressed = False
+    elapsed = 0
+    while pos < len(data):
+        flags = data[pos]
+        dt, pos = read_varint(data, pos + 1)
+        _, pos = read_varint(data, pos)
+        _, pos = read_varint(data, pos)
+        if samples > 0:
+            elapsed += dt
+        samples += 1
+        if flags & 1 and not pressed:
+            presses += 1
+        pressed = bool(flags & 1)
+    return (f"{width}x{height}, {samples} samples, {presses} touches, "
+            f"{elapsed / 1e6:.1f} s")
+
+
+def write_header(data, path, name):
+    """Write the trace as a C array for the replay tests."""
+    lines = [
+        f"// Touch trace captured {datetime.now():%Y-%m-%d} by scripts/capture_touch_trace.py",
+        f"// {summarize(data)}",
+        "#pragma once",
+        "#include <stdint.h>",
+        "",
+        f"static const uint8_t {name}[] = {{",
+    ]
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join(f"0x{b:02x}" for b in data[i : i + 16]) + ",")
+    lines.append("};")
+    path.write_text("\n".join(lines) + "\n")
+
+
+def capture_trace(port, baud=115200, output_dir="captures", header_name=None):
+    """Record a trace and save it; returns the file name or None."""
+    out_path = Path(output_dir)
+    out_path.mkdir(exist_ok=True)
+
+    print(f"Connecting to {port} at {baud} baud...")
+    ser = serial.Serial(port, baud, timeout=30)
+    time.sleep(0.5)
+    ser.reset_input_buffer()
+
+    print("Sending record trigger 'T'...")
+    ser.write(b"T")
+    ser.flush()
+    input("Recording. Use the touch screen, then press Enter to stop... ")
+
+    ser.reset_input_buffer()
+    ser.write(b"T")
+    ser.flush()
+
+    # Wait for the TRACE:<length> marker
+    line = b""
+    deadline = time.time() + 30
+    while time.time() < deadline:
+        byte = ser.read(1)
+        if not byte:
+            continue
+        if byte == b"\n":
+            text = line.decode("ascii", errors="ignore").strip()
+            if text.startswith("TRACE:"):
+                break
+            line = b""
+        else:
+            line += byte
+    else:
+        print("ERROR: Timed out waiting for TRACE marker")
+        ser.close()
+        return None
+
+    total_bytes = int(text.replace("TRACE:", ""))
+    print(f"Receiving {total_bytes} bytes...")
+    data = ser.read(total_bytes)
+    ser.read_until(b"END\n")
+    ser.close()
+
+    if len(data) < total_bytes:
+        print(f"WARNING: Incomplete data ({len(data)}/{total_bytes} bytes)")
+
+    timestamp = datetime.now().strftime("%Y%m%d_%H%M%S")
+    filename = out_path / f"touch_{timestamp}.lptt"
+    filename.write_bytes(data)
+    print(f"Saved: {filename} ({summarize(data)})")
+
+    if header_name:
+        header_path = out_path / f"{header_name}.h"
+        write_header(data, header_path, header_name)
+        print(f"Saved: {header_path}")
+    return str(filename)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Capture a touch trace from LPad device"
+    )
+    parser.add_argument(
+        "-p", "--port", help="Serial port (auto-detect if omitted)"
+    )
+    parser.add_argument(
+        "-b", "--baud", type=int, default=115200, help="Baud rate (default: 115200)"
+    )
+    parser.add_argument(
+        "-o", "--output", default="captures", help="Output directory (default: captures)"
+    )
+    parser.add_argument(
+        "--header", metavar="NAME", help="Also write NAME.h with the trace as a C array"
+    )
+    args = parser.parse_args()
+
+    port = args.port
+    if not port:
+        port = find_device_port()
+        if not port:
+            print("ERROR: Could not auto-detect device port. Use -p to specify.")
+            sys.exit(1)
+        print(f"Auto-detected device: {port}")
+
+    result = capture_trace(port, args.baud, args.output, args.header)
+    if result:
+        print(f"Touch trace captured successfully: {result}")
+    else:
+        print("Touch trace capture failed.")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
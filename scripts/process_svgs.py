@@ -1,44 +1,87 @@
 #!/usr/bin/env python3
 """
 SVG to C++ Vector Asset Converter
-Parses SVG files containing triangulated paths and generates optimized C++ data structures.
+Parses SVG files containing polygon paths (M/L/H/V/Z, absolute or relative),
+triangulates them (ear clipping, holes bridged into the outer contour), merges
+same-color triangles into indexed meshes and generates C++ data with int16
+quantized vertices and precomputed bounds.
 """
 
 import xml.etree.ElementTree as ET
 import re
-import os
+import math
 from pathlib import Path
-from typing import List, Tuple, Optional
+from typing import Dict, List, Tuple, Optional
 
 
-class VectorVertex:
-    def __init__(self, x: float, y: float):
-        self.x = x
-        self.y = y
+# Quantized coordinate that represents 1.0 (the full viewBox width/height).
+# Must match VECTOR_COORD_ONE in the generated header.
+COORD_ONE = 16384
+INT16_MIN = -32768
+INT16_MAX = 32767
 
-    def __repr__(self):
-        return f"VectorVertex({self.x:.6f}, {self.y:.6f})"
+EPSILON = 1e-9
 
+Point = Tuple[float, float]
 
-class VectorTriangle:
-    def __init__(self, v1: VectorVertex, v2: VectorVertex, v3: VectorVertex):
-        self.v1 = v1
-        self.v2 = v2
-        self.v3 = v3
 
-
-class VectorPath:
-    def __init__(self, color_rgb565: int, triangles: List[VectorTriangle]):
+class VectorMesh:
+    def __init__(self, color_rgb565: int):
         self.color = color_rgb565
-        self.triangles = triangles
+        self.triangles: List[Tuple[Point, Point, Point]] = []  # viewBox units
+        self.min_x = math.inf
+        self.min_y = math.inf
+        self.max_x = -math.inf
+        self.max_y = -math.inf
+
+    def add_triangles(self, triangles: List[Tuple[Point, Point, Point]]):
+        self.triangles.extend(triangles)
+        for tri in triangles:
+            for x, y in tri:
+                self.min_x = min(self.min_x, x)
+                self.min_y = min(self.min_y, y)
+                self.max_x = max(self.max_x, x)
+                self.max_y = max(self.max_y, y)
+
+    def overlaps(self, min_x: float, min_y: float, max_x: float, max_y: float) -> bool:
+        return not (max_x < self.min_x or min_x > self.max_x or
+                    max_y < self.min_y or min_y > self.max_y)
+
+
+class QuantizedMesh:
+    def __init__(self, color: int, vertices: List[Tuple[int, int]],
+                 indices: List[int]):
+        self.color = color
+        self.vertices = vertices
+        self.indices = indices
+        xs = [v[0] for v in vertices]
+        ys = [v[1] for v in vertices]
+        self.bounds = (min(xs), min(ys), max(xs), max(ys))
 
 
 class VectorShape:
-    def __init__(self, name: str, paths: List[VectorPath], width: float, height: float):
+    def __init__(self, name: str, meshes: List[QuantizedMesh], width: float,
+                 height: float, num_paths: int):
         self.name = name
-        self.paths = paths
+        self.meshes = meshes
         self.original_width = width
         self.original_height = height
+        self.num_paths = num_paths
+
+    @property
+    def num_vertices(self) -> int:
+        return sum(len(m.vertices) for m in self.meshes)
+
+    @property
+    def num_triangles(self) -> int:
+        return sum(len(m.indices) // 3 for m in self.meshes)
+
+    @property
+    def bounds(self) -> Tuple[int, int, int, int]:
+        return (min(m.bounds[0] for m in self.meshes),
+                min(m.bounds[1] for m in self.meshes),
+                max(m.bounds[2] for m in self.meshes),
+                max(m.bounds[3] for m in self.meshes))
 
 
 def hex_to_rgb565(hex_color: str) -> int:
@@ -58,46 +101,342 @@ def hex_to_rgb565(hex_color: str) -> int:
     return rgb565
 
 
-def parse_path_data(d: str) -> List[Tuple[float, float]]:
+# ---------------------------------------------------------------------------
+# Path parsing
+# ---------------------------------------------------------------------------
+
+_PATH_TOKEN = re.compile(r'[A-Za-z]|[-+]?(?:\d*\.\d+|\d+\.?)(?:[eE][-+]?\d+)?')
+
+
+def parse_path_data(d: str) -> List[List[Point]]:
     """
-    Parse SVG path 'd' attribute containing M, L, Z commands.
-    Returns list of (x, y) coordinate tuples.
+    Parse SVG path 'd' attribute containing M, L, H, V and Z commands
+    (absolute or relative). Returns one vertex list per subpath.
+    Curves are not supported and raise ValueError.
     """
-    vertices = []
-
-    # Remove commas and split by whitespace
-    d = d.replace(',', ' ')
-    tokens = d.split()
+    tokens = _PATH_TOKEN.findall(d)
+    subpaths: List[List[Point]] = []
+    current: List[Point] = []
 
+    cmd = None
+    x, y = 0.0, 0.0
+    start_x, start_y = 0.0, 0.0
     i = 0
-    current_x, current_y = 0.0, 0.0
+
+    def number() -> float:
+        nonlocal i
+        value = float(tokens[i])
+        i += 1
+        return value
 
     while i < len(tokens):
-        cmd = tokens[i]
-
-        if cmd == 'M':  # MoveTo
-            current_x = float(tokens[i+1])
-            current_y = float(tokens[i+2])
-            vertices.append((current_x, current_y))
-            i += 3
-        elif cmd == 'L':  # LineTo
-            current_x = float(tokens[i+1])
-            current_y = float(tokens[i+2])
-            vertices.append((current_x, current_y))
-            i += 3
-        elif cmd == 'Z' or cmd == 'z':  # ClosePath
+        tok = tokens[i]
+        if tok.isalpha():
+            cmd = tok
             i += 1
-        else:
-            # Try to parse as numeric coordinate (implicit LineTo)
-            try:
-                current_x = float(tokens[i])
-                current_y = float(tokens[i+1])
-                vertices.append((current_x, current_y))
-                i += 2
-            except (ValueError, IndexError):
-                i += 1
-
-    return vertices
+            if cmd in 'Zz':
+                if current:
+                    subpaths.append(current)
+                    current = []
+                x, y = start_x, start_y
+                continue
+            if cmd not in 'MmLlHhVv':
+                raise ValueError(f"unsupported path command '{cmd}'")
+        elif cmd is None or cmd in 'Zz':
+            raise ValueError(f"coordinate '{tok}' without a command")
+
+        relative = cmd.islower()
+        if cmd in 'Mm':
+            nx, ny = number(), number()
+            if current:
+                subpaths.append(current)
+            x, y = (x + nx, y + ny) if relative else (nx, ny)
+            start_x, start_y = x, y
+            current = [(x, y)]
+            # Further coordinate pairs are implicit LineTo
+            cmd = 'l' if relative else 'L'
+        elif cmd in 'Ll':
+            nx, ny = number(), number()
+            x, y = (x + nx, y + ny) if relative else (nx, ny)
+            current.append((x, y))
+        elif cmd in 'Hh':
+            nx = number()
+            x = x + nx if relative else nx
+            current.append((x, y))
+        elif cmd in 'Vv':
+            ny = number()
+            y = y + ny if relative else ny
+            current.append((x, y))
+
+    if current:
+        subpaths.append(current)
+    return subpaths
+
+
+# ---------------------------------------------------------------------------
+# Polygon helpers
+# ---------------------------------------------------------------------------
+
+def signed_area(poly: List[Point]) -> float:
+    area = 0.0
+    for i in range(len(poly)):
+        x0, y0 = poly[i]
+        x1, y1 = poly[(i + 1) % len(poly)]
+        area += x0 * y1 - x1 * y0
+    return area * 0.5
+
+
+def cross(a: Point, b: Point, c: Point) -> float:
+    return (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0])
+
+
+def clean_contour(poly: List[Point]) -> List[Point]:
+    """Drop repeated points (including an explicit closing point) and collinear vertices."""
+    out: List[Point] = []
+    for p in poly:
+        if not out or p != out[-1]:
+            out.append(p)
+    if len(out) > 1 and out[0] == out[-1]:
+        out.pop()
+
+    changed = True
+    while changed and len(out) >= 3:
+        changed = False
+        for i in range(len(out)):
+            if abs(cross(out[i - 1], out[i], out[(i + 1) % len(out)])) <= EPSILON:
+                out.pop(i)
+                changed = True
+                break
+    return out
+
+
+def point_in_polygon(p: Point, poly: List[Point]) -> bool:
+    inside = False
+    j = len(poly) - 1
+    for i in range(len(poly)):
+        xi, yi = poly[i]
+        xj, yj = poly[j]
+        if (yi > p[1]) != (yj > p[1]):
+            x_cross = xi + (p[1] - yi) * (xj - xi) / (yj - yi)
+            if p[0] < x_cross:
+                inside = not inside
+        j = i
+    return inside
+
+
+def point_in_triangle(p: Point, a: Point, b: Point, c: Point) -> bool:
+    """Inclusive test; works for either winding."""
+    d0 = cross(a, b, p)
+    d1 = cross(b, c, p)
+    d2 = cross(c, a, p)
+    has_neg = d0 < -EPSILON or d1 < -EPSILON or d2 < -EPSILON
+    has_pos = d0 > EPSILON or d1 > EPSILON or d2 > EPSILON
+    return not (has_neg and has_pos)
+
+
+def group_contours(contours: List[List[Point]]) -> List[Tuple[List[Point], List[List[Point]]]]:
+    """
+    Pair outer contours with their holes using even-odd nesting depth: a
+    contour inside an odd number of others is a hole of its innermost container.
+    """
+    depth = []
+    parent = []
+    for i, ci in enumerate(contours):
+        containers = [j for j, cj in enumerate(contours)
+                      if j != i and abs(signed_area(cj)) > abs(signed_area(ci))
+                      and all(point_in_polygon(p, cj) for p in ci)]
+        depth.append(len(containers))
+        innermost = min(containers, key=lambda j: abs(signed_area(contours[j])), default=None)
+        parent.append(innermost)
+
+    groups: Dict[int, Tuple[List[Point], List[List[Point]]]] = {}
+    for i, c in enumerate(contours):
+        if depth[i] % 2 == 0:
+            groups[i] = (c, [])
+    for i, c in enumerate(contours):
+        if depth[i] % 2 == 1 and parent[i] in groups:
+            groups[parent[i]][1].append(c)
+    return [groups[k] for k in sorted(groups)]
+
+
+def bridge_holes(outer: List[Point], holes: List[List[Point]]) -> List[Point]:
+    """
+    Merge holes into the outer contour with zero-width bridges (Eberly,
+    "Triangulation by Ear Clipping"), producing one weakly simple polygon.
+    """
+    poly = list(outer)
+    if signed_area(poly) < 0:
+        poly.reverse()
+
+    oriented = []
+    for hole in holes:
+        h = list(hole)
+        if signed_area(h) > 0:
+            h.reverse()
+        oriented.append(h)
+
+    # Rightmost holes first so later bridges can't cross earlier ones
+    oriented.sort(key=lambda h: max(p[0] for p in h), reverse=True)
+
+    for hole in oriented:
+        mi = max(range(len(hole)), key=lambda k: hole[k][0])
+        m = hole[mi]
+
+        # Closest edge hit by the ray from M towards +x
+        best_x = math.inf
+        best_edge = -1
+        for i in range(len(poly)):
+            a = poly[i]
+            b = poly[(i + 1) % len(poly)]
+            if a[1] == b[1]:
+                continue
+            if min(a[1], b[1]) <= m[1] <= max(a[1], b[1]):
+                x = a[0] + (m[1] - a[1]) * (b[0] - a[0]) / (b[1] - a[1])
+                if m[0] <= x < best_x:
+                    best_x = x
+                    best_edge = i
+        if best_edge < 0:
+            raise ValueError("hole is not inside its outer contour")
+
+        a_idx = best_edge
+        b_idx = (best_edge + 1) % len(poly)
+        pi = a_idx if poly[a_idx][0] > poly[b_idx][0] else b_idx
+        hit = (best_x, m[1])
+
+        # A reflex vertex inside triangle (M, hit, P) would block the bridge;
+        # take the one closest in angle to the ray instead
+        if hit != poly[pi]:
+            p = poly[pi]
+            best_angle = math.inf
+            best_dist = math.inf
+            for k in range(len(poly)):
+                v = poly[k]
+                if k == pi or v == p:
+                    continue
+                if cross(poly[k - 1], v, poly[(k + 1) % len(poly)]) > 0:
+                    continue  # Convex vertex
+                if not point_in_triangle(v, m, hit, p):
+                    continue
+                angle = math.atan2(abs(v[1] - m[1]), v[0] - m[0])
+                dist = (v[0] - m[0]) ** 2 + (v[1] - m[1]) ** 2
+                if angle < best_angle or (angle == best_angle and dist < best_dist):
+                    best_angle = angle
+                    best_dist = dist
+                    pi = k
+
+        # Earlier bridges may have duplicated P; attach to the copy whose
+        # interior wedge faces M so the new bridge doesn't cross the old one
+        p = poly[pi]
+        for k in range(len(poly)):
+            if poly[k] != p:
+                continue
+            prev_pt = poly[k - 1]
+            next_pt = poly[(k + 1) % len(poly)]
+            left_of_in = cross(prev_pt, p, m) > 0
+            left_of_out = cross(p, next_pt, m) > 0
+            if cross(prev_pt, p, next_pt) >= 0:
+                inside = left_of_in and left_of_out
+            else:
+                inside = left_of_in or left_of_out
+            if inside:
+                pi = k
+                break
+
+        bridged = hole[mi:] + hole[:mi + 1]
+        poly = poly[:pi + 1] + bridged + poly[pi:]
+
+    return poly
+
+
+def ear_clip(poly: List[Point]) -> List[Tuple[Point, Point, Point]]:
+    """Triangulate a counter-clockwise (positive area) weakly simple polygon."""
+    idx = list(range(len(poly)))
+    tris: List[Tuple[Point, Point, Point]] = []
+
+    while len(idx) > 3:
+        n = len(idx)
+        clipped = False
+        for k in range(n):
+            a = poly[idx[k - 1]]
+            b = poly[idx[k]]
+            c = poly[idx[(k + 1) % n]]
+            if cross(a, b, c) <= EPSILON:
+                continue  # Reflex or degenerate corner
+
+            is_ear = True
+            for j in idx:
+                p = poly[j]
+                if p == a or p == b or p == c:
+                    continue  # Bridge duplicates share coordinates
+                if point_in_triangle(p, a, b, c):
+                    is_ear = False
+                    break
+            if is_ear:
+                tris.append((a, b, c))
+                idx.pop(k)
+                clipped = True
+                break
+
+        if not clipped:
+            # Only zero-area corners remain (e.g. collapsed bridge); drop one
+            for k in range(n):
+                if abs(cross(poly[idx[k - 1]], poly[idx[k]], poly[idx[(k + 1) % n]])) <= EPSILON:
+                    idx.pop(k)
+                    clipped = True
+                    break
+        if not clipped:
+            raise ValueError("polygon is self-intersecting")
+
+    if len(idx) == 3:
+        a, b, c = (poly[i] for i in idx)
+        if cross(a, b, c) > EPSILON:
+            tris.append((a, b, c))
+    return tris
+
+
+def triangulate(contours: List[List[Point]]) -> List[Tuple[Point, Point, Point]]:
+    cleaned = [c for c in (clean_contour(c) for c in contours)
+               if len(c) >= 3 and abs(signed_area(c)) > EPSILON]
+    tris: List[Tuple[Point, Point, Point]] = []
+    for outer, holes in group_contours(cleaned):
+        tris.extend(ear_clip(bridge_holes(outer, holes)))
+    return tris
+
+
+# ---------------------------------------------------------------------------
+# Mesh building
+# ---------------------------------------------------------------------------
+
+def quantize(value: float, extent: float, name: str) -> int:
+    q = int(round(value / extent * COORD_ONE))
+    if q < INT16_MIN or q > INT16_MAX:
+        print(f"    WARNING: {name}: vertex {value} far outside the viewBox, clamped")
+        q = max(INT16_MIN, min(INT16_MAX, q))
+    return q
+
+
+def quantize_mesh(mesh: VectorMesh, width: float, height: float, name: str) -> Optional[QuantizedMesh]:
+    """Quantize to int16 and share identical vertices through an index list."""
+    vertices: List[Tuple[int, int]] = []
+    lookup: Dict[Tuple[int, int], int] = {}
+    indices: List[int] = []
+
+    for tri in mesh.triangles:
+        q = [(quantize(x, width, name), quantize(y, height, name)) for x, y in tri]
+        # Drop triangles that collapse after quantization
+        if (q[1][0] - q[0][0]) * (q[2][1] - q[0][1]) == (q[1][1] - q[0][1]) * (q[2][0] - q[0][0]):
+            continue
+        for v in q:
+            if v not in lookup:
+                lookup[v] = len(vertices)
+                vertices.append(v)
+            indices.append(lookup[v])
+
+    if not indices:
+        return None
+    if len(vertices) > 0xFFFF:
+        raise ValueError(f"{name}: mesh has more than 65535 vertices")
+    return QuantizedMesh(mesh.color, vertices, indices)
 
 
 def parse_svg_file(svg_path: Path) -> Optional[VectorShape]:
@@ -109,14 +448,15 @@ def parse_svg_file(svg_path: Path) -> Optional[VectorShape]:
         # Extract viewBox or width/height
         viewbox = root.get('viewBox')
         if viewbox:
-            _, _, width, height = map(float, viewbox.split())
+            _, _, width, height = map(float, viewbox.replace(',', ' ').split())
         else:
             width = float(root.get('width', '100'))
             height = float(root.get('height', '100'))
 
         # Find all path elements
-        paths = []
         namespace = {'svg': 'http://www.w3.org/2000/svg'}
+        meshes: List[VectorMesh] = []
+        num_paths = 0
 
         for path_elem in root.findall('.//path', namespace) + root.findall('.//svg:path', namespace) + root.findall('path'):
             fill = path_elem.get('fill')
@@ -125,33 +465,33 @@ def parse_svg_file(svg_path: Path) -> Optional[VectorShape]:
             if not fill or not d or fill.lower() == 'none':
                 continue
 
-            # Parse path data
-            vertices = parse_path_data(d)
-
-            if len(vertices) < 3:
+            try:
+                tris = triangulate(parse_path_data(d))
+            except ValueError as e:
+                print(f"    WARNING: skipping path '{path_elem.get('id', '?')}': {e}")
                 continue
-
-            # Convert to triangle (assuming each path is already a triangle)
-            if len(vertices) >= 3:
-                # Normalize coordinates to [0, 1]
-                norm_vertices = [
-                    VectorVertex(x / width, y / height) for x, y in vertices
-                ]
-
-                # Create triangle from first 3 vertices
-                triangle = VectorTriangle(
-                    norm_vertices[0],
-                    norm_vertices[1],
-                    norm_vertices[2]
-                )
-
-                # Convert color
-                rgb565 = hex_to_rgb565(fill)
-
-                paths.append(VectorPath(rgb565, [triangle]))
-
-        if not paths:
-            return None
+            if not tris:
+                continue
+            num_paths += 1
+
+            color = hex_to_rgb565(fill)
+            xs = [p[0] for t in tris for p in t]
+            ys = [p[1] for t in tris for p in t]
+            bbox = (min(xs), min(ys), max(xs), max(ys))
+
+            # Merge into the most recent mesh of the same color, as long as no
+            # mesh drawn in between overlaps this path (painter's order holds)
+            target = None
+            for mesh in reversed(meshes):
+                if mesh.color == color:
+                    target = mesh
+                    break
+                if mesh.overlaps(*bbox):
+                    break
+            if target is None:
+                target = VectorMesh(color)
+                meshes.append(target)
+            target.add_triangles(tris)
 
         # Generate name from filename (remove extension, convert to CamelCase)
         name = svg_path.stem
@@ -159,13 +499,21 @@ def parse_svg_file(svg_path: Path) -> Optional[VectorShape]:
         name_parts = re.split(r'[-_]', name)
         name = ''.join(part.capitalize() for part in name_parts)
 
-        return VectorShape(name, paths, width, height)
+        quantized = [q for q in (quantize_mesh(m, width, height, name) for m in meshes) if q]
+        if not quantized:
+            return None
+
+        return VectorShape(name, quantized, width, height, num_paths)
 
     except Exception as e:
         print(f"Error parsing {svg_path}: {e}")
         return None
 
 
+# ---------------------------------------------------------------------------
+# Code generation
+# ---------------------------------------------------------------------------
+
 def generate_cpp_header(shapes: List[VectorShape]) -> str:
     """Generate the vector_assets.h header file."""
     lines = [
@@ -177,28 +525,46 @@ def generate_cpp_header(shapes: List[VectorShape]) -> str:
         "// Auto-generated by scripts/process_svgs.py",
         "// DO NOT EDIT MANUALLY",
         "",
+        "// Quantized coordinate equal to 1.0 (the asset's full width or height)",
+        f"constexpr int32_t VECTOR_COORD_ONE = {COORD_ONE};",
+        "",
         "struct VectorVertex {",
-        "    float x; // 0.0 to 1.0",
-        "    float y; // 0.0 to 1.0",
+        "    int16_t x; // 0 to VECTOR_COORD_ONE",
+        "    int16_t y; // 0 to VECTOR_COORD_ONE",
         "};",
         "",
-        "struct VectorTriangle {",
-        "    VectorVertex v1;",
-        "    VectorVertex v2;",
-        "    VectorVertex v3;",
+        "struct VectorBounds {",
+        "    int16_t min_x;",
+        "    int16_t min_y;",
+        "    int16_t max_x;",
+        "    int16_t max_y;",
         "};",
         "",
-        "struct VectorPath {",
+        "// All triangles of one color, drawn in one pass",
+        "struct VectorMesh {",
         "    uint16_t color;      // RGB565",
-        "    size_t num_tris;",
-        "    const VectorTriangle* tris;",
+        "    uint16_t num_vertices;",
+        "    uint16_t num_indices; // 3 per triangle",
+        "    const VectorVertex* vertices;",
+        "    const uint16_t* indices;",
+        "    VectorBounds bounds;",
         "};",
         "",
         "struct VectorShape {",
-        "    size_t num_paths;",
-        "    const VectorPath* paths;",
+        "    size_t num_meshes;",
+        "    const VectorMesh* meshes;",
         "    float original_width;",
         "    float original_height;",
+        "    VectorBounds bounds;",
+        "};",
+        "",
+        "// Compile-time facts about a shape (sizing, memory budgeting)",
+        "struct VectorShapeInfo {",
+        "    float original_width;",
+        "    float original_height;",
+        "    size_t num_meshes;",
+        "    size_t num_vertices;",
+        "    size_t num_triangles;",
         "};",
         "",
         "namespace VectorAssets {",
@@ -207,9 +573,12 @@ def generate_cpp_header(shapes: List[VectorShape]) -> str:
 
     for shape in shapes:
         lines.append(f"    extern const VectorShape {shape.name};")
+        lines.append(f"    constexpr VectorShapeInfo {shape.name}Info = {{ "
+                     f"{shape.original_width:.1f}f, {shape.original_height:.1f}f, "
+                     f"{len(shape.meshes)}, {shape.num_vertices}, {shape.num_triangles} }};")
+        lines.append("")
 
     lines.extend([
-        "",
         "} // namespace VectorAssets",
         ""
     ])
@@ -217,6 +586,10 @@ def generate_cpp_header(shapes: List[VectorShape]) -> str:
     return '\n'.join(lines)
 
 
+def format_bounds(bounds: Tuple[int, int, int, int]) -> str:
+    return f"{{ {bounds[0]}, {bounds[1]}, {bounds[2]}, {bounds[3]} }}"
+
+
 def generate_cpp_source(shapes: List[VectorShape]) -> str:
     """Generate the vector_assets.cpp source file."""
     lines = [
@@ -230,37 +603,45 @@ def generate_cpp_source(shapes: List[VectorShape]) -> str:
     ]
 
     for shape in shapes:
-        # Generate triangle data for each path
-        for path_idx, path in enumerate(shape.paths):
-            tri_array_name = f"{shape.name}_path{path_idx}_tris"
-            lines.append(f"    static const VectorTriangle {tri_array_name}[] = {{")
+        lines.append(f"    // {shape.name}: {shape.num_paths} paths -> {len(shape.meshes)} meshes, "
+                     f"{shape.num_triangles} triangles, {shape.num_vertices} vertices")
+        lines.append("")
 
-            for tri in path.triangles:
-                lines.append(f"        {{ {{{tri.v1.x:.6f}f, {tri.v1.y:.6f}f}}, "
-                           f"{{{tri.v2.x:.6f}f, {tri.v2.y:.6f}f}}, "
-                           f"{{{tri.v3.x:.6f}f, {tri.v3.y:.6f}f}} }},")
+        for mesh_idx, mesh in enumerate(shape.meshes):
+            prefix = f"{shape.name}_mesh{mesh_idx}"
+            lines.append(f"    static constexpr VectorVertex {prefix}_vertices[] = {{")
+            for k in range(0, len(mesh.vertices), 4):
+                chunk = mesh.vertices[k:k + 4]
+                lines.append("        " + " ".join(f"{{{x}, {y}}}," for x, y in chunk))
+            lines.append("    };")
+            lines.append("")
 
+            lines.append(f"    static constexpr uint16_t {prefix}_indices[] = {{")
+            for k in range(0, len(mesh.indices), 12):
+                chunk = mesh.indices[k:k + 12]
+                lines.append("        " + " ".join(f"{i}," for i in chunk))
             lines.append("    };")
             lines.append("")
 
-        # Generate path array
-        paths_array_name = f"{shape.name}_paths"
-        lines.append(f"    static const VectorPath {paths_array_name}[] = {{")
+        # Generate mesh array
+        meshes_array_name = f"{shape.name}_meshes"
+        lines.append(f"    static constexpr VectorMesh {meshes_array_name}[] = {{")
 
-        for path_idx, path in enumerate(shape.paths):
-            tri_array_name = f"{shape.name}_path{path_idx}_tris"
-            lines.append(f"        {{ 0x{path.color:04X}, "
-                       f"{len(path.triangles)}, {tri_array_name} }},")
+        for mesh_idx, mesh in enumerate(shape.meshes):
+            prefix = f"{shape.name}_mesh{mesh_idx}"
+            lines.append(f"        {{ 0x{mesh.color:04X}, {len(mesh.vertices)}, {len(mesh.indices)}, "
+                         f"{prefix}_vertices, {prefix}_indices, {format_bounds(mesh.bounds)} }},")
 
         lines.append("    };")
         lines.append("")
 
         # Generate shape definition
         lines.append(f"    const VectorShape {shape.name} = {{")
-        lines.append(f"        {len(shape.paths)},")
-        lines.append(f"        {paths_array_name},")
+        lines.append(f"        {len(shape.meshes)},")
+        lines.append(f"        {meshes_array_name},")
         lines.append(f"        {shape.original_width:.1f}f,")
-        lines.append(f"        {shape.original_height:.1f}f")
+        lines.append(f"        {shape.original_height:.1f}f,")
+        lines.append(f"        {format_bounds(shape.bounds)}")
         lines.append("    };")
         lines.append("")
 
@@ -300,7 +681,8 @@ def main():
         shape = parse_svg_file(svg_path)
         if shape:
             shapes.append(shape)
-            print(f"    -> {shape.name} ({len(shape.paths)} paths)")
+            print(f"    -> {shape.name} ({shape.num_paths} paths, {len(shape.meshes)} meshes, "
+                  f"{shape.num_triangles} triangles)")
 
     if not shapes:
         print("No valid shapes found!")
@@ -2,29 +2,66 @@
  * @file animation_ticker.cpp
  * @brief Implementation of AnimationTicker class
  *
- * See features/app_animation_ticker.md for complete specification.
+ * See features/sys_animation_ticker.md for complete specification.
  */
 
 #include "animation_ticker.h"
+#include "job_scheduler.h"
 #include "../hal/timer.h"
 
-#ifndef UNIT_TEST
-#include <Arduino.h>
-#else
-// Forward declarations for mocked Arduino functions in unit tests
-extern "C" void delay(unsigned long ms);
-extern "C" void delayMicroseconds(unsigned int us);
-#endif
-
 AnimationTicker::AnimationTicker(uint32_t target_fps)
-    : first_call(true), next_frame_time(0), last_frame_micros(0) {
+    : first_call(true), next_frame_time(0), last_frame_micros(0), job_scheduler(nullptr),
+      current_fps(target_fps), stats(), idle_requested(false),
+      max_idle_micros(DEFAULT_MAX_IDLE_MICROS), idle_deadline_micros(0) {
+    // Widen the default limits rather than override an explicit rate
+    min_fps = target_fps < DEFAULT_MIN_FPS ? target_fps : DEFAULT_MIN_FPS;
+    max_fps = target_fps > DEFAULT_MAX_FPS ? target_fps : DEFAULT_MAX_FPS;
+    if (min_fps == 0) min_fps = 1;
+    if (current_fps == 0) current_fps = min_fps;
+
     // Calculate the time for a single frame in microseconds
-    frame_time_micros = 1000000ULL / target_fps;
+    frame_time_micros = 1000000ULL / current_fps;
 
     // Initialize the hardware timer
     hal_timer_init();
 }
 
+void AnimationTicker::setFpsLimits(uint32_t min_fps_limit, uint32_t max_fps_limit) {
+    min_fps = min_fps_limit > 0 ? min_fps_limit : 1;
+    max_fps = max_fps_limit > min_fps ? max_fps_limit : min_fps;
+    setTargetFps(current_fps);
+}
+
+void AnimationTicker::setTargetFps(uint32_t fps) {
+    if (fps < min_fps) fps = min_fps;
+    if (fps > max_fps) fps = max_fps;
+    if (fps == current_fps) return;
+
+    uint64_t new_frame_time = 1000000ULL / fps;
+    if (!first_call) {
+        // Keep the current frame's start; only its length changes
+        uint64_t frame_start = next_frame_time - frame_time_micros;
+        next_frame_time = frame_start + new_frame_time;
+    }
+    current_fps = fps;
+    frame_time_micros = new_frame_time;
+}
+
+uint32_t AnimationTicker::getMeanJitterMicros() const {
+    return stats.frames > 0 ? static_cast<uint32_t>(stats.total_jitter_micros / stats.frames) : 0;
+}
+
+void AnimationTicker::resetStats() {
+    stats = FrameStats();
+}
+
+void AnimationTicker::recordJitter(uint64_t jitter_micros) {
+    uint32_t jitter = jitter_micros > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(jitter_micros);
+    stats.frames++;
+    stats.total_jitter_micros += jitter;
+    if (jitter > stats.max_jitter_micros) stats.max_jitter_micros = jitter;
+}
+
 float AnimationTicker::waitForNextFrame() {
     // On the first call, initialize timing state and return 0.0f
     if (first_call) {
@@ -41,8 +78,32 @@ float AnimationTicker::waitForNextFrame() {
     // Calculate deltaTime (time elapsed since last frame) in seconds
     float deltaTime = (current_time - last_frame_micros) / 1000000.0f;
 
+    // Idle: nothing on screen changes, so wait for something to happen
+    // rather than for the next frame. Deferred jobs still get frames.
+    if (idle_requested && (job_scheduler == nullptr || job_scheduler->getPendingCount() == 0)) {
+        uint64_t deadline = current_time + max_idle_micros;
+        if (idle_deadline_micros != 0 && idle_deadline_micros < deadline) {
+            deadline = idle_deadline_micros;
+        }
+        bool woken = hal_timer_wait_for_wake(deadline);
+        uint64_t wake_time = hal_timer_get_micros();
+
+        stats.idle_waits++;
+        if (woken) stats.idle_wakes++;
+        stats.idle_micros += wake_time - current_time;
+
+        // Restart the schedule at the wake-up; the idle time is not
+        // handed to animations as one huge delta
+        next_frame_time = wake_time + frame_time_micros;
+        last_frame_micros = wake_time;
+        return deltaTime;
+    }
+
     // Check if we're behind schedule (death spiral guard)
     if (current_time >= next_frame_time) {
+        stats.late_frames++;
+        recordJitter(current_time - next_frame_time);
+
         // We've missed the frame deadline - reset schedule based on current time
         // instead of trying to catch up on all missed frames
         next_frame_time = current_time + frame_time_micros;
@@ -50,19 +111,21 @@ float AnimationTicker::waitForNextFrame() {
         return deltaTime;
     }
 
-    // We're ahead of schedule - wait for the remaining time in microseconds
-    uint64_t time_to_wait = next_frame_time - current_time;
-
-    // Use delayMicroseconds for microsecond precision
-    // For very long waits, break into chunks to avoid overflow
-    while (time_to_wait > 16383) {
-        delayMicroseconds(16383);
-        time_to_wait -= 16383;
-    }
-    if (time_to_wait > 0) {
-        delayMicroseconds(time_to_wait);
+    // We're ahead of schedule - spend the slack on deferred jobs first,
+    // stopping short of the deadline, then sleep out what is left
+    if (job_scheduler != nullptr && job_scheduler->getPendingCount() > 0 &&
+        next_frame_time - current_time > SLACK_GUARD_MICROS) {
+        job_scheduler->runUntil(next_frame_time - SLACK_GUARD_MICROS);
     }
 
+    // Sleep to an absolute deadline (vTaskDelayUntil-style): other tasks run
+    // meanwhile, and the schedule doesn't drift by this frame's work
+    hal_timer_sleep_until(next_frame_time);
+
+    uint64_t wake_time = hal_timer_get_micros();
+    recordJitter(wake_time > next_frame_time ? wake_time - next_frame_time
+                                             : next_frame_time - wake_time);
+
     // Advance to the next frame time
     next_frame_time += frame_time_micros;
     last_frame_micros = current_time;
@@ -4,9 +4,10 @@
  *
  * Provides a high-level animation timing service to ensure smooth, consistent
  * animation frame rates across all hardware platforms. Uses the Timer HAL to
- * create a reliable 30 frames-per-second (fps) tick.
+ * create a reliable tick (30 frames-per-second by default) and to sleep
+ * between frames; the rate can change at run time.
  *
- * See features/app_animation_ticker.md for complete specification.
+ * See features/sys_animation_ticker.md for complete specification.
  */
 
 #ifndef ANIMATION_TICKER_H
@@ -14,6 +15,8 @@
 
 #include <stdint.h>
 
+class JobScheduler;
+
 /**
  * @brief Animation frame rate management service
  *
@@ -33,8 +36,9 @@ public:
     /**
      * @brief Waits for the next frame time to synchronize animation loops
      *
-     * Call this method at the end of each animation frame. It will delay
-     * execution as needed to maintain the target frame rate. If a frame
+     * Call this method at the end of each animation frame. It sleeps until
+     * the next frame is due (hal_timer_sleep_until(), which yields to other
+     * tasks), so the loop keeps the target frame rate. If a frame
      * takes longer than the frame time, it implements a "catch-up guard"
      * to prevent animation freezing.
      *
@@ -42,11 +46,97 @@ public:
      */
     float waitForNextFrame();
 
+    /**
+     * @brief Runs deferred jobs in the frame slack instead of sleeping
+     *
+     * When a frame finishes early, waitForNextFrame() gives the scheduler
+     * the time up to SLACK_GUARD_MICROS before the next frame, then
+     * sleeps whatever is left. Pass nullptr to detach.
+     */
+    void setScheduler(JobScheduler* scheduler) { job_scheduler = scheduler; }
+
+    /** @brief Time left before the next frame that jobs may not use */
+    static constexpr uint32_t SLACK_GUARD_MICROS = 1000;
+
+    /**
+     * @brief Changes the frame rate from the next frame on
+     *
+     * The frame in progress is rescheduled to end one new frame time after
+     * it started (at once, if that has passed). The rate is clamped to the
+     * limits; 0 ("nothing moves") paces at the minimum rate, which bounds
+     * how often input is polled.
+     */
+    void setTargetFps(uint32_t fps);
+
+    /** @brief Sets the range setTargetFps() clamps to (defaults 10-60 fps) */
+    void setFpsLimits(uint32_t min_fps, uint32_t max_fps);
+
+    /** @brief Frame rate currently paced to, after clamping */
+    uint32_t getTargetFps() const { return current_fps; }
+
+    /**
+     * @brief Enters or leaves idle mode
+     *
+     * While idle, waitForNextFrame() stops pacing frames and blocks in
+     * hal_timer_wait_for_wake() until touch input or a data update
+     * wakes it, or max_idle_micros passes. Jobs waiting in the scheduler
+     * keep frames coming. Idle time is not animation time: the frame after
+     * a wake-up reports the time since the wake-up as its deltaTime.
+     */
+    void setIdle(bool idle) { idle_requested = idle; }
+    bool isIdle() const { return idle_requested; }
+
+    /** @brief Longest idle wait before a frame runs anyway */
+    void setMaxIdleMicros(uint64_t micros) { max_idle_micros = micros; }
+
+    /**
+     * @brief Ends idle waits by this hal_timer_get_micros() time at the latest
+     *
+     * For wake-ups that components have asked for (see
+     * UIRenderManager::getNextWakeMicros()). 0 means none.
+     */
+    void setIdleDeadline(uint64_t micros) { idle_deadline_micros = micros; }
+
+    static constexpr uint64_t DEFAULT_MAX_IDLE_MICROS = 1000000;
+
+    /**
+     * @brief Frame pacing statistics
+     *
+     * Jitter is how far a frame started from its scheduled time: the wake-up
+     * error after sleeping, or the overrun when a frame was late.
+     */
+    struct FrameStats {
+        uint32_t frames;              ///< Frames paced (excluding the first call)
+        uint32_t late_frames;         ///< Frames whose work overran the schedule
+        uint32_t max_jitter_micros;   ///< Largest jitter seen
+        uint64_t total_jitter_micros; ///< Sum of jitter, for the mean
+        uint32_t idle_waits;          ///< Idle waits (not counted as frames)
+        uint32_t idle_wakes;          ///< Idle waits ended by hal_timer_wake()
+        uint64_t idle_micros;         ///< Time spent idle
+    };
+
+    const FrameStats& getStats() const { return stats; }
+    uint32_t getMeanJitterMicros() const;
+    void resetStats();
+
+    static constexpr uint32_t DEFAULT_MIN_FPS = 10;
+    static constexpr uint32_t DEFAULT_MAX_FPS = 60;
+
 private:
     uint64_t frame_time_micros;  ///< Time for a single frame in microseconds
     uint64_t next_frame_time;    ///< Timestamp when next frame should occur
     uint64_t last_frame_micros;  ///< Timestamp of last frame for deltaTime calculation
     bool first_call;             ///< Flag to track first call to waitForNextFrame
+    JobScheduler* job_scheduler; ///< Runs in the frame slack, or nullptr
+    uint32_t current_fps;        ///< Current rate, after clamping
+    uint32_t min_fps;            ///< Lower clamp (and the rate for 0)
+    uint32_t max_fps;            ///< Upper clamp
+    FrameStats stats;            ///< Pacing statistics
+    bool idle_requested;         ///< Block until woken instead of pacing
+    uint64_t max_idle_micros;    ///< Upper bound on one idle wait
+    uint64_t idle_deadline_micros; ///< Absolute end of idle waits, or 0
+
+    void recordJitter(uint64_t jitter_micros);
 };
 
 #endif // ANIMATION_TICKER_H
@@ -13,14 +13,21 @@
 #include "../data/stock_tracker.h"
 #include "../theme_manager.h"
 #include "../relative_display.h"
+#include "../job_scheduler.h"
+#include "../../hal/timer.h"
 
 StockTickerApp::StockTickerApp()
     : m_display(nullptr)
     , m_graph(nullptr)
     , m_stockTracker(nullptr)
+    , m_scheduler(nullptr)
+    , m_redrawJob(JobScheduler::INVALID_JOB)
+    , m_redrawReady(false)
     , m_backgroundDrawn(false)
     , m_graphInitialRenderDone(false)
     , m_lastDataTimestamp(0)
+    , m_pulseRemaining(0.0f)
+    , m_layerMode(false)
 {
 }
 
@@ -78,6 +85,9 @@ void StockTickerApp::onRun() {
 }
 
 void StockTickerApp::onUnpause() {
+    // In layer mode the manager recomposes the cached layer
+    if (m_layerMode) return;
+
     // Graph was obscured — force full redraw
     m_backgroundDrawn = false;
     m_lastDataTimestamp = 0;
@@ -85,17 +95,39 @@ void StockTickerApp::onUnpause() {
 }
 
 void StockTickerApp::onClose() {
+    if (m_scheduler != nullptr && m_redrawJob != JobScheduler::INVALID_JOB) {
+        m_scheduler->cancel(m_redrawJob);
+        m_redrawJob = JobScheduler::INVALID_JOB;
+    }
     if (m_stockTracker != nullptr) {
         m_stockTracker->stop();
         delete m_stockTracker;
         m_stockTracker = nullptr;
     }
     if (m_graph != nullptr) {
+        m_layer.release();  // Borrowed the graph's composite buffer
         delete m_graph;
         m_graph = nullptr;
     }
 }
 
+uint32_t StockTickerApp::getTargetFps() const {
+    // Redraw slices advance once per frame, and the live indicator pulses
+    // for a while after each update. Otherwise nothing moves: new data
+    // wakes the loop (DataItem::touch()).
+    if (m_redrawReady || m_pulseRemaining > 0.0f ||
+        (m_graph != nullptr && m_graph->isRedrawPending())) {
+        return FPS_DEFAULT;
+    }
+    return FPS_STATIC;
+}
+
+uint32_t StockTickerApp::getUpdateFps() const {
+    // update() only steps the live indicator pulse; redraw slices and new
+    // data are handled in render()
+    return m_pulseRemaining > 0.0f ? FPS_DEFAULT : FPS_STATIC;
+}
+
 void StockTickerApp::render() {
     if (m_graph == nullptr || m_stockTracker == nullptr) return;
 
@@ -108,25 +140,93 @@ void StockTickerApp::render() {
 
     if (currentTimestamp != m_lastDataTimestamp) {
         m_graph->setData(graphData);
+        m_lastDataTimestamp = currentTimestamp;
 
-        if (!m_backgroundDrawn) {
-            m_graph->drawBackground();
-            m_backgroundDrawn = true;
+        // Redrawn a slice per frame into back surfaces; the previous graph
+        // stays on screen until the new one is swapped in
+        bool sliced = m_graph->requestRedraw(!m_backgroundDrawn, true);
+        m_backgroundDrawn = true;
+        if (!sliced) {
+            showGraph();
+            return;
         }
+        scheduleRedraw();
+    }
 
-        m_graph->drawData();
-        m_lastDataTimestamp = currentTimestamp;
+    if (m_graph->isRedrawPending()) {
+        bool scheduled = m_scheduler != nullptr && m_scheduler->isQueued(m_redrawJob);
+        if (m_graph->stepRedraw(scheduled ? REDRAW_MIN_BUDGET_US : REDRAW_BUDGET_US)) {
+            showGraph();
+        }
+    } else if (m_redrawReady) {
+        // Finished by the scheduler between frames
+        showGraph();
+    } else if (!m_layerMode && m_graphInitialRenderDone && isExposed()) {
+        // An overlay that covered part of the graph is gone: present the
+        // already composited graph again, without redrawing it
+        presentGraph();
+    }
+}
+
+void StockTickerApp::scheduleRedraw() {
+    if (m_scheduler == nullptr || m_scheduler->isQueued(m_redrawJob)) return;
+
+    m_redrawJob = m_scheduler->submit(redrawJobStep, this, JobScheduler::Priority::NORMAL,
+                                      hal_timer_get_micros() + REDRAW_DEADLINE_US);
+    if (m_redrawJob == JobScheduler::INVALID_JOB) {
+        Serial.println("[StockTickerApp] WARN: job queue full, redrawing in render() only");
+    }
+}
+
+bool StockTickerApp::redrawJobStep(void* context, uint32_t budget_us) {
+    StockTickerApp* app = static_cast<StockTickerApp*>(context);
+    if (app->m_graph == nullptr || !app->m_graph->isRedrawPending()) return true;
+
+    // Presenting waits for render(): the display belongs to the frame
+    if (app->m_graph->stepRedraw(budget_us)) {
+        app->m_redrawReady = true;
+        return true;
+    }
+    return false;
+}
+
+void StockTickerApp::showGraph() {
+    hal_surface_t composite;
+    if (m_layerMode && m_graph->composite(&composite)) {
+        // Layer mode: the manager composes and presents the buffer
+        m_layer.attach(composite, 0, 0);
+        m_layer.invalidate();
+    } else {
+        presentGraph();
+    }
+    m_graphInitialRenderDone = true;
+    m_redrawReady = false;
+    m_pulseRemaining = LIVE_PULSE_SECONDS;
+}
+
+void StockTickerApp::presentGraph() {
+    // Composite graph layers to GFX buffer (NO flush — manager handles that).
+    // Under a partly covering opaque overlay, only the visible part is sent.
+    hal_surface_t composite;
+    if (isRenderClipped() && m_graph->composite(&composite)) {
+        hal_rect_t clip = getRenderClip();
+        if (clip.x + clip.w > composite.width) clip.w = composite.width - clip.x;
+        if (clip.y + clip.h > composite.height) clip.h = composite.height - clip.y;
+        if (clip.w <= 0 || clip.h <= 0) return;
 
-        // Composite graph layers to GFX buffer (NO flush — manager handles that)
+        hal_surface_t visible = { composite.pixels + clip.y * composite.stride + clip.x,
+                                  clip.w, clip.h, composite.stride, composite.format };
+        hal_display_blit_surface(static_cast<int16_t>(clip.x), static_cast<int16_t>(clip.y), &visible);
+    } else {
         m_graph->render();
-        m_graphInitialRenderDone = true;
     }
 }
 
 void StockTickerApp::update(float dt) {
-    // Live indicator dirty-rect animation
-    if (m_graph != nullptr && m_graphInitialRenderDone) {
+    // Live indicator dirty-rect animation, for a while after each update
+    if (m_graph != nullptr && m_graphInitialRenderDone && m_pulseRemaining > 0.0f) {
         m_graph->update(dt);
+        m_pulseRemaining -= dt;
     }
 }
 
@@ -10,10 +10,12 @@
 #define STOCK_TICKER_APP_H
 
 #include "../ui/ui_component.h"
+#include "../ui/ui_layer.h"
 
 class RelativeDisplay;
 class TimeSeriesGraph;
 class StockTracker;
+class JobScheduler;
 struct GraphTheme;
 
 class StockTickerApp : public AppComponent {
@@ -23,6 +25,19 @@ public:
 
     bool begin(RelativeDisplay* display);
 
+    /**
+     * Render into a UILayer composed by the UIRenderManager instead of
+     * blitting to the display. The graph's composite buffer is the layer,
+     * so it costs no extra memory. Call before registration.
+     */
+    void enableLayer() { m_layerMode = true; }
+
+    /**
+     * Run graph redraws as a job in the frame slack, in addition to a small
+     * slice per render() so they finish even when frames have no slack.
+     */
+    void setJobScheduler(JobScheduler* scheduler) { m_scheduler = scheduler; }
+
     // UIComponent lifecycle
     void onRun() override;
     void onPause() override {}
@@ -34,15 +49,41 @@ public:
 
     bool isOpaque() const override { return true; }
     bool isFullscreen() const override { return true; }
+    UILayer* getLayer() override { return m_layerMode ? &m_layer : nullptr; }
+    uint32_t getTargetFps() const override;
+    uint32_t getUpdateFps() const override;
 
 private:
+    // Graph redraw time per frame (of ~33 ms at 30 fps)
+    static constexpr uint32_t REDRAW_BUDGET_US = 8000;
+    // With a scheduler, render() only guarantees progress; the rest runs in slack
+    static constexpr uint32_t REDRAW_MIN_BUDGET_US = 1000;
+    // A redraw is expected on screen within this time (scheduler deadline)
+    static constexpr uint32_t REDRAW_DEADLINE_US = 250000;
+    // The live indicator pulses this long after new data, then the app is
+    // static and the loop can idle until the next update wakes it
+    static constexpr float LIVE_PULSE_SECONDS = 10.0f;
+
+    static bool redrawJobStep(void* context, uint32_t budget_us);
+
+    void scheduleRedraw();
+    void showGraph();
+    void presentGraph();
+
     RelativeDisplay* m_display;
     TimeSeriesGraph* m_graph;
     StockTracker* m_stockTracker;
+    JobScheduler* m_scheduler;
+    int32_t m_redrawJob;
+    bool m_redrawReady;     ///< Finished by the scheduler, not yet shown
 
     bool m_backgroundDrawn;
     bool m_graphInitialRenderDone;
     long m_lastDataTimestamp;
+    float m_pulseRemaining;    ///< Seconds of live-indicator animation left
+
+    bool m_layerMode;
+    UILayer m_layer;
 
     GraphTheme createStockGraphTheme();
 };
@@ -53,9 +53,11 @@ public:
      * @brief Updates the timestamp to the current system time
      *
      * This method should be called whenever the data item's content is modified.
+     * It also wakes the UI task if it is idle, so the change gets drawn.
      */
     void touch() {
         m_lastUpdated = hal_timer_get_micros();
+        hal_timer_wake();
     }
 
 protected:
@@ -0,0 +1,161 @@
+/**
+ * @file display_list.cpp
+ * @brief DisplayList implementation
+ *
+ * See features/display_relative_drawing.md (Display Lists).
+ */
+
+#include "display_list.h"
+#include <string.h>
+
+void DisplayList::clear() {
+    m_commands.clear();
+    m_strings.clear();
+    m_pixels.clear();
+}
+
+size_t DisplayList::getMemoryUsage() const {
+    return m_commands.size() * sizeof(Command) + m_strings.size() +
+           m_pixels.size() * sizeof(uint16_t);
+}
+
+hal_rect_t DisplayList::getBounds() const {
+    hal_rect_t bounds = { 0, 0, 0, 0 };
+    bool first = true;
+    for (const Command& c : m_commands) {
+        if (c.w <= 0 || c.h <= 0) continue;
+        if (first) {
+            bounds = { c.x, c.y, c.w, c.h };
+            first = false;
+            continue;
+        }
+        int32_t x1 = bounds.x + bounds.w;
+        int32_t y1 = bounds.y + bounds.h;
+        if (c.x < bounds.x) bounds.x = c.x;
+        if (c.y < bounds.y) bounds.y = c.y;
+        if (c.x + c.w > x1) x1 = c.x + c.w;
+        if (c.y + c.h > y1) y1 = c.y + c.h;
+        bounds.w = x1 - bounds.x;
+        bounds.h = y1 - bounds.y;
+    }
+    return bounds;
+}
+
+void DisplayList::add(Op op, int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+    Command c;
+    c.op = op;
+    c.text_size = 0;
+    c.color = color;
+    c.x = static_cast<int16_t>(x);
+    c.y = static_cast<int16_t>(y);
+    c.w = static_cast<int16_t>(w);
+    c.h = static_cast<int16_t>(h);
+    c.cursor_x = 0;
+    c.cursor_y = 0;
+    c.data = 0;
+    m_commands.push_back(c);
+}
+
+void DisplayList::addPixel(int32_t x, int32_t y, uint16_t color) {
+    add(Op::PIXEL, x, y, 1, 1, color);
+}
+
+void DisplayList::addHLine(int32_t x, int32_t y, int32_t w, uint16_t color) {
+    if (w <= 0) return;
+    add(Op::HLINE, x, y, w, 1, color);
+}
+
+void DisplayList::addVLine(int32_t x, int32_t y, int32_t h, uint16_t color) {
+    if (h <= 0) return;
+    add(Op::VLINE, x, y, 1, h, color);
+}
+
+void DisplayList::addFillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+    if (w <= 0 || h <= 0) return;
+    add(Op::FILL_RECT, x, y, w, h, color);
+}
+
+void DisplayList::addText(int32_t cursor_x, int32_t cursor_y, const char* text, uint16_t color,
+                          uint8_t text_size, const hal_rect_t& bounds) {
+    if (text == nullptr || text[0] == '\0') return;
+
+    add(Op::TEXT, bounds.x, bounds.y, bounds.w, bounds.h, color);
+    Command& c = m_commands.back();
+    c.text_size = text_size;
+    c.cursor_x = static_cast<int16_t>(cursor_x);
+    c.cursor_y = static_cast<int16_t>(cursor_y);
+    c.data = static_cast<uint32_t>(m_strings.size());
+    m_strings.insert(m_strings.end(), text, text + strlen(text) + 1);
+}
+
+void DisplayList::addBitmap(int32_t x, int32_t y, const uint16_t* pixels, int32_t w, int32_t h,
+                            uint16_t key_color) {
+    if (pixels == nullptr || w <= 0 || h <= 0) return;
+
+    add(Op::BITMAP, x, y, w, h, key_color);
+    m_commands.back().data = static_cast<uint32_t>(m_pixels.size());
+    m_pixels.insert(m_pixels.end(), pixels, pixels + static_cast<size_t>(w) * h);
+}
+
+void DisplayList::replay(Arduino_GFX* gfx, int32_t dx, int32_t dy, const hal_rect_t* clip) const {
+    replayRange(gfx, 0, m_commands.size(), dx, dy, clip);
+}
+
+void DisplayList::replayRange(Arduino_GFX* gfx, size_t first, size_t count, int32_t dx, int32_t dy,
+                              const hal_rect_t* clip) const {
+    if (gfx == nullptr || first >= m_commands.size()) return;
+    size_t last = m_commands.size() - first < count ? m_commands.size() : first + count;
+
+    for (size_t i = first; i < last; i++) {
+        const Command& c = m_commands[i];
+        // Translated box, then clipped
+        int32_t x0 = c.x + dx;
+        int32_t y0 = c.y + dy;
+        int32_t x1 = x0 + c.w;
+        int32_t y1 = y0 + c.h;
+        if (clip != nullptr) {
+            if (x0 < clip->x) x0 = clip->x;
+            if (y0 < clip->y) y0 = clip->y;
+            if (x1 > clip->x + clip->w) x1 = clip->x + clip->w;
+            if (y1 > clip->y + clip->h) y1 = clip->y + clip->h;
+            // Text with unknown (empty) bounds can't be tested; draw it
+            bool unmeasured = c.op == Op::TEXT && (c.w <= 0 || c.h <= 0);
+            if ((x1 <= x0 || y1 <= y0) && !unmeasured) continue;
+        }
+
+        switch (c.op) {
+            case Op::PIXEL:
+                gfx->drawPixel(x0, y0, c.color);
+                break;
+            case Op::HLINE:
+                gfx->drawFastHLine(x0, y0, x1 - x0, c.color);
+                break;
+            case Op::VLINE:
+                gfx->drawFastVLine(x0, y0, y1 - y0, c.color);
+                break;
+            case Op::FILL_RECT:
+                gfx->fillRect(x0, y0, x1 - x0, y1 - y0, c.color);
+                break;
+            case Op::TEXT:
+                gfx->setFont(nullptr);
+                gfx->setTextSize(c.text_size);
+                gfx->setTextColor(c.color);
+                gfx->setCursor(c.cursor_x + dx, c.cursor_y + dy);
+                gfx->print(&m_strings[c.data]);
+                break;
+            case Op::BITMAP: {
+                const uint16_t* src = &m_pixels[c.data];
+                for (int32_t y = y0; y < y1; y++) {
+                    const uint16_t* row = src + (y - c.y - dy) * c.w;
+                    for (int32_t x = x0; x < x1; x++) {
+                        uint16_t pixel = row[x - c.x - dx];
+                        if (pixel != c.color) {
+                            gfx->drawPixel(x, y, pixel);
+                        }
+                    }
+                }
+                break;
+            }
+        }
+    }
+}
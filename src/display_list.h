@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Arduino_GFX_Library.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "../hal/display_damage.h"
+
+/**
+ * DisplayList - Retained list of drawing commands in pixel coordinates.
+ *
+ * A RelativeDisplay in recording mode (beginRecording()) appends its draw
+ * calls here instead of drawing them. Percent-to-pixel conversion and text
+ * measurement happen once, at record time. replay() then re-issues the
+ * commands on any Arduino_GFX target, translated and clipped. Redrawing
+ * static content such as graph axes, ticks and labels costs a walk over a
+ * compact array instead of the code that produced it.
+ *
+ * Rectangles, lines and bitmaps are clipped exactly. Text cannot be clipped
+ * per glyph through Arduino_GFX: text outside the clip is skipped, and text
+ * that touches the clip is drawn whole.
+ *
+ * See features/display_relative_drawing.md (Display Lists).
+ */
+class DisplayList {
+public:
+    enum class Op : uint8_t {
+        PIXEL,
+        HLINE,
+        VLINE,
+        FILL_RECT,
+        TEXT,     ///< Built-in font, box = measured text bounds
+        BITMAP    ///< RGB565 pixels, key color transparent
+    };
+
+    /** One recorded call; 20 bytes. */
+    struct Command {
+        Op op;
+        uint8_t text_size;   ///< TEXT: built-in font scale
+        uint16_t color;      ///< Draw color, or BITMAP key color
+        int16_t x, y, w, h;  ///< Affected box (PIXEL: 1x1)
+        int16_t cursor_x;    ///< TEXT: cursor position
+        int16_t cursor_y;
+        uint32_t data;       ///< TEXT: offset into the string pool; BITMAP: into the pixel pool
+    };
+
+    DisplayList() = default;
+
+    /** Drop all commands and pooled data (capacity is kept). */
+    void clear();
+
+    bool isEmpty() const { return m_commands.empty(); }
+    size_t getCommandCount() const { return m_commands.size(); }
+
+    /** Bytes held by commands, strings and bitmap pixels. */
+    size_t getMemoryUsage() const;
+
+    const Command& getCommand(size_t index) const { return m_commands[index]; }
+
+    /** Bounding box of everything recorded (empty when the list is empty). */
+    hal_rect_t getBounds() const;
+
+    // Recording (normally called by RelativeDisplay)
+    void addPixel(int32_t x, int32_t y, uint16_t color);
+    void addHLine(int32_t x, int32_t y, int32_t w, uint16_t color);
+    void addVLine(int32_t x, int32_t y, int32_t h, uint16_t color);
+    void addFillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+
+    /**
+     * @param cursor_x Text cursor (as for Arduino_GFX::setCursor)
+     * @param cursor_y
+     * @param text Copied into the list
+     * @param color Text color
+     * @param text_size Built-in font scale
+     * @param bounds Measured screen bounds of the text
+     */
+    void addText(int32_t cursor_x, int32_t cursor_y, const char* text, uint16_t color,
+                 uint8_t text_size, const hal_rect_t& bounds);
+
+    /** Copies w*h row-major pixels; pixels equal to key_color are skipped on replay. */
+    void addBitmap(int32_t x, int32_t y, const uint16_t* pixels, int32_t w, int32_t h,
+                   uint16_t key_color);
+
+    /**
+     * Draw every command on a target.
+     *
+     * @param gfx Target surface
+     * @param dx Offset added to every recorded X coordinate
+     * @param dy Offset added to every recorded Y coordinate
+     * @param clip Target-space clip rectangle, or nullptr for none
+     */
+    void replay(Arduino_GFX* gfx, int32_t dx = 0, int32_t dy = 0,
+                const hal_rect_t* clip = nullptr) const;
+
+    /**
+     * Draw count commands starting at first (clamped to the list), e.g. a
+     * slice per frame. Replaying consecutive ranges equals one replay().
+     */
+    void replayRange(Arduino_GFX* gfx, size_t first, size_t count, int32_t dx = 0, int32_t dy = 0,
+                     const hal_rect_t* clip = nullptr) const;
+
+private:
+    std::vector<Command> m_commands;
+    std::vector<char> m_strings;
+    std::vector<uint16_t> m_pixels;
+
+    void add(Op op, int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+};
@@ -5,64 +5,107 @@
 
 namespace VectorAssets {
 
-    static const VectorTriangle Lpadlogo_path0_tris[] = {
-        { {0.020408f, 0.135135f}, {0.387755f, 0.013514f}, {0.387755f, 0.256757f} },
+    // Lpadlogo: 10 paths -> 10 meshes, 10 triangles, 30 vertices
+
+    static constexpr VectorVertex Lpadlogo_mesh0_vertices[] = {
+        {334, 2214}, {6353, 221}, {6353, 4207},
+    };
+
+    static constexpr uint16_t Lpadlogo_mesh0_indices[] = {
+        0, 1, 2,
+    };
+
+    static constexpr VectorVertex Lpadlogo_mesh1_vertices[] = {
+        {334, 2214}, {6353, 4207}, {334, 6199},
+    };
+
+    static constexpr uint16_t Lpadlogo_mesh1_indices[] = {
+        0, 1, 2,
+    };
+
+    static constexpr VectorVertex Lpadlogo_mesh2_vertices[] = {
+        {334, 6199}, {6353, 4207}, {6353, 8192},
+    };
+
+    static constexpr uint16_t Lpadlogo_mesh2_indices[] = {
+        0, 1, 2,
+    };
+
+    static constexpr VectorVertex Lpadlogo_mesh3_vertices[] = {
+        {334, 6199}, {6353, 8192}, {334, 10185},
+    };
+
+    static constexpr uint16_t Lpadlogo_mesh3_indices[] = {
+        0, 1, 2,
+    };
+
+    static constexpr VectorVertex Lpadlogo_mesh4_vertices[] = {
+        {334, 10185}, {6353, 8192}, {6353, 12177},
+    };
+
+    static constexpr uint16_t Lpadlogo_mesh4_indices[] = {
+        0, 1, 2,
+    };
+
+    static constexpr VectorVertex Lpadlogo_mesh5_vertices[] = {
+        {334, 10185}, {6353, 12177}, {334, 14170},
     };
 
-    static const VectorTriangle Lpadlogo_path1_tris[] = {
-        { {0.020408f, 0.135135f}, {0.387755f, 0.256757f}, {0.020408f, 0.378378f} },
+    static constexpr uint16_t Lpadlogo_mesh5_indices[] = {
+        0, 1, 2,
     };
 
-    static const VectorTriangle Lpadlogo_path2_tris[] = {
-        { {0.020408f, 0.378378f}, {0.387755f, 0.256757f}, {0.387755f, 0.500000f} },
+    static constexpr VectorVertex Lpadlogo_mesh6_vertices[] = {
+        {334, 14170}, {6353, 12177}, {6353, 16163},
     };
 
-    static const VectorTriangle Lpadlogo_path3_tris[] = {
-        { {0.020408f, 0.378378f}, {0.387755f, 0.500000f}, {0.020408f, 0.621622f} },
+    static constexpr uint16_t Lpadlogo_mesh6_indices[] = {
+        0, 1, 2,
     };
 
-    static const VectorTriangle Lpadlogo_path4_tris[] = {
-        { {0.020408f, 0.621622f}, {0.387755f, 0.500000f}, {0.387755f, 0.743243f} },
+    static constexpr VectorVertex Lpadlogo_mesh7_vertices[] = {
+        {6353, 12177}, {10967, 14170}, {6353, 16163},
     };
 
-    static const VectorTriangle Lpadlogo_path5_tris[] = {
-        { {0.020408f, 0.621622f}, {0.387755f, 0.743243f}, {0.020408f, 0.864865f} },
+    static constexpr uint16_t Lpadlogo_mesh7_indices[] = {
+        0, 1, 2,
     };
 
-    static const VectorTriangle Lpadlogo_path6_tris[] = {
-        { {0.020408f, 0.864865f}, {0.387755f, 0.743243f}, {0.387755f, 0.986486f} },
+    static constexpr VectorVertex Lpadlogo_mesh8_vertices[] = {
+        {10967, 10052}, {10967, 14170}, {6353, 12177},
     };
 
-    static const VectorTriangle Lpadlogo_path7_tris[] = {
-        { {0.387755f, 0.986486f}, {0.669388f, 0.864865f}, {0.387755f, 0.743243f} },
+    static constexpr uint16_t Lpadlogo_mesh8_indices[] = {
+        0, 1, 2,
     };
 
-    static const VectorTriangle Lpadlogo_path8_tris[] = {
-        { {0.387755f, 0.743243f}, {0.669388f, 0.864865f}, {0.669388f, 0.613514f} },
+    static constexpr VectorVertex Lpadlogo_mesh9_vertices[] = {
+        {16050, 11690}, {10967, 14170}, {10967, 10052},
     };
 
-    static const VectorTriangle Lpadlogo_path9_tris[] = {
-        { {0.669388f, 0.613514f}, {0.669388f, 0.864865f}, {0.979592f, 0.713514f} },
+    static constexpr uint16_t Lpadlogo_mesh9_indices[] = {
+        0, 1, 2,
     };
 
-    static const VectorPath Lpadlogo_paths[] = {
-        { 0x6B2A, 1, Lpadlogo_path0_tris },
-        { 0x7B8C, 1, Lpadlogo_path1_tris },
-        { 0x8C0D, 1, Lpadlogo_path2_tris },
-        { 0x946F, 1, Lpadlogo_path3_tris },
-        { 0xA4F0, 1, Lpadlogo_path4_tris },
-        { 0xB551, 1, Lpadlogo_path5_tris },
-        { 0xC5D3, 1, Lpadlogo_path6_tris },
-        { 0xB572, 1, Lpadlogo_path7_tris },
-        { 0xCE14, 1, Lpadlogo_path8_tris },
-        { 0xAC2B, 1, Lpadlogo_path9_tris },
+    static constexpr VectorMesh Lpadlogo_meshes[] = {
+        { 0x6B2A, 3, 3, Lpadlogo_mesh0_vertices, Lpadlogo_mesh0_indices, { 334, 221, 6353, 4207 } },
+        { 0x7B8C, 3, 3, Lpadlogo_mesh1_vertices, Lpadlogo_mesh1_indices, { 334, 2214, 6353, 6199 } },
+        { 0x8C0D, 3, 3, Lpadlogo_mesh2_vertices, Lpadlogo_mesh2_indices, { 334, 4207, 6353, 8192 } },
+        { 0x946F, 3, 3, Lpadlogo_mesh3_vertices, Lpadlogo_mesh3_indices, { 334, 6199, 6353, 10185 } },
+        { 0xA4F0, 3, 3, Lpadlogo_mesh4_vertices, Lpadlogo_mesh4_indices, { 334, 8192, 6353, 12177 } },
+        { 0xB551, 3, 3, Lpadlogo_mesh5_vertices, Lpadlogo_mesh5_indices, { 334, 10185, 6353, 14170 } },
+        { 0xC5D3, 3, 3, Lpadlogo_mesh6_vertices, Lpadlogo_mesh6_indices, { 334, 12177, 6353, 16163 } },
+        { 0xB572, 3, 3, Lpadlogo_mesh7_vertices, Lpadlogo_mesh7_indices, { 6353, 12177, 10967, 16163 } },
+        { 0xCE14, 3, 3, Lpadlogo_mesh8_vertices, Lpadlogo_mesh8_indices, { 6353, 10052, 10967, 14170 } },
+        { 0xAC2B, 3, 3, Lpadlogo_mesh9_vertices, Lpadlogo_mesh9_indices, { 10967, 10052, 16050, 14170 } },
     };
 
     const VectorShape Lpadlogo = {
         10,
-        Lpadlogo_paths,
+        Lpadlogo_meshes,
         245.0f,
-        370.0f
+        370.0f,
+        { 334, 221, 16050, 16163 }
     };
 
 } // namespace VectorAssets
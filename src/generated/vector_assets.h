@@ -6,32 +6,51 @@
 // Auto-generated by scripts/process_svgs.py
 // DO NOT EDIT MANUALLY
 
+// Quantized coordinate equal to 1.0 (the asset's full width or height)
+constexpr int32_t VECTOR_COORD_ONE = 16384;
+
 struct VectorVertex {
-    float x; // 0.0 to 1.0
-    float y; // 0.0 to 1.0
+    int16_t x; // 0 to VECTOR_COORD_ONE
+    int16_t y; // 0 to VECTOR_COORD_ONE
 };
 
-struct VectorTriangle {
-    VectorVertex v1;
-    VectorVertex v2;
-    VectorVertex v3;
+struct VectorBounds {
+    int16_t min_x;
+    int16_t min_y;
+    int16_t max_x;
+    int16_t max_y;
 };
 
-struct VectorPath {
+// All triangles of one color, drawn in one pass
+struct VectorMesh {
     uint16_t color;      // RGB565
-    size_t num_tris;
-    const VectorTriangle* tris;
+    uint16_t num_vertices;
+    uint16_t num_indices; // 3 per triangle
+    const VectorVertex* vertices;
+    const uint16_t* indices;
+    VectorBounds bounds;
 };
 
 struct VectorShape {
-    size_t num_paths;
-    const VectorPath* paths;
+    size_t num_meshes;
+    const VectorMesh* meshes;
+    float original_width;
+    float original_height;
+    VectorBounds bounds;
+};
+
+// Compile-time facts about a shape (sizing, memory budgeting)
+struct VectorShapeInfo {
     float original_width;
     float original_height;
+    size_t num_meshes;
+    size_t num_vertices;
+    size_t num_triangles;
 };
 
 namespace VectorAssets {
 
     extern const VectorShape Lpadlogo;
+    constexpr VectorShapeInfo LpadlogoInfo = { 245.0f, 370.0f, 10, 30, 10 };
 
 } // namespace VectorAssets
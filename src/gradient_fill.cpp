@@ -0,0 +1,128 @@
+/**
+ * @file gradient_fill.cpp
+ * @brief Linear gradient fills
+ */
+
+#include "gradient_fill.h"
+#include "parallel_rows.h"
+#include "../hal/display_format.h"
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+uint16_t gradient_interpolate_565(uint16_t color1, uint16_t color2, float t) {
+    uint8_t r1 = (color1 >> 11) & 0x1F;
+    uint8_t g1 = (color1 >> 5) & 0x3F;
+    uint8_t b1 = color1 & 0x1F;
+
+    uint8_t r2 = (color2 >> 11) & 0x1F;
+    uint8_t g2 = (color2 >> 5) & 0x3F;
+    uint8_t b2 = color2 & 0x1F;
+
+    uint8_t r = static_cast<uint8_t>(r1 + t * (r2 - r1));
+    uint8_t g = static_cast<uint8_t>(g1 + t * (g2 - g1));
+    uint8_t b = static_cast<uint8_t>(b1 + t * (b2 - b1));
+
+    return ((r & 0x1F) << 11) | ((g & 0x3F) << 5) | (b & 0x1F);
+}
+
+namespace {
+
+// Per-fill constants, shared read-only by all bands
+struct GradientJob {
+    const LinearGradient* gradient;
+    hal_surface_t target;
+    int32_t x;
+    int32_t w;
+    bool vertical;
+    bool horizontal;
+    float dx;
+    float dy;
+    float length;
+};
+
+void setupJob(GradientJob& job, const LinearGradient& gradient, int32_t width, int32_t height) {
+    float angle_rad = gradient.angle_deg * M_PI / 180.0f;
+    job.gradient = &gradient;
+    job.vertical = fabsf(gradient.angle_deg - 90.0f) < 5.0f;
+    job.horizontal = fabsf(gradient.angle_deg - 0.0f) < 5.0f;
+    job.dx = cosf(angle_rad);
+    job.dy = sinf(angle_rad);
+    job.length = sqrtf(static_cast<float>(width * width + height * height));
+}
+
+uint16_t colorAt(const GradientJob& job, int32_t px, int32_t py, int32_t width, int32_t height) {
+    const LinearGradient& gradient = *job.gradient;
+
+    // Position along the gradient, 0.0 - 1.0
+    float t;
+    if (job.vertical) {
+        t = static_cast<float>(py) / static_cast<float>(height);
+    } else if (job.horizontal) {
+        t = static_cast<float>(px) / static_cast<float>(width);
+    } else {
+        // Diagonal: project the pixel onto the gradient direction
+        t = (px * job.dx + py * job.dy) / job.length;
+    }
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+
+    if (gradient.num_stops == 2) {
+        return gradient_interpolate_565(gradient.color_stops[0], gradient.color_stops[1], t);
+    }
+    // 3-color gradient
+    if (t < 0.5f) {
+        return gradient_interpolate_565(gradient.color_stops[0], gradient.color_stops[1], t * 2.0f);
+    }
+    return gradient_interpolate_565(gradient.color_stops[1], gradient.color_stops[2], (t - 0.5f) * 2.0f);
+}
+
+void fillRows(void* context, int32_t y0, int32_t y1) {
+    const GradientJob& job = *static_cast<const GradientJob*>(context);
+    const hal_surface_t& s = job.target;
+    for (int32_t py = y0; py < y1; py++) {
+        uint16_t* row = s.pixels + py * s.stride;
+        if (job.vertical) {
+            // One color per row
+            uint16_t color = hal_color_to_format(colorAt(job, job.x, py, s.width, s.height), s.format);
+            for (int32_t px = job.x; px < job.x + job.w; px++) row[px] = color;
+            continue;
+        }
+        for (int32_t px = job.x; px < job.x + job.w; px++) {
+            row[px] = hal_color_to_format(colorAt(job, px, py, s.width, s.height), s.format);
+        }
+    }
+}
+
+}  // namespace
+
+uint16_t gradient_color_at(const LinearGradient& gradient, int32_t px, int32_t py,
+                           int32_t width, int32_t height) {
+    GradientJob job;
+    setupJob(job, gradient, width, height);
+    return colorAt(job, px, py, width, height);
+}
+
+void gradient_fill_linear(const hal_surface_t& target, int32_t x, int32_t y, int32_t w, int32_t h,
+                          const LinearGradient& gradient, bool parallel) {
+    if (target.pixels == nullptr) return;
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > target.width) w = target.width - x;
+    if (y + h > target.height) h = target.height - y;
+    if (w <= 0 || h <= 0) return;
+
+    GradientJob job;
+    setupJob(job, gradient, target.width, target.height);
+    job.target = target;
+    job.x = x;
+    job.w = w;
+
+    if (parallel) {
+        ParallelRows::getInstance().run(y, y + h, fillRows, &job);
+    } else {
+        fillRows(&job, y, y + h);
+    }
+}
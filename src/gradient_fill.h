@@ -0,0 +1,37 @@
+/**
+ * @file gradient_fill.h
+ * @brief Linear gradient fills straight into a pixel surface
+ *
+ * Rows are independent, so large fills are split across cores with
+ * ParallelRows (features/sys_parallel_rows.md).
+ */
+
+#ifndef GRADIENT_FILL_H
+#define GRADIENT_FILL_H
+
+#include <stdint.h>
+#include "gradients.h"
+#include "../hal/display.h"
+
+/** Interpolate between two RGB565 colors per channel; t in [0, 1]. */
+uint16_t gradient_interpolate_565(uint16_t color1, uint16_t color2, float t);
+
+/**
+ * Color of a 2- or 3-stop linear gradient at a pixel.
+ * Angles within 5 degrees of 0 or 90 run exactly across the width or down
+ * the height; other angles are normalized by the diagonal.
+ * @param width, height Size of the area the gradient spans
+ */
+uint16_t gradient_color_at(const LinearGradient& gradient, int32_t px, int32_t py,
+                           int32_t width, int32_t height);
+
+/**
+ * Fill a rectangle of the target with the gradient spanning the whole
+ * target, in the target's pixel format. The rectangle is clipped to the
+ * target.
+ * @param parallel Split the rows across cores (ParallelRows)
+ */
+void gradient_fill_linear(const hal_surface_t& target, int32_t x, int32_t y, int32_t w, int32_t h,
+                          const LinearGradient& gradient, bool parallel = true);
+
+#endif // GRADIENT_FILL_H
@@ -0,0 +1,27 @@
+#include "indexed_canvas.h"
+
+IndexedCanvas::IndexedCanvas(IndexedSurface* surface)
+    : Arduino_GFX(surface ? surface->getWidth() : 0, surface ? surface->getHeight() : 0)
+    , m_surface(surface)
+{
+}
+
+bool IndexedCanvas::begin(int32_t speed) {
+    (void)speed;  // Nothing to initialize; the surface owns the memory
+    return m_surface != nullptr && m_surface->isValid();
+}
+
+void IndexedCanvas::writePixelPreclipped(int16_t x, int16_t y, uint16_t color) {
+    m_surface->setPixel(x, y, m_surface->mapColor(color));
+}
+
+void IndexedCanvas::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    m_surface->fillSpan(x, y, w, m_surface->mapColor(color));
+}
+
+void IndexedCanvas::writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    uint8_t index = m_surface->mapColor(color);
+    for (int16_t row = 0; row < h; row++) {
+        m_surface->fillSpan(x, y + row, w, index);
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Arduino_GFX_Library.h>
+#include "indexed_surface.h"
+
+/**
+ * IndexedCanvas - Arduino_GFX drawing target backed by an IndexedSurface.
+ *
+ * Lets existing GFX/RelativeDisplay drawing code render into a palette-indexed
+ * layer: every RGB565 color is mapped through IndexedSurface::mapColor().
+ * The canvas never outputs anything itself; the owner composites the surface.
+ */
+class IndexedCanvas : public Arduino_GFX {
+public:
+    explicit IndexedCanvas(IndexedSurface* surface);
+
+    bool begin(int32_t speed = GFX_NOT_DEFINED) override;
+    void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
+    void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+
+    IndexedSurface* getSurface() const { return m_surface; }
+
+private:
+    IndexedSurface* m_surface;
+};
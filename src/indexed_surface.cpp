@@ -0,0 +1,260 @@
+#include "indexed_surface.h"
+#include "../hal/display_format.h"
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif
+
+IndexedSurface::IndexedSurface()
+    : m_pixels(nullptr)
+    , m_width(0)
+    , m_height(0)
+    , m_stride(0)
+    , m_bpp(8)
+    , m_transparent(false)
+    , m_paletteUsed(0)
+    , m_lastColor(0)
+    , m_lastIndex(0)
+    , m_lastValid(false)
+{
+    memset(m_palette, 0, sizeof(m_palette));
+    memset(m_paletteSwapped, 0, sizeof(m_paletteSwapped));
+}
+
+IndexedSurface::~IndexedSurface() {
+    release();
+}
+
+bool IndexedSurface::init(int16_t width, int16_t height, uint8_t bits_per_pixel,
+                          int32_t transparent_color) {
+    release();
+    if (width <= 0 || height <= 0) return false;
+    if (bits_per_pixel != 1 && bits_per_pixel != 2 &&
+        bits_per_pixel != 4 && bits_per_pixel != 8) {
+        return false;
+    }
+
+    int32_t stride = (static_cast<int32_t>(width) * bits_per_pixel + 7) / 8;
+    size_t size = static_cast<size_t>(stride) * height;
+    m_pixels = static_cast<uint8_t*>(
+#ifdef BOARD_HAS_PSRAM
+        ps_malloc(size)
+#else
+        malloc(size)
+#endif
+    );
+    if (m_pixels == nullptr) return false;
+
+    m_width = width;
+    m_height = height;
+    m_stride = stride;
+    m_bpp = bits_per_pixel;
+    m_transparent = transparent_color != NO_TRANSPARENCY;
+
+    memset(m_palette, 0, sizeof(m_palette));
+    memset(m_paletteSwapped, 0, sizeof(m_paletteSwapped));
+    if (m_transparent) {
+        m_palette[TRANSPARENT_INDEX] = static_cast<uint16_t>(transparent_color);
+        m_paletteSwapped[TRANSPARENT_INDEX] = hal_pixel_swap16(m_palette[TRANSPARENT_INDEX]);
+    }
+    resetPalette();
+    memset(m_pixels, 0, size);
+    return true;
+}
+
+void IndexedSurface::release() {
+    free(m_pixels);
+    m_pixels = nullptr;
+    m_width = 0;
+    m_height = 0;
+    m_stride = 0;
+    m_paletteUsed = 0;
+    m_lastValid = false;
+}
+
+void IndexedSurface::swap(IndexedSurface& other) {
+    if (&other == this) return;
+    std::swap(m_pixels, other.m_pixels);
+    std::swap(m_width, other.m_width);
+    std::swap(m_height, other.m_height);
+    std::swap(m_stride, other.m_stride);
+    std::swap(m_bpp, other.m_bpp);
+    std::swap(m_transparent, other.m_transparent);
+    std::swap(m_palette, other.m_palette);
+    std::swap(m_paletteSwapped, other.m_paletteSwapped);
+    std::swap(m_paletteUsed, other.m_paletteUsed);
+    std::swap(m_lastColor, other.m_lastColor);
+    std::swap(m_lastIndex, other.m_lastIndex);
+    std::swap(m_lastValid, other.m_lastValid);
+}
+
+void IndexedSurface::resetPalette() {
+    m_paletteUsed = m_transparent ? 1 : 0;
+    m_lastValid = false;
+}
+
+uint8_t IndexedSurface::mapColor(uint16_t color) {
+    if (m_lastValid && m_lastColor == color) return m_lastIndex;
+
+    uint8_t index = 0;
+    bool found = false;
+    for (uint16_t i = 0; i < m_paletteUsed; i++) {
+        if (m_palette[i] == color) {
+            index = static_cast<uint8_t>(i);
+            found = true;
+            break;
+        }
+    }
+
+    if (!found && m_paletteUsed < getPaletteSize()) {
+        index = static_cast<uint8_t>(m_paletteUsed);
+        m_palette[m_paletteUsed] = color;
+        m_paletteSwapped[m_paletteUsed++] = hal_pixel_swap16(color);
+        found = true;
+    }
+
+    if (!found) {
+        // Palette full: nearest opaque entry (components scaled to 6 bits)
+        int32_t r = (color >> 11) << 1, g = (color >> 5) & 0x3F, b = (color & 0x1F) << 1;
+        int32_t best = INT32_MAX;
+        for (uint16_t i = m_transparent ? 1 : 0; i < m_paletteUsed; i++) {
+            uint16_t c = m_palette[i];
+            int32_t dr = r - ((c >> 11) << 1);
+            int32_t dg = g - ((c >> 5) & 0x3F);
+            int32_t db = b - ((c & 0x1F) << 1);
+            int32_t d = dr * dr + dg * dg + db * db;
+            if (d < best) {
+                best = d;
+                index = static_cast<uint8_t>(i);
+            }
+        }
+    }
+
+    m_lastColor = color;
+    m_lastIndex = index;
+    m_lastValid = true;
+    return index;
+}
+
+void IndexedSurface::fill(uint8_t index) {
+    if (m_pixels == nullptr) return;
+
+    uint8_t mask = static_cast<uint8_t>((1u << m_bpp) - 1);
+    uint8_t pattern = 0;
+    for (int shift = 0; shift < 8; shift += m_bpp) {
+        pattern |= static_cast<uint8_t>((index & mask) << shift);
+    }
+    memset(m_pixels, pattern, getDataSize());
+}
+
+void IndexedSurface::setPixel(int32_t x, int32_t y, uint8_t index) {
+    if (m_pixels == nullptr || x < 0 || y < 0 || x >= m_width || y >= m_height) return;
+
+    if (m_bpp == 8) {
+        m_pixels[y * m_stride + x] = index;
+        return;
+    }
+    int32_t bit = x * m_bpp;
+    uint8_t* byte = &m_pixels[y * m_stride + (bit >> 3)];
+    int shift = 8 - m_bpp - (bit & 7);
+    uint8_t mask = static_cast<uint8_t>(((1u << m_bpp) - 1) << shift);
+    *byte = static_cast<uint8_t>((*byte & ~mask) | ((index << shift) & mask));
+}
+
+uint8_t IndexedSurface::getPixel(int32_t x, int32_t y) const {
+    if (m_pixels == nullptr || x < 0 || y < 0 || x >= m_width || y >= m_height) return 0;
+
+    if (m_bpp == 8) {
+        return m_pixels[y * m_stride + x];
+    }
+    int32_t bit = x * m_bpp;
+    uint8_t byte = m_pixels[y * m_stride + (bit >> 3)];
+    int shift = 8 - m_bpp - (bit & 7);
+    return static_cast<uint8_t>((byte >> shift) & ((1u << m_bpp) - 1));
+}
+
+void IndexedSurface::fillSpan(int32_t x, int32_t y, int32_t w, uint8_t index) {
+    if (m_pixels == nullptr || y < 0 || y >= m_height) return;
+    if (x < 0) { w += x; x = 0; }
+    if (x + w > m_width) { w = m_width - x; }
+    if (w <= 0) return;
+
+    if (m_bpp == 8) {
+        memset(&m_pixels[y * m_stride + x], index, w);
+        return;
+    }
+    for (int32_t i = 0; i < w; i++) {
+        setPixel(x + i, y, index);
+    }
+}
+
+void IndexedSurface::compositeRow(int16_t row, const uint16_t* below, uint16_t* out,
+                                  hal_pixel_format_t format) const {
+    if (m_pixels == nullptr || out == nullptr || row < 0 || row >= m_height) return;
+
+    const uint8_t* src = &m_pixels[row * m_stride];
+    const uint16_t* palette = (format == HAL_PIXEL_FORMAT_RGB565_BE) ? m_paletteSwapped : m_palette;
+    const int32_t transparent = m_transparent ? TRANSPARENT_INDEX : -1;
+
+    if (m_bpp == 8) {
+        for (int32_t x = 0; x < m_width; x++) {
+            uint8_t idx = src[x];
+            if (idx != transparent) {
+                out[x] = palette[idx];
+            } else if (below != nullptr) {
+                out[x] = below[x];
+            }
+        }
+        return;
+    }
+
+    const int32_t per_byte = 8 / m_bpp;
+    const uint8_t mask = static_cast<uint8_t>((1u << m_bpp) - 1);
+    int32_t x = 0;
+    int32_t i = 0;
+    while (x < m_width) {
+        // Runs of fully transparent bytes (TRANSPARENT_INDEX is 0 in every
+        // slot) become a single copy of the layer below
+        if (m_transparent && src[i] == 0) {
+            int32_t run_start = x;
+            while (x < m_width && src[i] == 0) {
+                x += per_byte;
+                i++;
+            }
+            if (x > m_width) x = m_width;
+            if (below != nullptr && below != out) {
+                memcpy(&out[run_start], &below[run_start], (x - run_start) * sizeof(uint16_t));
+            }
+            continue;
+        }
+
+        uint8_t byte = src[i++];
+        int32_t n = (m_width - x < per_byte) ? (m_width - x) : per_byte;
+        for (int32_t k = 0; k < n; k++) {
+            uint8_t idx = static_cast<uint8_t>((byte >> (8 - m_bpp * (k + 1))) & mask);
+            if (idx != transparent) {
+                out[x + k] = palette[idx];
+            } else if (below != nullptr) {
+                out[x + k] = below[x + k];
+            }
+        }
+        x += n;
+    }
+}
+
+void IndexedSurface::compositeTo(const hal_surface_t& target, const hal_surface_t& background) const {
+    if (target.pixels == nullptr || background.pixels == nullptr) return;
+    if (target.format != background.format) return;
+    if (target.width < m_width || target.height < m_height ||
+        background.width < m_width || background.height < m_height) {
+        return;
+    }
+
+    for (int16_t row = 0; row < m_height; row++) {
+        compositeRow(row, background.pixels + row * background.stride,
+                     target.pixels + row * target.stride, target.format);
+    }
+}
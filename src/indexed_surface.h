@@ -0,0 +1,129 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../hal/display.h"
+
+/**
+ * IndexedSurface - Palette-indexed pixel buffer (1, 2, 4 or 8 bits per pixel).
+ *
+ * Intended for layers that only ever hold a handful of colors (graph data
+ * lines, text, menu overlays). Pixels are packed MSB-first, rows padded to a
+ * whole byte. The palette is built on the fly by mapColor(): new colors get
+ * the next free entry, and once the palette is full the nearest existing
+ * entry is reused.
+ *
+ * With a transparent color, index 0 is reserved for it and compositeRow()
+ * lets the layer below show through. Fully transparent bytes are skipped
+ * without unpacking, so sparse layers composite at close to memcpy speed.
+ */
+class IndexedSurface {
+public:
+    static constexpr int32_t NO_TRANSPARENCY = -1;
+    static constexpr uint8_t TRANSPARENT_INDEX = 0;
+
+    IndexedSurface();
+    ~IndexedSurface();
+
+    IndexedSurface(const IndexedSurface&) = delete;
+    IndexedSurface& operator=(const IndexedSurface&) = delete;
+
+    /**
+     * Allocate the pixel buffer (PSRAM when available) and reset the palette.
+     * All pixels start at index 0.
+     *
+     * @param width Width in pixels
+     * @param height Height in pixels
+     * @param bits_per_pixel 1, 2, 4 or 8
+     * @param transparent_color RGB565 color mapped to TRANSPARENT_INDEX, or NO_TRANSPARENCY
+     * @return true on success
+     */
+    bool init(int16_t width, int16_t height, uint8_t bits_per_pixel,
+              int32_t transparent_color = NO_TRANSPARENCY);
+
+    void release();
+
+    /**
+     * Exchange pixels, size and palette with another surface. O(1) for the
+     * pixels; used to flip a back surface to the front once it is complete.
+     */
+    void swap(IndexedSurface& other);
+
+    bool isValid() const { return m_pixels != nullptr; }
+    int16_t getWidth() const { return m_width; }
+    int16_t getHeight() const { return m_height; }
+    uint8_t getBitsPerPixel() const { return m_bpp; }
+    bool hasTransparency() const { return m_transparent; }
+
+    /** Bytes per row. */
+    int32_t getStride() const { return m_stride; }
+
+    /** Size of the pixel buffer in bytes. */
+    size_t getDataSize() const { return static_cast<size_t>(m_stride) * m_height; }
+
+    uint16_t getPaletteSize() const { return static_cast<uint16_t>(1u << m_bpp); }
+    uint16_t getPaletteColor(uint8_t index) const { return m_palette[index]; }
+
+    /** Number of palette entries in use (including the transparent entry). */
+    uint16_t getPaletteUsed() const { return m_paletteUsed; }
+
+    /** Forget every color except the transparent entry; pixels are not touched. */
+    void resetPalette();
+
+    /**
+     * Palette index for an RGB565 color, adding it if there is room.
+     * The transparent color always maps to TRANSPARENT_INDEX.
+     */
+    uint8_t mapColor(uint16_t color);
+
+    /** Fill every pixel with an index. */
+    void fill(uint8_t index);
+
+    /** Set one pixel (clipped). */
+    void setPixel(int32_t x, int32_t y, uint8_t index);
+
+    /** Read one pixel (0 outside the surface). */
+    uint8_t getPixel(int32_t x, int32_t y) const;
+
+    /** Fill a horizontal span (clipped). */
+    void fillSpan(int32_t x, int32_t y, int32_t w, uint8_t index);
+
+    /**
+     * Expand one row to RGB565.
+     *
+     * The palette is kept in both byte orders, so expanding straight into
+     * panel order costs nothing extra.
+     *
+     * @param row Row to expand
+     * @param below Row of the layer underneath (shown through transparent
+     *              pixels, already in format), or nullptr to leave out[] untouched there
+     * @param out Destination row (getWidth() pixels)
+     * @param format Pixel format of below and out
+     */
+    void compositeRow(int16_t row, const uint16_t* below, uint16_t* out,
+                      hal_pixel_format_t format = HAL_PIXEL_FORMAT_RGB565) const;
+
+    /**
+     * Composite the whole surface over a same-sized background into target
+     * (target may alias background). Both must share the same pixel format;
+     * nothing is written otherwise.
+     */
+    void compositeTo(const hal_surface_t& target, const hal_surface_t& background) const;
+
+private:
+    uint8_t* m_pixels;
+    int16_t m_width;
+    int16_t m_height;
+    int32_t m_stride;
+    uint8_t m_bpp;
+    bool m_transparent;
+
+    uint16_t m_palette[256];         // CPU order
+    uint16_t m_paletteSwapped[256];  // Same entries, big-endian
+    uint16_t m_paletteUsed;
+
+    // Last mapColor() result; line drawing maps the same color many times
+    uint16_t m_lastColor;
+    uint8_t m_lastIndex;
+    bool m_lastValid;
+};
@@ -18,6 +18,18 @@ TouchGestureEngine::TouchGestureEngine(int16_t screen_width, int16_t screen_heig
       m_last_y(0),
       m_touch_duration_ms(0),
       m_hold_event_fired(false),
+      m_has_timestamp(false),
+      m_last_timestamp_us(0),
+      m_timestamp_carry_us(0),
+      m_history(),
+      m_history_count(0),
+      m_history_next(0),
+      m_now_us(0),
+      m_reported_x(0),
+      m_reported_y(0),
+      m_prediction_us(0),
+      m_has_pending_event(false),
+      m_pending_event(),
       m_use_custom_edge_zones(false),
       m_edge_left_threshold(0),
       m_edge_right_threshold(0),
@@ -28,13 +40,24 @@ TouchGestureEngine::TouchGestureEngine(int16_t screen_width, int16_t screen_heig
 
 bool TouchGestureEngine::update(int16_t x, int16_t y, bool is_pressed,
                                   uint32_t delta_time, touch_gesture_event_t* event) {
+    m_now_us += static_cast<uint64_t>(delta_time) * 1000;
+    return process(x, y, is_pressed, delta_time, event);
+}
+
+bool TouchGestureEngine::process(int16_t x, int16_t y, bool is_pressed,
+                                 uint32_t delta_time, touch_gesture_event_t* event) {
     bool gesture_detected = false;
+    m_has_pending_event = false;
 
     // State transitions based on touch state
     if (is_pressed) {
         // Touch is currently active
         m_touch_duration_ms += delta_time;
 
+        // Velocity history starts fresh with each touch
+        if (m_state == STATE_IDLE) m_history_count = 0;
+        addSample(x, y);
+
         switch (m_state) {
             case STATE_IDLE:
                 // New touch started
@@ -45,6 +68,8 @@ bool TouchGestureEngine::update(int16_t x, int16_t y, bool is_pressed,
                 m_last_y = y;
                 m_touch_duration_ms = 0;
                 m_hold_event_fired = false;
+                m_reported_x = x;
+                m_reported_y = y;
                 break;
 
             case STATE_PRESSED: {
@@ -71,6 +96,8 @@ bool TouchGestureEngine::update(int16_t x, int16_t y, bool is_pressed,
                     if (dx > movement_threshold || dy > movement_threshold) {
                         // Significant movement detected, enter dragging state
                         m_state = STATE_DRAGGING;
+                        fillDragEvent(event, TOUCH_DRAG, x, y);
+                        gesture_detected = true;
                     }
                 }
                 m_last_x = x;
@@ -87,7 +114,7 @@ bool TouchGestureEngine::update(int16_t x, int16_t y, bool is_pressed,
                 if (dx > movement_threshold || dy > movement_threshold) {
                     // Hold + Drag detected!
                     m_state = STATE_DRAGGING;
-                    fillEventData(event, TOUCH_HOLD_DRAG, x, y);
+                    fillDragEvent(event, TOUCH_HOLD_DRAG, x, y);
                     gesture_detected = true;
                 }
                 m_last_x = x;
@@ -96,9 +123,12 @@ bool TouchGestureEngine::update(int16_t x, int16_t y, bool is_pressed,
             }
 
             case STATE_DRAGGING:
-                // Continue reporting drag events if from hold
+                // Continue reporting drag events (hold drags even when still)
                 if (m_hold_event_fired) {
-                    fillEventData(event, TOUCH_HOLD_DRAG, x, y);
+                    fillDragEvent(event, TOUCH_HOLD_DRAG, x, y);
+                    gesture_detected = true;
+                } else if (x != m_last_x || y != m_last_y) {
+                    fillDragEvent(event, TOUCH_DRAG, x, y);
                     gesture_detected = true;
                 }
                 m_last_x = x;
@@ -126,6 +156,12 @@ bool TouchGestureEngine::update(int16_t x, int16_t y, bool is_pressed,
                 }
 
                 case STATE_DRAGGING: {
+                    // Release velocity: samples from before a pause don't count
+                    float vx, vy;
+                    getVelocity(&vx, &vy);
+                    float fling_threshold = m_screen_max_dim * FLING_VELOCITY_PERCENT;
+                    bool fling = !m_hold_event_fired && (vx * vx + vy * vy) >= fling_threshold * fling_threshold;
+
                     // Check if this was a swipe or edge drag
                     int16_t dx = m_last_x - m_start_x;
                     int16_t dy = m_last_y - m_start_y;
@@ -154,6 +190,23 @@ bool TouchGestureEngine::update(int16_t x, int16_t y, bool is_pressed,
                             fillEventData(event, TOUCH_SWIPE, m_last_x, m_last_y, swipe_dir);
                             gesture_detected = true;
                         }
+                        event->velocity_x = vx;
+                        event->velocity_y = vy;
+                    }
+
+                    if (fling) {
+                        // Ends the drag where the finger really was (undoes any prediction)
+                        touch_direction_t fling_dir = (std::fabs(vx) > std::fabs(vy))
+                            ? (vx > 0 ? TOUCH_DIR_RIGHT : TOUCH_DIR_LEFT)
+                            : (vy > 0 ? TOUCH_DIR_DOWN : TOUCH_DIR_UP);
+                        touch_gesture_event_t* target = gesture_detected ? &m_pending_event : event;
+                        fillEventData(target, TOUCH_FLING, m_last_x, m_last_y, fling_dir);
+                        target->delta_x = static_cast<int16_t>(m_last_x - m_reported_x);
+                        target->delta_y = static_cast<int16_t>(m_last_y - m_reported_y);
+                        target->velocity_x = vx;
+                        target->velocity_y = vy;
+                        m_has_pending_event = gesture_detected;
+                        gesture_detected = true;
                     }
                     break;
                 }
@@ -176,6 +229,95 @@ bool TouchGestureEngine::update(int16_t x, int16_t y, bool is_pressed,
     return gesture_detected;
 }
 
+bool TouchGestureEngine::updateAt(int16_t x, int16_t y, bool is_pressed,
+                                  uint64_t timestamp_us, touch_gesture_event_t* event) {
+    uint32_t delta_ms = 0;
+    if (!m_has_timestamp) {
+        m_has_timestamp = true;
+        m_last_timestamp_us = timestamp_us;
+    } else if (timestamp_us > m_last_timestamp_us) {
+        // An older timestamp (never expected) counts as no time passing
+        uint64_t elapsed_us = (timestamp_us - m_last_timestamp_us) + m_timestamp_carry_us;
+        delta_ms = static_cast<uint32_t>(elapsed_us / 1000);
+        m_timestamp_carry_us = static_cast<uint32_t>(elapsed_us % 1000);
+        m_last_timestamp_us = timestamp_us;
+    }
+    if (timestamp_us > m_now_us) m_now_us = timestamp_us;
+    return process(x, y, is_pressed, delta_ms, event);
+}
+
+bool TouchGestureEngine::takePendingEvent(touch_gesture_event_t* event) {
+    if (!m_has_pending_event) return false;
+    *event = m_pending_event;
+    m_has_pending_event = false;
+    return true;
+}
+
+void TouchGestureEngine::addSample(int16_t x, int16_t y) {
+    m_history[m_history_next] = { x, y, m_now_us };
+    m_history_next = (m_history_next + 1) % HISTORY_SIZE;
+    if (m_history_count < HISTORY_SIZE) m_history_count++;
+}
+
+void TouchGestureEngine::getVelocity(float* velocity_x, float* velocity_y) const {
+    *velocity_x = 0.0f;
+    *velocity_y = 0.0f;
+
+    // Least-squares line through the recent samples: noise in any single
+    // report moves the slope far less than a two-point difference would
+    float sum_t = 0.0f, sum_x = 0.0f, sum_y = 0.0f;
+    int n = 0;
+    for (int i = 0; i < m_history_count; i++) {
+        const Sample& s = m_history[i];
+        if (m_now_us - s.t_us > VELOCITY_WINDOW_US) continue;
+        sum_t += -static_cast<float>(m_now_us - s.t_us) * 1e-6f;
+        sum_x += s.x;
+        sum_y += s.y;
+        n++;
+    }
+    if (n < 2) return;
+
+    float mean_t = sum_t / n, mean_x = sum_x / n, mean_y = sum_y / n;
+    float stt = 0.0f, stx = 0.0f, sty = 0.0f;
+    for (int i = 0; i < m_history_count; i++) {
+        const Sample& s = m_history[i];
+        if (m_now_us - s.t_us > VELOCITY_WINDOW_US) continue;
+        float t = -static_cast<float>(m_now_us - s.t_us) * 1e-6f - mean_t;
+        stt += t * t;
+        stx += t * (s.x - mean_x);
+        sty += t * (s.y - mean_y);
+    }
+    if (stt <= 0.0f) return;
+    *velocity_x = stx / stt;
+    *velocity_y = sty / stt;
+}
+
+void TouchGestureEngine::predict(int16_t x, int16_t y, int16_t* out_x, int16_t* out_y) const {
+    *out_x = x;
+    *out_y = y;
+    if (m_prediction_us == 0) return;
+
+    float vx, vy;
+    getVelocity(&vx, &vy);
+    float ahead = m_prediction_us * 1e-6f;
+    float px = x + vx * ahead;
+    float py = y + vy * ahead;
+    *out_x = static_cast<int16_t>(std::min(std::max(px, 0.0f), static_cast<float>(m_screen_width - 1)));
+    *out_y = static_cast<int16_t>(std::min(std::max(py, 0.0f), static_cast<float>(m_screen_height - 1)));
+}
+
+void TouchGestureEngine::fillDragEvent(touch_gesture_event_t* event, touch_gesture_type_t type,
+                                       int16_t x, int16_t y) {
+    int16_t px, py;
+    predict(x, y, &px, &py);
+    fillEventData(event, type, px, py);
+    event->delta_x = static_cast<int16_t>(px - m_reported_x);
+    event->delta_y = static_cast<int16_t>(py - m_reported_y);
+    getVelocity(&event->velocity_x, &event->velocity_y);
+    m_reported_x = px;
+    m_reported_y = py;
+}
+
 int16_t TouchGestureEngine::getMovementThreshold() const {
     return static_cast<int16_t>(m_screen_max_dim * MOVEMENT_THRESHOLD_PERCENT);
 }
@@ -302,6 +444,12 @@ void TouchGestureEngine::fillEventData(touch_gesture_event_t* event,
     event->y_px = y;
     event->x_percent = static_cast<float>(x) / static_cast<float>(m_screen_width);
     event->y_percent = static_cast<float>(y) / static_cast<float>(m_screen_height);
+    event->start_x_px = m_start_x;
+    event->start_y_px = m_start_y;
+    event->delta_x = 0;
+    event->delta_y = 0;
+    event->velocity_x = 0.0f;
+    event->velocity_y = 0.0f;
 
     // Clamp percentages to 0.0-1.0
     if (event->x_percent < 0.0f) event->x_percent = 0.0f;
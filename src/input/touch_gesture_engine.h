@@ -8,8 +8,11 @@
  * - HOLD_DRAG: Hold followed by movement
  * - SWIPE: Fast movement from center region
  * - EDGE_DRAG: Movement starting from screen edge
+ * - DRAG: Continuous finger movement, reported as it happens
+ * - FLING: Release while moving fast, with the release velocity
  *
- * Provides coordinates in both absolute pixels and relative percentages.
+ * Provides coordinates in both absolute pixels and relative percentages,
+ * plus a filtered velocity from a short timestamped sample history.
  *
  * Specification: features/touch_gesture_engine.md
  */
@@ -28,7 +31,9 @@ typedef enum {
     TOUCH_HOLD,             ///< Press and hold (> 1s, minimal movement)
     TOUCH_HOLD_DRAG,        ///< Hold followed by dragging
     TOUCH_SWIPE,            ///< Fast directional swipe from center
-    TOUCH_EDGE_DRAG         ///< Swipe starting from screen edge
+    TOUCH_EDGE_DRAG,        ///< Swipe starting from screen edge
+    TOUCH_DRAG,             ///< Finger moved during a drag (not after a hold); see delta_x/delta_y
+    TOUCH_FLING             ///< Released while moving fast; see velocity_x/velocity_y
 } touch_gesture_type_t;
 
 /**
@@ -56,6 +61,14 @@ typedef struct {
     // Relative coordinates (0.0 to 1.0)
     float x_percent;                ///< X position as percentage (0.0 = left, 1.0 = right)
     float y_percent;                ///< Y position as percentage (0.0 = top, 1.0 = bottom)
+
+    // Motion (zero where not meaningful)
+    int16_t start_x_px;             ///< Where the touch went down
+    int16_t start_y_px;
+    int16_t delta_x;                ///< Movement since the previous DRAG of this touch (DRAG, FLING)
+    int16_t delta_y;
+    float velocity_x;               ///< Filtered velocity in pixels per second (DRAG, SWIPE, FLING, ...)
+    float velocity_y;
 } touch_gesture_event_t;
 
 /**
@@ -85,6 +98,49 @@ public:
      */
     bool update(int16_t x, int16_t y, bool is_pressed, uint32_t delta_time, touch_gesture_event_t* event);
 
+    /**
+     * @brief Update the gesture engine with a timestamped touch sample
+     *
+     * Call once per sample from hal_touch_pop_sample(), in order. The time
+     * since the previous sample replaces update()'s delta_time; remainders
+     * below a millisecond carry over to the next sample.
+     *
+     * @param timestamp_us Sample time (hal_timer_get_micros() units)
+     * @return true if a new gesture event was detected, false otherwise
+     */
+    bool updateAt(int16_t x, int16_t y, bool is_pressed, uint64_t timestamp_us, touch_gesture_event_t* event);
+
+    /**
+     * @brief Take a second event produced by the last update
+     *
+     * A release can be both a SWIPE (or EDGE_DRAG) and a FLING: update()
+     * returns the former and keeps the FLING here. Call after every update.
+     *
+     * @return true if an event was taken
+     */
+    bool takePendingEvent(touch_gesture_event_t* event);
+
+    /**
+     * @brief Filtered velocity of the current touch, in pixels per second
+     *
+     * Least-squares slope of the pressed samples within VELOCITY_WINDOW_US
+     * of the latest update; zero with fewer than two such samples. After a
+     * pause the old samples age out, so a finger that stopped reads zero.
+     */
+    void getVelocity(float* velocity_x, float* velocity_y) const;
+
+    /**
+     * @brief Report DRAG and HOLD_DRAG positions this far ahead
+     *
+     * Positions are extrapolated along the filtered velocity, so a drawn
+     * drag keeps up with the finger despite input and frame latency.
+     * Deltas follow the reported positions; the FLING ending a drag
+     * corrects any overshoot.
+     *
+     * @param ahead_us Prediction horizon (0 = off, the default)
+     */
+    void setPredictionMicros(uint32_t ahead_us) { m_prediction_us = ahead_us; }
+
     /**
      * @brief Get the start position of the current/last gesture (for debugging)
      * @param start_x Output parameter for start X coordinate
@@ -137,6 +193,28 @@ private:
     uint32_t m_touch_duration_ms;         // Time since touch started
     bool m_hold_event_fired;              // Whether hold event was already fired
 
+    // Sample timing for updateAt()
+    bool m_has_timestamp;
+    uint64_t m_last_timestamp_us;
+    uint32_t m_timestamp_carry_us;        // Sub-millisecond remainder not yet counted
+
+    // Sample history for velocity (ring, oldest overwritten)
+    struct Sample {
+        int16_t x, y;
+        uint64_t t_us;
+    };
+    static constexpr int HISTORY_SIZE = 16;
+    Sample m_history[HISTORY_SIZE];
+    int m_history_count;
+    int m_history_next;
+    uint64_t m_now_us;                    // Time of the current sample
+
+    // Drag reporting
+    int16_t m_reported_x, m_reported_y;  // Last DRAG position handed out
+    uint32_t m_prediction_us;
+    bool m_has_pending_event;
+    touch_gesture_event_t m_pending_event;
+
     // Board-specific edge zone configuration (for limited touch panel ranges)
     bool m_use_custom_edge_zones;
     int16_t m_edge_left_threshold;
@@ -150,6 +228,8 @@ private:
     static constexpr float SWIPE_DISTANCE_PERCENT = 0.08f;     // 8% of axis dimension for center swipes (easy to trigger)
     static constexpr float EDGE_THRESHOLD_PERCENT = 0.30f;     // 30% from edge (balanced - not too strict, not too loose)
     static constexpr float EDGE_SWIPE_DISTANCE_PERCENT = 0.30f; // 30% of axis dimension for edge drags (3.75x center swipes)
+    static constexpr uint32_t VELOCITY_WINDOW_US = 100000;     // Samples older than 100ms don't count toward velocity
+    static constexpr float FLING_VELOCITY_PERCENT = 0.50f;     // 50% of max dimension per second to fling
 
     // Helper functions
     int16_t getMovementThreshold() const;
@@ -162,6 +242,10 @@ private:
     touch_direction_t getSwipeDirection(int16_t dx, int16_t dy) const;
     void fillEventData(touch_gesture_event_t* event, touch_gesture_type_t type,
                        int16_t x, int16_t y, touch_direction_t dir = TOUCH_DIR_NONE);
+    bool process(int16_t x, int16_t y, bool is_pressed, uint32_t delta_time, touch_gesture_event_t* event);
+    void addSample(int16_t x, int16_t y);
+    void predict(int16_t x, int16_t y, int16_t* out_x, int16_t* out_y) const;
+    void fillDragEvent(touch_gesture_event_t* event, touch_gesture_type_t type, int16_t x, int16_t y);
 };
 
 #endif // TOUCH_GESTURE_ENGINE_H
@@ -0,0 +1,84 @@
+/**
+ * @file touch_replay.cpp
+ * @brief TouchReplay implementation
+ *
+ * See features/touch_gesture_engine.md (Trace Replay).
+ */
+
+#include "touch_replay.h"
+#include "../ui/ui_render_manager.h"
+#include "../../hal/touch_trace.h"
+#include "../../hal/timer.h"
+
+TouchReplay::TouchReplay(TouchGestureEngine* engine, UIRenderManager* manager)
+    : m_engine(engine), m_manager(manager) {
+}
+
+bool TouchReplay::load(const uint8_t* data, size_t size) {
+    if (!hal_touch_trace_read_header(data, size, &m_width, &m_height)) {
+        m_data = nullptr;
+        m_size = 0;
+        return false;
+    }
+    m_data = data;
+    m_size = size;
+    return true;
+}
+
+void TouchReplay::dispatch(const touch_gesture_event_t& event) {
+    m_stats.events++;
+    m_stats.events_by_type[event.type]++;
+    if (m_manager) m_manager->routeInput(event);
+    if (m_eventFn) m_eventFn(event, m_eventContext);
+}
+
+const TouchReplay::Stats& TouchReplay::run(float speed) {
+    m_stats = Stats();
+    if (m_data == nullptr || m_engine == nullptr) return m_stats;
+
+    hal_touch_trace_state_t state = {};
+    size_t pos = HAL_TOUCH_TRACE_HEADER_SIZE;
+    uint64_t first_timestamp = 0;
+    uint64_t start = hal_timer_get_micros();
+
+    while (pos < m_size) {
+        hal_touch_sample_t sample;
+        size_t used = hal_touch_trace_decode(&state, m_data + pos, m_size - pos, &sample);
+        if (used == 0) {
+            m_stats.truncated = true;
+            break;
+        }
+        pos += used;
+
+        if (m_stats.samples == 0) first_timestamp = sample.timestamp_us;
+        m_stats.trace_micros = sample.timestamp_us - first_timestamp;
+        if (speed > 0.0f) {
+            hal_timer_sleep_until(start + static_cast<uint64_t>(m_stats.trace_micros / speed));
+        }
+
+        // Same handling as the input loop (main.cpp), except that drags
+        // aren't merged: every event is routed and timed
+        uint64_t begin = hal_timer_get_micros();
+        const hal_touch_point_t& point = sample.point;
+        touch_gesture_event_t event = {};
+        if (point.is_home_button) {
+            event.type = TOUCH_EDGE_DRAG;
+            event.direction = TOUCH_DIR_DOWN;
+            event.x_px = static_cast<int16_t>(m_width / 2);
+            event.y_px = static_cast<int16_t>(m_height - 1);
+            event.x_percent = 0.5f;
+            event.y_percent = 1.0f;
+            dispatch(event);
+        } else if (m_engine->updateAt(point.x, point.y, point.is_pressed,
+                                      sample.timestamp_us, &event)) {
+            dispatch(event);
+            if (m_engine->takePendingEvent(&event)) dispatch(event);
+        }
+        uint64_t took = hal_timer_get_micros() - begin;
+
+        m_stats.samples++;
+        m_stats.busy_micros += took;
+        if (took > m_stats.max_sample_micros) m_stats.max_sample_micros = static_cast<uint32_t>(took);
+    }
+    return m_stats;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file touch_replay.h
+ * @brief Replays recorded touch traces through the gesture engine and UI
+ *
+ * Feeds the samples of a trace recorded on the board (hal/touch_trace.h)
+ * to TouchGestureEngine::updateAt() and routes the resulting gestures to
+ * UIRenderManager::routeInput(), as the input loop and render task do.
+ * The engine sees the recorded timestamps at any replay speed, so the
+ * gestures are the same whether a trace is replayed in real time or as
+ * fast as possible; only the measured processing cost differs.
+ *
+ * Specification: features/touch_gesture_engine.md (Trace Replay)
+ */
+
+#ifndef TOUCH_REPLAY_H
+#define TOUCH_REPLAY_H
+
+#include "touch_gesture_engine.h"
+#include <stddef.h>
+#include <stdint.h>
+
+class UIRenderManager;
+
+class TouchReplay {
+public:
+    struct Stats {
+        uint32_t samples;                     ///< Samples replayed
+        uint32_t events;                      ///< Gestures produced (pending FLINGs included)
+        uint32_t events_by_type[TOUCH_FLING + 1];
+        uint64_t busy_micros;                 ///< Time in the engine and routing
+        uint32_t max_sample_micros;           ///< Slowest single sample, engine and routing
+        uint64_t trace_micros;                ///< From the first sample to the last
+        bool truncated;                       ///< Stopped at a malformed record
+    };
+
+    /** Called for every gesture, after it is routed. */
+    using EventFn = void(*)(const touch_gesture_event_t& event, void* context);
+
+    /**
+     * @param engine Classifies the samples; sized to the trace's screen
+     * @param manager Receives every gesture, or nullptr to only classify
+     */
+    explicit TouchReplay(TouchGestureEngine* engine, UIRenderManager* manager = nullptr);
+
+    /**
+     * Use a trace. The data is not copied and must outlive run().
+     * @return false if it doesn't start with a valid trace header
+     */
+    bool load(const uint8_t* data, size_t size);
+
+    uint16_t getWidth() const { return m_width; }
+    uint16_t getHeight() const { return m_height; }
+
+    void setEventCallback(EventFn fn, void* context) {
+        m_eventFn = fn;
+        m_eventContext = context;
+    }
+
+    /**
+     * Replay the loaded trace from the start.
+     * @param speed 1.0 = real time, 10.0 = ten times faster, 0 = no waiting
+     * @return Statistics for this run
+     */
+    const Stats& run(float speed = 0.0f);
+
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    TouchGestureEngine* m_engine;
+    UIRenderManager* m_manager;
+    EventFn m_eventFn = nullptr;
+    void* m_eventContext = nullptr;
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    uint16_t m_width = 0;
+    uint16_t m_height = 0;
+    Stats m_stats = {};
+
+    void dispatch(const touch_gesture_event_t& event);
+};
+
+#endif // TOUCH_REPLAY_H
@@ -0,0 +1,89 @@
+/**
+ * @file input_latency.cpp
+ * @brief Implementation of InputLatency
+ *
+ * See features/sys_render_task.md (Input Latency).
+ */
+
+#include "input_latency.h"
+#include <algorithm>
+#include <stdio.h>
+
+static uint32_t span(uint64_t from, uint64_t to) {
+    if (to <= from) return 0;
+    uint64_t micros = to - from;
+    return micros > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(micros);
+}
+
+InputLatency::InputLatency()
+    : m_samples(), m_next(0), m_count(0), m_total(0) {
+}
+
+void InputLatency::record(const Stamps& stamps) {
+    m_samples[SAMPLE_TO_POST][m_next] = span(stamps.sample, stamps.posted);
+    m_samples[POST_TO_ROUTE][m_next] = span(stamps.posted, stamps.routed);
+    m_samples[ROUTE_TO_RENDER][m_next] = span(stamps.routed, stamps.rendered);
+    m_samples[RENDER_TO_PRESENT][m_next] = span(stamps.rendered, stamps.presented);
+    m_samples[TOTAL][m_next] = span(stamps.sample, stamps.presented);
+
+    m_next = (m_next + 1) % WINDOW;
+    if (m_count < WINDOW) m_count++;
+    m_total++;
+}
+
+InputLatency::Summary InputLatency::summarize(Stage stage) const {
+    Summary summary = {};
+    if (m_count == 0 || stage >= STAGE_COUNT) return summary;
+
+    uint32_t sorted[WINDOW];
+    std::copy(m_samples[stage], m_samples[stage] + m_count, sorted);
+    std::sort(sorted, sorted + m_count);
+
+    // Nearest rank: the smallest value with at least p% of the window at or below it
+    auto rank = [&](int percent) {
+        int index = (percent * m_count + 99) / 100 - 1;
+        return sorted[index < 0 ? 0 : index];
+    };
+    summary.count = static_cast<uint32_t>(m_count);
+    summary.p50 = rank(50);
+    summary.p90 = rank(90);
+    summary.p99 = rank(99);
+    summary.max = sorted[m_count - 1];
+    return summary;
+}
+
+void InputLatency::reset() {
+    m_next = 0;
+    m_count = 0;
+    m_total = 0;
+}
+
+const char* InputLatency::getStageName(Stage stage) {
+    switch (stage) {
+        case SAMPLE_TO_POST: return "sample->post";
+        case POST_TO_ROUTE: return "post->route";
+        case ROUTE_TO_RENDER: return "route->render";
+        case RENDER_TO_PRESENT: return "render->present";
+        case TOTAL: return "total";
+        default: return "?";
+    }
+}
+
+size_t InputLatency::format(char* buffer, size_t size) const {
+    if (buffer == nullptr || size == 0) return 0;
+    buffer[0] = '\0';
+
+    size_t used = 0;
+    int n = snprintf(buffer, size, "[Latency] %d gestures (us): p50 / p90 / p99 / max\n", m_count);
+    for (int stage = 0; n >= 0 && stage < STAGE_COUNT; stage++) {
+        used += static_cast<size_t>(n);
+        if (used >= size) return size - 1;
+        Summary s = summarize(static_cast<Stage>(stage));
+        n = snprintf(buffer + used, size - used, "  %-16s %6u %6u %6u %6u\n",
+                     getStageName(static_cast<Stage>(stage)),
+                     static_cast<unsigned>(s.p50), static_cast<unsigned>(s.p90),
+                     static_cast<unsigned>(s.p99), static_cast<unsigned>(s.max));
+    }
+    if (n > 0) used += static_cast<size_t>(n);
+    return used >= size ? size - 1 : used;
+}
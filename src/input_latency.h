@@ -0,0 +1,79 @@
+/**
+ * @file input_latency.h
+ * @brief Input-to-photon latency statistics
+ *
+ * Each routed gesture carries the time of the touch sample it came from.
+ * The render task stamps it again when it is routed, when the first frame
+ * after that has finished drawing, and when the panel flush returns. This
+ * class keeps a window of those measurements and reports percentiles per
+ * stage.
+ *
+ * See features/sys_render_task.md (Input Latency).
+ */
+
+#ifndef INPUT_LATENCY_H
+#define INPUT_LATENCY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+class InputLatency {
+public:
+    enum Stage : uint8_t {
+        SAMPLE_TO_POST,     ///< Touch sample to gesture posted (sampler, queue, engine)
+        POST_TO_ROUTE,      ///< Posted to routed (command queue, frame wait)
+        ROUTE_TO_RENDER,    ///< Routed to the end of the frame's drawing
+        RENDER_TO_PRESENT,  ///< End of drawing to the panel flush returning
+        TOTAL,              ///< Touch sample to presented
+        STAGE_COUNT
+    };
+
+    /** hal_timer_get_micros() times of one gesture's trip. */
+    struct Stamps {
+        uint64_t sample;
+        uint64_t posted;
+        uint64_t routed;
+        uint64_t rendered;
+        uint64_t presented;
+    };
+
+    struct Summary {
+        uint32_t count;     ///< Measurements in the window
+        uint32_t p50;       ///< Microseconds
+        uint32_t p90;
+        uint32_t p99;
+        uint32_t max;
+    };
+
+    /** Measurements kept; older ones are overwritten. */
+    static constexpr int WINDOW = 128;
+
+    InputLatency();
+
+    /** Add one gesture's stamps. Stamps out of order count as zero. */
+    void record(const Stamps& stamps);
+
+    /** Percentiles (nearest rank) over the window. All zero when empty. */
+    Summary summarize(Stage stage) const;
+
+    /** Measurements recorded since the last reset, including overwritten ones. */
+    uint32_t getTotalCount() const { return m_total; }
+
+    void reset();
+
+    /**
+     * Write a report, one line per stage.
+     * @return Characters written, excluding the terminator
+     */
+    size_t format(char* buffer, size_t size) const;
+
+    static const char* getStageName(Stage stage);
+
+private:
+    uint32_t m_samples[STAGE_COUNT][WINDOW];
+    int m_next;
+    int m_count;
+    uint32_t m_total;
+};
+
+#endif // INPUT_LATENCY_H
@@ -0,0 +1,127 @@
+/**
+ * @file job_scheduler.cpp
+ * @brief Implementation of JobScheduler
+ *
+ * See features/sys_animation_ticker.md (Frame-Slack Job Scheduler).
+ */
+
+#include "job_scheduler.h"
+#include "../hal/timer.h"
+
+JobScheduler::JobScheduler()
+    : m_jobs(), m_count(0), m_nextId(1), m_nextSequence(0), m_stats() {
+}
+
+int32_t JobScheduler::submit(StepFn step, void* context, Priority priority,
+                             uint64_t deadline_us, uint32_t step_estimate_us) {
+    if (step == nullptr || m_count >= MAX_JOBS) return INVALID_JOB;
+
+    Job& job = m_jobs[m_count++];
+    job.id = m_nextId++;
+    if (m_nextId <= 0) m_nextId = 1;  // Ids stay positive across wrap-around
+    job.step = step;
+    job.context = context;
+    job.priority = priority;
+    job.deadline = deadline_us;
+    job.step_estimate = step_estimate_us ? step_estimate_us : DEFAULT_STEP_ESTIMATE_US;
+    job.sequence = m_nextSequence++;
+    return job.id;
+}
+
+bool JobScheduler::cancel(int32_t id) {
+    for (int i = 0; i < m_count; i++) {
+        if (m_jobs[i].id == id) {
+            removeAt(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobScheduler::isQueued(int32_t id) const {
+    for (int i = 0; i < m_count; i++) {
+        if (m_jobs[i].id == id) return true;
+    }
+    return false;
+}
+
+void JobScheduler::resetStats() {
+    m_stats = Stats();
+}
+
+int JobScheduler::pickNext() const {
+    int best = -1;
+    for (int i = 0; i < m_count; i++) {
+        if (best < 0) {
+            best = i;
+            continue;
+        }
+        const Job& a = m_jobs[i];
+        const Job& b = m_jobs[best];
+        if (a.priority != b.priority) {
+            if (a.priority < b.priority) best = i;
+            continue;
+        }
+        // Earliest deadline first; jobs without one go after those with one
+        if (a.deadline != b.deadline) {
+            if (b.deadline == 0 || (a.deadline != 0 && a.deadline < b.deadline)) best = i;
+            continue;
+        }
+        if (static_cast<int32_t>(a.sequence - b.sequence) < 0) best = i;
+    }
+    return best;
+}
+
+void JobScheduler::removeAt(int index) {
+    for (int i = index; i < m_count - 1; i++) {
+        m_jobs[i] = m_jobs[i + 1];
+    }
+    m_count--;
+}
+
+int JobScheduler::runUntil(uint64_t limit_us) {
+    int steps = 0;
+    while (m_count > 0) {
+        uint64_t now = hal_timer_get_micros();
+        int index = pickNext();
+
+        // Don't start a step that is expected to run past the limit. The
+        // best job decides: lower-priority work doesn't jump ahead of it.
+        if (now >= limit_us || limit_us - now < m_jobs[index].step_estimate) break;
+
+        uint64_t remaining = limit_us - now;
+        uint32_t budget = remaining > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(remaining);
+
+        // Copied: a step may submit or cancel jobs, moving the array
+        Job job = m_jobs[index];
+        bool done = job.step(job.context, budget);
+        uint64_t end = hal_timer_get_micros();
+        uint32_t took = static_cast<uint32_t>(end - now);
+
+        m_stats.steps++;
+        m_stats.busy_micros += end - now;
+        steps++;
+
+        // The job may have been cancelled from inside its own step
+        int current = -1;
+        for (int i = 0; i < m_count; i++) {
+            if (m_jobs[i].id == job.id) {
+                current = i;
+                break;
+            }
+        }
+        if (current < 0) continue;
+
+        if (done) {
+            m_stats.completed++;
+            if (job.deadline != 0 && end > job.deadline) m_stats.late++;
+            removeAt(current);
+        } else {
+            // Average with the last measurement; a single slow step counts for half
+            Job& entry = m_jobs[current];
+            entry.step_estimate = (entry.step_estimate + took + 1) / 2;
+            if (entry.step_estimate == 0) entry.step_estimate = 1;
+        }
+    }
+    return steps;
+}
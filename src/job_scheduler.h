@@ -0,0 +1,113 @@
+/**
+ * @file job_scheduler.h
+ * @brief Cooperative scheduler for deferrable work in frame slack
+ *
+ * Jobs are split into short steps. The AnimationTicker runs steps in the
+ * time left over at the end of each frame, instead of sleeping through it,
+ * and stops before the next frame is due.
+ *
+ * See features/sys_animation_ticker.md (Frame-Slack Job Scheduler).
+ */
+
+#ifndef JOB_SCHEDULER_H
+#define JOB_SCHEDULER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Runs queued job steps by priority, then earliest deadline
+ *
+ * A job is a step function called repeatedly until it reports completion.
+ * Each step should do a bounded amount of work (one parse chunk, a few rows
+ * of a sprite). The scheduler measures how long each job's steps take and
+ * only starts a step that is expected to finish before the caller's limit,
+ * so a frame never overruns because of deferred work. Single-threaded: call
+ * everything from the main loop.
+ */
+class JobScheduler {
+public:
+    // Not HIGH/LOW: Arduino.h defines those as macros
+    enum class Priority : uint8_t {
+        URGENT,
+        NORMAL,
+        BACKGROUND
+    };
+
+    /**
+     * One step of a job.
+     * @param context Pointer given to submit()
+     * @param budget_us Time left before the caller's limit; a step may use it
+     *                  to size its work, but must not block
+     * @return true when the job is finished (it is then removed)
+     */
+    using StepFn = bool(*)(void* context, uint32_t budget_us);
+
+    struct Stats {
+        uint32_t steps;           ///< Steps run
+        uint32_t completed;       ///< Jobs finished
+        uint32_t late;            ///< Jobs finished after their deadline
+        uint64_t busy_micros;     ///< Time spent in steps
+    };
+
+    static constexpr int MAX_JOBS = 16;
+    static constexpr int32_t INVALID_JOB = -1;
+
+    /** Assumed cost of a job's first step when submit() gives no estimate. */
+    static constexpr uint32_t DEFAULT_STEP_ESTIMATE_US = 500;
+
+    JobScheduler();
+
+    /**
+     * Queue a job.
+     * @param step Step function
+     * @param context Passed to every step
+     * @param priority Higher priorities always run first
+     * @param deadline_us hal_timer_get_micros() time the job should be done by,
+     *                    or 0 for none; orders jobs of equal priority
+     * @param step_estimate_us Expected cost of one step (0 = default); replaced
+     *                         by measurements once the job has run
+     * @return Job id, or INVALID_JOB if the queue is full or step is null
+     */
+    int32_t submit(StepFn step, void* context, Priority priority = Priority::NORMAL,
+                   uint64_t deadline_us = 0, uint32_t step_estimate_us = 0);
+
+    /** Remove a queued job without running it again. @return false if unknown */
+    bool cancel(int32_t id);
+
+    bool isQueued(int32_t id) const;
+    int getPendingCount() const { return m_count; }
+
+    /**
+     * Run steps until the next one would not finish before limit_us.
+     * @param limit_us hal_timer_get_micros() time to be done by
+     * @return Number of steps run
+     */
+    int runUntil(uint64_t limit_us);
+
+    const Stats& getStats() const { return m_stats; }
+    void resetStats();
+
+private:
+    struct Job {
+        int32_t id;
+        StepFn step;
+        void* context;
+        Priority priority;
+        uint64_t deadline;
+        uint32_t step_estimate;   ///< Running average of measured step time
+        uint32_t sequence;        ///< Submission order, for FIFO among equals
+    };
+
+    Job m_jobs[MAX_JOBS];
+    int m_count;
+    int32_t m_nextId;
+    uint32_t m_nextSequence;
+    Stats m_stats;
+
+    /** Index of the job to run next, or -1 when empty. */
+    int pickNext() const;
+    void removeAt(int index);
+};
+
+#endif // JOB_SCHEDULER_H
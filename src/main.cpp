@@ -4,6 +4,9 @@
  *
  * UIRenderManager-driven architecture with Widget-based System Menu.
  *
+ * Two tasks: loop() polls input and posts it to a RenderTask, which runs
+ * the UI frames (route, render, update, compose, blit) on the other core.
+ *
  * Components:
  *   Z=1  StockTickerApp       (AppComponent)
  *   Z=10 MiniLogoComponent    (SystemComponent, passive overlay)
@@ -20,22 +23,118 @@
 #include "theme_manager.h"
 #include "relative_display.h"
 #include "animation_ticker.h"
+#include "job_scheduler.h"
+#include "render_task.h"
+#include "parallel_rows.h"
 #include "input/touch_gesture_engine.h"
 #include "wifi_config_generated.h"
 
 #include "../hal/display.h"
 #include "../hal/touch.h"
+#include "../hal/touch_trace.h"
 #include "../hal/network.h"
+#include "../hal/timer.h"
 
 // --- Static globals ---
 static AnimationTicker* g_ticker = nullptr;
+static JobScheduler* g_jobScheduler = nullptr;
 static RelativeDisplay* g_relativeDisplay = nullptr;
 static TouchGestureEngine* g_gestureEngine = nullptr;
+static RenderTask* g_renderTask = nullptr;
+
+// Touch samples arrive from the HAL's INT-driven sampler; without any,
+// the input loop still wakes this often to check the serial port
+static constexpr uint32_t SERIAL_POLL_MS = 20;
+static bool g_touching = false;
+
+// Drags are reported one 60fps frame ahead (the rate held while touching)
+static constexpr uint32_t TOUCH_PREDICTION_US = 16667;
+
+// Drags from one pass are merged into a single event (deltas summed), so a
+// burst of samples costs the render task one command, not one per sample.
+// The merged drag keeps the time of its oldest sample, so the latency
+// report ('L') counts from the first movement it carries.
+static touch_gesture_event_t g_pendingDrag;
+static uint64_t g_pendingDragSampleMicros = 0;
+static bool g_hasPendingDrag = false;
+
+// Touch trace capture: 'T' starts recording, 'T' again sends the trace
+// (scripts/capture_touch_trace.py). Held in RAM until then, so the serial
+// log can't interleave with it.
+static constexpr size_t TRACE_BUFFER_SIZE = 64 * 1024;  // ~2 minutes of touch at 100Hz
+static uint8_t* g_traceBuffer = nullptr;
+static size_t g_traceLength = 0;
+static bool g_traceCapturing = false;  // Recording, or stopped by a full buffer
 
 static StockTickerApp* g_stockTicker = nullptr;
 static MiniLogoComponent* g_miniLogo = nullptr;
 static SystemMenuComponent* g_systemMenu = nullptr;
 
+static void postGesture(const touch_gesture_event_t& event, uint64_t sample_micros) {
+    if (!g_renderTask->postGesture(event, sample_micros)) {
+        Serial.println("[Input] WARN: render queue full, gesture dropped");
+    }
+}
+
+static void flushDrag() {
+    if (g_hasPendingDrag) {
+        postGesture(g_pendingDrag, g_pendingDragSampleMicros);
+        g_hasPendingDrag = false;
+    }
+}
+
+static void queueGesture(const touch_gesture_event_t& event, uint64_t sample_micros) {
+    if (event.type == TOUCH_DRAG) {
+        int16_t dx = g_hasPendingDrag ? g_pendingDrag.delta_x : 0;
+        int16_t dy = g_hasPendingDrag ? g_pendingDrag.delta_y : 0;
+        if (!g_hasPendingDrag) g_pendingDragSampleMicros = sample_micros;
+        g_pendingDrag = event;
+        g_pendingDrag.delta_x = static_cast<int16_t>(g_pendingDrag.delta_x + dx);
+        g_pendingDrag.delta_y = static_cast<int16_t>(g_pendingDrag.delta_y + dy);
+        g_hasPendingDrag = true;
+        return;
+    }
+    flushDrag();  // Keep the order: the drag happened first
+    postGesture(event, sample_micros);
+}
+
+static void appendTrace(const uint8_t* data, size_t length, void* context) {
+    (void)context;
+    if (g_traceLength + length > TRACE_BUFFER_SIZE) {
+        // Records are deltas: stop rather than skip one, so what's kept decodes
+        hal_touch_trace_stop();
+        Serial.println("[Trace] WARN: buffer full, recording stopped");
+        return;
+    }
+    memcpy(g_traceBuffer + g_traceLength, data, length);
+    g_traceLength += length;
+}
+
+static void toggleTouchTrace() {
+    if (!g_traceCapturing) {
+        if (g_traceBuffer == nullptr) {
+            g_traceBuffer = static_cast<uint8_t*>(ps_malloc(TRACE_BUFFER_SIZE));
+            if (g_traceBuffer == nullptr) {
+                Serial.println("[Trace] ERROR: no memory for the trace buffer");
+                return;
+            }
+        }
+        g_traceLength = 0;
+        g_traceCapturing = hal_touch_trace_start(
+            static_cast<uint16_t>(hal_display_get_width_pixels()),
+            static_cast<uint16_t>(hal_display_get_height_pixels()),
+            appendTrace, nullptr);
+        Serial.println("[Trace] Recording touch samples ('T' to stop)");
+        return;
+    }
+
+    hal_touch_trace_stop();
+    g_traceCapturing = false;
+    Serial.printf("TRACE:%u\n", static_cast<unsigned>(g_traceLength));
+    Serial.write(g_traceBuffer, g_traceLength);
+    Serial.print("\nEND\n");
+}
+
 static void displayError(const char* message) {
     hal_display_clear(LPad::ThemeManager::getInstance().getTheme()->colors.text_error);
     hal_display_flush();
@@ -71,6 +170,19 @@ void setup() {
     int32_t width = hal_display_get_width_pixels();
     int32_t height = hal_display_get_height_pixels();
     Serial.printf("  [INFO] Display resolution: %d x %d pixels\n", width, height);
+
+    // Draw into the PSRAM framebuffer; the manager's flush pushes damage
+    if (hal_display_set_shadow_primary(true)) {
+        Serial.println("  [INFO] Shadow framebuffer is primary draw target");
+        #ifdef APP_TILE_HASH_DAMAGE
+        // Send only the 16x16 tiles that changed within each flush's damage
+        if (hal_display_set_tile_hashing(true)) {
+            Serial.println("  [INFO] Tile-hash damage detection enabled");
+        }
+        #endif
+    } else {
+        Serial.println("  [WARN] No shadow framebuffer, drawing directly to panel");
+    }
     yield();
 
     // [2/6] Touch HAL
@@ -138,11 +250,23 @@ void setup() {
     static AnimationTicker ticker(30);
     g_ticker = &ticker;
 
+    // Deferred work runs in each frame's slack instead of a busy-wait
+    static JobScheduler jobScheduler;
+    g_jobScheduler = &jobScheduler;
+    g_ticker->setScheduler(g_jobScheduler);
+
+    // Full-surface kernels (compose, gradients, meshes) split rows with
+    // one helper on the second core
+    if (!ParallelRows::getInstance().begin(1)) {
+        Serial.println("  [WARN] No row helper, full redraws stay on one core");
+    }
+
     g_gestureEngine = new TouchGestureEngine(
         static_cast<int16_t>(width),
         static_cast<int16_t>(height)
     );
     hal_touch_configure_gesture_engine(g_gestureEngine);
+    g_gestureEngine->setPredictionMicros(TOUCH_PREDICTION_US);
 
     Serial.println("  [PASS] RelativeDisplay + 30fps Ticker + GestureEngine");
     yield();
@@ -159,6 +283,7 @@ void setup() {
         displayError("StockTickerApp init failed");
         while (1) delay(1000);
     }
+    g_stockTicker->setJobScheduler(g_jobScheduler);
 
     // Mini Logo (Z=10)
     g_miniLogo = new MiniLogoComponent();
@@ -202,6 +327,15 @@ void setup() {
         Serial.printf("  [INFO] WiFi list populated with %d networks\n", g_wifi_count);
     }
 
+    #ifdef APP_UI_LAYERS
+    // Render into cached layers; the manager composes only what changed
+    g_stockTicker->enableLayer();
+    if (!g_miniLogo->enableLayer()) {
+        Serial.println("  [WARN] MiniLogo layer unavailable, drawing directly");
+    }
+    Serial.println("  [INFO] Layer mode enabled (StockTicker, MiniLogo)");
+    #endif
+
     Serial.println("  [PASS] StockTicker + MiniLogo + SystemMenu(Widgets) created");
     yield();
 
@@ -212,6 +346,7 @@ void setup() {
     auto& mgr = UIRenderManager::getInstance();
     mgr.reset();
     mgr.setFlushCallback(hal_display_flush);
+    mgr.setLayerBackdrop(theme->colors.background);
 
     mgr.registerComponent(g_stockTicker, 1);
     mgr.registerComponent(g_miniLogo, 10);
@@ -232,6 +367,14 @@ void setup() {
     hal_display_clear(theme->colors.background);
     hal_display_flush();
 
+    // From here on only the render task calls into the UI components
+    static RenderTask renderTask(g_ticker);
+    g_renderTask = &renderTask;
+    if (!g_renderTask->start()) {
+        displayError("Render task creation failed");
+        while (1) delay(1000);
+    }
+
     Serial.println("\n=== LPad v0.72 Started ===");
     Serial.println("Swipe down from top edge to open System Menu");
     Serial.println("Tap a WiFi network in the menu to connect");
@@ -239,22 +382,30 @@ void setup() {
 }
 
 void loop() {
-    float deltaTime = g_ticker->waitForNextFrame();
+    // Input side: consume touch samples and serial, hand the results to the render task
+    hal_touch_wait_for_sample(SERIAL_POLL_MS);
 
-    // --- Serial screenshot trigger ---
+    // --- Serial commands: screenshot (taken between frames), touch trace, latency ---
     if (Serial.available()) {
         char c = Serial.read();
         if (c == 'S') {
-            hal_display_dump_screen();
+            RenderTask::Command command;
+            command.type = RenderTask::Command::Type::SCREENSHOT;
+            g_renderTask->post(command);
+        } else if (c == 'T') {
+            toggleTouchTrace();
+        } else if (c == 'L') {
+            RenderTask::Command command;
+            command.type = RenderTask::Command::Type::LATENCY_REPORT;
+            g_renderTask->post(command);
         }
     }
 
-    // --- Touch input -> gesture -> UIRenderManager ---
-    hal_touch_point_t touch_point;
-    bool touch_ok = hal_touch_read(&touch_point);
-
-    if (touch_ok) {
-        touch_gesture_event_t gesture_event;
+    // --- Touch samples since the last pass -> gestures -> render task ---
+    hal_touch_sample_t sample;
+    while (hal_touch_pop_sample(&sample)) {
+        const hal_touch_point_t& touch_point = sample.point;
+        touch_gesture_event_t gesture_event = {};
         bool gesture_detected = false;
 
         if (touch_point.is_home_button) {
@@ -266,22 +417,23 @@ void loop() {
             gesture_event.y_percent = 1.0f;
             gesture_detected = true;
         } else {
-            uint32_t dt_ms = static_cast<uint32_t>(deltaTime * 1000.0f);
-            gesture_detected = g_gestureEngine->update(
+            gesture_detected = g_gestureEngine->updateAt(
                 touch_point.x, touch_point.y,
-                touch_point.is_pressed, dt_ms,
+                touch_point.is_pressed, sample.timestamp_us,
                 &gesture_event
             );
         }
 
         if (gesture_detected) {
-            UIRenderManager::getInstance().routeInput(gesture_event);
+            queueGesture(gesture_event, sample.timestamp_us);
+            if (g_gestureEngine->takePendingEvent(&gesture_event)) {
+                queueGesture(gesture_event, sample.timestamp_us);
+            }
         }
+        g_touching = touch_point.is_pressed;
     }
+    flushDrag();
 
-    // --- Render (Painter's Algorithm) + flush ---
-    UIRenderManager::getInstance().renderAll();
-
-    // --- Update animations ---
-    UIRenderManager::getInstance().updateAll(deltaTime);
+    RenderTask::InputState input = { g_touching };
+    g_renderTask->publishInput(input);
 }
@@ -0,0 +1,229 @@
+/**
+ * @file parallel_rows.cpp
+ * @brief Implementation of ParallelRows
+ *
+ * See features/sys_parallel_rows.md.
+ */
+
+#include "parallel_rows.h"
+
+#ifdef ARDUINO
+    #include <Arduino.h>
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/task.h>
+    #include <freertos/semphr.h>
+#else
+    #include <condition_variable>
+    #include <mutex>
+    #include <thread>
+#endif
+
+// ---------------------------------------------------------------------------
+// Signal: a binary semaphore on either platform
+// ---------------------------------------------------------------------------
+
+namespace {
+
+#ifdef ARDUINO
+class Signal {
+public:
+    Signal() : m_sem(xSemaphoreCreateBinary()) {}
+    ~Signal() { if (m_sem != nullptr) vSemaphoreDelete(m_sem); }
+    bool isValid() const { return m_sem != nullptr; }
+    void give() { xSemaphoreGive(m_sem); }
+    void take() { xSemaphoreTake(m_sem, portMAX_DELAY); }
+private:
+    SemaphoreHandle_t m_sem;
+};
+#else
+class Signal {
+public:
+    bool isValid() const { return true; }
+    void give() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_given = true;
+        m_cv.notify_one();
+    }
+    void take() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this]() { return m_given; });
+        m_given = false;
+    }
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_given = false;
+};
+#endif
+
+}  // namespace
+
+// Signalled by the last helper to finish its band
+static Signal* s_done = nullptr;
+
+struct ParallelRows::Helper {
+    ParallelRows* owner;
+    int band;                  ///< Band index this helper runs (1..helpers)
+    Signal start;
+    std::atomic<bool> quit;
+#ifdef ARDUINO
+    Signal exited;
+    TaskHandle_t handle;
+#else
+    std::thread thread;
+#endif
+
+    Helper(ParallelRows* owner, int band) : owner(owner), band(band), quit(false) {}
+};
+
+// ---------------------------------------------------------------------------
+// ParallelRows
+// ---------------------------------------------------------------------------
+
+ParallelRows& ParallelRows::getInstance() {
+    static ParallelRows instance;
+    return instance;
+}
+
+ParallelRows::ParallelRows()
+    : m_helpers()
+    , m_helperCount(0)
+    , m_busy(false)
+    , m_stats()
+    , m_fn(nullptr)
+    , m_context(nullptr)
+    , m_y0(0)
+    , m_y1(0)
+    , m_bands(0)
+    , m_pending(0) {
+}
+
+ParallelRows::~ParallelRows() {
+    end();
+}
+
+#ifdef ARDUINO
+void ParallelRows::helperTask(void* param) {
+    Helper* helper = static_cast<Helper*>(param);
+    helper->owner->helperLoop(helper);
+    helper->exited.give();
+    vTaskDelete(nullptr);
+}
+#endif
+
+bool ParallelRows::begin(int helpers) {
+    end();
+    if (helpers > MAX_HELPERS) helpers = MAX_HELPERS;
+    if (helpers <= 0) return true;
+
+    if (s_done == nullptr) s_done = new Signal();
+    if (!s_done->isValid()) return false;
+
+    bool ok = true;
+    for (int i = 0; i < helpers; i++) {
+        Helper* helper = new Helper(this, i + 1);
+#ifdef ARDUINO
+        // Not pinned: the scheduler runs it on whichever core the caller
+        // isn't keeping busy
+        BaseType_t result = pdFAIL;
+        if (helper->start.isValid() && helper->exited.isValid()) {
+            result = xTaskCreate(helperTask, "rows", TASK_STACK_SIZE, helper,
+                                 TASK_PRIORITY, &helper->handle);
+        }
+        if (result != pdPASS) {
+            Serial.println("[ParallelRows] Failed to create helper task");
+            delete helper;
+            ok = false;
+            break;
+        }
+#else
+        helper->thread = std::thread(&ParallelRows::helperLoop, this, helper);
+#endif
+        m_helpers[m_helperCount++] = helper;
+    }
+    return ok;
+}
+
+void ParallelRows::end() {
+    for (int i = 0; i < m_helperCount; i++) {
+        Helper* helper = m_helpers[i];
+        helper->quit.store(true, std::memory_order_release);
+        helper->start.give();
+#ifdef ARDUINO
+        helper->exited.take();
+#else
+        helper->thread.join();
+#endif
+        delete helper;
+        m_helpers[i] = nullptr;
+    }
+    m_helperCount = 0;
+}
+
+void ParallelRows::helperLoop(Helper* helper) {
+    for (;;) {
+        helper->start.take();
+        if (helper->quit.load(std::memory_order_acquire)) return;
+
+        int32_t band_y0, band_y1;
+        bandBounds(m_y0, m_y1, m_bands, helper->band, &band_y0, &band_y1);
+        m_fn(m_context, band_y0, band_y1);
+
+        if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            s_done->give();
+        }
+    }
+}
+
+void ParallelRows::bandBounds(int32_t y0, int32_t y1, int count, int k,
+                              int32_t* band_y0, int32_t* band_y1) {
+    int32_t rows = y1 - y0;
+    int32_t base = rows / count;
+    int32_t extra = rows % count;
+    *band_y0 = y0 + k * base + (k < extra ? k : extra);
+    *band_y1 = *band_y0 + base + (k < extra ? 1 : 0);
+}
+
+void ParallelRows::run(int32_t y0, int32_t y1, BandFn fn, void* context,
+                       int32_t min_band_rows) {
+    if (fn == nullptr || y1 <= y0) return;
+    if (min_band_rows < 1) min_band_rows = 1;
+
+    int bands = getWorkerCount();
+    int32_t max_bands = (y1 - y0) / min_band_rows;
+    if (max_bands < bands) bands = max_bands < 1 ? 1 : static_cast<int>(max_bands);
+
+    bool expected = false;
+    if (!m_busy.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        // Nested in a band, or another task's run() is in progress
+        fn(context, y0, y1);
+        return;
+    }
+    m_stats.runs++;
+    if (bands < 2) {
+        // Too small to split, or no helpers
+        fn(context, y0, y1);
+        m_busy.store(false, std::memory_order_release);
+        return;
+    }
+    m_stats.parallel_runs++;
+
+    m_fn = fn;
+    m_context = context;
+    m_y0 = y0;
+    m_y1 = y1;
+    m_bands = bands;
+    m_pending.store(bands - 1, std::memory_order_release);
+
+    // Giving the start signal publishes the job to the helper
+    for (int k = 1; k < bands; k++) {
+        m_helpers[k - 1]->start.give();
+    }
+
+    int32_t band_y0, band_y1;
+    bandBounds(y0, y1, bands, 0, &band_y0, &band_y1);
+    fn(context, band_y0, band_y1);
+
+    s_done->take();
+    m_busy.store(false, std::memory_order_release);
+}
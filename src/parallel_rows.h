@@ -0,0 +1,110 @@
+/**
+ * @file parallel_rows.h
+ * @brief Fork-join splitting of row-independent surface work across cores
+ *
+ * Full-surface kernels (gradient fills, layer composition, mask resolves)
+ * compute each row from shared, read-only input. ParallelRows cuts such a
+ * row range into bands, runs one band on the calling task and the others on
+ * helper tasks (FreeRTOS on ESP32, std::thread on the host), and returns
+ * once every band is done.
+ *
+ * See features/sys_parallel_rows.md for complete specification.
+ */
+
+#ifndef PARALLEL_ROWS_H
+#define PARALLEL_ROWS_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief Runs a band function over a row range on up to MAX_HELPERS + 1 cores
+ *
+ * Determinism: bands depend only on the range, min_band_rows and the worker
+ * count, and a band function must write only the rows it is given and read
+ * nothing another band writes. The result is then bit-identical to a single
+ * call over the whole range, whatever the timing.
+ *
+ * run() is meant for one task (the render task). A run() from inside a band,
+ * or from a second task while one is in progress, executes serially.
+ */
+class ParallelRows {
+public:
+    /**
+     * Work on rows [y0, y1). Must not block or take locks another band holds.
+     */
+    using BandFn = void(*)(void* context, int32_t y0, int32_t y1);
+
+    static constexpr int MAX_HELPERS = 3;
+
+    /** Rows below which run() doesn't split (kernels may pass more). */
+    static constexpr int32_t DEFAULT_MIN_BAND_ROWS = 8;
+
+    static constexpr uint32_t TASK_STACK_SIZE = 4096;
+    static constexpr uint32_t TASK_PRIORITY = 2;
+
+    static ParallelRows& getInstance();
+
+    /**
+     * Start helper workers. Without begin(), run() is serial.
+     * @param helpers Workers besides the caller (clamped to MAX_HELPERS);
+     *                1 on the dual-core ESP32-S3
+     * @return false if a helper could not be created (fewer are used)
+     */
+    bool begin(int helpers);
+
+    /** Stop and join the helpers; run() is serial afterwards. */
+    void end();
+
+    /** Caller plus helpers. */
+    int getWorkerCount() const { return m_helperCount + 1; }
+
+    /**
+     * Split [y0, y1) into at most getWorkerCount() bands of at least
+     * min_band_rows rows, run them in parallel and wait for all of them.
+     */
+    void run(int32_t y0, int32_t y1, BandFn fn, void* context,
+             int32_t min_band_rows = DEFAULT_MIN_BAND_ROWS);
+
+    /**
+     * Band k of count bands over [y0, y1): the split run() uses. Earlier
+     * bands get the remainder rows.
+     */
+    static void bandBounds(int32_t y0, int32_t y1, int count, int k,
+                           int32_t* band_y0, int32_t* band_y1);
+
+    struct Stats {
+        uint32_t runs;            ///< Calls to run(), nested ones excepted
+        uint32_t parallel_runs;   ///< Calls that used helpers
+    };
+    const Stats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = Stats(); }
+
+private:
+    struct Helper;
+
+    ParallelRows();
+    ~ParallelRows();
+    ParallelRows(const ParallelRows&) = delete;
+    ParallelRows& operator=(const ParallelRows&) = delete;
+
+    Helper* m_helpers[MAX_HELPERS];
+    int m_helperCount;
+    std::atomic<bool> m_busy;
+    Stats m_stats;
+
+    // The job in progress, read by helpers after their start signal
+    BandFn m_fn;
+    void* m_context;
+    int32_t m_y0;
+    int32_t m_y1;
+    int m_bands;
+    std::atomic<int> m_pending;
+
+    void helperLoop(Helper* helper);
+#ifdef ARDUINO
+    static void helperTask(void* param);
+#endif
+};
+
+#endif // PARALLEL_ROWS_H
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Fixed-point relative coordinates.
+ *
+ * Positions are percentages of an axis in 16.16 fixed point (rel_fixed_t;
+ * 100% = 100 << 16). Each axis carries a precomputed scale in pixels per
+ * percent, kept in 8.24 so that a conversion is one 32x32->64 multiply, an
+ * add and a shift: no float divide and no roundf() per coordinate.
+ *
+ * Rounding is half away from zero, like roundf((pct / 100) * dim), and is
+ * exact except within 2^-16 percent of a half-pixel tie. (The float formula
+ * itself misses some ties, e.g. 65% of 170, because pct / 100 is inexact.)
+ *
+ * RelativeCoords holds scales computed at run time; StaticRelativeCoords<W, H>
+ * folds them into constants for a panel whose size is known at compile time.
+ *
+ * See features/display_relative_drawing.md (Fixed-Point Coordinates).
+ */
+
+typedef int32_t rel_fixed_t;
+
+static constexpr int REL_FIXED_SHIFT = 16;
+static constexpr rel_fixed_t REL_FIXED_ONE = static_cast<rel_fixed_t>(1) << REL_FIXED_SHIFT;
+
+/** Float percent to 16.16 (nearest). */
+constexpr rel_fixed_t relFixed(float percent) {
+    return static_cast<rel_fixed_t>(percent * static_cast<float>(REL_FIXED_ONE) +
+                                    (percent >= 0.0f ? 0.5f : -0.5f));
+}
+
+/** Whole percent to 16.16. */
+constexpr rel_fixed_t relFixedPercent(int32_t percent) {
+    return static_cast<rel_fixed_t>(percent * REL_FIXED_ONE);
+}
+
+/** Pixels-per-percent scale (8.24) for an axis of dim pixels (dim < 25600). */
+constexpr uint32_t relAxisScale(int32_t dim) {
+    // Rounded up so exact ties land on the upper pixel, as roundf() would
+    return dim <= 0 ? 0u
+                    : static_cast<uint32_t>(((static_cast<uint64_t>(dim) << 24) + 99u) / 100u);
+}
+
+/** 16.16 percent to pixels on an axis with the given scale. */
+inline int32_t relToPixels(rel_fixed_t value, uint32_t scale) {
+    uint32_t magnitude = value < 0 ? 0u - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+    int32_t pixels = static_cast<int32_t>((static_cast<uint64_t>(magnitude) * scale + (1ull << 39)) >> 40);
+    return value < 0 ? -pixels : pixels;
+}
+
+/** Pixels back to 16.16 percent of an axis (for callers that only have pixels). */
+inline rel_fixed_t relFromPixels(int32_t pixels, int32_t dim) {
+    if (dim <= 0) return 0;
+    int64_t scaled = static_cast<int64_t>(pixels) * relFixedPercent(100);
+    return static_cast<rel_fixed_t>((scaled + (scaled >= 0 ? dim / 2 : -(dim / 2))) / dim);
+}
+
+class RelativeCoords {
+public:
+    RelativeCoords(int32_t width, int32_t height)
+        : m_scaleX(relAxisScale(width)), m_scaleY(relAxisScale(height)) {}
+
+    int32_t x(rel_fixed_t percent) const { return relToPixels(percent, m_scaleX); }
+    int32_t y(rel_fixed_t percent) const { return relToPixels(percent, m_scaleY); }
+    int32_t width(rel_fixed_t percent) const { return relToPixels(percent, m_scaleX); }
+    int32_t height(rel_fixed_t percent) const { return relToPixels(percent, m_scaleY); }
+
+    uint32_t getScaleX() const { return m_scaleX; }
+    uint32_t getScaleY() const { return m_scaleY; }
+
+private:
+    uint32_t m_scaleX;
+    uint32_t m_scaleY;
+};
+
+template <int32_t W, int32_t H>
+struct StaticRelativeCoords {
+    static_assert(W > 0 && W < 25600 && H > 0 && H < 25600, "panel size out of range");
+
+    static constexpr uint32_t SCALE_X = relAxisScale(W);
+    static constexpr uint32_t SCALE_Y = relAxisScale(H);
+
+    static int32_t x(rel_fixed_t percent) { return relToPixels(percent, SCALE_X); }
+    static int32_t y(rel_fixed_t percent) { return relToPixels(percent, SCALE_Y); }
+    static int32_t width(rel_fixed_t percent) { return relToPixels(percent, SCALE_X); }
+    static int32_t height(rel_fixed_t percent) { return relToPixels(percent, SCALE_Y); }
+};
@@ -12,6 +12,7 @@
 
 #define _USE_MATH_DEFINES
 #include "relative_display.h"
+#include "display_list.h"
 #include "gradients.h"
 #include "../hal/display.h"
 #include <cmath>
@@ -22,7 +23,7 @@
 #endif
 
 RelativeDisplay::RelativeDisplay(Arduino_GFX* gfx, int32_t width, int32_t height)
-    : _gfx(gfx), _width(width), _height(height) {
+    : _gfx(gfx), _width(width), _height(height), _coords(width, height), _recording(nullptr) {
 }
 
 void RelativeDisplay::init() {
@@ -31,33 +32,15 @@ void RelativeDisplay::init() {
     // or any other initialization required by the underlying GFX object
 }
 
-int32_t RelativeDisplay::relativeToAbsoluteX(float x_percent) const {
-    return static_cast<int32_t>(roundf((x_percent / 100.0f) * static_cast<float>(_width)));
-}
-
-int32_t RelativeDisplay::relativeToAbsoluteY(float y_percent) const {
-    return static_cast<int32_t>(roundf((y_percent / 100.0f) * static_cast<float>(_height)));
-}
-
-int32_t RelativeDisplay::relativeToAbsoluteWidth(float width_percent) const {
-    return static_cast<int32_t>(roundf((width_percent / 100.0f) * static_cast<float>(_width)));
-}
-
-int32_t RelativeDisplay::relativeToAbsoluteHeight(float height_percent) const {
-    return static_cast<int32_t>(roundf((height_percent / 100.0f) * static_cast<float>(_height)));
-}
-
-void RelativeDisplay::drawPixel(float x_percent, float y_percent, uint16_t color) {
-    int32_t x = relativeToAbsoluteX(x_percent);
-    int32_t y = relativeToAbsoluteY(y_percent);
+void RelativeDisplay::drawAbsolutePixel(int32_t x, int32_t y, uint16_t color) {
+    if (_recording) {
+        _recording->addPixel(x, y, color);
+        return;
+    }
     _gfx->drawPixel(x, y, color);
 }
 
-void RelativeDisplay::drawHorizontalLine(float y_percent, float x_start_percent, float x_end_percent, uint16_t color) {
-    int32_t y = relativeToAbsoluteY(y_percent);
-    int32_t x_start = relativeToAbsoluteX(x_start_percent);
-    int32_t x_end = relativeToAbsoluteX(x_end_percent);
-
+void RelativeDisplay::drawAbsoluteHLine(int32_t y, int32_t x_start, int32_t x_end, uint16_t color) {
     // Ensure start <= end
     if (x_start > x_end) {
         int32_t temp = x_start;
@@ -67,14 +50,14 @@ void RelativeDisplay::drawHorizontalLine(float y_percent, float x_start_percent,
 
     // Draw horizontal line
     int32_t width = x_end - x_start + 1;
+    if (_recording) {
+        _recording->addHLine(x_start, y, width, color);
+        return;
+    }
     _gfx->drawFastHLine(x_start, y, width, color);
 }
 
-void RelativeDisplay::drawVerticalLine(float x_percent, float y_start_percent, float y_end_percent, uint16_t color) {
-    int32_t x = relativeToAbsoluteX(x_percent);
-    int32_t y_start = relativeToAbsoluteY(y_start_percent);
-    int32_t y_end = relativeToAbsoluteY(y_end_percent);
-
+void RelativeDisplay::drawAbsoluteVLine(int32_t x, int32_t y_start, int32_t y_end, uint16_t color) {
     // Ensure start <= end
     if (y_start > y_end) {
         int32_t temp = y_start;
@@ -84,18 +67,65 @@ void RelativeDisplay::drawVerticalLine(float x_percent, float y_start_percent, f
 
     // Draw vertical line
     int32_t height = y_end - y_start + 1;
+    if (_recording) {
+        _recording->addVLine(x, y_start, height, color);
+        return;
+    }
     _gfx->drawFastVLine(x, y_start, height, color);
 }
 
-void RelativeDisplay::fillRect(float x_start_percent, float y_start_percent, float width_percent, float height_percent, uint16_t color) {
-    int32_t x = relativeToAbsoluteX(x_start_percent);
-    int32_t y = relativeToAbsoluteY(y_start_percent);
-    int32_t w = relativeToAbsoluteWidth(width_percent);
-    int32_t h = relativeToAbsoluteHeight(height_percent);
-
+void RelativeDisplay::fillAbsoluteRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+    if (_recording) {
+        _recording->addFillRect(x, y, w, h, color);
+        return;
+    }
     _gfx->fillRect(x, y, w, h, color);
 }
 
+void RelativeDisplay::drawText(int32_t x, int32_t y, const char* text, uint16_t color, uint8_t size) {
+    if (text == nullptr) return;
+
+    _gfx->setFont(nullptr);
+    _gfx->setTextSize(size);
+    if (_recording) {
+        // Measure now so replays can skip text outside their clip
+        int16_t x1, y1;
+        uint16_t w, h;
+        _gfx->getTextBounds(text, x, y, &x1, &y1, &w, &h);
+        hal_rect_t bounds = { x1, y1, w, h };
+        _recording->addText(x, y, text, color, size, bounds);
+    } else {
+        _gfx->setTextColor(color);
+        _gfx->setCursor(x, y);
+        _gfx->print(text);
+    }
+}
+
+void RelativeDisplay::drawKeyedBitmap(int32_t x, int32_t y, const uint16_t* pixels, int32_t w, int32_t h,
+                                      uint16_t key_color) {
+    if (pixels == nullptr) return;
+    if (_recording) {
+        _recording->addBitmap(x, y, pixels, w, h, key_color);
+        return;
+    }
+    for (int32_t row = 0; row < h; row++) {
+        for (int32_t col = 0; col < w; col++) {
+            uint16_t pixel = pixels[row * w + col];
+            if (pixel != key_color) {
+                _gfx->drawPixel(x + col, y + row, pixel);
+            }
+        }
+    }
+}
+
+void RelativeDisplay::beginRecording(DisplayList* list) {
+    _recording = list;
+}
+
+void RelativeDisplay::endRecording() {
+    _recording = nullptr;
+}
+
 Arduino_GFX* RelativeDisplay::getGfx() const {
     return _gfx;
 }
@@ -2,6 +2,9 @@
 
 #include <Arduino_GFX_Library.h>
 #include <stdint.h>
+#include "relative_coords.h"
+
+class DisplayList;
 
 class RelativeDisplay {
 public:
@@ -12,16 +15,60 @@ public:
     void init();
 
     // Converts relative units (0.0-100.0) to absolute pixel coordinates.
-    int32_t relativeToAbsoluteX(float x_percent) const;
-    int32_t relativeToAbsoluteY(float y_percent) const;
-    int32_t relativeToAbsoluteWidth(float width_percent) const;
-    int32_t relativeToAbsoluteHeight(float height_percent) const;
+    int32_t relativeToAbsoluteX(float x_percent) const { return _coords.x(relFixed(x_percent)); }
+    int32_t relativeToAbsoluteY(float y_percent) const { return _coords.y(relFixed(y_percent)); }
+    int32_t relativeToAbsoluteWidth(float width_percent) const { return _coords.width(relFixed(width_percent)); }
+    int32_t relativeToAbsoluteHeight(float height_percent) const { return _coords.height(relFixed(height_percent)); }
 
     // Drawing primitives using relative coordinates.
-    void drawPixel(float x_percent, float y_percent, uint16_t color);
-    void drawHorizontalLine(float y_percent, float x_start_percent, float x_end_percent, uint16_t color);
-    void drawVerticalLine(float x_percent, float y_start_percent, float y_end_percent, uint16_t color);
-    void fillRect(float x_start_percent, float y_start_percent, float width_percent, float height_percent, uint16_t color);
+    // The float versions are thin wrappers over the 16.16 fixed-point ones.
+    void drawPixel(float x_percent, float y_percent, uint16_t color) {
+        drawPixelFixed(relFixed(x_percent), relFixed(y_percent), color);
+    }
+    void drawHorizontalLine(float y_percent, float x_start_percent, float x_end_percent, uint16_t color) {
+        drawHorizontalLineFixed(relFixed(y_percent), relFixed(x_start_percent), relFixed(x_end_percent), color);
+    }
+    void drawVerticalLine(float x_percent, float y_start_percent, float y_end_percent, uint16_t color) {
+        drawVerticalLineFixed(relFixed(x_percent), relFixed(y_start_percent), relFixed(y_end_percent), color);
+    }
+    void fillRect(float x_start_percent, float y_start_percent, float width_percent, float height_percent, uint16_t color) {
+        fillRectFixed(relFixed(x_start_percent), relFixed(y_start_percent),
+                      relFixed(width_percent), relFixed(height_percent), color);
+    }
+
+    // Fixed-point primitives (relative_coords.h): percentages in 16.16.
+    void drawPixelFixed(rel_fixed_t x, rel_fixed_t y, uint16_t color) {
+        drawAbsolutePixel(_coords.x(x), _coords.y(y), color);
+    }
+    void drawHorizontalLineFixed(rel_fixed_t y, rel_fixed_t x_start, rel_fixed_t x_end, uint16_t color) {
+        drawAbsoluteHLine(_coords.y(y), _coords.x(x_start), _coords.x(x_end), color);
+    }
+    void drawVerticalLineFixed(rel_fixed_t x, rel_fixed_t y_start, rel_fixed_t y_end, uint16_t color) {
+        drawAbsoluteVLine(_coords.x(x), _coords.y(y_start), _coords.y(y_end), color);
+    }
+    void fillRectFixed(rel_fixed_t x, rel_fixed_t y, rel_fixed_t w, rel_fixed_t h, uint16_t color) {
+        fillAbsoluteRect(_coords.x(x), _coords.y(y), _coords.width(w), _coords.height(h), color);
+    }
+
+    // Pixel-space primitives, for code that already works in pixels.
+    // Lines take inclusive end points in either order. All of these are recorded.
+    void drawAbsolutePixel(int32_t x, int32_t y, uint16_t color);
+    void drawAbsoluteHLine(int32_t y, int32_t x_start, int32_t x_end, uint16_t color);
+    void drawAbsoluteVLine(int32_t x, int32_t y_start, int32_t y_end, uint16_t color);
+    void fillAbsoluteRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+
+    // Text (built-in font, scaled by size; the size stays set for measuring) and
+    // keyed bitmaps at pixel positions.
+    // Going through RelativeDisplay rather than getGfx() lets them be recorded.
+    void drawText(int32_t x, int32_t y, const char* text, uint16_t color, uint8_t size);
+    void drawKeyedBitmap(int32_t x, int32_t y, const uint16_t* pixels, int32_t w, int32_t h, uint16_t key_color);
+
+    // Display lists (features/display_relative_drawing.md): between begin and end,
+    // draw calls are resolved to pixels and appended to the list instead of drawn.
+    // Background methods and the procedural API below are never recorded.
+    void beginRecording(DisplayList* list);
+    void endRecording();
+    bool isRecording() const { return _recording != nullptr; }
 
     // Background drawing methods (features/display_background.md)
     void drawSolidBackground(uint16_t color);
@@ -35,10 +82,39 @@ public:
     int32_t getWidth() const { return _width; }
     int32_t getHeight() const { return _height; }
 
+    const RelativeCoords& getCoords() const { return _coords; }
+
 private:
     Arduino_GFX* _gfx;
     int32_t _width;
     int32_t _height;
+    RelativeCoords _coords;
+    DisplayList* _recording;
+};
+
+// RelativeDisplay for a panel whose size is known at compile time: the
+// fixed-point primitives use constant scales (StaticRelativeCoords), so a
+// conversion compiles to a multiply by an immediate. Everything else,
+// including recording, is inherited.
+template <int32_t W, int32_t H>
+class PanelRelativeDisplay : public RelativeDisplay {
+public:
+    typedef StaticRelativeCoords<W, H> Coords;
+
+    explicit PanelRelativeDisplay(Arduino_GFX* gfx) : RelativeDisplay(gfx, W, H) {}
+
+    void drawPixelFixed(rel_fixed_t x, rel_fixed_t y, uint16_t color) {
+        drawAbsolutePixel(Coords::x(x), Coords::y(y), color);
+    }
+    void drawHorizontalLineFixed(rel_fixed_t y, rel_fixed_t x_start, rel_fixed_t x_end, uint16_t color) {
+        drawAbsoluteHLine(Coords::y(y), Coords::x(x_start), Coords::x(x_end), color);
+    }
+    void drawVerticalLineFixed(rel_fixed_t x, rel_fixed_t y_start, rel_fixed_t y_end, uint16_t color) {
+        drawAbsoluteVLine(Coords::x(x), Coords::y(y_start), Coords::y(y_end), color);
+    }
+    void fillRectFixed(rel_fixed_t x, rel_fixed_t y, rel_fixed_t w, rel_fixed_t h, uint16_t color) {
+        fillAbsoluteRect(Coords::x(x), Coords::y(y), Coords::width(w), Coords::height(h), color);
+    }
 };
 
 // ============================================================================
@@ -0,0 +1,207 @@
+/**
+ * @file render_task.cpp
+ * @brief Implementation of RenderTask
+ *
+ * See features/sys_render_task.md.
+ */
+
+#include "render_task.h"
+#include "animation_ticker.h"
+#include "ui/ui_render_manager.h"
+#include "../hal/display.h"
+#include "../hal/timer.h"
+
+#ifdef ARDUINO
+    #include <Arduino.h>
+#else
+    #include <stdio.h>
+#endif
+
+RenderTask::RenderTask(AnimationTicker* ticker)
+    : m_ticker(ticker)
+    , m_commands()
+    , m_input(InputState{ false })
+    , m_lastPublished{ false }
+    , m_running(false)
+    , m_dropped(0)
+    , m_frames(0)
+    , m_latency()
+    , m_inFlight()
+    , m_inFlightCount(0)
+#ifdef ARDUINO
+    , m_exited(true)
+    , m_taskHandle(nullptr)
+#endif
+{
+}
+
+RenderTask::~RenderTask() {
+    stop();
+}
+
+bool RenderTask::start(int core) {
+    if (m_ticker == nullptr || isRunning()) return false;
+    m_running.store(true, std::memory_order_release);
+
+#ifdef ARDUINO
+    if (core == OTHER_CORE) {
+        core = xPortGetCoreID() == 0 ? 1 : 0;
+    }
+    m_exited.store(false, std::memory_order_release);
+    BaseType_t result = xTaskCreatePinnedToCore(
+        taskFunction,
+        "render",
+        TASK_STACK_SIZE,
+        this,
+        TASK_PRIORITY,
+        &m_taskHandle,
+        core
+    );
+    if (result != pdPASS) {
+        Serial.println("[RenderTask] Failed to create task");
+        m_running.store(false, std::memory_order_release);
+        m_exited.store(true, std::memory_order_release);
+        return false;
+    }
+    Serial.printf("[RenderTask] Started on core %d\n", core);
+#else
+    (void)core;
+    m_thread = std::thread(&RenderTask::runLoop, this);
+#endif
+    return true;
+}
+
+void RenderTask::stop() {
+    if (!isRunning()) return;
+    m_running.store(false, std::memory_order_release);
+    hal_timer_wake();  // An idle frame would otherwise wait out its cap
+
+#ifdef ARDUINO
+    while (!m_exited.load(std::memory_order_acquire)) {
+        vTaskDelay(1);
+    }
+    m_taskHandle = nullptr;
+#else
+    if (m_thread.joinable()) m_thread.join();
+#endif
+}
+
+#ifdef ARDUINO
+void RenderTask::taskFunction(void* param) {
+    RenderTask* task = static_cast<RenderTask*>(param);
+    task->runLoop();
+    // Nothing of the object may be touched after this store
+    task->m_exited.store(true, std::memory_order_release);
+    vTaskDelete(nullptr);
+}
+#endif
+
+void RenderTask::runLoop() {
+    while (m_running.load(std::memory_order_acquire)) {
+        runFrame();
+    }
+}
+
+bool RenderTask::post(const Command& command) {
+    if (!m_commands.push(command)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    hal_timer_wake();
+    return true;
+}
+
+bool RenderTask::postGesture(const touch_gesture_event_t& event, uint64_t sample_micros) {
+    Command command;
+    command.type = Command::Type::GESTURE;
+    command.gesture = event;
+    command.sample_micros = sample_micros;
+    command.posted_micros = sample_micros != 0 ? hal_timer_get_micros() : 0;
+    return post(command);
+}
+
+void RenderTask::publishInput(const InputState& state) {
+    m_input.write(state);
+    if (state.touching != m_lastPublished.touching) {
+        m_lastPublished = state;
+        hal_timer_wake();
+    }
+}
+
+void RenderTask::execute(const Command& command) {
+    switch (command.type) {
+        case Command::Type::GESTURE:
+            UIRenderManager::getInstance().routeInput(command.gesture);
+            if (command.sample_micros != 0 && m_inFlightCount < static_cast<int>(COMMAND_QUEUE_SIZE)) {
+                InputLatency::Stamps& stamps = m_inFlight[m_inFlightCount++];
+                stamps.sample = command.sample_micros;
+                stamps.posted = command.posted_micros;
+                stamps.routed = hal_timer_get_micros();
+            }
+            break;
+        case Command::Type::SCREENSHOT:
+            hal_display_dump_screen();
+            break;
+        case Command::Type::LATENCY_REPORT:
+            reportLatency();
+            break;
+    }
+}
+
+void RenderTask::drainCommands(void* context) {
+    RenderTask* task = static_cast<RenderTask*>(context);
+    Command command;
+    while (task->m_commands.pop(&command)) {
+        task->execute(command);
+    }
+}
+
+void RenderTask::reportLatency() {
+    char report[512];
+    m_latency.format(report, sizeof(report));
+#ifdef ARDUINO
+    Serial.print(report);
+#else
+    fputs(report, stdout);
+#endif
+    m_latency.reset();
+}
+
+void RenderTask::runFrame() {
+    float deltaTime = m_ticker->waitForNextFrame();
+    UIRenderManager& mgr = UIRenderManager::getInstance();
+
+    // --- Update → commands posted so far, in order → late update →
+    // render (Painter's Algorithm) + flush ---
+    // Commands are drained after the update, as late as possible, so
+    // gestures that arrive while animations step still make this frame
+    mgr.runFrame(deltaTime, drainCommands, this);
+    const InputState& input = m_input.read();
+
+    // The gestures routed above are on the panel once the flush returns.
+    // What they only start (a fling's motion) is stepped by the next
+    // frame's update, so this is the latency of the first response.
+    if (m_inFlightCount > 0) {
+        uint64_t presented = hal_timer_get_micros();
+        for (int i = 0; i < m_inFlightCount; i++) {
+            m_inFlight[i].rendered = mgr.getLastDrawnMicros();
+            m_inFlight[i].presented = presented;
+            m_latency.record(m_inFlight[i]);
+        }
+        m_inFlightCount = 0;
+    }
+
+    // --- Pace the next frame to what the components need ---
+    // A finger on the glass keeps the full rate so drags track it
+    uint32_t targetFps = input.touching ? UIComponent::FPS_ANIMATION : mgr.getTargetFps();
+    m_ticker->setTargetFps(targetFps);
+
+    // Nothing on screen will change by itself: sleep until a command, an
+    // input change, a data update or a component's wake-up time wakes the
+    // task. A command posted after this check still wakes it
+    // (hal_timer_wake() is remembered).
+    m_ticker->setIdleDeadline(mgr.getNextWakeMicros());
+    m_ticker->setIdle(!input.touching && m_commands.isEmpty() && mgr.isIdle());
+
+    m_frames.fetch_add(1, std::memory_order_relaxed);
+}
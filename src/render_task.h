@@ -0,0 +1,147 @@
+/**
+ * @file render_task.h
+ * @brief UI frame loop running in its own task, fed by a command queue
+ *
+ * Everything that touches UI components — input routing, render, update,
+ * compose and blit — runs here. The rest of the firmware (touch polling,
+ * serial) talks to it only through a lock-free command queue and a
+ * triple-buffered input state, so it never blocks a frame and never races
+ * the components. On ESP32 the task is pinned to the core loop() is not on;
+ * on the host it is a std::thread, so the split can be run under sanitizers.
+ * Gestures carry the time of their touch sample, and the task measures how
+ * long each takes to reach the panel (InputLatency).
+ *
+ * See features/sys_render_task.md for complete specification.
+ */
+
+#ifndef RENDER_TASK_H
+#define RENDER_TASK_H
+
+#include <stdint.h>
+#include <atomic>
+#include "spsc_queue.h"
+#include "triple_buffer.h"
+#include "input_latency.h"
+#include "input/touch_gesture_engine.h"
+
+#ifdef ARDUINO
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/task.h>
+#else
+    #include <thread>
+#endif
+
+class AnimationTicker;
+
+class RenderTask {
+public:
+    /** One-off requests, executed in order just before a frame is drawn. */
+    struct Command {
+        enum class Type : uint8_t {
+            GESTURE,        ///< Route `gesture` to the components
+            SCREENSHOT,     ///< Dump the screen over serial between frames
+            LATENCY_REPORT  ///< Print the latency percentiles, then start over
+        };
+        Type type;
+        touch_gesture_event_t gesture;
+        uint64_t sample_micros;  ///< GESTURE: its touch sample's time, 0 if untracked
+        uint64_t posted_micros;  ///< GESTURE: when it was posted
+    };
+
+    /** Latest-value state published by the input side. */
+    struct InputState {
+        bool touching;     ///< A finger is on the glass: pace at full rate
+    };
+
+    static constexpr size_t COMMAND_QUEUE_SIZE = 32;
+
+    /** start() default: the core the caller is not running on. */
+    static constexpr int OTHER_CORE = -1;
+    static constexpr uint32_t TASK_STACK_SIZE = 8192;
+    static constexpr uint32_t TASK_PRIORITY = 2;
+
+    /**
+     * @param ticker Paces the frames; used only by the render task once
+     *               started (attach a JobScheduler to it beforehand)
+     */
+    explicit RenderTask(AnimationTicker* ticker);
+    ~RenderTask();
+
+    /**
+     * Start the frame loop. Register components with the UIRenderManager
+     * first; from now on only the render task may call into them.
+     * @param core ESP32 core to pin to (ignored on the host)
+     * @return false if already running or the task could not be created
+     */
+    bool start(int core = OTHER_CORE);
+
+    /** Finish the current frame and end the loop. Blocks until it has. */
+    void stop();
+
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    // --- Input side (one producer task, e.g. loop()) ---
+
+    /**
+     * Queue a command and wake the render task if it is idle.
+     * @return false if the queue is full (the command is dropped and counted)
+     */
+    bool post(const Command& command);
+
+    /**
+     * @param sample_micros hal_timer_get_micros() time of the touch sample
+     *                      the gesture came from; 0 leaves it out of the
+     *                      latency statistics
+     */
+    bool postGesture(const touch_gesture_event_t& event, uint64_t sample_micros = 0);
+
+    /** Publish the input state. Wakes the render task only when it changed. */
+    void publishInput(const InputState& state);
+
+    uint32_t getDroppedCommands() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // --- Render side ---
+
+    /**
+     * One frame: wait for it, update, execute queued commands, late update,
+     * render, and choose the pacing of the next
+     * (UIRenderManager::runFrame()). The task calls this in a loop; tests
+     * may call it directly instead of start().
+     */
+    void runFrame();
+
+    uint32_t getFrameCount() const { return m_frames.load(std::memory_order_relaxed); }
+
+    /** Latency of tracked gestures. Render side only (or once stopped). */
+    const InputLatency& getLatency() const { return m_latency; }
+
+private:
+    AnimationTicker* m_ticker;
+    SpscQueue<Command, COMMAND_QUEUE_SIZE> m_commands;
+    TripleBuffer<InputState> m_input;
+    InputState m_lastPublished;    ///< Input side only
+
+    std::atomic<bool> m_running;
+    std::atomic<uint32_t> m_dropped;
+    std::atomic<uint32_t> m_frames;
+
+    // Tracked gestures routed this frame, waiting for it to be presented
+    InputLatency m_latency;
+    InputLatency::Stamps m_inFlight[COMMAND_QUEUE_SIZE];
+    int m_inFlightCount;
+
+    void execute(const Command& command);
+    static void drainCommands(void* context);
+    void reportLatency();
+    void runLoop();
+
+#ifdef ARDUINO
+    std::atomic<bool> m_exited;
+    TaskHandle_t m_taskHandle;
+    static void taskFunction(void* param);
+#else
+    std::thread m_thread;
+#endif
+};
+
+#endif // RENDER_TASK_H
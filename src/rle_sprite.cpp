@@ -0,0 +1,81 @@
+#include "rle_sprite.h"
+#include "../hal/display_rle.h"
+
+RleSprite::RleSprite()
+    : m_width(0)
+    , m_height(0)
+    , m_opaquePixels(0)
+{
+}
+
+void RleSprite::clear() {
+    m_data.clear();
+    m_width = 0;
+    m_height = 0;
+    m_opaquePixels = 0;
+}
+
+bool RleSprite::encode(const uint16_t* pixels, int16_t width, int16_t height,
+                       int32_t stride, uint16_t transparent_color) {
+    clear();
+    if (pixels == nullptr || width <= 0 || height <= 0 || stride < width) {
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+
+    for (int16_t row = 0; row < height; row++) {
+        const uint16_t* src = pixels + static_cast<int32_t>(row) * stride;
+        size_t count_index = m_data.size();
+        m_data.push_back(0);  // Run count, patched below
+
+        uint16_t runs = 0;
+        int16_t col = 0;
+        int16_t run_end = 0;  // End of the previous run (for relative skip)
+        while (col < width) {
+            while (col < width && src[col] == transparent_color) {
+                col++;
+            }
+            if (col >= width) break;
+
+            int16_t run_start = col;
+            while (col < width && src[col] != transparent_color) {
+                col++;
+            }
+
+            m_data.push_back(static_cast<uint16_t>(run_start - run_end));
+            m_data.push_back(static_cast<uint16_t>(col - run_start));
+            m_data.insert(m_data.end(), src + run_start, src + col);
+            m_opaquePixels += col - run_start;
+            run_end = col;
+            runs++;
+        }
+        m_data[count_index] = runs;
+    }
+
+    return true;
+}
+
+bool RleSprite::encodeCanvas(hal_canvas_handle_t canvas, uint16_t transparent_color) {
+    clear();
+    if (canvas == nullptr) return false;
+
+    hal_surface_t surface;
+    if (!hal_display_lock_surface(canvas, &surface)) return false;
+    bool ok = encode(surface.pixels, static_cast<int16_t>(surface.width),
+                     static_cast<int16_t>(surface.height), surface.stride, transparent_color);
+    hal_display_unlock_surface(canvas, 0, 0, 0, 0);  // Read-only access
+    return ok;
+}
+
+void RleSprite::blit(int32_t x, int32_t y) const {
+    if (isEmpty()) return;
+    hal_display_blit_rle(static_cast<int16_t>(x), static_cast<int16_t>(y),
+                         m_width, m_height, m_data.data());
+}
+
+void RleSprite::blitTo(const hal_surface_t& target, int32_t x, int32_t y) const {
+    if (isEmpty()) return;
+    hal_rle_blit_to_surface(&target, x, y, m_height, m_data.data(), nullptr);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "../hal/display.h"
+
+/**
+ * RleSprite - Run-length encoded RGB565 sprite with transparency.
+ *
+ * Stores the scanline run stream defined in hal/display_rle.h:
+ *
+ *   row 0: [runs] [skip len px px ...] [skip len px ...] ...
+ *   row 1: [runs] ...
+ *
+ * `skip` is the number of transparent pixels before the opaque run, measured
+ * from the end of the previous run (or the row start). Fully transparent rows
+ * are a single 0. Blitting touches only opaque pixels and never re-tests the
+ * chroma key; the HAL consumes the stream directly.
+ */
+class RleSprite {
+public:
+    RleSprite();
+
+    /**
+     * Encode a pixel buffer, treating transparent_color as fully transparent.
+     *
+     * @param pixels Source pixels (row-major)
+     * @param width Width in pixels
+     * @param height Height in pixels
+     * @param stride Distance between source rows, in pixels
+     * @param transparent_color Chroma key to drop
+     * @return true on success, false for invalid input
+     */
+    bool encode(const uint16_t* pixels, int16_t width, int16_t height,
+                int32_t stride, uint16_t transparent_color);
+
+    /**
+     * Encode the contents of an offscreen canvas (e.g. a pre-rendered
+     * overlay), treating transparent_color as fully transparent.
+     *
+     * @param canvas Source canvas
+     * @param transparent_color Chroma key to drop
+     * @return true on success, false if the canvas can't be accessed
+     */
+    bool encodeCanvas(hal_canvas_handle_t canvas, uint16_t transparent_color);
+
+    /**
+     * Blit to the display with a single hal_display_blit_rle() call.
+     * @param x,y Destination top-left corner (pixels)
+     */
+    void blit(int32_t x, int32_t y) const;
+
+    /**
+     * Blit into a locked surface, clipped to its bounds.
+     * @param target Destination surface
+     * @param x,y Destination top-left corner (pixels)
+     */
+    void blitTo(const hal_surface_t& target, int32_t x, int32_t y) const;
+
+    void clear();
+
+    int16_t getWidth() const { return m_width; }
+    int16_t getHeight() const { return m_height; }
+    bool isEmpty() const { return m_data.empty(); }
+
+    /** Encoded size in bytes (useful for memory budgeting). */
+    size_t getDataSize() const { return m_data.size() * sizeof(uint16_t); }
+
+    /** Number of opaque pixels. */
+    int32_t getOpaquePixelCount() const { return m_opaquePixels; }
+
+private:
+    std::vector<uint16_t> m_data;
+    int16_t m_width;
+    int16_t m_height;
+    int32_t m_opaquePixels;
+};
@@ -0,0 +1,67 @@
+/**
+ * @file spsc_queue.h
+ * @brief Lock-free single-producer, single-consumer ring buffer
+ *
+ * Carries commands from the input loop to the render task without a mutex,
+ * so neither side ever blocks on the other.
+ *
+ * See features/sys_render_task.md.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief Fixed-capacity FIFO for exactly one producer and one consumer
+ *
+ * push() may only be called from one task and pop() from one (other) task.
+ * Each side owns one index and only reads the other's, so an acquire/release
+ * pair per call is all the synchronization needed. Capacity must be a power
+ * of two; all of it is usable.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+public:
+    SpscQueue() : m_head(0), m_tail(0) {}
+
+    /** Producer side. @return false if the queue is full */
+    bool push(const T& item) {
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= Capacity) return false;
+        m_items[tail & MASK] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Consumer side. @return false if the queue is empty */
+    bool pop(T* item) {
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return false;
+        *item = m_items[head & MASK];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Either side; only a snapshot while the other side runs. */
+    bool isEmpty() const {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr uint32_t MASK = static_cast<uint32_t>(Capacity - 1);
+
+    T m_items[Capacity];
+    std::atomic<uint32_t> m_head;   ///< Next slot to read (consumer writes)
+    std::atomic<uint32_t> m_tail;   ///< Next slot to write (producer writes)
+};
+
+#endif // SPSC_QUEUE_H
@@ -5,6 +5,8 @@
 
 #include "mini_logo_component.h"
 #include "../ui_mini_logo.h"
+#include "../rle_sprite.h"
+#include "../vector_sprite_cache.h"
 
 MiniLogoComponent::MiniLogoComponent()
     : m_miniLogo(nullptr)
@@ -21,12 +23,42 @@ bool MiniLogoComponent::begin(RelativeDisplay* display) {
     return true;
 }
 
+bool MiniLogoComponent::enableLayer() {
+    if (m_miniLogo == nullptr) return false;
+
+    int32_t left, top;
+    const RleSprite* sprite = m_miniLogo->getSprite(&left, &top);
+    if (sprite == nullptr) return false;
+    if (!m_layer.init(left, top, sprite->getWidth(), sprite->getHeight())) return false;
+
+    // Runs never cover the key, so everything outside the logo stays clear
+    const uint16_t key = VectorSpriteCache::TRANSPARENT_KEY;
+    m_layer.setBlendMode(UILayer::BlendMode::KEYED, key);
+    m_layer.fill(key);
+    sprite->blitTo(m_layer.getSurface(), 0, 0);
+    return true;
+}
+
 void MiniLogoComponent::render() {
+    // In layer mode the logo was rendered once; the manager composes it
+    if (m_layer.isValid()) return;
+
     if (m_miniLogo != nullptr) {
         m_miniLogo->render();
     }
 }
 
+bool MiniLogoComponent::getBounds(hal_rect_t& out) const {
+    // The sprite's box, so an opaque overlay on top can skip the logo
+    if (m_miniLogo == nullptr) return false;
+
+    int32_t left, top;
+    const RleSprite* sprite = m_miniLogo->getSprite(&left, &top);
+    if (sprite == nullptr) return false;
+    out = { left, top, sprite->getWidth(), sprite->getHeight() };
+    return true;
+}
+
 bool MiniLogoComponent::handleInput(const touch_gesture_event_t& event) {
     (void)event;
     return false; // Pass-through
@@ -4,12 +4,15 @@
  *
  * Wraps the existing MiniLogo as a passive overlay SystemComponent.
  * Always visible, transparent, draws logo to GFX buffer without flushing.
+ * In layer mode the logo is rendered once into a keyed UILayer and the
+ * manager composes it over whatever changes beneath.
  */
 
 #ifndef MINI_LOGO_COMPONENT_H
 #define MINI_LOGO_COMPONENT_H
 
 #include "../ui/ui_component.h"
+#include "../ui/ui_layer.h"
 
 class RelativeDisplay;
 class MiniLogo;
@@ -21,14 +24,25 @@ public:
 
     bool begin(RelativeDisplay* display);
 
+    /**
+     * Render the logo once into a keyed UILayer instead of blitting it every
+     * frame. Call after begin() and before registration.
+     * @return false if the sprite or the layer could not be created
+     */
+    bool enableLayer();
+
     void render() override;
     bool handleInput(const touch_gesture_event_t& event) override;
 
     bool isOpaque() const override { return false; }
     bool isFullscreen() const override { return false; }
+    bool getBounds(hal_rect_t& out) const override;
+    uint32_t getTargetFps() const override { return FPS_STATIC; }
+    UILayer* getLayer() override { return m_layer.isValid() ? &m_layer : nullptr; }
 
 private:
     MiniLogo* m_miniLogo;
+    UILayer m_layer;
 };
 
 #endif // MINI_LOGO_COMPONENT_H
@@ -114,6 +114,17 @@ void SystemMenuComponent::update(float dt) {
     }
 }
 
+uint32_t SystemMenuComponent::getTargetFps() const {
+    if (m_inner == nullptr) return FPS_STATIC;
+
+    // Slides and list flings run at the full rate; open, the widgets blink
+    // and poll WiFi
+    SystemMenu::State state = m_inner->getState();
+    if (state == SystemMenu::OPENING || state == SystemMenu::CLOSING) return FPS_ANIMATION;
+    if (state == SystemMenu::OPEN && m_inner->isFlinging()) return FPS_ANIMATION;
+    return state == SystemMenu::OPEN ? FPS_DEFAULT : FPS_STATIC;
+}
+
 void SystemMenuComponent::render() {
     if (m_inner) {
         m_inner->render();
@@ -56,6 +56,7 @@ public:
 
     bool isOpaque() const override { return true; }
     bool isFullscreen() const override { return true; }
+    uint32_t getTargetFps() const override;
 
 private:
     SystemMenu* m_inner;
@@ -1,4 +1,5 @@
 #include "theme_manager.h"
+#include "../hal/display_format.h"
 
 namespace LPad {
 
@@ -49,6 +50,7 @@ Theme ThemeManager::default_theme_ = {
 
 ThemeManager::ThemeManager()
     : active_theme_(&default_theme_) {
+    convertNativeColors();
 }
 
 ThemeManager& ThemeManager::getInstance() {
@@ -59,9 +61,20 @@ ThemeManager& ThemeManager::getInstance() {
 void ThemeManager::setTheme(const Theme* theme) {
     if (theme != nullptr) {
         active_theme_ = theme;
+        convertNativeColors();
     }
 }
 
+void ThemeManager::convertNativeColors() {
+    // ThemeColors is a flat list of RGB565 values, so it converts as one row
+    static_assert(sizeof(ThemeColors) % sizeof(uint16_t) == 0,
+                  "ThemeColors must only hold uint16_t colors");
+    hal_pixels_convert(reinterpret_cast<uint16_t*>(&native_colors_),
+                       reinterpret_cast<const uint16_t*>(&active_theme_->colors),
+                       sizeof(ThemeColors) / sizeof(uint16_t),
+                       HAL_PIXEL_FORMAT_RGB565, hal_display_get_native_format());
+}
+
 const Theme* ThemeManager::getDefaultTheme() {
     return &default_theme_;
 }
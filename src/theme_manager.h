@@ -90,6 +90,14 @@ public:
      */
     void setTheme(const Theme* theme);
 
+    /**
+     * Get the active theme's colors in the panel's native pixel format
+     * (hal_display_get_native_format()), converted once per setTheme().
+     * For code writing directly into panel-order surfaces such as the shadow
+     * framebuffer; Arduino_GFX drawing keeps using getTheme()->colors.
+     */
+    const ThemeColors& getNativeColors() const { return native_colors_; }
+
     /**
      * Get the default theme
      * @return Pointer to the default Theme struct
@@ -104,9 +112,15 @@ private:
     // Private constructor for singleton
     ThemeManager();
 
+    // Rebuild native_colors_ from the active theme
+    void convertNativeColors();
+
     // Active theme pointer
     const Theme* active_theme_;
 
+    // Active theme colors in the panel's native pixel format
+    ThemeColors native_colors_;
+
     // Default theme instance
     static Theme default_theme_;
 };
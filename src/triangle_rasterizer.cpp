@@ -0,0 +1,321 @@
+#include "triangle_rasterizer.h"
+#include "parallel_rows.h"
+#include "../hal/display_format.h"
+#include <math.h>
+#include <string.h>
+
+// ---------------------------------------------------------------------------
+// Sample patterns (offsets within a pixel, in 1/16 px)
+// ---------------------------------------------------------------------------
+
+struct SamplePattern {
+    int32_t count;
+    uint8_t fullMask;
+    int32_t x[4];
+    int32_t y[4];
+};
+
+// Single sample at the pixel center
+static const SamplePattern kCenterSample = { 1, 0x1, {8, 0, 0, 0}, {8, 0, 0, 0} };
+
+// 4x rotated grid: no two samples share a row or column
+static const SamplePattern kRotatedGrid4x = { 4, 0xF, {6, 14, 2, 10}, {2, 6, 10, 14} };
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+// Edge function w(p) = A * (p.x - a.x) + B * (p.y - a.y) + bias; inside if w >= 0
+struct Edge {
+    int32_t A;
+    int32_t B;
+    int32_t c;  // Value at the origin (0, 0), bias included
+};
+
+static int32_t orient(const RasterVertex& a, const RasterVertex& b, const RasterVertex& c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+// Top edge: horizontal with the interior below. Left edge: interior to the right.
+// Samples exactly on any other edge belong to the neighbouring triangle.
+static Edge makeEdge(const RasterVertex& a, const RasterVertex& b) {
+    Edge e;
+    e.A = -(b.y - a.y);
+    e.B = b.x - a.x;
+    bool top_left = (a.y == b.y && b.x > a.x) || (b.y < a.y);
+    e.c = -e.A * a.x - e.B * a.y + (top_left ? 0 : -1);
+    return e;
+}
+
+static int32_t evalEdge(const Edge& e, int32_t x, int32_t y) {
+    return e.A * x + e.B * y + e.c;
+}
+
+static inline int32_t min4(int32_t a, int32_t b, int32_t c, int32_t d) {
+    int32_t ab = (a < b) ? a : b;
+    int32_t cd = (c < d) ? c : d;
+    return (ab < cd) ? ab : cd;
+}
+
+static inline int32_t max4(int32_t a, int32_t b, int32_t c, int32_t d) {
+    int32_t ab = (a > b) ? a : b;
+    int32_t cd = (c > d) ? c : d;
+    return (ab > cd) ? ab : cd;
+}
+
+static inline uint16_t blend565(uint16_t fg, uint16_t bg, uint32_t alpha32) {
+    // Spread RGB565 into 0x07E0F81F lanes so all channels blend in one multiply
+    uint32_t f = (fg | (static_cast<uint32_t>(fg) << 16)) & 0x07E0F81FU;
+    uint32_t b = (bg | (static_cast<uint32_t>(bg) << 16)) & 0x07E0F81FU;
+    uint32_t r = ((((f - b) * alpha32) >> 5) + b) & 0x07E0F81FU;
+    return static_cast<uint16_t>((r >> 16) | r);
+}
+
+static inline uint32_t popcount4(uint8_t bits) {
+    static const uint8_t kCounts[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+    return kCounts[bits & 0xF];
+}
+
+// ---------------------------------------------------------------------------
+// TriangleRasterizer
+// ---------------------------------------------------------------------------
+
+int32_t TriangleRasterizer::toFixed(float px) {
+    return static_cast<int32_t>(lroundf(px * static_cast<float>(SUBPIXEL_ONE)));
+}
+
+TriangleRasterizer::TriangleRasterizer(const hal_surface_t& target)
+    : m_target(target)
+    , m_antiAlias(false)
+    , m_maskX(0), m_maskY(0), m_maskW(0), m_maskH(0)
+    , m_dirtyMinX(0), m_dirtyMinY(0), m_dirtyMaxX(0), m_dirtyMaxY(0)
+{
+}
+
+void TriangleRasterizer::getDirtyRect(int32_t& x, int32_t& y, int32_t& w, int32_t& h) const {
+    x = m_dirtyMinX;
+    y = m_dirtyMinY;
+    w = m_dirtyMaxX - m_dirtyMinX;
+    h = m_dirtyMaxY - m_dirtyMinY;
+}
+
+void TriangleRasterizer::fillMesh(const RasterTriangle* tris, size_t count, uint16_t color) {
+    if (m_target.pixels == nullptr || tris == nullptr || count == 0) return;
+
+    const int32_t limit = MAX_COORD_PX * SUBPIXEL_ONE;
+
+    // Mesh bounding box in 16.4
+    int32_t min_x = limit, min_y = limit, max_x = -limit, max_y = -limit;
+    for (size_t t = 0; t < count; t++) {
+        for (int v = 0; v < 3; v++) {
+            const RasterVertex& p = tris[t].v[v];
+            if (p.x < min_x) min_x = p.x;
+            if (p.y < min_y) min_y = p.y;
+            if (p.x > max_x) max_x = p.x;
+            if (p.y > max_y) max_y = p.y;
+        }
+    }
+
+    // Pixel bounds (exclusive end), clipped to the surface
+    int32_t px0 = min_x >> SUBPIXEL_BITS;
+    int32_t py0 = min_y >> SUBPIXEL_BITS;
+    int32_t px1 = (max_x >> SUBPIXEL_BITS) + 1;
+    int32_t py1 = (max_y >> SUBPIXEL_BITS) + 1;
+    if (px0 < 0) px0 = 0;
+    if (py0 < 0) py0 = 0;
+    if (px1 > m_target.width) px1 = m_target.width;
+    if (py1 > m_target.height) py1 = m_target.height;
+    if (px0 >= px1 || py0 >= py1) return;
+
+    m_maskX = px0;
+    m_maskY = py0;
+    m_maskW = px1 - px0;
+    m_maskH = py1 - py0;
+    m_mask.assign(static_cast<size_t>(m_maskW) * m_maskH, 0);
+    m_rowMinX.assign(m_maskH, 0);
+    m_rowMaxX.assign(m_maskH, 0);
+
+    MeshJob job = { this, tris, count, color };
+    ParallelRows::getInstance().run(0, m_maskH, rasterizeRows, &job, PARALLEL_MIN_ROWS);
+    mergeDirtyRows();
+}
+
+void TriangleRasterizer::rasterizeRows(void* context, int32_t row0, int32_t row1) {
+    const MeshJob& job = *static_cast<const MeshJob*>(context);
+    TriangleRasterizer* r = job.rasterizer;
+    for (size_t t = 0; t < job.count; t++) {
+        r->rasterizeTriangle(job.tris[t], r->m_maskY + row0, r->m_maskY + row1);
+    }
+    r->resolveRows(job.color, row0, row1);
+}
+
+void TriangleRasterizer::rasterizeTriangle(const RasterTriangle& tri, int32_t y0, int32_t y1) {
+    const int32_t limit = MAX_COORD_PX * SUBPIXEL_ONE;
+    for (int v = 0; v < 3; v++) {
+        if (tri.v[v].x < -limit || tri.v[v].x > limit ||
+            tri.v[v].y < -limit || tri.v[v].y > limit) {
+            return;
+        }
+    }
+
+    RasterVertex v0 = tri.v[0];
+    RasterVertex v1 = tri.v[1];
+    RasterVertex v2 = tri.v[2];
+    int32_t area = orient(v0, v1, v2);
+    if (area == 0) return;
+    if (area < 0) {
+        RasterVertex tmp = v1;
+        v1 = v2;
+        v2 = tmp;
+    }
+
+    const SamplePattern& sp = m_antiAlias ? kRotatedGrid4x : kCenterSample;
+    Edge edges[3] = { makeEdge(v1, v2), makeEdge(v2, v0), makeEdge(v0, v1) };
+
+    // Per-edge offset of each sample relative to the pixel's top-left corner
+    int32_t sample_off[3][4];
+    for (int e = 0; e < 3; e++) {
+        for (int s = 0; s < sp.count; s++) {
+            sample_off[e][s] = edges[e].A * sp.x[s] + edges[e].B * sp.y[s];
+        }
+    }
+
+    // Triangle pixel bounds, clipped to the mask rows being worked on
+    int32_t tx0 = v0.x, tx1 = v0.x, ty0 = v0.y, ty1 = v0.y;
+    const RasterVertex* vs[2] = { &v1, &v2 };
+    for (int i = 0; i < 2; i++) {
+        if (vs[i]->x < tx0) tx0 = vs[i]->x;
+        if (vs[i]->x > tx1) tx1 = vs[i]->x;
+        if (vs[i]->y < ty0) ty0 = vs[i]->y;
+        if (vs[i]->y > ty1) ty1 = vs[i]->y;
+    }
+    int32_t bx0 = tx0 >> SUBPIXEL_BITS;
+    int32_t by0 = ty0 >> SUBPIXEL_BITS;
+    int32_t bx1 = (tx1 >> SUBPIXEL_BITS) + 1;
+    int32_t by1 = (ty1 >> SUBPIXEL_BITS) + 1;
+    if (bx0 < m_maskX) bx0 = m_maskX;
+    if (by0 < y0) by0 = y0;
+    if (bx1 > m_maskX + m_maskW) bx1 = m_maskX + m_maskW;
+    if (by1 > y1) by1 = y1;
+    if (bx0 >= bx1 || by0 >= by1) return;
+
+    const int32_t step = SUBPIXEL_ONE;
+
+    for (int32_t tile_y = by0; tile_y < by1; tile_y += TILE_SIZE) {
+        int32_t tile_y1 = (tile_y + TILE_SIZE < by1) ? tile_y + TILE_SIZE : by1;
+        for (int32_t tile_x = bx0; tile_x < bx1; tile_x += TILE_SIZE) {
+            int32_t tile_x1 = (tile_x + TILE_SIZE < bx1) ? tile_x + TILE_SIZE : bx1;
+
+            // Classify the tile using its corners (edge functions are linear)
+            bool outside = false;
+            bool inside = true;
+            for (int e = 0; e < 3 && !outside; e++) {
+                int32_t c00 = evalEdge(edges[e], tile_x * step, tile_y * step);
+                int32_t c10 = evalEdge(edges[e], tile_x1 * step, tile_y * step);
+                int32_t c01 = evalEdge(edges[e], tile_x * step, tile_y1 * step);
+                int32_t c11 = evalEdge(edges[e], tile_x1 * step, tile_y1 * step);
+                int32_t lo = min4(c00, c10, c01, c11);
+                int32_t hi = max4(c00, c10, c01, c11);
+                if (hi < 0) outside = true;
+                if (lo < 0) inside = false;
+            }
+            if (outside) continue;
+
+            if (inside) {
+                for (int32_t y = tile_y; y < tile_y1; y++) {
+                    uint8_t* m = &m_mask[(y - m_maskY) * m_maskW + (tile_x - m_maskX)];
+                    for (int32_t x = tile_x; x < tile_x1; x++) {
+                        *m++ |= sp.fullMask;
+                    }
+                }
+                continue;
+            }
+
+            // Partial tile: test every sample, stepping the edge functions
+            for (int32_t y = tile_y; y < tile_y1; y++) {
+                int32_t w0 = evalEdge(edges[0], tile_x * step, y * step);
+                int32_t w1 = evalEdge(edges[1], tile_x * step, y * step);
+                int32_t w2 = evalEdge(edges[2], tile_x * step, y * step);
+                uint8_t* m = &m_mask[(y - m_maskY) * m_maskW + (tile_x - m_maskX)];
+                for (int32_t x = tile_x; x < tile_x1; x++) {
+                    uint8_t bits = 0;
+                    for (int s = 0; s < sp.count; s++) {
+                        if ((w0 + sample_off[0][s]) >= 0 &&
+                            (w1 + sample_off[1][s]) >= 0 &&
+                            (w2 + sample_off[2][s]) >= 0) {
+                            bits |= static_cast<uint8_t>(1u << s);
+                        }
+                    }
+                    *m++ |= bits;
+                    w0 += edges[0].A * step;
+                    w1 += edges[1].A * step;
+                    w2 += edges[2].A * step;
+                }
+            }
+        }
+    }
+}
+
+void TriangleRasterizer::resolveRows(uint16_t color, int32_t row0, int32_t row1) {
+    const uint8_t full = m_antiAlias ? kRotatedGrid4x.fullMask : kCenterSample.fullMask;
+    const uint32_t samples = m_antiAlias ? 4 : 1;
+    const hal_pixel_format_t format = m_target.format;
+
+    // Solid pixels are stored pre-converted; blended pixels round-trip
+    // through CPU order (only edge pixels pay for the swap)
+    const uint16_t stored = hal_color_to_format(color, format);
+
+    for (int32_t row = row0; row < row1; row++) {
+        int32_t min_x = m_maskX + m_maskW, max_x = m_maskX;
+        const uint8_t* m = &m_mask[row * m_maskW];
+        uint16_t* dst = m_target.pixels + (m_maskY + row) * m_target.stride + m_maskX;
+        int32_t col = 0;
+        while (col < m_maskW) {
+            if (m[col] == 0) {
+                col++;
+                continue;
+            }
+            int32_t span_start = col;
+            while (col < m_maskW && m[col] != 0) {
+                uint8_t bits = m[col];
+                if (bits == full) {
+                    dst[col] = stored;
+                } else {
+                    uint16_t below = hal_color_from_format(dst[col], format);
+                    uint16_t mixed = blend565(color, below, (popcount4(bits) * 32) / samples);
+                    dst[col] = hal_color_to_format(mixed, format);
+                }
+                col++;
+            }
+            if (m_maskX + span_start < min_x) min_x = m_maskX + span_start;
+            if (m_maskX + col > max_x) max_x = m_maskX + col;
+        }
+        m_rowMinX[row] = min_x;
+        m_rowMaxX[row] = max_x;
+    }
+}
+
+void TriangleRasterizer::mergeDirtyRows() {
+    bool any = false;
+    int32_t min_x = m_maskX + m_maskW, max_x = m_maskX;
+    int32_t min_y = m_maskY + m_maskH, max_y = m_maskY;
+    for (int32_t row = 0; row < m_maskH; row++) {
+        if (m_rowMinX[row] >= m_rowMaxX[row]) continue;
+        any = true;
+        if (m_rowMinX[row] < min_x) min_x = m_rowMinX[row];
+        if (m_rowMaxX[row] > max_x) max_x = m_rowMaxX[row];
+        if (m_maskY + row < min_y) min_y = m_maskY + row;
+        max_y = m_maskY + row + 1;
+    }
+
+    if (!any) return;
+    if (m_dirtyMaxX == m_dirtyMinX) {
+        m_dirtyMinX = min_x; m_dirtyMinY = min_y;
+        m_dirtyMaxX = max_x; m_dirtyMaxY = max_y;
+        return;
+    }
+    if (min_x < m_dirtyMinX) m_dirtyMinX = min_x;
+    if (min_y < m_dirtyMinY) m_dirtyMinY = min_y;
+    if (max_x > m_dirtyMaxX) m_dirtyMaxX = max_x;
+    if (max_y > m_dirtyMaxY) m_dirtyMaxY = max_y;
+}
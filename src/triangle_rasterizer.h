@@ -0,0 +1,95 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "../hal/display.h"
+
+/** Vertex in 16.4 fixed-point pixel coordinates (1/16 px precision). */
+struct RasterVertex {
+    int32_t x;
+    int32_t y;
+};
+
+struct RasterTriangle {
+    RasterVertex v[3];
+};
+
+/**
+ * TriangleRasterizer - Fixed-point edge-function rasterizer writing to a surface.
+ *
+ * - Vertices are 16.4 fixed point; edge functions are evaluated in int32.
+ * - Top-left fill rule: triangles sharing an edge never double-cover or leave
+ *   gaps between them.
+ * - The bounding box is walked in TILE_SIZE x TILE_SIZE tiles; tiles fully
+ *   outside an edge are skipped, tiles fully inside all edges are filled
+ *   without per-sample tests.
+ * - Optional 4x coverage anti-aliasing (rotated-grid samples); edge pixels are
+ *   blended with the existing surface color.
+ * - fillMesh() takes all triangles of one color at once, accumulates their
+ *   coverage in a mask and writes the result as horizontal spans. Coverage
+ *   from triangles in the same mesh is unioned, so interior seams never blend.
+ * - The mask is split into row bands across cores (ParallelRows); each band
+ *   rasterizes every triangle clipped to its rows, so the result is the
+ *   same as on one core.
+ *
+ * Vertices must lie within +/- MAX_COORD_PX; triangles outside are dropped.
+ */
+class TriangleRasterizer {
+public:
+    static constexpr int32_t SUBPIXEL_BITS = 4;
+    static constexpr int32_t SUBPIXEL_ONE = 1 << SUBPIXEL_BITS;
+    static constexpr int32_t TILE_SIZE = 8;
+    static constexpr int32_t MAX_COORD_PX = 1000;  // Keeps edge functions within int32
+    static constexpr int32_t PARALLEL_MIN_ROWS = 16;  // Fewer rows per band don't pay for a core
+
+    /** Convert a pixel coordinate to 16.4 fixed point (round to nearest). */
+    static int32_t toFixed(float px);
+
+    explicit TriangleRasterizer(const hal_surface_t& target);
+
+    void setAntiAlias(bool enabled) { m_antiAlias = enabled; }
+    bool getAntiAlias() const { return m_antiAlias; }
+
+    /**
+     * Rasterize a batch of same-colored triangles into the target surface.
+     * @param tris Triangles in 16.4 fixed point (either winding)
+     * @param count Number of triangles
+     * @param color RGB565 fill color (CPU order; converted to the target format once)
+     */
+    void fillMesh(const RasterTriangle* tris, size_t count, uint16_t color);
+
+    /**
+     * Bounding box of every pixel written so far (w/h are 0 if none).
+     * Suitable as the damage rect for hal_display_unlock_surface().
+     */
+    void getDirtyRect(int32_t& x, int32_t& y, int32_t& w, int32_t& h) const;
+
+private:
+    hal_surface_t m_target;
+    bool m_antiAlias;
+
+    // Per-mesh coverage mask (one bit per sample) over the mesh bounding box
+    std::vector<uint8_t> m_mask;
+    int32_t m_maskX, m_maskY, m_maskW, m_maskH;
+
+    // Written span of each mask row (min >= max if none), set per band
+    std::vector<int32_t> m_rowMinX;
+    std::vector<int32_t> m_rowMaxX;
+
+    // Accumulated dirty bounds (inclusive min, exclusive max)
+    int32_t m_dirtyMinX, m_dirtyMinY, m_dirtyMaxX, m_dirtyMaxY;
+
+    struct MeshJob {
+        TriangleRasterizer* rasterizer;
+        const RasterTriangle* tris;
+        size_t count;
+        uint16_t color;
+    };
+    static void rasterizeRows(void* context, int32_t row0, int32_t row1);
+
+    /** Cover the triangle's samples in mask rows [y0, y1) (pixel rows). */
+    void rasterizeTriangle(const RasterTriangle& tri, int32_t y0, int32_t y1);
+    void resolveRows(uint16_t color, int32_t row0, int32_t row1);
+    void mergeDirtyRows();
+};
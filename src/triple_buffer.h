@@ -0,0 +1,64 @@
+/**
+ * @file triple_buffer.h
+ * @brief Wait-free latest-value exchange between two tasks
+ *
+ * See features/sys_render_task.md.
+ */
+
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief Hands the most recent copy of a state struct from a writer to a reader
+ *
+ * For state where only the latest value matters (is a finger down, which
+ * network is connected). The writer fills a private back slot and swaps it
+ * with the shared middle slot; the reader swaps the middle slot with its
+ * front slot when it is newer. Neither side waits or sees a torn value, and
+ * intermediate values the reader never looked at are skipped. One writer
+ * task and one reader task.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    explicit TripleBuffer(const T& initial = T())
+        : m_middle(1), m_back(0), m_front(2) {
+        m_slots[0] = initial;
+        m_slots[1] = initial;
+        m_slots[2] = initial;
+    }
+
+    /** Writer side: publish a new value. */
+    void write(const T& value) {
+        m_slots[m_back] = value;
+        uint8_t old = m_middle.exchange(static_cast<uint8_t>(m_back | FRESH),
+                                        std::memory_order_acq_rel);
+        m_back = old & INDEX_MASK;
+    }
+
+    /**
+     * Reader side: the latest published value. The reference stays valid
+     * until the next read().
+     */
+    const T& read() {
+        if (m_middle.load(std::memory_order_relaxed) & FRESH) {
+            uint8_t old = m_middle.exchange(m_front, std::memory_order_acq_rel);
+            m_front = old & INDEX_MASK;
+        }
+        return m_slots[m_front];
+    }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x03;
+    static constexpr uint8_t FRESH = 0x04;      ///< Middle slot not read yet
+
+    T m_slots[3];
+    std::atomic<uint8_t> m_middle;   ///< Slot index, plus FRESH
+    uint8_t m_back;                  ///< Writer's slot
+    uint8_t m_front;                 ///< Reader's slot
+};
+
+#endif // TRIPLE_BUFFER_H
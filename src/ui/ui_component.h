@@ -14,8 +14,10 @@
 
 #include <stdint.h>
 #include "../input/touch_gesture_engine.h"
+#include "../../hal/display_damage.h"
 
 class UIRenderManager;
+class UILayer;
 
 /**
  * @brief Abstract base class for all renderable/interactive UI elements.
@@ -40,10 +42,83 @@ public:
     virtual void update(float dt) { (void)dt; }
     virtual bool handleInput(const touch_gesture_event_t& event) { return false; }
 
+    /**
+     * Late update: called by UIRenderManager::runFrame() after the frame's
+     * input has been routed, just before rendering. Visuals that follow the
+     * finger (a dragged item, a cursor) settle here on the latest input,
+     * rather than in update(), which runs before it.
+     */
+    virtual void lateUpdate() {}
+
     // Properties for render manager occlusion check
     virtual bool isOpaque() const { return false; }
     virtual bool isFullscreen() const { return false; }
 
+    /**
+     * Offscreen layer this component renders into (layer mode), or nullptr
+     * to draw straight to the display. In layer mode, render() only updates
+     * the layer and invalidates what changed; the manager composes it.
+     */
+    virtual UILayer* getLayer() { return nullptr; }
+
+    /**
+     * Screen rectangle this component draws into, or false (the default)
+     * when it may draw anywhere. Lets the manager skip it once covered.
+     */
+    virtual bool getBounds(hal_rect_t& out) const { (void)out; return false; }
+
+    /**
+     * Screen rectangle this component paints with opaque pixels every time it
+     * renders, or false (the default) for none. Components beneath are
+     * clipped to what the region leaves visible, or skipped entirely. Opaque
+     * full-screen components are treated as covering the whole screen.
+     */
+    virtual bool getOpaqueBounds(hal_rect_t& out) const { (void)out; return false; }
+
+    /**
+     * Frame rate this component wants right now: FPS_ANIMATION during a
+     * slide or fling, a low rate when only data changes, FPS_STATIC when
+     * nothing moves. The loop runs at the fastest rate among the components
+     * that are drawn. The default keeps the classic 30 fps.
+     */
+    virtual uint32_t getTargetFps() const { return FPS_DEFAULT; }
+
+    static constexpr uint32_t FPS_STATIC = 0;
+    static constexpr uint32_t FPS_DEFAULT = 30;
+    static constexpr uint32_t FPS_ANIMATION = 60;
+
+    /**
+     * Rate at which update() needs calling; by default the frame rate the
+     * component asks for. The manager skips update() on frames where the
+     * component is not due and hands it the summed dt when it is. At
+     * FPS_STATIC, update() only runs for a requestWakeAt(), and the frames
+     * in between don't add to its dt.
+     */
+    virtual uint32_t getUpdateFps() const { return getTargetFps(); }
+
+    /**
+     * Ask for an update() at hal_timer_get_micros() time `micros` (on the
+     * first frame from then on), whatever getUpdateFps() says. An idle
+     * render task wakes for it. A new request replaces the last; 0 cancels.
+     */
+    void requestWakeAt(uint64_t micros) { m_wakeMicros = micros; }
+    uint64_t getWakeMicros() const { return m_wakeMicros; }
+
+    /**
+     * During render(): true when opaque components above cover part of this
+     * one, in which case only getRenderClip() (a bounding rectangle of what
+     * remains visible) needs drawing.
+     */
+    bool isRenderClipped() const { return m_clipped; }
+    const hal_rect_t& getRenderClip() const { return m_renderClip; }
+
+    /**
+     * During render(): true when part of this component that was covered (or
+     * skipped) since its last render() is visible again. Components that only
+     * draw on change must repaint the render clip.
+     */
+    bool isExposed() const { return m_exposed; }
+
     bool isVisible() const { return m_visible; }
     void setVisible(bool v) { m_visible = v; }
     bool isPaused() const { return m_paused; }
@@ -54,6 +129,28 @@ protected:
     bool m_paused = false;
     int m_zOrder = 0;
 
+private:
+    bool m_drawnDirect = false;  // Drew to the display last frame (not via a layer)
+
+    // Screen bounds and opaque region this frame, and when it last drew
+    // directly (an empty rectangle means none)
+    hal_rect_t m_bounds = { 0, 0, 0, 0 };
+    hal_rect_t m_cover = { 0, 0, 0, 0 };
+    hal_rect_t m_drawnBounds = { 0, 0, 0, 0 };
+    hal_rect_t m_drawnCover = { 0, 0, 0, 0 };
+
+    // Visibility under the opaque regions of the components above
+    bool m_culled = false;
+    bool m_clipped = false;
+    bool m_exposed = false;
+    hal_rect_t m_renderClip = { 0, 0, 0, 0 };
+    hal_rect_t m_hiddenBounds = { 0, 0, 0, 0 };  // Covered (or not drawn) since last render()
+
+    // Update scheduling: frame time since the last update(), and the wake-up asked for
+    float m_updateDt = 0.0f;
+    bool m_updatedOnce = false;
+    uint64_t m_wakeMicros = 0;
+
     friend class UIRenderManager;
 };
 
@@ -0,0 +1,176 @@
+/**
+ * @file ui_layer.cpp
+ * @brief UILayer implementation
+ *
+ * Specification: features/core_ui_render_manager.md (§3.4 Layer Mode)
+ */
+
+#include "ui_layer.h"
+#include "../../hal/display_format.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif
+
+// Alpha blend of two CPU-order RGB565 pixels, alpha in 0..32. The green
+// channel is moved to the upper half-word so all three channels scale in one
+// multiply without carrying into each other.
+static inline uint16_t blend565(uint16_t fg, uint16_t bg, uint32_t alpha) {
+    uint32_t f = (fg | (static_cast<uint32_t>(fg) << 16)) & 0x07E0F81Fu;
+    uint32_t b = (bg | (static_cast<uint32_t>(bg) << 16)) & 0x07E0F81Fu;
+    uint32_t r = ((f * alpha + b * (32 - alpha)) >> 5) & 0x07E0F81Fu;
+    return static_cast<uint16_t>(r | (r >> 16));
+}
+
+UILayer::UILayer()
+    : m_surface{ nullptr, 0, 0, 0, HAL_PIXEL_FORMAT_RGB565 }
+    , m_owned(false)
+    , m_x(0)
+    , m_y(0)
+    , m_opacity(255)
+    , m_blend(BlendMode::NORMAL)
+    , m_keyColor(0)
+    , m_keyNative(0)
+    , m_presented(false)
+    , m_presentedBounds{ 0, 0, 0, 0 }
+    , m_presentedOpacity(255)
+    , m_presentedBlend(BlendMode::NORMAL)
+    , m_presentedKey(0)
+{
+    hal_damage_reset(&m_damage);
+}
+
+UILayer::~UILayer() {
+    release();
+}
+
+bool UILayer::init(int32_t x, int32_t y, int32_t width, int32_t height,
+                   hal_pixel_format_t format) {
+    release();
+    if (width <= 0 || height <= 0) return false;
+
+    size_t size = static_cast<size_t>(width) * static_cast<size_t>(height) * sizeof(uint16_t);
+    uint16_t* pixels = static_cast<uint16_t*>(
+#ifdef BOARD_HAS_PSRAM
+        ps_malloc(size)
+#else
+        malloc(size)
+#endif
+    );
+    if (pixels == nullptr) return false;
+
+    m_surface = { pixels, width, height, width, format };
+    m_owned = true;
+    m_x = x;
+    m_y = y;
+    m_keyNative = hal_color_to_format(m_keyColor, format);
+    invalidate();
+    return true;
+}
+
+void UILayer::attach(const hal_surface_t& surface, int32_t x, int32_t y) {
+    bool same = !m_owned && surface.pixels == m_surface.pixels &&
+                surface.width == m_surface.width && surface.height == m_surface.height &&
+                surface.stride == m_surface.stride && surface.format == m_surface.format;
+    if (!same) {
+        release();
+        m_surface = surface;
+        m_keyNative = hal_color_to_format(m_keyColor, surface.format);
+        invalidate();
+    }
+    setPosition(x, y);
+}
+
+void UILayer::release() {
+    if (m_owned) {
+        free(m_surface.pixels);
+    }
+    m_surface.pixels = nullptr;
+    m_surface.width = 0;
+    m_surface.height = 0;
+    m_surface.stride = 0;
+    m_owned = false;
+    hal_damage_reset(&m_damage);
+}
+
+hal_rect_t UILayer::getBounds() const {
+    hal_rect_t r = { m_x, m_y, m_surface.width, m_surface.height };
+    return r;
+}
+
+void UILayer::setPosition(int32_t x, int32_t y) {
+    m_x = x;
+    m_y = y;
+}
+
+void UILayer::setOpacity(uint8_t opacity) {
+    m_opacity = opacity;
+}
+
+void UILayer::setBlendMode(BlendMode mode, uint16_t key_color) {
+    m_blend = mode;
+    m_keyColor = key_color;
+    m_keyNative = hal_color_to_format(key_color, m_surface.format);
+}
+
+void UILayer::fill(uint16_t color) {
+    if (!isValid()) return;
+    uint16_t native = hal_color_to_format(color, m_surface.format);
+    for (int32_t row = 0; row < m_surface.height; row++) {
+        uint16_t* p = m_surface.pixels + row * m_surface.stride;
+        for (int32_t col = 0; col < m_surface.width; col++) {
+            p[col] = native;
+        }
+    }
+    invalidate();
+}
+
+void UILayer::invalidate() {
+    hal_damage_reset(&m_damage);
+    hal_damage_add(&m_damage, 0, 0, m_surface.width, m_surface.height);
+}
+
+void UILayer::invalidate(int32_t x, int32_t y, int32_t w, int32_t h) {
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > m_surface.width) { w = m_surface.width - x; }
+    if (y + h > m_surface.height) { h = m_surface.height - y; }
+    hal_damage_add(&m_damage, x, y, w, h);
+}
+
+void UILayer::blendSpan(uint16_t* dst, hal_pixel_format_t dst_format,
+                        int32_t lx, int32_t ly, int32_t count) const {
+    if (m_opacity == 0 || count <= 0) return;
+    const uint16_t* src = m_surface.pixels + ly * m_surface.stride + lx;
+    const hal_pixel_format_t src_format = m_surface.format;
+    const bool keyed = m_blend == BlendMode::KEYED;
+
+    if (m_opacity == 255) {
+        if (!keyed) {
+            hal_pixels_convert(dst, src, count, src_format, dst_format);
+            return;
+        }
+        // Copy the runs between key pixels; comparisons use the key in the
+        // surface's own byte order
+        int32_t i = 0;
+        while (i < count) {
+            while (i < count && src[i] == m_keyNative) i++;
+            int32_t start = i;
+            while (i < count && src[i] != m_keyNative) i++;
+            if (i > start) {
+                hal_pixels_convert(dst + start, src + start, i - start, src_format, dst_format);
+            }
+        }
+        return;
+    }
+
+    const uint32_t alpha = (static_cast<uint32_t>(m_opacity) + 4) >> 3;
+    for (int32_t i = 0; i < count; i++) {
+        if (keyed && src[i] == m_keyNative) continue;
+        uint16_t fg = hal_color_from_format(src[i], src_format);
+        uint16_t bg = hal_color_from_format(dst[i], dst_format);
+        dst[i] = hal_color_to_format(blend565(fg, bg, alpha), dst_format);
+    }
+}
@@ -0,0 +1,131 @@
+/**
+ * @file ui_layer.h
+ * @brief Cached offscreen surface a UIComponent renders into (layer mode)
+ *
+ * A component in layer mode draws into its UILayer instead of the display,
+ * and invalidates the parts it changed. The UIRenderManager composes the
+ * changed regions of all layers, bottom to top, one span at a time, and
+ * presents the result. An overlay can then change (or fade, or move)
+ * without the component beneath it rendering again.
+ *
+ * Specification: features/core_ui_render_manager.md (§3.4 Layer Mode)
+ */
+
+#ifndef UI_LAYER_H
+#define UI_LAYER_H
+
+#include <stdint.h>
+#include "../../hal/display.h"
+#include "../../hal/display_damage.h"
+
+class UILayer {
+public:
+    /**
+     * How layer pixels combine with what lies beneath them. Both modes are
+     * scaled by the layer opacity.
+     */
+    enum class BlendMode : uint8_t {
+        NORMAL,  ///< Every pixel covers the pixels below
+        KEYED    ///< Pixels equal to the key color are transparent
+    };
+
+    UILayer();
+    ~UILayer();
+
+    UILayer(const UILayer&) = delete;
+    UILayer& operator=(const UILayer&) = delete;
+
+    /**
+     * Allocate an owned surface (PSRAM when available) at a screen position.
+     * Pixels are stored in the given format (the panel's by default) and are
+     * left uninitialized; the whole layer starts invalidated.
+     *
+     * @return true on success
+     */
+    bool init(int32_t x, int32_t y, int32_t width, int32_t height,
+              hal_pixel_format_t format = hal_display_get_native_format());
+
+    /**
+     * Use memory owned by someone else (e.g. a graph's composite buffer) as
+     * the layer surface. The memory must outlive the layer or the next
+     * attach()/release(). Re-attaching the same pixels keeps the layer's
+     * invalidation state; anything else invalidates the whole layer.
+     */
+    void attach(const hal_surface_t& surface, int32_t x, int32_t y);
+
+    /** Free (or detach) the surface. */
+    void release();
+
+    bool isValid() const { return m_surface.pixels != nullptr; }
+
+    /** Surface to draw into (layer-local coordinates, getFormat() order). */
+    const hal_surface_t& getSurface() const { return m_surface; }
+    hal_pixel_format_t getFormat() const { return m_surface.format; }
+
+    /** Screen rectangle covered by the layer. */
+    hal_rect_t getBounds() const;
+
+    void setPosition(int32_t x, int32_t y);
+
+    /** 0 = invisible, 255 = fully opaque. */
+    void setOpacity(uint8_t opacity);
+    uint8_t getOpacity() const { return m_opacity; }
+
+    /**
+     * @param mode Blend mode
+     * @param key_color CPU-order RGB565 key for BlendMode::KEYED
+     */
+    void setBlendMode(BlendMode mode, uint16_t key_color = 0);
+    BlendMode getBlendMode() const { return m_blend; }
+    uint16_t getKeyColor() const { return m_keyColor; }
+
+    /** True when every pixel fully covers whatever lies below. */
+    bool isOpaque() const { return m_blend == BlendMode::NORMAL && m_opacity == 255; }
+
+    /** Fill the whole layer with a CPU-order RGB565 color and invalidate it. */
+    void fill(uint16_t color);
+
+    /** Mark the whole layer as changed. */
+    void invalidate();
+
+    /** Mark a layer-local rectangle as changed (clipped to the layer). */
+    void invalidate(int32_t x, int32_t y, int32_t w, int32_t h);
+
+    /** Changed layer-local regions since the manager last composed the layer. */
+    const hal_damage_t& getDamage() const { return m_damage; }
+
+    /**
+     * Blend one span of the layer over a destination row.
+     *
+     * @param dst First destination pixel
+     * @param dst_format Pixel format of dst
+     * @param lx Layer-local X of the first pixel
+     * @param ly Layer-local row
+     * @param count Number of pixels (must lie within the layer)
+     */
+    void blendSpan(uint16_t* dst, hal_pixel_format_t dst_format,
+                   int32_t lx, int32_t ly, int32_t count) const;
+
+private:
+    hal_surface_t m_surface;
+    bool m_owned;
+    int32_t m_x;
+    int32_t m_y;
+    uint8_t m_opacity;
+    BlendMode m_blend;
+    uint16_t m_keyColor;     // CPU order
+    uint16_t m_keyNative;    // Same key in m_surface.format
+    hal_damage_t m_damage;
+
+    // What the manager last composed, to damage old + new bounds when the
+    // layer moves, fades, or disappears
+    bool m_presented;
+    hal_rect_t m_presentedBounds;
+    uint8_t m_presentedOpacity;
+    BlendMode m_presentedBlend;
+    uint16_t m_presentedKey;
+
+    friend class UIRenderManager;
+};
+
+#endif // UI_LAYER_H
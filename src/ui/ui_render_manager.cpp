@@ -2,14 +2,19 @@
  * @file ui_render_manager.cpp
  * @brief UIRenderManager implementation
  *
- * Implements the Painter's Algorithm render loop with occlusion optimization,
- * activation-event routing, and SystemComponent pause/resume lifecycle.
+ * Implements the Painter's Algorithm render loop with occlusion optimization
+ * and rectangle-level culling, span-level layer composition, activation-event routing, and
+ * SystemComponent pause/resume lifecycle.
  *
  * Specification: features/core_ui_render_manager.md
  * Architecture:  docs/ARCHITECTURE.md §H
  */
 
 #include "ui_render_manager.h"
+#include "../parallel_rows.h"
+#include "../../hal/display_format.h"
+#include "../../hal/timer.h"
+#include <stdlib.h>
 
 // ---------------------------------------------------------------------------
 // SystemComponent::systemPause — defined here to break circular header dep
@@ -92,36 +97,513 @@ void UIRenderManager::setActiveApp(AppComponent* app) {
     }
 }
 
+// ---------------------------------------------------------------------------
+// Internal: rectangle helpers (an empty rectangle has w <= 0 or h <= 0)
+// ---------------------------------------------------------------------------
+static hal_rect_t screenRect() {
+    hal_rect_t r = { 0, 0, hal_display_get_width_pixels(), hal_display_get_height_pixels() };
+    return r;
+}
+
+static bool isEmptyRect(const hal_rect_t& r) {
+    return r.w <= 0 || r.h <= 0;
+}
+
+static bool sameRect(const hal_rect_t& a, const hal_rect_t& b) {
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+static hal_rect_t intersectRect(const hal_rect_t& a, const hal_rect_t& b) {
+    int32_t x0 = (a.x > b.x) ? a.x : b.x;
+    int32_t y0 = (a.y > b.y) ? a.y : b.y;
+    int32_t x1 = (a.x + a.w < b.x + b.w) ? a.x + a.w : b.x + b.w;
+    int32_t y1 = (a.y + a.h < b.y + b.h) ? a.y + a.h : b.y + b.h;
+    hal_rect_t r = { x0, y0, x1 - x0, y1 - y0 };
+    if (isEmptyRect(r)) {
+        r = { 0, 0, 0, 0 };
+    }
+    return r;
+}
+
+static hal_rect_t unionRect(const hal_rect_t& a, const hal_rect_t& b) {
+    if (isEmptyRect(a)) return b;
+    if (isEmptyRect(b)) return a;
+    int32_t x0 = (a.x < b.x) ? a.x : b.x;
+    int32_t y0 = (a.y < b.y) ? a.y : b.y;
+    int32_t x1 = (a.x + a.w > b.x + b.w) ? a.x + a.w : b.x + b.w;
+    int32_t y1 = (a.y + a.h > b.y + b.h) ? a.y + a.h : b.y + b.h;
+    hal_rect_t r = { x0, y0, x1 - x0, y1 - y0 };
+    return r;
+}
+
+// Disjoint rectangles of a screen area left uncovered
+static constexpr int32_t REGION_MAX_RECTS = 16;
+
+struct VisibleRegion {
+    hal_rect_t rects[REGION_MAX_RECTS];
+    int32_t count;
+};
+
+static void initRegion(VisibleRegion& region, const hal_rect_t& r) {
+    region.count = 0;
+    if (!isEmptyRect(r)) {
+        region.rects[region.count++] = r;
+    }
+}
+
+// Remove each cover rectangle from the region; a rectangle splits into at
+// most four pieces (above, below, left, right of the cut). If the pieces no
+// longer fit, the remaining covers are ignored: the region may come out
+// larger than the truth, never smaller.
+static void subtractCover(VisibleRegion& region, const hal_rect_t* cover, int count) {
+    for (int c = 0; c < count && region.count > 0; c++) {
+        VisibleRegion next;
+        next.count = 0;
+        for (int32_t i = 0; i < region.count; i++) {
+            const hal_rect_t& r = region.rects[i];
+            hal_rect_t cut = intersectRect(r, cover[c]);
+            hal_rect_t pieces[4];
+            int n = 0;
+            if (isEmptyRect(cut)) {
+                pieces[n++] = r;
+            } else {
+                if (cut.y > r.y) {
+                    pieces[n++] = { r.x, r.y, r.w, cut.y - r.y };
+                }
+                if (cut.y + cut.h < r.y + r.h) {
+                    pieces[n++] = { r.x, cut.y + cut.h, r.w, r.y + r.h - (cut.y + cut.h) };
+                }
+                if (cut.x > r.x) {
+                    pieces[n++] = { r.x, cut.y, cut.x - r.x, cut.h };
+                }
+                if (cut.x + cut.w < r.x + r.w) {
+                    pieces[n++] = { cut.x + cut.w, cut.y, r.x + r.w - (cut.x + cut.w), cut.h };
+                }
+            }
+            if (next.count + n > REGION_MAX_RECTS) {
+                return;
+            }
+            for (int k = 0; k < n; k++) {
+                next.rects[next.count++] = pieces[k];
+            }
+        }
+        region = next;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Internal: add a screen rectangle to a damage set, clipped to the display
+// ---------------------------------------------------------------------------
+static void addScreenDamage(hal_damage_t& damage, hal_rect_t r) {
+    r = intersectRect(r, screenRect());
+    hal_damage_add(&damage, r.x, r.y, r.w, r.h);
+}
+
 // ---------------------------------------------------------------------------
 // Render Loop — Painter's Algorithm with Occlusion
 // ---------------------------------------------------------------------------
 void UIRenderManager::renderAll() {
     int floor = findOcclusionFloor();
 
-    for (int i = floor; i < m_componentCount; i++) {
+    // Opaque regions of direct-drawing components; these draw over every
+    // layer, so no layer is composed beneath them
+    hal_rect_t directCover[MAX_COMPONENTS];
+    int directCount = computeVisibility(floor, directCover);
+
+    // Layer pass: components in layer mode refresh their layers, and every
+    // region whose composed result may differ is collected
+    hal_damage_t damage;
+    hal_damage_reset(&damage);
+    hal_damage_t exposed;
+    hal_damage_reset(&exposed);
+
+    for (int i = 0; i < m_componentCount; i++) {
         UIComponent* comp = m_components[i];
-        if (comp->isVisible() && !comp->isPaused()) {
+        bool active = i >= floor && comp->isVisible() && !comp->isPaused() && !comp->m_culled;
+        UILayer* layer = comp->getLayer();
+        if (layer == nullptr) {
+            // A direct-drawing component that stops drawing somewhere leaves
+            // its pixels on screen; the layers beneath must be composed again
+            if (comp->m_drawnDirect) {
+                if (!active || !sameRect(comp->m_bounds, comp->m_drawnBounds)) {
+                    addScreenDamage(exposed, comp->m_drawnBounds);
+                } else if (!sameRect(comp->m_cover, comp->m_drawnCover)) {
+                    addScreenDamage(exposed, comp->m_drawnCover);
+                }
+            }
+            continue;
+        }
+        if (active) {
+            comp->render();
+        }
+        collectLayerDamage(layer, active, damage);
+    }
+
+    for (int32_t e = 0; e < exposed.count; e++) {
+        for (int i = floor; i < m_componentCount; i++) {
+            UILayer* layer = m_components[i]->getLayer();
+            if (layer != nullptr && layer->m_presented) {
+                addScreenDamage(damage, intersectRect(exposed.rects[e], layer->m_presentedBounds));
+            }
+        }
+    }
+
+    if (damage.count > 0) {
+        composeLayers(floor, damage, directCover, directCount);
+    }
+
+    // Direct pass: everything else draws on top, in Z-Order
+    for (int i = 0; i < m_componentCount; i++) {
+        UIComponent* comp = m_components[i];
+        if (comp->getLayer() != nullptr) {
+            comp->m_drawnDirect = false;
+            continue;
+        }
+        bool active = i >= floor && comp->isVisible() && !comp->isPaused() && !comp->m_culled;
+        if (active) {
             comp->render();
+            comp->m_drawnBounds = comp->m_bounds;
+            comp->m_drawnCover = comp->m_cover;
         }
+        comp->m_drawnDirect = active;
     }
 
+    m_lastDrawnMicros = hal_timer_get_micros();
     if (m_flushCallback) {
         m_flushCallback();
     }
 }
 
+// ---------------------------------------------------------------------------
+// Occlusion Culling
+// ---------------------------------------------------------------------------
+int UIRenderManager::computeVisibility(int floor, hal_rect_t* directCover) {
+    // Walk from the top down, accumulating the opaque regions painted so far.
+    // A direct-drawing component can only be hidden by direct-drawing ones
+    // above it (layers are composed before any of them draw); a layer can be
+    // hidden by anything above it.
+    const hal_rect_t screen = screenRect();
+    hal_rect_t cover[MAX_COMPONENTS];
+    int coverCount = 0;
+    int directCount = 0;
+
+    for (int i = m_componentCount - 1; i >= 0; i--) {
+        UIComponent* comp = m_components[i];
+        UILayer* layer = comp->getLayer();
+        comp->m_culled = false;
+        comp->m_clipped = false;
+        comp->m_exposed = false;
+        comp->m_cover = { 0, 0, 0, 0 };
+
+        hal_rect_t bounds = screen;
+        if (layer != nullptr) {
+            if (layer->isValid()) {
+                bounds = layer->getBounds();
+            }
+        } else if (!comp->getBounds(bounds)) {
+            bounds = screen;
+        }
+        bounds = intersectRect(bounds, screen);
+        comp->m_bounds = bounds;
+
+        if (i < floor || !comp->isVisible() || comp->isPaused()) {
+            // Anything it drew may be painted over before it returns
+            comp->m_hiddenBounds = bounds;
+            continue;
+        }
+
+        const hal_rect_t* above = (layer != nullptr) ? cover : directCover;
+        int aboveCount = (layer != nullptr) ? coverCount : directCount;
+
+        VisibleRegion visible;
+        initRegion(visible, bounds);
+        subtractCover(visible, above, aboveCount);
+
+        if (visible.count == 0) {
+            comp->m_culled = true;
+            comp->m_hiddenBounds = bounds;
+            continue;
+        }
+
+        hal_rect_t clip = { 0, 0, 0, 0 };
+        for (int32_t k = 0; k < visible.count; k++) {
+            clip = unionRect(clip, visible.rects[k]);
+            if (!comp->m_exposed &&
+                !isEmptyRect(intersectRect(visible.rects[k], comp->m_hiddenBounds))) {
+                comp->m_exposed = true;
+            }
+        }
+        comp->m_clipped = visible.count != 1 || !sameRect(clip, bounds);
+        comp->m_renderClip = clip;
+
+        hal_rect_t hidden = { 0, 0, 0, 0 };
+        for (int c = 0; c < aboveCount; c++) {
+            hidden = unionRect(hidden, intersectRect(bounds, above[c]));
+        }
+        comp->m_hiddenBounds = hidden;
+
+        // Opaque region this component adds for the ones below
+        hal_rect_t opaque = { 0, 0, 0, 0 };
+        if (layer != nullptr) {
+            if (layer->isValid() && layer->isOpaque()) {
+                opaque = bounds;
+            }
+        } else if (comp->getOpaqueBounds(opaque)) {
+            opaque = intersectRect(opaque, screen);
+        } else if (comp->isOpaque() && comp->isFullscreen()) {
+            opaque = screen;
+        }
+        if (!isEmptyRect(opaque)) {
+            comp->m_cover = opaque;
+            cover[coverCount++] = opaque;
+            if (layer == nullptr) {
+                directCover[directCount++] = opaque;
+            }
+        }
+    }
+    return directCount;
+}
+
+// ---------------------------------------------------------------------------
+// Layer Composition
+// ---------------------------------------------------------------------------
+void UIRenderManager::collectLayerDamage(UILayer* layer, bool active, hal_damage_t& damage) {
+    bool shown = active && layer->isValid() && layer->getOpacity() > 0;
+    if (!shown) {
+        // Uncover whatever the layer was hiding; its content is composed in
+        // full if it comes back
+        if (layer->m_presented) {
+            addScreenDamage(damage, layer->m_presentedBounds);
+            layer->m_presented = false;
+        }
+        hal_damage_reset(&layer->m_damage);
+        return;
+    }
+
+    hal_rect_t bounds = layer->getBounds();
+    const hal_rect_t& last = layer->m_presentedBounds;
+    bool moved = bounds.x != last.x || bounds.y != last.y ||
+                 bounds.w != last.w || bounds.h != last.h;
+    bool restyled = layer->getOpacity() != layer->m_presentedOpacity ||
+                    layer->getBlendMode() != layer->m_presentedBlend ||
+                    layer->getKeyColor() != layer->m_presentedKey;
+
+    if (!layer->m_presented || moved || restyled) {
+        if (layer->m_presented) {
+            addScreenDamage(damage, last);
+        }
+        addScreenDamage(damage, bounds);
+    } else {
+        const hal_damage_t& changed = layer->getDamage();
+        for (int32_t i = 0; i < changed.count; i++) {
+            hal_rect_t r = changed.rects[i];
+            r.x += bounds.x;
+            r.y += bounds.y;
+            addScreenDamage(damage, r);
+        }
+    }
+    hal_damage_reset(&layer->m_damage);
+
+    layer->m_presented = true;
+    layer->m_presentedBounds = bounds;
+    layer->m_presentedOpacity = layer->getOpacity();
+    layer->m_presentedBlend = layer->getBlendMode();
+    layer->m_presentedKey = layer->getKeyColor();
+}
+
+void UIRenderManager::composeLayers(int floor, const hal_damage_t& damage,
+                                    const hal_rect_t* cover, int coverCount) {
+    if (m_componentCount == 0 || m_presentCallback == nullptr) {
+        return;
+    }
+
+    UILayer* layers[MAX_COMPONENTS];
+    int count = 0;
+    for (int i = floor; i < m_componentCount; i++) {
+        UILayer* layer = m_components[i]->getLayer();
+        if (layer != nullptr && layer->m_presented) {
+            layers[count++] = layer;
+        }
+    }
+
+    // Skip whatever a direct-drawing component will paint over anyway
+    const hal_pixel_format_t format = hal_display_get_native_format();
+    for (int32_t d = 0; d < damage.count; d++) {
+        VisibleRegion visible;
+        initRegion(visible, damage.rects[d]);
+        subtractCover(visible, cover, coverCount);
+        for (int32_t k = 0; k < visible.count; k++) {
+            composeRect(layers, count, visible.rects[k], format);
+        }
+    }
+}
+
+void UIRenderManager::composeRect(UILayer* const* layers, int count, const hal_rect_t& r,
+                                  hal_pixel_format_t format) {
+    // Compose a band of rows at a time so each present covers many rows
+    int32_t band_rows = COMPOSE_BAND_PIXELS / r.w;
+    if (band_rows < 1) band_rows = 1;
+    if (band_rows > r.h) band_rows = r.h;
+
+    int32_t needed = r.w * band_rows;
+    if (needed > m_composeCapacity) {
+        free(m_composeBuffer);
+        m_composeBuffer = static_cast<uint16_t*>(malloc(needed * sizeof(uint16_t)));
+        m_composeCapacity = (m_composeBuffer != nullptr) ? needed : 0;
+        if (m_composeBuffer == nullptr) {
+            return;
+        }
+    }
+
+    // Rows are independent: each is composed from the read-only layers
+    int32_t min_rows = (PARALLEL_MIN_PIXELS + r.w - 1) / r.w;
+    ComposeJob job = { this, layers, count, r.x, r.y, r.w, format };
+
+    for (int32_t y = r.y; y < r.y + r.h; y += band_rows) {
+        int32_t rows = (r.y + r.h - y < band_rows) ? r.y + r.h - y : band_rows;
+        job.y = y;
+        ParallelRows::getInstance().run(0, rows, composeRows, &job, min_rows);
+        hal_surface_t band = { m_composeBuffer, r.w, rows, r.w, format };
+        m_presentCallback(static_cast<int16_t>(r.x), static_cast<int16_t>(y), &band);
+    }
+}
+
+void UIRenderManager::composeRows(void* context, int32_t row0, int32_t row1) {
+    const ComposeJob& job = *static_cast<const ComposeJob*>(context);
+    const UIRenderManager* mgr = job.manager;
+    for (int32_t row = row0; row < row1; row++) {
+        mgr->composeRow(job.layers, job.count, job.y + row, job.x, job.w,
+                        &mgr->m_composeBuffer[row * job.w], job.format);
+    }
+}
+
+void UIRenderManager::composeRow(UILayer* const* layers, int count, int32_t y,
+                                 int32_t x, int32_t w, uint16_t* out,
+                                 hal_pixel_format_t format) const {
+    // Start from the topmost layer that opaquely covers the whole span;
+    // everything beneath it would be overwritten anyway
+    int start = -1;
+    for (int k = count - 1; k >= 0; k--) {
+        hal_rect_t b = layers[k]->getBounds();
+        if (layers[k]->isOpaque() && y >= b.y && y < b.y + b.h &&
+            x >= b.x && x + w <= b.x + b.w) {
+            start = k;
+            break;
+        }
+    }
+    if (start < 0) {
+        uint16_t backdrop = hal_color_to_format(m_layerBackdrop, format);
+        for (int32_t i = 0; i < w; i++) {
+            out[i] = backdrop;
+        }
+        start = 0;
+    }
+
+    for (int k = start; k < count; k++) {
+        hal_rect_t b = layers[k]->getBounds();
+        if (y < b.y || y >= b.y + b.h) continue;
+        int32_t x0 = (x > b.x) ? x : b.x;
+        int32_t x1 = (x + w < b.x + b.w) ? x + w : b.x + b.w;
+        if (x1 <= x0) continue;
+        layers[k]->blendSpan(&out[x0 - x], format, x0 - b.x, y - b.y, x1 - x0);
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Update Loop
 // ---------------------------------------------------------------------------
+bool UIRenderManager::isUpdateDue(UIComponent* comp, uint64_t now) {
+    if (!comp->m_updatedOnce) return true;
+    if (comp->m_wakeMicros != 0 && now >= comp->m_wakeMicros) {
+        comp->m_wakeMicros = 0;
+        return true;
+    }
+    uint32_t fps = comp->getUpdateFps();
+    if (fps == UIComponent::FPS_STATIC) return false;
+
+    // Due from 3/4 of its period on, so a loop running at the component's
+    // own rate never skips it for a frame that came a little early
+    return comp->m_updateDt * static_cast<float>(fps) >= 0.75f;
+}
+
 void UIRenderManager::updateAll(float dt) {
+    uint64_t now = hal_timer_get_micros();
+    for (int i = 0; i < m_componentCount; i++) {
+        UIComponent* comp = m_components[i];
+        if (!comp->isVisible() || comp->isPaused()) continue;
+
+        comp->m_updateDt += dt;
+        if (isUpdateDue(comp, now)) {
+            float elapsed = comp->m_updateDt;
+            comp->m_updateDt = 0.0f;
+            comp->m_updatedOnce = true;
+            comp->update(elapsed);
+        } else if (comp->getUpdateFps() == UIComponent::FPS_STATIC) {
+            // Static time is not animation time: when the component animates
+            // again (or wakes), it gets one frame's dt, not the whole pause
+            comp->m_updateDt = 0.0f;
+        }
+    }
+}
+
+uint64_t UIRenderManager::getNextWakeMicros() const {
+    uint64_t next = 0;
+    for (int i = 0; i < m_componentCount; i++) {
+        const UIComponent* comp = m_components[i];
+        if (!comp->isVisible() || comp->isPaused() || comp->m_wakeMicros == 0) continue;
+        if (next == 0 || comp->m_wakeMicros < next) next = comp->m_wakeMicros;
+    }
+    return next;
+}
+
+void UIRenderManager::lateUpdateAll() {
     for (int i = 0; i < m_componentCount; i++) {
         UIComponent* comp = m_components[i];
         if (comp->isVisible() && !comp->isPaused()) {
-            comp->update(dt);
+            comp->lateUpdate();
         }
     }
 }
 
+void UIRenderManager::runFrame(float dt, InputDrain drain, void* context) {
+    // Animations first: what they change is drawn this frame, not the next
+    updateAll(dt);
+
+    // Input as late as possible, then whatever follows it directly
+    if (drain) {
+        drain(context);
+    }
+    lateUpdateAll();
+
+    renderAll();
+}
+
+uint32_t UIRenderManager::getTargetFps() const {
+    uint32_t fps = UIComponent::FPS_STATIC;
+    int floor = findOcclusionFloor();
+    for (int i = floor; i < m_componentCount; i++) {
+        const UIComponent* comp = m_components[i];
+        if (!comp->isVisible() || comp->isPaused() || comp->m_culled) continue;
+        uint32_t wanted = comp->getTargetFps();
+        if (wanted > fps) fps = wanted;
+    }
+    return fps;
+}
+
+bool UIRenderManager::isIdle() {
+    if (getTargetFps() != UIComponent::FPS_STATIC) return false;
+
+    // Layers changed outside render() (e.g. in update()) still need composing
+    for (int i = 0; i < m_componentCount; i++) {
+        UIComponent* comp = m_components[i];
+        if (!comp->isVisible() || comp->isPaused()) continue;
+        UILayer* layer = comp->getLayer();
+        if (layer == nullptr) continue;
+        if (!layer->m_presented || layer->getDamage().count > 0) return false;
+    }
+    return true;
+}
+
 // ---------------------------------------------------------------------------
 // Event Routing
 // ---------------------------------------------------------------------------
@@ -212,11 +694,14 @@ void UIRenderManager::sortByZOrder() {
 // ---------------------------------------------------------------------------
 int UIRenderManager::findOcclusionFloor() const {
     // Walk from highest Z downward; the first visible, opaque, fullscreen
-    // component occludes everything below it.
+    // component occludes everything below it. In layer mode the layer must be
+    // opaque too (a faded or keyed layer lets the components below show).
     for (int i = m_componentCount - 1; i >= 0; i--) {
         UIComponent* comp = m_components[i];
+        UILayer* layer = comp->getLayer();
         if (comp->isVisible() && !comp->isPaused() &&
-            comp->isOpaque() && comp->isFullscreen()) {
+            comp->isOpaque() && comp->isFullscreen() &&
+            (layer == nullptr || (layer->isValid() && layer->isOpaque()))) {
             return i;
         }
     }
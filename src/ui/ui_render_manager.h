@@ -13,6 +13,7 @@
 #define UI_RENDER_MANAGER_H
 
 #include "ui_component.h"
+#include "ui_layer.h"
 
 class UIRenderManager {
 public:
@@ -33,12 +34,75 @@ public:
     using FlushCallback = void(*)();
     void setFlushCallback(FlushCallback fn) { m_flushCallback = fn; }
 
-    /** Render all visible, non-paused components in ascending Z-Order (Painter's Algorithm). */
+    /**
+     * Set a callback that receives composed layer pixels (default:
+     * hal_display_blit_surface). Bands arrive in the panel's native format.
+     */
+    using PresentCallback = void(*)(int16_t x, int16_t y, const hal_surface_t* surface);
+    void setPresentCallback(PresentCallback fn) { m_presentCallback = fn; }
+
+    /** Color shown where no layer covers a composed region (CPU-order RGB565). */
+    void setLayerBackdrop(uint16_t color) { m_layerBackdrop = color; }
+
+    /**
+     * Render all visible, non-paused components in ascending Z-Order (Painter's Algorithm).
+     * Components in layer mode update their layers first and the changed regions are
+     * composed; direct-drawing components then render on top, in Z-Order. Components
+     * hidden by the opaque regions of those above are skipped, and partly hidden ones
+     * are given a render clip.
+     */
     void renderAll();
 
-    /** Update all visible, non-paused components with the frame delta time. */
+    /**
+     * hal_timer_get_micros() time at which the last renderAll() finished
+     * drawing and composing, just before the flush callback.
+     */
+    uint64_t getLastDrawnMicros() const { return m_lastDrawnMicros; }
+
+    /**
+     * Update the visible, non-paused components that are due: at their
+     * getUpdateFps() rate, or for a wake-up they asked for, or for the first
+     * time. Each gets the frame time summed since its last update(), not
+     * counting frames it spent at FPS_STATIC.
+     */
     void updateAll(float dt);
 
+    /**
+     * Earliest wake-up requested by a visible, non-paused component
+     * (UIComponent::requestWakeAt()), or 0 for none.
+     */
+    uint64_t getNextWakeMicros() const;
+
+    /** Call lateUpdate() on all visible, non-paused components. */
+    void lateUpdateAll();
+
+    /** Routes the input that arrived for this frame (see runFrame()). */
+    using InputDrain = void(*)(void* context);
+
+    /**
+     * One frame, in stages: update → input drain → late update → render
+     * (layout: bounds and occlusion, then drawing and composition) →
+     * present (flush). Animations are advanced to this frame before it is
+     * drawn, and input is drained as late as possible, so both are current
+     * on screen.
+     * @param drain Routes the pending input through routeInput(); may be null
+     */
+    void runFrame(float dt, InputDrain drain = nullptr, void* context = nullptr);
+
+    /**
+     * Fastest getTargetFps() among the components that are drawn (visible,
+     * not paused, not hidden by opaque components above as of the last
+     * renderAll()), or UIComponent::FPS_STATIC when there are none.
+     */
+    uint32_t getTargetFps() const;
+
+    /**
+     * True when nothing on screen will change by itself: every drawn
+     * component requests FPS_STATIC and no layer has damage waiting to be
+     * composed. The loop can then sleep until input or data arrives.
+     */
+    bool isIdle();
+
     /** Route a touch event: first checks activation events, then dispatches highest-Z first. */
     void routeInput(const touch_gesture_event_t& event);
 
@@ -53,6 +117,12 @@ public:
 
     static constexpr int MAX_COMPONENTS = 16;
 
+    /** Pixels composed per presented band (bounds the compose buffer). */
+    static constexpr int32_t COMPOSE_BAND_PIXELS = 4096;
+
+    /** Fewest pixels worth handing to another core when composing a band. */
+    static constexpr int32_t PARALLEL_MIN_PIXELS = 1024;
+
 private:
     UIRenderManager() = default;
     UIRenderManager(const UIRenderManager&) = delete;
@@ -62,9 +132,37 @@ private:
     int m_componentCount = 0;
     AppComponent* m_activeApp = nullptr;
     FlushCallback m_flushCallback = nullptr;
+    PresentCallback m_presentCallback = hal_display_blit_surface;
+    uint16_t m_layerBackdrop = 0x0000;
+    uint64_t m_lastDrawnMicros = 0;
+
+    uint16_t* m_composeBuffer = nullptr;
+    int32_t m_composeCapacity = 0;
 
     void sortByZOrder();
+    static bool isUpdateDue(UIComponent* comp, uint64_t now);
     int findOcclusionFloor() const;
+    int computeVisibility(int floor, hal_rect_t* directCover);
+
+    void collectLayerDamage(UILayer* layer, bool active, hal_damage_t& damage);
+    void composeLayers(int floor, const hal_damage_t& damage,
+                       const hal_rect_t* cover, int coverCount);
+    void composeRect(UILayer* const* layers, int count, const hal_rect_t& r,
+                     hal_pixel_format_t format);
+    void composeRow(UILayer* const* layers, int count, int32_t y,
+                    int32_t x, int32_t w, uint16_t* out, hal_pixel_format_t format) const;
+
+    // One band's rows, split across cores by ParallelRows
+    struct ComposeJob {
+        const UIRenderManager* manager;
+        UILayer* const* layers;
+        int count;
+        int32_t x;
+        int32_t y;
+        int32_t w;
+        hal_pixel_format_t format;
+    };
+    static void composeRows(void* context, int32_t row0, int32_t row1);
 };
 
 #endif // UI_RENDER_MANAGER_H
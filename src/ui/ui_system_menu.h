@@ -68,6 +68,9 @@ public:
     State getState() const { return m_state; }
     bool isActive() const { return m_state != CLOSED; }
 
+    /** True while the WiFi list coasts after a fling. */
+    bool isFlinging() const { return m_wifiList != nullptr && m_wifiList->isFlinging(); }
+
     void update(float deltaTime);
     void render();
     bool handleInput(const touch_gesture_event_t& event);
@@ -5,12 +5,15 @@
  * Specification: features/ui_standard_widgets.md §2
  * Implementation Notes:
  *   - Line height computed from font via getTextBounds("Ay", ...)
- *   - Scroll physics: simple linear offset, no momentum (v1)
+ *   - Scroll physics: drags follow the finger, flings decay exponentially;
+ *     the pixel position snaps to whole items when drawn
  *   - Hit testing: index = (tap_y - start_y + scroll_offset) / line_height
  */
 
 #include "scrollable_list_widget.h"
+#include "../../../hal/timer.h"
 #include <Arduino_GFX_Library.h>
+#include <math.h>
 
 ScrollableListWidget::ScrollableListWidget() {
     paddingX = 4;
@@ -64,6 +67,41 @@ void ScrollableListWidget::clearItems() {
     m_itemCount = 0;
     m_scrollOffset = 0;
     m_selectedIndex = -1;
+    m_scrollPosition = 0.0f;
+    m_flingVelocity = 0.0f;
+}
+
+void ScrollableListWidget::updateScrollLimit(int32_t h) {
+    int maxScroll = m_itemCount - getVisibleItemCount(h);
+    m_maxScrollPosition = maxScroll > 0 ? static_cast<float>(maxScroll * m_lineHeight) : 0.0f;
+}
+
+void ScrollableListWidget::setScrollPosition(float position) {
+    if (position < 0.0f) position = 0.0f;
+    if (position > m_maxScrollPosition) position = m_maxScrollPosition;
+    m_scrollPosition = position;
+    m_scrollOffset = m_lineHeight > 0
+        ? static_cast<int>(position / m_lineHeight + 0.5f) : 0;
+}
+
+void ScrollableListWidget::update() {
+    if (m_flingVelocity == 0.0f) return;
+
+    uint64_t now = hal_timer_get_micros();
+    float dt = static_cast<float>(now - m_lastFlingMicros) * 1e-6f;
+    m_lastFlingMicros = now;
+
+    // Exact integral of v0 * e^(-k t) over dt, so the distance doesn't
+    // depend on the frame rate
+    float decay = expf(-FLING_DECAY * dt);
+    float target = m_scrollPosition + m_flingVelocity * (1.0f - decay) / FLING_DECAY;
+    m_flingVelocity *= decay;
+    setScrollPosition(target);
+
+    bool atEnd = m_scrollPosition != target;  // Clamped: hit the top or bottom
+    if (atEnd || fabsf(m_flingVelocity) < FLING_STOP_VELOCITY) {
+        m_flingVelocity = 0.0f;
+    }
 }
 
 int ScrollableListWidget::getVisibleItemCount(int32_t h) const {
@@ -97,6 +135,9 @@ void ScrollableListWidget::render(Arduino_GFX* gfx, int32_t x, int32_t y, int32_
         }
     }
 
+    updateScrollLimit(h);
+    if (m_scrollPosition > m_maxScrollPosition) setScrollPosition(m_maxScrollPosition);
+
     int visible = getVisibleItemCount(h);
     int32_t itemY = y;
 
@@ -156,9 +197,28 @@ void ScrollableListWidget::render(Arduino_GFX* gfx, int32_t x, int32_t y, int32_
 bool ScrollableListWidget::handleInput(const touch_gesture_event_t& event,
                                         int32_t x, int32_t y, int32_t w, int32_t h) {
     (void)w;
+    updateScrollLimit(h);
+
+    // DRAG → the list follows the finger
+    if (event.type == TOUCH_DRAG) {
+        m_flingVelocity = 0.0f;
+        m_dragged = true;
+        setScrollPosition(m_scrollPosition - event.delta_y);
+        return true;
+    }
+
+    // FLING → keep moving at the release velocity, slowing down in update()
+    if (event.type == TOUCH_FLING) {
+        m_dragged = false;
+        setScrollPosition(m_scrollPosition - event.delta_y);
+        m_flingVelocity = -event.velocity_y;
+        m_lastFlingMicros = hal_timer_get_micros();
+        return true;
+    }
 
     // TAP → select item
     if (event.type == TOUCH_TAP) {
+        m_flingVelocity = 0.0f;
         int index = getItemAtY(event.y_px, y, h);
         if (index >= 0) {
             m_selectedIndex = index;
@@ -169,7 +229,11 @@ bool ScrollableListWidget::handleInput(const touch_gesture_event_t& event,
         }
     }
 
-    // SWIPE → scroll list
+    // SWIPE → scroll list, unless drags already moved it
+    if (event.type == TOUCH_SWIPE && m_dragged) {
+        m_dragged = false;
+        return true;
+    }
     if (event.type == TOUCH_SWIPE) {
         int visible = getVisibleItemCount(h);
         int scrollAmount = (visible > 2) ? visible / 2 : 1;
@@ -180,11 +244,13 @@ bool ScrollableListWidget::handleInput(const touch_gesture_event_t& event,
             // Finger moves up → show items further down
             m_scrollOffset += scrollAmount;
             if (m_scrollOffset > maxScroll) m_scrollOffset = maxScroll;
+            m_scrollPosition = static_cast<float>(m_scrollOffset * m_lineHeight);
             return true;
         } else if (event.direction == TOUCH_DIR_DOWN) {
             // Finger moves down → show items further up
             m_scrollOffset -= scrollAmount;
             if (m_scrollOffset < 0) m_scrollOffset = 0;
+            m_scrollPosition = static_cast<float>(m_scrollOffset * m_lineHeight);
             return true;
         }
     }
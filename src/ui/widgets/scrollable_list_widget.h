@@ -46,11 +46,15 @@ public:
     int getItemCount() const { return m_itemCount; }
     int getSelectedIndex() const { return m_selectedIndex; }
     int getScrollOffset() const { return m_scrollOffset; }
+    bool isFlinging() const { return m_flingVelocity != 0.0f; }
 
     void render(Arduino_GFX* gfx, int32_t x, int32_t y, int32_t w, int32_t h) override;
     bool handleInput(const touch_gesture_event_t& event,
                      int32_t x, int32_t y, int32_t w, int32_t h) override;
 
+    /** Advances a fling; subclasses that override must call it. */
+    void update() override;
+
     /** Callback fired when an item is tapped. */
     using SelectionCallback = void(*)(int index, void* context);
     void setSelectionCallback(SelectionCallback cb, void* ctx = nullptr) {
@@ -76,7 +80,18 @@ protected:
     SelectionCallback m_callback = nullptr;
     void* m_callbackCtx = nullptr;
 
+    // Kinetic scrolling: a pixel position that snaps to whole items
+    float m_scrollPosition = 0.0f;      // Pixels scrolled past the first item
+    float m_maxScrollPosition = 0.0f;   // From the last known box height
+    float m_flingVelocity = 0.0f;       // Pixels per second, positive = toward later items
+    uint64_t m_lastFlingMicros = 0;
+    bool m_dragged = false;             // The current touch is moving the list
+    static constexpr float FLING_DECAY = 3.0f;          // Velocity falls by e^-3 per second
+    static constexpr float FLING_STOP_VELOCITY = 30.0f;  // Pixels per second
+
     int getVisibleItemCount(int32_t h) const;
+    void setScrollPosition(float position);
+    void updateScrollLimit(int32_t h);
     int getItemAtY(int32_t tapY, int32_t boxY, int32_t boxH) const;
 };
 
@@ -87,16 +87,22 @@ void GridWidgetLayout::render(Arduino_GFX* gfx, int32_t clipMaxY) {
 }
 
 bool GridWidgetLayout::handleInput(const touch_gesture_event_t& event) {
+    // Drags and flings belong to the widget the touch started in, even
+    // once the finger has left it
+    bool fromStart = event.type == TOUCH_DRAG || event.type == TOUCH_FLING;
+    int32_t hitX = fromStart ? event.start_x_px : event.x_px;
+    int32_t hitY = fromStart ? event.start_y_px : event.y_px;
+
     // Check widgets in reverse order (highest visual priority first)
     for (int i = m_cellCount - 1; i >= 0; i--) {
         WidgetCell& cell = m_cells[i];
         if (cell.widget == nullptr) continue;
 
         // Hit test: is the touch event within this widget's bounding box?
-        if (event.x_px >= cell.pixelX &&
-            event.x_px < cell.pixelX + cell.pixelW &&
-            event.y_px >= cell.pixelY &&
-            event.y_px < cell.pixelY + cell.pixelH) {
+        if (hitX >= cell.pixelX &&
+            hitX < cell.pixelX + cell.pixelW &&
+            hitY >= cell.pixelY &&
+            hitY < cell.pixelY + cell.pixelH) {
             if (cell.widget->handleInput(event, cell.pixelX, cell.pixelY,
                                           cell.pixelW, cell.pixelH)) {
                 return true;
@@ -125,6 +125,7 @@ void WiFiListWidget::handleSelection(int index) {
 }
 
 void WiFiListWidget::update() {
+    ScrollableListWidget::update();
     if (m_connectingIndex < 0) return;
 
     hal_network_status_t status = hal_network_get_status();
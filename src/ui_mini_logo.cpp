@@ -1,5 +1,6 @@
 #include "ui_mini_logo.h"
 #include "vector_renderer.h"
+#include "vector_sprite_cache.h"
 #include "generated/vector_assets.h"
 
 MiniLogo::MiniLogo(RelativeDisplay* display, Corner corner)
@@ -14,23 +15,42 @@ void MiniLogo::render() {
     // Calculate position and anchor based on corner
     float x_percent, y_percent, anchor_x, anchor_y;
     calculatePositionAndAnchor(x_percent, y_percent, anchor_x, anchor_y);
+    float widthPercent = calculateWidthPercent();
 
+    // Blit the cached sprite (rasterized once per size); fall back to
+    // direct vector rendering if no sprite could be produced
+    if (!VectorSpriteCache::getInstance().draw(*m_display, VectorAssets::Lpadlogo,
+                                               x_percent, y_percent, widthPercent,
+                                               anchor_x, anchor_y)) {
+        VectorRenderer::draw(*m_display, VectorAssets::Lpadlogo,
+                            x_percent, y_percent, widthPercent,
+                            anchor_x, anchor_y);
+    }
+}
+
+const RleSprite* MiniLogo::getSprite(int32_t* out_left, int32_t* out_top) {
+    if (m_display == nullptr) return nullptr;
+
+    float x_percent, y_percent, anchor_x, anchor_y;
+    calculatePositionAndAnchor(x_percent, y_percent, anchor_x, anchor_y);
+    return VectorSpriteCache::getInstance().place(*m_display, VectorAssets::Lpadlogo,
+                                                  x_percent, y_percent, calculateWidthPercent(),
+                                                  anchor_x, anchor_y, nullptr,
+                                                  out_left, out_top);
+}
+
+float MiniLogo::calculateWidthPercent() const {
     // Calculate width maintaining aspect ratio
     // The logo is 245x370 (W x H), which is portrait (taller than wide)
-    float logoAspectRatio = VectorAssets::Lpadlogo.original_width /
-                           VectorAssets::Lpadlogo.original_height;  // 245/370 = 0.662
+    constexpr float logoAspectRatio = VectorAssets::LpadlogoInfo.original_width /
+                                      VectorAssets::LpadlogoInfo.original_height;  // 245/370 = 0.662
 
     int32_t screen_width = m_display->getWidth();
     int32_t screen_height = m_display->getHeight();
     float screenAspectRatio = static_cast<float>(screen_height) / static_cast<float>(screen_width);
 
     // Width percent needed to maintain logo aspect ratio at given height percent
-    float widthPercent = LOGO_HEIGHT_PERCENT * screenAspectRatio * logoAspectRatio;
-
-    // Render the logo using VectorRenderer
-    VectorRenderer::draw(*m_display, VectorAssets::Lpadlogo,
-                        x_percent, y_percent, widthPercent,
-                        anchor_x, anchor_y);
+    return LOGO_HEIGHT_PERCENT * screenAspectRatio * logoAspectRatio;
 }
 
 void MiniLogo::setCorner(Corner corner) {
@@ -2,6 +2,8 @@
 
 #include "relative_display.h"
 
+class RleSprite;
+
 /**
  * MiniLogo - Renders a small, static LPad logo in a specified corner of the screen.
  *
@@ -34,6 +36,14 @@ public:
      */
     void render();
 
+    /**
+     * Resolve the cached sprite render() would blit, and where
+     * @param out_left Receives the sprite's left edge (pixels)
+     * @param out_top Receives the sprite's top edge (pixels)
+     * @return The sprite, or nullptr if none could be produced
+     */
+    const RleSprite* getSprite(int32_t* out_left, int32_t* out_top);
+
     /**
      * Change the logo's corner position
      * @param corner New corner position
@@ -56,6 +66,9 @@ private:
     // Offset from corner edges in pixels
     static constexpr float CORNER_OFFSET_PX = 10.0f;
 
+    // Width percent that keeps the logo's aspect ratio at LOGO_HEIGHT_PERCENT
+    float calculateWidthPercent() const;
+
     // Calculate position and anchor based on corner
     void calculatePositionAndAnchor(float& out_x, float& out_y, float& out_anchor_x, float& out_anchor_y);
 };
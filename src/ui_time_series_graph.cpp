@@ -5,10 +5,14 @@
 
 #define _USE_MATH_DEFINES
 #include "ui_time_series_graph.h"
+#include "gradient_fill.h"
 #include "../hal/display.h"
+#include "../hal/display_format.h"
+#include "../hal/timer.h"
 #include <Arduino_GFX_Library.h>
 #include <algorithm>
 #include <cmath>
+#include <string.h>
 #include <string>
 #include <vector>
 
@@ -16,23 +20,6 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-// Helper function to interpolate between two RGB565 colors
-static uint16_t interpolate_color(uint16_t color1, uint16_t color2, float t) {
-    uint8_t r1 = (color1 >> 11) & 0x1F;
-    uint8_t g1 = (color1 >> 5) & 0x3F;
-    uint8_t b1 = color1 & 0x1F;
-
-    uint8_t r2 = (color2 >> 11) & 0x1F;
-    uint8_t g2 = (color2 >> 5) & 0x3F;
-    uint8_t b2 = color2 & 0x1F;
-
-    uint8_t r = static_cast<uint8_t>(r1 + t * (r2 - r1));
-    uint8_t g = static_cast<uint8_t>(g1 + t * (g2 - g1));
-    uint8_t b = static_cast<uint8_t>(b1 + t * (b2 - b1));
-
-    return ((r & 0x1F) << 11) | ((g & 0x3F) << 5) | (b & 0x1F);
-}
-
 // Helper function to format a number with 3 significant digits
 static void format_3_sig_digits(double value, char* buffer, size_t buffer_size) {
     if (value == 0.0) {
@@ -66,12 +53,17 @@ TimeSeriesGraph::TimeSeriesGraph(const GraphTheme& theme, Arduino_GFX* main_disp
       bg_canvas_(nullptr), data_canvas_(nullptr),
       rel_main_(nullptr), rel_bg_(nullptr), rel_data_(nullptr),
       composite_buffer_(nullptr), composite_buffer_size_(0),
+      bg_format_(HAL_PIXEL_FORMAT_RGB565),
       pulse_phase_(0.0f), y_tick_increment_(0.0f),
       tick_label_position_(TickLabelPosition::OUTSIDE),
       x_axis_title_(nullptr), y_axis_title_(nullptr), watermarkText_(nullptr),
       last_indicator_x_(0), last_indicator_y_(0), last_indicator_radius_(0),
       has_drawn_indicator_(false),
-      cached_y_min_(0.0), cached_y_max_(0.0), range_cached_(false) {
+      cached_y_min_(0.0), cached_y_max_(0.0), range_cached_(false),
+      bg_list_valid_(false),
+      bg_job_{ false, STAGE_DONE, 0 }, data_job_{ false, STAGE_DONE, 0 },
+      bg_back_canvas_(nullptr), rel_bg_back_(nullptr),
+      data_back_canvas_(nullptr), rel_data_back_(nullptr) {
 }
 
 TimeSeriesGraph::~TimeSeriesGraph() {
@@ -79,10 +71,14 @@ TimeSeriesGraph::~TimeSeriesGraph() {
     delete rel_main_;
     delete rel_bg_;
     delete rel_data_;
+    delete rel_bg_back_;
+    delete rel_data_back_;
 
     // Clean up canvas instances (they free their PSRAM buffers)
     delete bg_canvas_;
     delete data_canvas_;
+    delete bg_back_canvas_;
+    delete data_back_canvas_;
 
     // Clean up composite buffer
     if (composite_buffer_ != nullptr) {
@@ -92,6 +88,8 @@ TimeSeriesGraph::~TimeSeriesGraph() {
 }
 
 bool TimeSeriesGraph::begin() {
+#if defined(BOARD_HAS_PSRAM) || defined(UNIT_TEST)
+    uint8_t data_bpp = dataLayerBitsPerPixel();
 #ifdef BOARD_HAS_PSRAM
     // PSRAM should already be initialized by the HAL or Arduino framework
     // Check if PSRAM is available
@@ -106,8 +104,9 @@ bool TimeSeriesGraph::begin() {
         return false;
     }
 
-    // Calculate required memory (2 canvases * width * height * 2 bytes per pixel)
-    size_t required_bytes = 2 * width_ * height_ * 2;
+    // Calculate required memory (RGB565 background + indexed data layer)
+    size_t required_bytes = width_ * height_ * 2 +
+                            ((width_ * data_bpp + 7) / 8) * height_;
     Serial.printf("  [INFO] Required memory: %zu bytes\n", required_bytes);
 
     if (psram_free < required_bytes) {
@@ -115,6 +114,7 @@ bool TimeSeriesGraph::begin() {
                      required_bytes, psram_free);
         return false;
     }
+#endif  // BOARD_HAS_PSRAM (native tests allocate from the heap)
 
     // Allocate background canvas in PSRAM
     Serial.println("  [INFO] Allocating background canvas...");
@@ -129,21 +129,30 @@ bool TimeSeriesGraph::begin() {
     bg_canvas_->fillScreen(0x0000);
     Serial.println("  [OK] Background canvas created");
 
-    // Allocate data canvas in PSRAM
-    Serial.println("  [INFO] Allocating data canvas...");
-    data_canvas_ = new Arduino_Canvas(width_, height_, main_display_);
-    if (!data_canvas_ || !data_canvas_->begin(GFX_SKIP_OUTPUT_BEGIN)) {
+    // Allocate data layer in PSRAM. It only ever holds the line color(s) on
+    // a transparent background, so it is palette-indexed rather than RGB565.
+    // Index 0 is the chroma key and starts out transparent.
+    Serial.printf("  [INFO] Allocating data canvas (%u bpp)...\n", data_bpp);
+    constexpr uint16_t CHROMA_KEY = 0x0001;
+    if (!data_layer_.init(static_cast<int16_t>(width_), static_cast<int16_t>(height_),
+                          data_bpp, CHROMA_KEY)) {
+        Serial.println("  [ERROR] Failed to allocate data layer");
+        delete bg_canvas_;
+        bg_canvas_ = nullptr;
+        return false;
+    }
+    data_canvas_ = new IndexedCanvas(&data_layer_);
+    if (!data_canvas_ || !data_canvas_->begin()) {
         Serial.println("  [ERROR] Failed to create data canvas");
         delete data_canvas_;
         delete bg_canvas_;
         data_canvas_ = nullptr;
         bg_canvas_ = nullptr;
+        data_layer_.release();
         return false;
     }
-    // Clear canvas with chroma key to prevent corrupted frame flash
-    constexpr uint16_t CHROMA_KEY = 0x0001;
-    data_canvas_->fillScreen(CHROMA_KEY);
-    Serial.println("  [OK] Data canvas created");
+    Serial.printf("  [OK] Data canvas created (%u bytes)\n",
+                  static_cast<unsigned>(data_layer_.getDataSize()));
 
     // Create RelativeDisplay instances for each layer
     Serial.println("  [INFO] Creating RelativeDisplay wrappers...");
@@ -159,33 +168,55 @@ bool TimeSeriesGraph::begin() {
 #endif
 }
 
+// Tick labels only depend on the extremes of the values
+static bool sameValueRange(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.empty() || b.empty()) return a.empty() == b.empty();
+    auto ra = std::minmax_element(a.begin(), a.end());
+    auto rb = std::minmax_element(b.begin(), b.end());
+    return *ra.first == *rb.first && *ra.second == *rb.second;
+}
+
 void TimeSeriesGraph::setData(const GraphData& data) {
+    if (data.x_values != data_.x_values || !sameValueRange(data.y_values, data_.y_values)) {
+        bg_list_valid_ = false;  // Tick labels change
+    }
     data_ = data;
     range_cached_ = false;  // Invalidate cached range when data changes
 }
 
 void TimeSeriesGraph::setYTicks(float increment) {
     y_tick_increment_ = increment;
+    bg_list_valid_ = false;
 }
 
 void TimeSeriesGraph::setTheme(const GraphTheme& theme) {
     theme_ = theme;
+    bg_list_valid_ = false;
 }
 
 void TimeSeriesGraph::setTickLabelPosition(TickLabelPosition pos) {
     tick_label_position_ = pos;
+    bg_list_valid_ = false;
 }
 
 void TimeSeriesGraph::setXAxisTitle(const char* title) {
     x_axis_title_ = title;
+    bg_list_valid_ = false;
 }
 
 void TimeSeriesGraph::setYAxisTitle(const char* title) {
     y_axis_title_ = title;
+    bg_list_valid_ = false;
 }
 
 void TimeSeriesGraph::setWatermark(const char* text) {
     watermarkText_ = text;
+    bg_list_valid_ = false;
+}
+
+uint8_t TimeSeriesGraph::dataLayerBitsPerPixel() const {
+    bool gradient = theme_.useLineGradient && theme_.lineGradient.num_stops >= 2;
+    return gradient ? 8 : 1;
 }
 
 TimeSeriesGraph::GraphMargins TimeSeriesGraph::getMargins() const {
@@ -211,95 +242,97 @@ TimeSeriesGraph::GraphMargins TimeSeriesGraph::getMargins() const {
     return m;
 }
 
+void TimeSeriesGraph::recordStaticContent() {
+    // Static content is recorded once, with pixel positions and text bounds
+    // resolved, and replayed until something it depends on changes
+    if (!bg_list_valid_) {
+        bg_list_.clear();
+        rel_bg_->beginRecording(&bg_list_);
+        drawStaticContent(rel_bg_);
+        rel_bg_->endRecording();
+        bg_list_valid_ = true;
+    }
+}
+
 void TimeSeriesGraph::drawBackground() {
     if (!rel_bg_) return;
 
-    // Fill background canvas with color or gradient
-    if (theme_.useBackgroundGradient) {
-        // Draw gradient to background canvas using RelativeDisplay
-        int32_t x_start = 0;
-        int32_t y_start = 0;
-        int32_t x_end = width_;
-        int32_t y_end = height_;
-
-        float angle_rad = theme_.backgroundGradient.angle_deg * M_PI / 180.0f;
-
-        // Calculate gradient direction vector
-        float dx = cosf(angle_rad);
-        float dy = sinf(angle_rad);
-
-        // Calculate gradient length (diagonal distance for proper normalization)
-        float gradient_length = sqrtf(static_cast<float>(width_ * width_ + height_ * height_));
-
-        // Draw gradient pixel by pixel (could be optimized with line-based rendering)
-        for (int32_t py = y_start; py < y_end; py++) {
-            if (py % 20 == 0) yield();  // Feed watchdog every 20 rows
-            for (int32_t px = x_start; px < x_end; px++) {
-                // Calculate position along gradient direction
-                // Project pixel position onto gradient vector
-                float proj = (px * dx + py * dy);
-
-                // Normalize to 0.0 - 1.0 range based on angle
-                float t;
-                if (fabsf(theme_.backgroundGradient.angle_deg - 90.0f) < 5.0f) {
-                    // Vertical gradient (optimized path)
-                    t = static_cast<float>(py) / static_cast<float>(height_);
-                } else if (fabsf(theme_.backgroundGradient.angle_deg - 0.0f) < 5.0f) {
-                    // Horizontal gradient (optimized path)
-                    t = static_cast<float>(px) / static_cast<float>(width_);
-                } else {
-                    // Diagonal gradient - normalize based on projection
-                    t = proj / gradient_length;
-                }
+    // Drawn in place now; a pending slice of older state must not replace it
+    bg_job_.active = false;
+    recordStaticContent();
 
-                // Clamp t to [0, 1]
-                if (t < 0.0f) t = 0.0f;
-                if (t > 1.0f) t = 1.0f;
-
-                // Interpolate color based on number of stops
-                uint16_t color;
-                if (theme_.backgroundGradient.num_stops == 2) {
-                    color = interpolate_color(
-                        theme_.backgroundGradient.color_stops[0],
-                        theme_.backgroundGradient.color_stops[1],
-                        t
-                    );
-                } else {
-                    // 3-color gradient
-                    if (t < 0.5f) {
-                        color = interpolate_color(
-                            theme_.backgroundGradient.color_stops[0],
-                            theme_.backgroundGradient.color_stops[1],
-                            t * 2.0f
-                        );
-                    } else {
-                        color = interpolate_color(
-                            theme_.backgroundGradient.color_stops[1],
-                            theme_.backgroundGradient.color_stops[2],
-                            (t - 0.5f) * 2.0f
-                        );
-                    }
-                }
+    // GFX draws CPU-order pixels; render() converts them once afterwards
+    bg_format_ = HAL_PIXEL_FORMAT_RGB565;
+    paintBackground(0, 0, width_, height_);
+}
 
-                // Draw pixel in relative coordinates
-                float x_pct = (static_cast<float>(px) / static_cast<float>(width_)) * 100.0f;
-                float y_pct = (static_cast<float>(py) / static_cast<float>(height_)) * 100.0f;
-                rel_bg_->drawPixel(x_pct, y_pct, color);
-            }
+void TimeSeriesGraph::restoreBackground(int32_t x, int32_t y, int32_t w, int32_t h) {
+    if (!rel_bg_ || !bg_canvas_) return;
+    if (!bg_list_valid_) {
+        drawBackground();
+        return;
+    }
+
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > width_) w = width_ - x;
+    if (y + h > height_) h = height_ - y;
+    if (w <= 0 || h <= 0) return;
+
+    // The rest of the canvas is kept, so it must be back in CPU order first
+    uint16_t* bg_buffer = bg_canvas_->getFramebuffer();
+    if (bg_buffer && bg_format_ != HAL_PIXEL_FORMAT_RGB565) {
+        size_t count = static_cast<size_t>(width_) * static_cast<size_t>(height_);
+        hal_pixels_convert(bg_buffer, bg_buffer, count, bg_format_, HAL_PIXEL_FORMAT_RGB565);
+        bg_format_ = HAL_PIXEL_FORMAT_RGB565;
+    }
+    paintBackground(x, y, w, h);
+}
+
+void TimeSeriesGraph::paintBackground(int32_t x, int32_t y, int32_t w, int32_t h) {
+    Arduino_GFX* canvas = rel_bg_->getGfx();
+    if (!canvas) return;
+
+    fillBackground(canvas, x, y, w, h);
+
+    // Everything else comes from the recorded display list
+    hal_rect_t clip = { x, y, w, h };
+    bg_list_.replay(canvas, 0, 0, &clip);
+}
+
+void TimeSeriesGraph::fillBackground(Arduino_GFX* canvas, int32_t x, int32_t y, int32_t w, int32_t h) {
+    if (!theme_.useBackgroundGradient) {
+        canvas->fillRect(x, y, w, h, theme_.backgroundColor);
+        return;
+    }
+
+    // Straight into the canvas buffer, rows split across cores
+    Arduino_Canvas* target = (canvas == bg_canvas_) ? bg_canvas_
+                           : (canvas == bg_back_canvas_) ? bg_back_canvas_ : nullptr;
+    uint16_t* bg_buffer = target ? target->getFramebuffer() : nullptr;
+    if (bg_buffer) {
+        hal_surface_t surface = { bg_buffer, width_, height_, width_, HAL_PIXEL_FORMAT_RGB565 };
+        gradient_fill_linear(surface, x, y, w, h, theme_.backgroundGradient);
+        return;
+    }
+
+    for (int32_t py = y; py < y + h; py++) {
+        if (py % 20 == 0) yield();  // Feed watchdog every 20 rows
+        for (int32_t px = x; px < x + w; px++) {
+            canvas->drawPixel(px, py, gradient_color_at(theme_.backgroundGradient, px, py, width_, height_));
         }
-    } else {
-        rel_bg_->fillRect(0.0f, 0.0f, 100.0f, 100.0f, theme_.backgroundColor);
     }
+}
 
+void TimeSeriesGraph::drawStaticContent(RelativeDisplay* target) {
     // Draw ticker watermark (under all other elements)
     if (watermarkText_ != nullptr && watermarkText_[0] != '\0') {
-        Arduino_GFX* canvas = rel_bg_->getGfx();
+        Arduino_GFX* canvas = target->getGfx();
         if (canvas) {
             // Use built-in font at size 3 for heading-like watermark
             // (custom GFX fonts crash on PSRAM Arduino_Canvas)
             canvas->setFont(nullptr);
             canvas->setTextSize(3);
-            canvas->setTextColor(theme_.watermarkColor);
 
             // Measure text for centering
             int16_t x1, y1;
@@ -310,28 +343,23 @@ void TimeSeriesGraph::drawBackground() {
             int16_t text_x = (width_ - tw) / 2;
             int16_t text_y = 4;  // Small offset from top
 
-            canvas->setCursor(text_x, text_y);
-            canvas->print(watermarkText_);
-
-            // Reset font state
-            canvas->setFont(nullptr);
-            canvas->setTextSize(1);
+            target->drawText(text_x, text_y, watermarkText_, theme_.watermarkColor, 3);
         }
     }
 
     // Draw axes to background canvas
-    drawAxes(rel_bg_);
+    drawAxes(target);
 
     // Draw Y-axis ticks and labels if enabled
     if (y_tick_increment_ > 0.0f) {
-        drawYTicks(rel_bg_);
+        drawYTicks(target);
     }
 
     // Draw X-axis ticks and labels
-    drawXTicks(rel_bg_);
+    drawXTicks(target);
 
     // Draw axis titles if set
-    drawAxisTitles(rel_bg_);
+    drawAxisTitles(target);
 }
 
 void TimeSeriesGraph::drawAxisTitles(RelativeDisplay* target) {
@@ -375,8 +403,7 @@ void TimeSeriesGraph::drawAxisTitles(RelativeDisplay* target) {
         if (title_y < 0) title_y = 0;
         if (title_y + static_cast<int32_t>(h) >= height_) title_y = height_ - h - 1;
 
-        canvas->setCursor(title_x, title_y);
-        canvas->print(x_axis_title_);
+        target->drawText(title_x, title_y, x_axis_title_, theme_.tickColor, 2);
     }
 
     // Y-axis title: rotated -90 degrees (text reads bottom-to-top)
@@ -405,28 +432,24 @@ void TimeSeriesGraph::drawAxisTitles(RelativeDisplay* target) {
             tempCanvas->print(y_axis_title_);
 
             uint16_t* src = tempCanvas->getFramebuffer();
-            if (src) {
-                // After -90° rotation: (buf_w x buf_h) becomes (buf_h x buf_w)
-                float graph_center_y = (m.top + (100.0f - m.bottom)) / 2.0f;
-                int32_t center_py = target->relativeToAbsoluteY(graph_center_y);
-                int32_t rotated_h = buf_w;  // height of rotated image
-                int32_t start_x = 2;
-                int32_t start_y = center_py - rotated_h / 2;
-
+            int32_t rotated_w = buf_h;  // -90° rotation: (buf_w x buf_h) becomes (buf_h x buf_w)
+            int32_t rotated_h = buf_w;
+            uint16_t* rotated = static_cast<uint16_t*>(malloc(rotated_w * rotated_h * sizeof(uint16_t)));
+            if (src && rotated) {
                 for (int32_t sy = 0; sy < buf_h; sy++) {
                     for (int32_t sx = 0; sx < buf_w; sx++) {
-                        uint16_t pixel = src[sy * buf_w + sx];
-                        if (pixel != ROT_KEY) {
-                            // -90° rotation: (sx, sy) -> (sy, buf_w - 1 - sx)
-                            int32_t dx = start_x + sy;
-                            int32_t dy = start_y + (buf_w - 1 - sx);
-                            if (dx >= 0 && dx < width_ && dy >= 0 && dy < height_) {
-                                canvas->drawPixel(dx, dy, pixel);
-                            }
-                        }
+                        // -90° rotation: (sx, sy) -> (sy, buf_w - 1 - sx)
+                        rotated[(buf_w - 1 - sx) * rotated_w + sy] = src[sy * buf_w + sx];
                     }
                 }
+
+                float graph_center_y = (m.top + (100.0f - m.bottom)) / 2.0f;
+                int32_t center_py = target->relativeToAbsoluteY(graph_center_y);
+                int32_t start_x = 2;
+                int32_t start_y = center_py - rotated_h / 2;
+                target->drawKeyedBitmap(start_x, start_y, rotated, rotated_w, rotated_h, ROT_KEY);
             }
+            free(rotated);
             delete tempCanvas;
         } else {
             delete tempCanvas;
@@ -434,31 +457,170 @@ void TimeSeriesGraph::drawAxisTitles(RelativeDisplay* target) {
     }
 }
 
+bool TimeSeriesGraph::clearDataLayer(IndexedSurface& layer) {
+    // A theme change may switch between solid and gradient lines
+    uint8_t data_bpp = dataLayerBitsPerPixel();
+    if (!layer.isValid() || layer.getBitsPerPixel() != data_bpp) {
+        constexpr uint16_t CHROMA_KEY = 0x0001;
+        if (!layer.init(static_cast<int16_t>(width_), static_cast<int16_t>(height_),
+                        data_bpp, CHROMA_KEY)) {
+            return false;
+        }
+    }
+
+    // Clear to the transparent index and start a fresh palette
+    layer.resetPalette();
+    layer.fill(IndexedSurface::TRANSPARENT_INDEX);
+    return true;
+}
+
 void TimeSeriesGraph::drawData() {
     if (!rel_data_) return;
 
-    // Clear data canvas using chroma key color for transparency
-    // We use 0x0001 (nearly black) as our "transparent" color
-    // This will be skipped during compositing
-    constexpr uint16_t CHROMA_KEY = 0x0001;
-    rel_data_->fillRect(0.0f, 0.0f, 100.0f, 100.0f, CHROMA_KEY);
+    // Drawn in place now; a pending slice of older data must not replace it
+    data_job_.active = false;
+    if (!clearDataLayer(data_layer_)) return;
 
     if (!data_.y_values.empty()) {
         drawDataLine(rel_data_);
     }
 }
 
-void TimeSeriesGraph::render() {
-    if (!bg_canvas_ || !data_canvas_ || !main_display_) return;
+// ============================================================================
+// Time-Sliced Redraw
+// ============================================================================
+
+// Work between budget checks: rows of background fill, display list
+// commands, data line segments
+static constexpr int32_t REDRAW_FILL_ROWS = 8;
+static constexpr size_t REDRAW_REPLAY_COMMANDS = 16;
+static constexpr size_t REDRAW_LINE_SEGMENTS = 8;
+
+bool TimeSeriesGraph::allocateBackSurfaces(bool background, bool data) {
+    if (background && bg_back_canvas_ == nullptr) {
+        Arduino_Canvas* canvas = new Arduino_Canvas(width_, height_, main_display_);
+        if (!canvas || !canvas->begin(GFX_SKIP_OUTPUT_BEGIN)) {
+            delete canvas;
+            return false;
+        }
+        bg_back_canvas_ = canvas;
+        rel_bg_back_ = new RelativeDisplay(bg_back_canvas_, width_, height_);
+    }
 
-    // OPTIMIZATION: Pre-composite layers in memory, then do single DMA blit
-    // This avoids multiple address window updates and is faster for sparse data
+    if (data && data_back_canvas_ == nullptr) {
+        if (!clearDataLayer(data_back_)) return false;
+        data_back_canvas_ = new IndexedCanvas(&data_back_);
+        if (!data_back_canvas_ || !data_back_canvas_->begin()) {
+            delete data_back_canvas_;
+            data_back_canvas_ = nullptr;
+            data_back_.release();
+            return false;
+        }
+        rel_data_back_ = new RelativeDisplay(data_back_canvas_, width_, height_);
+    }
+    return true;
+}
+
+bool TimeSeriesGraph::requestRedraw(bool background, bool data) {
+    if (!rel_bg_ || !rel_data_) return false;
+
+    if (!allocateBackSurfaces(background, data)) {
+        // Not enough memory for a second set of surfaces: draw in place
+        if (background) drawBackground();
+        if (data) drawData();
+        return false;
+    }
+
+    if (background) {
+        recordStaticContent();
+        bg_job_ = { true, STAGE_FILL, 0 };
+    }
+    if (data) {
+        if (!clearDataLayer(data_back_)) {
+            drawData();
+            return false;
+        }
+        data_job_ = { true, STAGE_LINE, 1 };
+    }
+    return true;
+}
+
+bool TimeSeriesGraph::stepBackgroundJob() {
+    Arduino_GFX* canvas = rel_bg_back_->getGfx();
+
+    if (bg_job_.stage == STAGE_FILL) {
+        int32_t row = static_cast<int32_t>(bg_job_.cursor);
+        int32_t rows = std::min(REDRAW_FILL_ROWS, height_ - row);
+        fillBackground(canvas, 0, row, width_, rows);
+        bg_job_.cursor += rows;
+        if (static_cast<int32_t>(bg_job_.cursor) >= height_) {
+            bg_job_.stage = STAGE_REPLAY;
+            bg_job_.cursor = 0;
+        }
+        return false;
+    }
+
+    if (bg_job_.stage == STAGE_REPLAY) {
+        bg_list_.replayRange(canvas, bg_job_.cursor, REDRAW_REPLAY_COMMANDS);
+        bg_job_.cursor += REDRAW_REPLAY_COMMANDS;
+        if (bg_job_.cursor < bg_list_.getCommandCount()) return false;
+        bg_job_.stage = STAGE_DONE;
+    }
+    return true;
+}
+
+bool TimeSeriesGraph::stepDataJob() {
+    if (data_job_.stage == STAGE_LINE) {
+        size_t count = data_.y_values.size();
+        size_t last = std::min(data_job_.cursor + REDRAW_LINE_SEGMENTS, count);
+        if (data_job_.cursor < last) {
+            drawDataSegments(rel_data_back_, data_job_.cursor, last);
+        }
+        data_job_.cursor = last;
+        if (last < count) return false;
+        data_job_.stage = STAGE_DONE;
+    }
+    return true;
+}
+
+bool TimeSeriesGraph::stepRedraw(uint32_t budget_us) {
+    if (!isRedrawPending()) return false;
+
+    uint64_t start = hal_timer_get_micros();
+    bool bg_done = !bg_job_.active || bg_job_.stage == STAGE_DONE;
+    bool data_done = !data_job_.active || data_job_.stage == STAGE_DONE;
+    do {
+        // The background first: it is the bigger job and the data line
+        // is usually ready sooner than it
+        if (!bg_done) {
+            bg_done = stepBackgroundJob();
+        } else if (!data_done) {
+            data_done = stepDataJob();
+        }
+    } while (!(bg_done && data_done) && hal_timer_get_micros() - start < budget_us);
+
+    if (!(bg_done && data_done)) return false;
+
+    // Both layers complete: flip them to the front together
+    if (bg_job_.active) {
+        std::swap(bg_canvas_, bg_back_canvas_);
+        std::swap(rel_bg_, rel_bg_back_);
+        bg_format_ = HAL_PIXEL_FORMAT_RGB565;  // Back surfaces are drawn in CPU order
+        bg_job_.active = false;
+    }
+    if (data_job_.active) {
+        data_layer_.swap(data_back_);
+        data_job_.active = false;
+    }
+    return true;
+}
+
+bool TimeSeriesGraph::composite(hal_surface_t* out_surface) {
+    if (!bg_canvas_ || !data_layer_.isValid() || out_surface == nullptr) return false;
 
-    constexpr uint16_t CHROMA_KEY = 0x0001;
     uint16_t* bg_buffer = bg_canvas_->getFramebuffer();
-    uint16_t* data_buffer = data_canvas_->getFramebuffer();
 
-    if (!bg_buffer || !data_buffer) return;
+    if (!bg_buffer) return false;
 
     // Allocate composite buffer in PSRAM if needed
     size_t required_size = static_cast<size_t>(width_) * static_cast<size_t>(height_);
@@ -471,24 +633,51 @@ void TimeSeriesGraph::render() {
         composite_buffer_size_ = required_size;
     }
 
-    if (composite_buffer_ == nullptr) {
-        // Fallback: blit layers separately if allocation fails
-        hal_display_fast_blit(0, 0, width_, height_, bg_buffer);
-        hal_display_fast_blit_transparent(0, 0, width_, height_, data_buffer, CHROMA_KEY);
-        return;
+    // Composite in the panel's byte order so the blit is zero-transform.
+    // The background is converted in place once per drawBackground(), and
+    // the data palette is kept in both orders, so no per-frame swap remains.
+    const hal_pixel_format_t format = hal_display_get_native_format();
+    if (bg_format_ != format) {
+        hal_pixels_convert(bg_buffer, bg_buffer, required_size, bg_format_, format);
+        bg_format_ = format;
     }
 
-    // Composite: background + data (with transparency) in memory
-    for (size_t i = 0; i < required_size; i++) {
-        if (data_buffer[i] != CHROMA_KEY) {
-            composite_buffer_[i] = data_buffer[i];  // Use data pixel
-        } else {
-            composite_buffer_[i] = bg_buffer[i];     // Use background pixel
-        }
+    if (composite_buffer_ == nullptr) return false;
+
+    // Composite: background + data (palette expansion, transparent index
+    // shows the background) in memory
+    for (int32_t row = 0; row < height_; row++) {
+        data_layer_.compositeRow(static_cast<int16_t>(row), &bg_buffer[row * width_],
+                                 &composite_buffer_[row * width_], format);
+    }
+
+    *out_surface = { composite_buffer_, width_, height_, width_, format };
+    return true;
+}
+
+void TimeSeriesGraph::render() {
+    if (!bg_canvas_ || !data_layer_.isValid() || !main_display_) return;
+
+    // OPTIMIZATION: Pre-composite layers in memory, then do single DMA blit
+    // This avoids multiple address window updates and is faster for sparse data
+    hal_surface_t surface;
+    if (composite(&surface)) {
+        hal_display_blit_surface(0, 0, &surface);
+        return;
     }
 
-    // Single fast DMA blit of the composited result
-    hal_display_fast_blit(0, 0, width_, height_, composite_buffer_);
+    // Fallback: composite and blit one row at a time if allocation fails
+    // (composite() has already put the background in native order)
+    uint16_t* bg_buffer = bg_canvas_->getFramebuffer();
+    if (!bg_buffer) return;
+    uint16_t* row_buffer = static_cast<uint16_t*>(malloc(width_ * sizeof(uint16_t)));
+    if (row_buffer == nullptr) return;
+    hal_surface_t row_surface = { row_buffer, width_, 1, width_, bg_format_ };
+    for (int32_t row = 0; row < height_; row++) {
+        data_layer_.compositeRow(static_cast<int16_t>(row), &bg_buffer[row * width_], row_buffer, bg_format_);
+        hal_display_blit_surface(0, static_cast<int16_t>(row), &row_surface);
+    }
+    free(row_buffer);
 }
 
 void TimeSeriesGraph::update(float deltaTime) {
@@ -676,8 +865,7 @@ void TimeSeriesGraph::drawYTicks(RelativeDisplay* target) {
             // getTextBounds returns y1 (offset from baseline to top, usually negative)
             // Text center is at baseline + y1 + h/2
             // To center at label_y: baseline = label_y - y1 - h/2
-            canvas->setCursor(label_x, label_y - y1 - h / 2);
-            canvas->print(label);
+            target->drawText(label_x, label_y - y1 - h / 2, label, theme_.tickColor, 2);
         } else {
             // INSIDE: tick extends RIGHT into graph
             float tick_end = x_axis + theme_.tickLength;
@@ -690,8 +878,7 @@ void TimeSeriesGraph::drawYTicks(RelativeDisplay* target) {
             // getTextBounds returns y1 (offset from baseline to top, usually negative)
             // Text center is at baseline + y1 + h/2
             // To center at label_y: baseline = label_y - y1 - h/2
-            canvas->setCursor(label_x, label_y - y1 - h / 2);
-            canvas->print(label);
+            target->drawText(label_x, label_y - y1 - h / 2, label, theme_.tickColor, 2);
         }
     }
 }
@@ -772,8 +959,7 @@ void TimeSeriesGraph::drawXTicks(RelativeDisplay* target) {
             int32_t label_y = target->relativeToAbsoluteY(tick_end + 0.5f);
             if (label_x < 0) label_x = 0;
             if (label_x + w >= width_) label_x = width_ - w - 1;
-            canvas->setCursor(label_x, label_y + h);
-            canvas->print(label);
+            target->drawText(label_x, label_y + h, label, theme_.tickColor, 2);
         } else {
             // INSIDE: tick extends UP into graph
             float tick_top = y_axis - theme_.tickLength;
@@ -787,13 +973,16 @@ void TimeSeriesGraph::drawXTicks(RelativeDisplay* target) {
             // Position baseline so text bottom (baseline - h/4) is 2px above tick_top
             int32_t label_y = tick_top_px - h + 2;
             if (label_x < 0) label_x = 0;
-            canvas->setCursor(label_x, label_y);
-            canvas->print(label);
+            target->drawText(label_x, label_y, label, theme_.tickColor, 2);
         }
     }
 }
 
 void TimeSeriesGraph::drawDataLine(RelativeDisplay* target) {
+    drawDataSegments(target, 1, data_.y_values.size());
+}
+
+void TimeSeriesGraph::drawDataSegments(RelativeDisplay* target, size_t first, size_t last) {
     if (data_.y_values.size() < 2) return;
 
     // Calculate or use cached data range
@@ -824,7 +1013,9 @@ void TimeSeriesGraph::drawDataLine(RelativeDisplay* target) {
     int32_t half_thickness = thickness_px / 2;
 
     // Draw thick line segments between consecutive points
-    for (size_t i = 1; i < point_count; i++) {
+    if (first < 1) first = 1;
+    if (last > point_count) last = point_count;
+    for (size_t i = first; i < last; i++) {
         float x1 = mapXToScreen(i - 1, point_count);
         float y1 = mapYToScreen(data_.y_values[i - 1], y_min, y_max);
         float x2 = mapXToScreen(i, point_count);
@@ -836,7 +1027,7 @@ void TimeSeriesGraph::drawDataLine(RelativeDisplay* target) {
             // Interpolate color based on position along X axis
             float t = static_cast<float>(i - 1) / static_cast<float>(point_count - 1);
             if (theme_.lineGradient.num_stops == 2) {
-                segment_color = interpolate_color(
+                segment_color = gradient_interpolate_565(
                     theme_.lineGradient.color_stops[0],
                     theme_.lineGradient.color_stops[1],
                     t
@@ -844,13 +1035,13 @@ void TimeSeriesGraph::drawDataLine(RelativeDisplay* target) {
             } else {
                 // 3-color gradient
                 if (t < 0.5f) {
-                    segment_color = interpolate_color(
+                    segment_color = gradient_interpolate_565(
                         theme_.lineGradient.color_stops[0],
                         theme_.lineGradient.color_stops[1],
                         t * 2.0f
                     );
                 } else {
-                    segment_color = interpolate_color(
+                    segment_color = gradient_interpolate_565(
                         theme_.lineGradient.color_stops[1],
                         theme_.lineGradient.color_stops[2],
                         (t - 0.5f) * 2.0f
@@ -887,9 +1078,7 @@ void TimeSeriesGraph::drawDataLine(RelativeDisplay* target) {
                         int32_t px = x + tx;
                         int32_t py = y + ty;
                         if (px >= 0 && px < width_ && py >= 0 && py < height_) {
-                            float x_pct = (static_cast<float>(px) / static_cast<float>(width_)) * 100.0f;
-                            float y_pct = (static_cast<float>(py) / static_cast<float>(height_)) * 100.0f;
-                            target->drawPixel(x_pct, y_pct, segment_color);
+                            target->drawAbsolutePixel(px, py, segment_color);
                         }
                     }
                 }
@@ -1004,11 +1193,11 @@ void TimeSeriesGraph::drawLiveIndicator() {
 
             if (dist <= static_cast<float>(radius_px)) {
                 float t = (radius_px > 0) ? (dist / static_cast<float>(radius_px)) : 0.0f;
-                uint16_t color = interpolate_color(
+                uint16_t color = hal_color_to_format(gradient_interpolate_565(
                     theme_.liveIndicatorGradient.color_stops[0],
                     theme_.liveIndicatorGradient.color_stops[1],
                     t
-                );
+                ), bg_format_);
 
                 // Write to buffer
                 int32_t buffer_x = px - box_x;
@@ -1019,10 +1208,10 @@ void TimeSeriesGraph::drawLiveIndicator() {
         }
     }
 
-    // Step 3: Single atomic blit to display (erase + draw in one operation)
-    hal_display_fast_blit(static_cast<int16_t>(box_x), static_cast<int16_t>(box_y),
-                          static_cast<int16_t>(box_width), static_cast<int16_t>(box_height),
-                          region_buffer);
+    // Step 3: Single atomic blit to display (erase + draw in one operation);
+    // the region is in the composite buffer's byte order
+    hal_surface_t region = { region_buffer, box_width, box_height, box_width, bg_format_ };
+    hal_display_blit_surface(static_cast<int16_t>(box_x), static_cast<int16_t>(box_y), &region);
 
     free(region_buffer);
 
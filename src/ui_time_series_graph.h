@@ -14,6 +14,9 @@
 
 #include "gradients.h"
 #include "relative_display.h"
+#include "display_list.h"
+#include "indexed_surface.h"
+#include "indexed_canvas.h"
 #include <Arduino_GFX_Library.h>
 #include <vector>
 #include <stdint.h>
@@ -127,10 +130,21 @@ public:
      * @brief Draws the background layer (axes, gradients)
      *
      * This renders static elements to the background canvas. Call this once
-     * during initialization or when the theme changes.
+     * during initialization or when the theme changes. Watermark, axes, ticks,
+     * labels and titles are recorded into a display list the first time and
+     * replayed afterwards, until a setter or new data changes them.
      */
     void drawBackground();
 
+    /**
+     * @brief Repaints one region of the background canvas
+     *
+     * Refills the region and replays the recorded display list clipped to it;
+     * the rest of the canvas is kept. Falls back to drawBackground() when
+     * nothing has been recorded yet.
+     */
+    void restoreBackground(int32_t x, int32_t y, int32_t w, int32_t h);
+
     /**
      * @brief Draws the data layer (data line)
      *
@@ -139,6 +153,35 @@ public:
      */
     void drawData();
 
+    /**
+     * @brief Starts (or restarts) a time-sliced redraw of the given layers
+     *
+     * drawBackground() and drawData() run to completion in one call. Here
+     * the same work is split into slices that stepRedraw() runs within a
+     * per-frame budget. The slices draw into back surfaces, so the front
+     * surfaces, the composite buffer and the screen keep the previous frame
+     * until every requested layer is complete and swapped in at once.
+     *
+     * @param background Redraw the background layer
+     * @param data Redraw the data layer
+     * @return false if the back surfaces could not be allocated; the layers
+     *         were then drawn in place and can be presented right away
+     */
+    bool requestRedraw(bool background, bool data);
+
+    /**
+     * @brief Runs pending redraw slices for about budget_us microseconds
+     *
+     * Always makes some progress, so a budget of 0 runs one slice.
+     *
+     * @return true when the redraw completed and was swapped to the front
+     *         during this call; present as after drawData()
+     */
+    bool stepRedraw(uint32_t budget_us);
+
+    /** @brief Whether a requestRedraw() is still in progress */
+    bool isRedrawPending() const { return bg_job_.active || data_job_.active; }
+
     /**
      * @brief Renders the final composition to the main display
      *
@@ -147,6 +190,18 @@ public:
      */
     void render();
 
+    /**
+     * @brief Composites background + data into the composite buffer only
+     *
+     * For layer mode: the caller presents the surface (e.g. attaches it to
+     * a UILayer) instead of render() blitting it. The surface is in the
+     * panel's native format and stays valid until the graph is destroyed.
+     *
+     * @param out_surface Receives the composite buffer description
+     * @return false if the composite buffer could not be allocated
+     */
+    bool composite(hal_surface_t* out_surface);
+
     /**
      * @brief Updates animation state and draws to main display
      *
@@ -181,7 +236,8 @@ private:
     // Layered rendering system
     Arduino_GFX* main_display_;           ///< Main hardware display
     Arduino_Canvas* bg_canvas_;           ///< Background canvas (PSRAM)
-    Arduino_Canvas* data_canvas_;         ///< Data canvas (PSRAM)
+    IndexedCanvas* data_canvas_;          ///< Data canvas (draws into data_layer_)
+    IndexedSurface data_layer_;           ///< Palette-indexed data layer (PSRAM)
 
     RelativeDisplay* rel_main_;           ///< RelativeDisplay for main display
     RelativeDisplay* rel_bg_;             ///< RelativeDisplay for background canvas
@@ -190,6 +246,7 @@ private:
     // Composite buffer for efficient rendering
     uint16_t* composite_buffer_;          ///< Composited frame buffer (PSRAM)
     size_t composite_buffer_size_;        ///< Size of composite buffer in pixels
+    hal_pixel_format_t bg_format_;        ///< Byte order of bg canvas and composite buffer
 
     // Animation state
     float pulse_phase_;                   ///< Current phase of pulse animation (0 to 2*PI)
@@ -210,6 +267,77 @@ private:
     double cached_y_max_;
     bool range_cached_;
 
+    // Recorded static background content (pixel coordinates)
+    DisplayList bg_list_;
+    bool bg_list_valid_;
+
+    // Time-sliced redraw (requestRedraw()/stepRedraw())
+    enum RedrawStage : uint8_t {
+        STAGE_FILL,     ///< Background fill, by rows
+        STAGE_REPLAY,   ///< Background display list, by commands
+        STAGE_LINE,     ///< Data line, by segments
+        STAGE_DONE      ///< Waiting for the other layer before the swap
+    };
+    struct RedrawJob {
+        bool active;
+        RedrawStage stage;
+        size_t cursor;    ///< Next row, command or segment
+    };
+    RedrawJob bg_job_;
+    RedrawJob data_job_;
+
+    // Back surfaces, allocated on the first requestRedraw()
+    Arduino_Canvas* bg_back_canvas_;
+    RelativeDisplay* rel_bg_back_;
+    IndexedSurface data_back_;
+    IndexedCanvas* data_back_canvas_;
+    RelativeDisplay* rel_data_back_;
+
+    /**
+     * @brief Allocates the back surfaces the requested layers need
+     */
+    bool allocateBackSurfaces(bool background, bool data);
+
+    /**
+     * @brief Records the static background content if it changed
+     */
+    void recordStaticContent();
+
+    /**
+     * @brief Runs one slice of a job; returns true when the job is done
+     */
+    bool stepBackgroundJob();
+    bool stepDataJob();
+
+    /**
+     * @brief Fills a background region with the theme color or gradient
+     */
+    void fillBackground(Arduino_GFX* canvas, int32_t x, int32_t y, int32_t w, int32_t h);
+
+    /**
+     * @brief Clears the data layer to transparent, re-initializing it if
+     * the theme switched between solid and gradient lines
+     */
+    bool clearDataLayer(IndexedSurface& layer);
+
+    /**
+     * @brief Fills a background region (color or gradient) and replays the
+     * display list clipped to it
+     */
+    void paintBackground(int32_t x, int32_t y, int32_t w, int32_t h);
+
+    /**
+     * @brief Draws the watermark, axes, ticks and titles to the given
+     * RelativeDisplay (recorded by drawBackground())
+     */
+    void drawStaticContent(RelativeDisplay* target);
+
+    /**
+     * @brief Bits per pixel for the data layer: 1 for a solid line (line color
+     * plus transparency), 8 for a gradient line
+     */
+    uint8_t dataLayerBitsPerPixel() const;
+
     /**
      * @brief Draws the X and Y axes to the given RelativeDisplay
      */
@@ -235,6 +363,11 @@ private:
      */
     void drawDataLine(RelativeDisplay* target);
 
+    /**
+     * @brief Draws the line segments ending at points [first, last)
+     */
+    void drawDataSegments(RelativeDisplay* target, size_t first, size_t last);
+
     /**
      * @brief Draws the live data indicator at the last point
      *
@@ -1,9 +1,8 @@
 #include "vector_renderer.h"
-#include "../hal/display.h"
+#include "triangle_rasterizer.h"
 #include <Arduino_GFX_Library.h>
-
-// Transparent color for canvas-based rendering (bright magenta — unlikely in real content)
-static const uint16_t VECTOR_TRANSPARENT = 0xF81F;
+#include <math.h>
+#include <vector>
 
 void VectorRenderer::draw(
     RelativeDisplay& display,
@@ -17,99 +16,110 @@ void VectorRenderer::draw(
     // Calculate aspect ratio from original dimensions
     float shape_aspect_ratio = shape.original_height / shape.original_width;
 
-    // Get screen dimensions to account for screen aspect ratio
-    int32_t screen_width = hal_display_get_width_pixels();
-    int32_t screen_height = hal_display_get_height_pixels();
-    float screen_aspect_ratio = static_cast<float>(screen_width) / static_cast<float>(screen_height);
-
-    // Calculate target dimensions in percent
-    float target_width = width_percent;
-    float target_height = width_percent * shape_aspect_ratio * screen_aspect_ratio;
-
-    // Calculate base position adjusted for anchor
-    float base_x = x_percent - (anchor_x * target_width);
-    float base_y = y_percent - (anchor_y * target_height);
-
-    // First pass: compute pixel bounding box of all triangles
-    int32_t min_px = screen_width, min_py = screen_height;
-    int32_t max_px = 0, max_py = 0;
-
-    for (size_t pi = 0; pi < shape.num_paths; pi++) {
-        const VectorPath& path = shape.paths[pi];
-        for (size_t ti = 0; ti < path.num_tris; ti++) {
-            const VectorTriangle& tri = path.tris[ti];
-            int32_t vx[3], vy[3];
-            vx[0] = display.relativeToAbsoluteX(base_x + tri.v1.x * target_width);
-            vy[0] = display.relativeToAbsoluteY(base_y + tri.v1.y * target_height);
-            vx[1] = display.relativeToAbsoluteX(base_x + tri.v2.x * target_width);
-            vy[1] = display.relativeToAbsoluteY(base_y + tri.v2.y * target_height);
-            vx[2] = display.relativeToAbsoluteX(base_x + tri.v3.x * target_width);
-            vy[2] = display.relativeToAbsoluteY(base_y + tri.v3.y * target_height);
-            for (int v = 0; v < 3; v++) {
-                if (vx[v] < min_px) min_px = vx[v];
-                if (vy[v] < min_py) min_py = vy[v];
-                if (vx[v] > max_px) max_px = vx[v];
-                if (vy[v] > max_py) max_py = vy[v];
-            }
-        }
+    // Target size in pixels; height follows the shape's aspect ratio so the
+    // result is undistorted regardless of the screen's aspect ratio
+    float screen_width = static_cast<float>(display.getWidth());
+    float screen_height = static_cast<float>(display.getHeight());
+    float width_px = (width_percent / 100.0f) * screen_width;
+    float height_px = width_px * shape_aspect_ratio;
+
+    // Top-left corner adjusted for anchor (sub-pixel precision is kept)
+    float origin_x = (x_percent / 100.0f) * screen_width - anchor_x * width_px;
+    float origin_y = (y_percent / 100.0f) * screen_height - anchor_y * height_px;
+
+    // Preferred path: rasterize straight into the shadow framebuffer with AA.
+    // Only in shadow-primary mode: otherwise the shadow is just a mirror, and
+    // pushing the bounds from it would overwrite pixels drawn through GFX
+    // since the last sync
+    hal_surface_t fb;
+    if (hal_display_is_shadow_primary() && hal_display_lock_surface(nullptr, &fb)) {
+        rasterize(shape, fb, origin_x, origin_y, width_px, height_px, nullptr, true);
+
+        // Damage is the shape's precomputed bounds, not its whole box
+        const float scale_x = width_px / VECTOR_COORD_ONE;
+        const float scale_y = height_px / VECTOR_COORD_ONE;
+        int32_t x0 = static_cast<int32_t>(floorf(origin_x + shape.bounds.min_x * scale_x));
+        int32_t y0 = static_cast<int32_t>(floorf(origin_y + shape.bounds.min_y * scale_y));
+        int32_t x1 = static_cast<int32_t>(ceilf(origin_x + shape.bounds.max_x * scale_x)) + 1;
+        int32_t y1 = static_cast<int32_t>(ceilf(origin_y + shape.bounds.max_y * scale_y)) + 1;
+        hal_display_unlock_surface(nullptr, x0, y0, x1 - x0, y1 - y0);
+        return;
     }
 
-    // Clamp to screen bounds
-    if (min_px < 0) min_px = 0;
-    if (min_py < 0) min_py = 0;
-    if (max_px >= screen_width) max_px = screen_width - 1;
-    if (max_py >= screen_height) max_py = screen_height - 1;
-
-    int16_t cw = static_cast<int16_t>(max_px - min_px + 1);
-    int16_t ch = static_cast<int16_t>(max_py - min_py + 1);
-    if (cw <= 0 || ch <= 0) return;
-
-    // Try to create a temporary canvas for shadow-buffer-aware rendering
-    hal_canvas_handle_t canvas = hal_display_canvas_create(cw, ch);
-    Arduino_GFX* draw_target;
-    int32_t offset_x, offset_y;
-    bool using_canvas = false;
-
-    if (canvas) {
-        hal_display_canvas_fill(canvas, VECTOR_TRANSPARENT);
-        draw_target = static_cast<Arduino_GFX*>(
-            static_cast<Arduino_Canvas*>(canvas));
-        offset_x = min_px;
-        offset_y = min_py;
-        using_canvas = true;
-    } else {
-        // Fallback: draw directly to GFX (no shadow buffer capture)
-        draw_target = display.getGfx();
-        offset_x = 0;
-        offset_y = 0;
+    // Fallback: draw directly to GFX (no shadow buffer capture)
+    Arduino_GFX* gfx = display.getGfx();
+    if (gfx == nullptr) return;
+
+    const float scale_x = width_px / VECTOR_COORD_ONE;
+    const float scale_y = height_px / VECTOR_COORD_ONE;
+    for (size_t mi = 0; mi < shape.num_meshes; mi++) {
+        const VectorMesh& mesh = shape.meshes[mi];
+        for (uint16_t i = 0; i + 2 < mesh.num_indices; i += 3) {
+            const VectorVertex& v1 = mesh.vertices[mesh.indices[i]];
+            const VectorVertex& v2 = mesh.vertices[mesh.indices[i + 1]];
+            const VectorVertex& v3 = mesh.vertices[mesh.indices[i + 2]];
+            gfx->fillTriangle(
+                static_cast<int16_t>(lroundf(origin_x + v1.x * scale_x)),
+                static_cast<int16_t>(lroundf(origin_y + v1.y * scale_y)),
+                static_cast<int16_t>(lroundf(origin_x + v2.x * scale_x)),
+                static_cast<int16_t>(lroundf(origin_y + v2.y * scale_y)),
+                static_cast<int16_t>(lroundf(origin_x + v3.x * scale_x)),
+                static_cast<int16_t>(lroundf(origin_y + v3.y * scale_y)),
+                mesh.color);
+        }
     }
+}
 
-    // Second pass: draw all triangles
-    for (size_t pi = 0; pi < shape.num_paths; pi++) {
-        const VectorPath& path = shape.paths[pi];
-        for (size_t ti = 0; ti < path.num_tris; ti++) {
-            const VectorTriangle& tri = path.tris[ti];
+void VectorRenderer::rasterize(
+    const VectorShape& shape,
+    const hal_surface_t& target,
+    float origin_x,
+    float origin_y,
+    float width_px,
+    float height_px,
+    const uint16_t* palette,
+    bool antialias
+) {
+    if (target.pixels == nullptr || width_px <= 0.0f || height_px <= 0.0f) return;
+
+    TriangleRasterizer rasterizer(target);
+    rasterizer.setAntiAlias(antialias);
+
+    const float scale_x = width_px / VECTOR_COORD_ONE;
+    const float scale_y = height_px / VECTOR_COORD_ONE;
+
+    // Meshes are already merged by color at build time; each vertex is
+    // transformed once and shared by every triangle that indexes it
+    std::vector<RasterVertex> verts;
+    std::vector<RasterTriangle> tris;
 
-            int32_t x1 = display.relativeToAbsoluteX(base_x + tri.v1.x * target_width) - offset_x;
-            int32_t y1 = display.relativeToAbsoluteY(base_y + tri.v1.y * target_height) - offset_y;
-            int32_t x2 = display.relativeToAbsoluteX(base_x + tri.v2.x * target_width) - offset_x;
-            int32_t y2 = display.relativeToAbsoluteY(base_y + tri.v2.y * target_height) - offset_y;
-            int32_t x3 = display.relativeToAbsoluteX(base_x + tri.v3.x * target_width) - offset_x;
-            int32_t y3 = display.relativeToAbsoluteY(base_y + tri.v3.y * target_height) - offset_y;
+    for (size_t mi = 0; mi < shape.num_meshes; mi++) {
+        const VectorMesh& mesh = shape.meshes[mi];
 
-            draw_target->fillTriangle(x1, y1, x2, y2, x3, y3, path.color);
+        // Skip meshes whose precomputed bounds miss the target entirely
+        float left = origin_x + mesh.bounds.min_x * scale_x;
+        float top = origin_y + mesh.bounds.min_y * scale_y;
+        float right = origin_x + mesh.bounds.max_x * scale_x;
+        float bottom = origin_y + mesh.bounds.max_y * scale_y;
+        if (right < 0.0f || bottom < 0.0f ||
+            left >= static_cast<float>(target.width) || top >= static_cast<float>(target.height)) {
+            continue;
+        }
+
+        verts.resize(mesh.num_vertices);
+        for (uint16_t vi = 0; vi < mesh.num_vertices; vi++) {
+            verts[vi].x = TriangleRasterizer::toFixed(origin_x + mesh.vertices[vi].x * scale_x);
+            verts[vi].y = TriangleRasterizer::toFixed(origin_y + mesh.vertices[vi].y * scale_y);
         }
-    }
 
-    // Blit canvas to display via HAL (updates both display and shadow buffer)
-    if (using_canvas) {
-        Arduino_Canvas* canvas_ptr = static_cast<Arduino_Canvas*>(canvas);
-        uint16_t* fb = canvas_ptr->getFramebuffer();
-        if (fb) {
-            hal_display_fast_blit_transparent(
-                static_cast<int16_t>(min_px), static_cast<int16_t>(min_py),
-                cw, ch, fb, VECTOR_TRANSPARENT);
+        tris.resize(mesh.num_indices / 3);
+        for (size_t ti = 0; ti < tris.size(); ti++) {
+            tris[ti].v[0] = verts[mesh.indices[ti * 3]];
+            tris[ti].v[1] = verts[mesh.indices[ti * 3 + 1]];
+            tris[ti].v[2] = verts[mesh.indices[ti * 3 + 2]];
         }
-        hal_display_canvas_delete(canvas);
+
+        uint16_t color = palette ? palette[mi] : mesh.color;
+        rasterizer.fillMesh(tris.data(), tris.size(), color);
     }
 }
@@ -2,12 +2,14 @@
 
 #include "relative_display.h"
 #include "generated/vector_assets.h"
+#include "../hal/display.h"
 
 /**
  * VectorRenderer - Renders vector shapes (triangulated SVG assets) to a RelativeDisplay.
  *
- * Transforms normalized [0,1] vertex coordinates to screen space based on positioning,
- * scaling, and anchor point parameters.
+ * Transforms quantized vertex coordinates (VECTOR_COORD_ONE == full asset size) to
+ * screen space based on positioning, scaling, and anchor point parameters. Triangles are filled by TriangleRasterizer
+ * (16.4 fixed point, top-left rule, optional 4x AA).
  */
 class VectorRenderer {
 public:
@@ -31,4 +33,27 @@ public:
         float anchor_x = 0.5f,
         float anchor_y = 0.5f
     );
+
+    /**
+     * Rasterize a shape into a surface using the fixed-point TriangleRasterizer.
+     * Pixels outside the shape are left untouched; with anti-aliasing, edge
+     * pixels blend with the existing surface contents.
+     *
+     * @param shape VectorShape data (from generated/vector_assets.h)
+     * @param target Destination surface
+     * @param origin_x,origin_y Top-left corner of the shape in the surface (pixels, sub-pixel allowed)
+     * @param width_px,height_px Size of the rasterized shape in pixels
+     * @param palette Optional per-mesh colors (shape.num_meshes entries), nullptr for asset colors
+     * @param antialias Enable 4x coverage anti-aliasing
+     */
+    static void rasterize(
+        const VectorShape& shape,
+        const hal_surface_t& target,
+        float origin_x,
+        float origin_y,
+        float width_px,
+        float height_px,
+        const uint16_t* palette = nullptr,
+        bool antialias = false
+    );
 };
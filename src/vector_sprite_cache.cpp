@@ -0,0 +1,107 @@
+#include "vector_sprite_cache.h"
+#include "vector_renderer.h"
+#include <math.h>
+#include <vector>
+
+VectorSpriteCache& VectorSpriteCache::getInstance() {
+    static VectorSpriteCache instance;
+    return instance;
+}
+
+VectorSpriteCache::VectorSpriteCache()
+    : m_useCounter(0)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+const RleSprite* VectorSpriteCache::get(const VectorShape& shape, int16_t width_px,
+                                        int16_t height_px, const uint16_t* palette) {
+    if (width_px <= 0 || height_px <= 0) return nullptr;
+
+    m_useCounter++;
+
+    // Hit: same asset, size and palette
+    Entry* victim = &m_entries[0];
+    for (int i = 0; i < MAX_ENTRIES; i++) {
+        Entry& e = m_entries[i];
+        if (e.shape == &shape && e.palette == palette &&
+            e.width == width_px && e.height == height_px) {
+            e.lastUse = m_useCounter;
+            m_hits++;
+            return &e.sprite;
+        }
+        // Track the least recently used slot (empty slots have lastUse 0)
+        if (e.lastUse < victim->lastUse) {
+            victim = &e;
+        }
+    }
+
+    // Miss: rasterize into a scratch buffer, then keep only the runs
+    m_misses++;
+    std::vector<uint16_t> scratch(static_cast<size_t>(width_px) * height_px, TRANSPARENT_KEY);
+    hal_surface_t surface = { scratch.data(), width_px, height_px, width_px, HAL_PIXEL_FORMAT_RGB565 };
+    // No AA: edge pixels would blend with the chroma key
+    VectorRenderer::rasterize(shape, surface, 0.0f, 0.0f, width_px, height_px, palette, false);
+
+    victim->sprite.encode(scratch.data(), width_px, height_px, width_px, TRANSPARENT_KEY);
+    victim->shape = &shape;
+    victim->palette = palette;
+    victim->width = width_px;
+    victim->height = height_px;
+    victim->lastUse = m_useCounter;
+    return &victim->sprite;
+}
+
+bool VectorSpriteCache::draw(RelativeDisplay& display, const VectorShape& shape,
+                             float x_percent, float y_percent, float width_percent,
+                             float anchor_x, float anchor_y, const uint16_t* palette) {
+    int32_t left, top;
+    const RleSprite* sprite = place(display, shape, x_percent, y_percent, width_percent,
+                                    anchor_x, anchor_y, palette, &left, &top);
+    if (sprite == nullptr) return false;
+
+    sprite->blit(left, top);
+    return true;
+}
+
+const RleSprite* VectorSpriteCache::place(RelativeDisplay& display, const VectorShape& shape,
+                                          float x_percent, float y_percent, float width_percent,
+                                          float anchor_x, float anchor_y, const uint16_t* palette,
+                                          int32_t* out_left, int32_t* out_top) {
+    // Same sizing as VectorRenderer::draw(): width from percent, height from aspect
+    int32_t width_px = display.relativeToAbsoluteWidth(width_percent);
+    float shape_aspect_ratio = shape.original_height / shape.original_width;
+    int32_t height_px = static_cast<int32_t>(roundf(static_cast<float>(width_px) * shape_aspect_ratio));
+
+    const RleSprite* sprite = get(shape, static_cast<int16_t>(width_px),
+                                  static_cast<int16_t>(height_px), palette);
+    if (sprite == nullptr) return nullptr;
+
+    *out_left = display.relativeToAbsoluteX(x_percent) -
+                static_cast<int32_t>(roundf(anchor_x * static_cast<float>(width_px)));
+    *out_top = display.relativeToAbsoluteY(y_percent) -
+               static_cast<int32_t>(roundf(anchor_y * static_cast<float>(height_px)));
+    return sprite;
+}
+
+void VectorSpriteCache::clear() {
+    for (int i = 0; i < MAX_ENTRIES; i++) {
+        m_entries[i].sprite.clear();
+        m_entries[i].shape = nullptr;
+        m_entries[i].palette = nullptr;
+        m_entries[i].width = 0;
+        m_entries[i].height = 0;
+        m_entries[i].lastUse = 0;
+    }
+    m_hits = 0;
+    m_misses = 0;
+}
+
+int VectorSpriteCache::getEntryCount() const {
+    int count = 0;
+    for (int i = 0; i < MAX_ENTRIES; i++) {
+        if (m_entries[i].shape != nullptr) count++;
+    }
+    return count;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+#include "rle_sprite.h"
+#include "relative_display.h"
+#include "generated/vector_assets.h"
+
+/**
+ * VectorSpriteCache - Rasterize-once cache for vector assets.
+ *
+ * Sprites are keyed by (asset, pixel width, pixel height, palette). The first
+ * request rasterizes the shape into a scratch buffer and run-length encodes it;
+ * every later request with the same key only blits the cached runs.
+ *
+ * The anchor is resolved to a whole-pixel blit origin, so it does not change
+ * the rasterized pixels and is not part of the key.
+ */
+class VectorSpriteCache {
+public:
+    static constexpr int MAX_ENTRIES = 4;
+
+    /** Chroma key used while encoding; palettes must not contain it. */
+    static constexpr uint16_t TRANSPARENT_KEY = 0xF81F;
+
+    static VectorSpriteCache& getInstance();
+
+    /**
+     * Look up (or build) the sprite for a shape at a given pixel size.
+     *
+     * @param shape VectorShape data (from generated/vector_assets.h)
+     * @param width_px Width in pixels
+     * @param height_px Height in pixels
+     * @param palette Optional per-mesh colors (shape.num_meshes entries).
+     *                Compared by address, so pass a persistent array.
+     * @return Cached sprite, or nullptr if the size is invalid
+     */
+    const RleSprite* get(const VectorShape& shape, int16_t width_px, int16_t height_px,
+                         const uint16_t* palette = nullptr);
+
+    /**
+     * Draw a shape using the same placement rules as VectorRenderer::draw().
+     *
+     * @return true if a cached sprite was blitted
+     */
+    bool draw(RelativeDisplay& display, const VectorShape& shape,
+              float x_percent, float y_percent, float width_percent,
+              float anchor_x = 0.5f, float anchor_y = 0.5f,
+              const uint16_t* palette = nullptr);
+
+    /**
+     * Resolve the sprite and top-left corner draw() would use, without
+     * drawing (e.g. to render into an offscreen layer).
+     *
+     * @return Cached sprite, or nullptr if the size is invalid
+     */
+    const RleSprite* place(RelativeDisplay& display, const VectorShape& shape,
+                           float x_percent, float y_percent, float width_percent,
+                           float anchor_x, float anchor_y, const uint16_t* palette,
+                           int32_t* out_left, int32_t* out_top);
+
+    /** Drop all cached sprites. */
+    void clear();
+
+    int getEntryCount() const;
+    uint32_t getHitCount() const { return m_hits; }
+    uint32_t getMissCount() const { return m_misses; }
+
+private:
+    VectorSpriteCache();
+    VectorSpriteCache(const VectorSpriteCache&) = delete;
+    VectorSpriteCache& operator=(const VectorSpriteCache&) = delete;
+
+    struct Entry {
+        const VectorShape* shape = nullptr;
+        const uint16_t* palette = nullptr;
+        int16_t width = 0;
+        int16_t height = 0;
+        uint32_t lastUse = 0;
+        RleSprite sprite;
+    };
+
+    Entry m_entries[MAX_ENTRIES];
+    uint32_t m_useCounter;
+    uint32_t m_hits;
+    uint32_t m_misses;
+};
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdlib.h>
 #include <thread>
 #include <chrono>
 
@@ -23,6 +24,25 @@ inline void delayMicroseconds(unsigned int us) {
     std::this_thread::sleep_for(std::chrono::microseconds(us));
 }
 
+// Nothing to feed on the host
+inline void yield(void) {}
+
+// No PSRAM on the host: plain heap
+inline void* ps_malloc(size_t size) {
+    return malloc(size);
+}
+
 #ifdef __cplusplus
 }
+
+// Mock Serial: log output is dropped in native tests
+class MockSerial {
+public:
+    size_t print(const char* str) { (void)str; return 0; }
+    size_t println(const char* str = "") { (void)str; return 0; }
+    template <typename... Args>
+    size_t printf(const char* format, Args...) { (void)format; return 0; }
+};
+
+static MockSerial Serial;
 #endif
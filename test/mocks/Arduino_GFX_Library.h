@@ -8,14 +8,19 @@
 
 #pragma once
 
+#include <Arduino.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <vector>
 
 // Define PROGMEM for native environment (no-op)
 #ifndef PROGMEM
 #define PROGMEM
 #endif
 
+#define GFX_NOT_DEFINED -1
+#define GFX_SKIP_OUTPUT_BEGIN -2
+
 // GFX font structures (from Adafruit_GFX)
 typedef struct {
     uint16_t bitmapOffset;  ///< Pointer into GFXfont->bitmap
@@ -44,6 +49,12 @@ public:
     virtual bool begin(int32_t speed = 0) = 0;
     virtual void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) = 0;
 
+    // Low-level write methods (called by the drawing methods in the real library)
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { (void)x; (void)y; (void)w; (void)color; }
+    virtual void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        (void)x; (void)y; (void)w; (void)h; (void)color;
+    }
+
     // Drawing methods that can be overridden
     virtual void drawPixel(int16_t x, int16_t y, uint16_t color) {}
     virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {}
@@ -55,6 +66,7 @@ public:
     // Text methods
     virtual void setFont(const GFXfont* f = nullptr) { (void)f; }
     virtual void setTextColor(uint16_t color) { (void)color; }
+    virtual void setTextSize(uint8_t s) { (void)s; }
     virtual void setCursor(int16_t x, int16_t y) { (void)x; (void)y; }
     virtual size_t print(const char* str) { (void)str; return 0; }
     virtual void getTextBounds(const char* str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
@@ -73,18 +85,40 @@ protected:
     int16_t _height;
 };
 
-// Minimal stub of Arduino_Canvas class for testing
+// Minimal stub of Arduino_Canvas class for testing: an RGB565 framebuffer
+// that the rectangle and pixel primitives draw into
 class Arduino_Canvas : public Arduino_GFX {
 public:
     Arduino_Canvas(int16_t w, int16_t h, Arduino_GFX *output) : Arduino_GFX(w, h), _output(output) {}
     virtual ~Arduino_Canvas() {}
 
-    bool begin(int32_t speed = 0) override { return true; }
-    void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override {}
-    void fillScreen(uint16_t color) { (void)color; }
+    bool begin(int32_t speed = 0) override {
+        (void)speed;
+        _framebuffer.assign(static_cast<size_t>(_width) * _height, 0);
+        return true;
+    }
+    void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override {
+        if (!_framebuffer.empty()) _framebuffer[static_cast<size_t>(y) * _width + x] = color;
+    }
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (x >= 0 && y >= 0 && x < _width && y < _height) writePixelPreclipped(x, y, color);
+    }
+    void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override { fillRect(x, y, w, 1, color); }
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override { fillRect(x, y, w, 1, color); }
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override { fillRect(x, y, 1, h, color); }
+    void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+        fillRect(x, y, w, h, color);
+    }
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+        for (int16_t py = y; py < y + h; py++) {
+            for (int16_t px = x; px < x + w; px++) drawPixel(px, py, color);
+        }
+    }
+    void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
     void flush() {}
-    uint16_t* getFramebuffer() { return nullptr; }
+    uint16_t* getFramebuffer() { return _framebuffer.empty() ? nullptr : _framebuffer.data(); }
 
 protected:
     Arduino_GFX *_output;
+    std::vector<uint16_t> _framebuffer;
 };
@@ -8,13 +8,19 @@
 
 #include <unity.h>
 #include "../../src/animation_ticker.h"
+#include "../../src/job_scheduler.h"
 
 // Mock state for hal_timer_get_micros
 static uint64_t mock_current_time_micros = 0;
 
-// Mock state to track delay calls
+// Mock state to track sleeps
 static uint64_t total_delay_micros = 0;
 
+// When set, sleeping advances the virtual clock to the deadline plus a
+// wake-up latency, like a real task delay
+static bool mock_sleep_advances_clock = false;
+static uint64_t mock_wake_latency_micros = 0;
+
 // Mock implementation of hal_timer_get_micros
 extern "C" uint64_t hal_timer_get_micros(void) {
     return mock_current_time_micros;
@@ -25,20 +31,41 @@ extern "C" bool hal_timer_init(void) {
     return true;
 }
 
-// Mock implementation of delay (Arduino function)
-extern "C" void delay(unsigned long ms) {
-    total_delay_micros += ms * 1000;
+// Idle waits: woken at mock_wake_at_micros if that comes before the
+// deadline, else time out at the deadline; the virtual clock advances
+static uint64_t mock_wake_at_micros = 0;
+static uint64_t last_wait_deadline = 0;
+static int wait_calls = 0;
+
+extern "C" bool hal_timer_wait_for_wake(uint64_t deadline_micros) {
+    wait_calls++;
+    last_wait_deadline = deadline_micros;
+    if (mock_wake_at_micros != 0 && mock_wake_at_micros < deadline_micros) {
+        mock_current_time_micros = mock_wake_at_micros;
+        return true;
+    }
+    mock_current_time_micros = deadline_micros;
+    return false;
 }
 
-// Mock implementation of delayMicroseconds (Arduino function)
-extern "C" void delayMicroseconds(unsigned int us) {
-    total_delay_micros += us;
+// Mock implementation of hal_timer_sleep_until
+extern "C" void hal_timer_sleep_until(uint64_t deadline_micros) {
+    if (deadline_micros <= mock_current_time_micros) return;
+    total_delay_micros += deadline_micros - mock_current_time_micros;
+    if (mock_sleep_advances_clock) {
+        mock_current_time_micros = deadline_micros + mock_wake_latency_micros;
+    }
 }
 
 void setUp(void) {
     // Reset mock state before each test
     mock_current_time_micros = 0;
     total_delay_micros = 0;
+    mock_sleep_advances_clock = false;
+    mock_wake_latency_micros = 0;
+    mock_wake_at_micros = 0;
+    last_wait_deadline = 0;
+    wait_calls = 0;
 }
 
 void tearDown(void) {
@@ -188,6 +215,225 @@ void test_returns_correct_delta_time(void) {
     TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.033333f, deltaTime);
 }
 
+// A deferred job whose steps take 4 ms of (virtual) time, 20 steps in all
+static int job_steps_left = 0;
+
+static bool fourMillisecondStep(void* context, uint32_t budget_us) {
+    mock_current_time_micros += 4000;
+    return --job_steps_left <= 0;
+}
+
+/**
+ * Test: Jobs run in the frame slack, stop short of the next frame, and
+ * replace the busy-wait instead of adding to it
+ */
+void test_scheduler_runs_in_frame_slack(void) {
+    AnimationTicker ticker(30);
+    JobScheduler scheduler;
+    ticker.setScheduler(&scheduler);
+
+    mock_current_time_micros = 1000000;
+    ticker.waitForNextFrame();
+
+    job_steps_left = 20;
+    scheduler.submit(fourMillisecondStep, nullptr, JobScheduler::Priority::NORMAL, 0, 4000);
+
+    // 10 ms of work leaves 23333 us; 5 steps (20 ms) fit before the guard
+    mock_current_time_micros += 10000;
+    total_delay_micros = 0;
+    ticker.waitForNextFrame();
+    TEST_ASSERT_EQUAL_UINT32(5, scheduler.getStats().steps);
+    TEST_ASSERT_UINT_WITHIN(100, 3333, total_delay_micros);
+    uint64_t frame_end = mock_current_time_micros + total_delay_micros;
+    TEST_ASSERT_UINT64_WITHIN(100, 1033333, frame_end);
+
+    // The frame schedule is unchanged: the next frame still gets its slack
+    mock_current_time_micros = frame_end + 10000;
+    total_delay_micros = 0;
+    ticker.waitForNextFrame();
+    TEST_ASSERT_EQUAL_UINT32(10, scheduler.getStats().steps);
+    TEST_ASSERT_UINT_WITHIN(100, 3333, total_delay_micros);
+
+    // No slack, no jobs
+    mock_current_time_micros += total_delay_micros + 40000;
+    ticker.waitForNextFrame();
+    TEST_ASSERT_EQUAL_UINT32(10, scheduler.getStats().steps);
+    TEST_ASSERT_EQUAL(1, scheduler.getPendingCount());
+}
+
+/**
+ * Test: The rate can change between frames; the frame in progress keeps its
+ * start and takes the new length
+ */
+void test_target_fps_changes_frame_time(void) {
+    AnimationTicker ticker(30);
+    mock_sleep_advances_clock = true;
+
+    mock_current_time_micros = 1000000;
+    ticker.waitForNextFrame();
+
+    // Speed up to 60fps mid-frame: this frame ends at 1000000 + 16666
+    mock_current_time_micros += 5000;
+    ticker.setTargetFps(60);
+    TEST_ASSERT_EQUAL_UINT32(60, ticker.getTargetFps());
+    ticker.waitForNextFrame();
+    TEST_ASSERT_EQUAL_UINT64(1016666, mock_current_time_micros);
+
+    // And the next one a full 60fps frame later
+    mock_current_time_micros += 1000;
+    ticker.waitForNextFrame();
+    TEST_ASSERT_EQUAL_UINT64(1033332, mock_current_time_micros);
+
+    // Nothing moves: pace at the minimum rate (10fps)
+    ticker.setTargetFps(0);
+    TEST_ASSERT_EQUAL_UINT32(AnimationTicker::DEFAULT_MIN_FPS, ticker.getTargetFps());
+    ticker.waitForNextFrame();
+    TEST_ASSERT_EQUAL_UINT64(1033332 + 100000, mock_current_time_micros);
+
+    // Requests above the limit are clamped
+    ticker.setTargetFps(240);
+    TEST_ASSERT_EQUAL_UINT32(AnimationTicker::DEFAULT_MAX_FPS, ticker.getTargetFps());
+    ticker.setFpsLimits(1, 120);
+    ticker.setTargetFps(240);
+    TEST_ASSERT_EQUAL_UINT32(120, ticker.getTargetFps());
+    ticker.setTargetFps(1);
+    TEST_ASSERT_EQUAL_UINT32(1, ticker.getTargetFps());
+}
+
+/**
+ * Test: Jitter is the wake-up error, or the overrun of a late frame
+ */
+void test_jitter_statistics(void) {
+    AnimationTicker ticker(30);
+    mock_sleep_advances_clock = true;
+
+    mock_current_time_micros = 1000000;
+    ticker.waitForNextFrame();
+
+    // Three frames that wake 200, 400 and 0 us late
+    const uint64_t latencies[3] = { 200, 400, 0 };
+    for (int i = 0; i < 3; i++) {
+        mock_wake_latency_micros = latencies[i];
+        mock_current_time_micros += 1000;
+        ticker.waitForNextFrame();
+    }
+
+    // The schedule is absolute: wake-up latency doesn't accumulate
+    TEST_ASSERT_EQUAL_UINT64(1000000 + 3 * 33333, mock_current_time_micros);
+
+    // A frame whose work overruns by 5 ms
+    mock_current_time_micros += 33333 + 5000;
+    ticker.waitForNextFrame();
+
+    const AnimationTicker::FrameStats& stats = ticker.getStats();
+    TEST_ASSERT_EQUAL_UINT32(4, stats.frames);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.late_frames);
+    TEST_ASSERT_EQUAL_UINT32(5000, stats.max_jitter_micros);
+    TEST_ASSERT_EQUAL_UINT32((200 + 400 + 0 + 5000) / 4, ticker.getMeanJitterMicros());
+
+    ticker.resetStats();
+    TEST_ASSERT_EQUAL_UINT32(0, ticker.getStats().frames);
+    TEST_ASSERT_EQUAL_UINT32(0, ticker.getMeanJitterMicros());
+}
+
+/**
+ * Test: Idle frames block until woken, and the frame after a wake-up gets a
+ * normal deltaTime instead of the whole idle period
+ */
+void test_idle_waits_for_wake(void) {
+    AnimationTicker ticker(30);
+    mock_sleep_advances_clock = true;
+
+    mock_current_time_micros = 1000000;
+    ticker.waitForNextFrame();
+
+    // Go idle after a 5 ms frame; a touch wakes the task 1.5 s later
+    ticker.setIdle(true);
+    mock_current_time_micros += 5000;
+    mock_wake_at_micros = 2505000;
+    total_delay_micros = 0;
+    float deltaTime = ticker.waitForNextFrame();
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.005f, deltaTime);
+    TEST_ASSERT_EQUAL(1, wait_calls);
+    TEST_ASSERT_EQUAL_UINT64(1005000 + AnimationTicker::DEFAULT_MAX_IDLE_MICROS, last_wait_deadline);
+    TEST_ASSERT_EQUAL_UINT64(0, total_delay_micros);
+    TEST_ASSERT_EQUAL_UINT64(1005000 + AnimationTicker::DEFAULT_MAX_IDLE_MICROS, mock_current_time_micros);
+
+    // Nobody woke it within the limit; the next wait is woken by the touch
+    mock_current_time_micros += 2000;
+    ticker.waitForNextFrame();
+    TEST_ASSERT_EQUAL_UINT64(2505000, mock_current_time_micros);
+
+    // Active again: the first frame measures from the wake-up and is paced
+    // one frame after it
+    ticker.setIdle(false);
+    mock_current_time_micros += 10000;
+    deltaTime = ticker.waitForNextFrame();
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.010f, deltaTime);
+    TEST_ASSERT_EQUAL_UINT64(2505000 + 33333, mock_current_time_micros);
+
+    const AnimationTicker::FrameStats& stats = ticker.getStats();
+    TEST_ASSERT_EQUAL_UINT32(2, stats.idle_waits);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.idle_wakes);
+    TEST_ASSERT_EQUAL_UINT64(2505000 - 1005000 - 2000, stats.idle_micros);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.frames);
+}
+
+/**
+ * Test: An idle deadline (a component's wake-up) ends the wait before the cap
+ */
+void test_idle_deadline_ends_wait(void) {
+    AnimationTicker ticker(30);
+    mock_current_time_micros = 1000000;
+    ticker.waitForNextFrame();
+
+    ticker.setIdle(true);
+    ticker.setIdleDeadline(1250000);
+    ticker.waitForNextFrame();
+    TEST_ASSERT_EQUAL_UINT64(1250000, last_wait_deadline);
+    TEST_ASSERT_EQUAL_UINT64(1250000, mock_current_time_micros);
+
+    // Later than the cap: the cap still applies
+    ticker.setIdleDeadline(9000000);
+    ticker.waitForNextFrame();
+    TEST_ASSERT_EQUAL_UINT64(1250000 + AnimationTicker::DEFAULT_MAX_IDLE_MICROS, last_wait_deadline);
+
+    ticker.setIdleDeadline(0);
+    ticker.waitForNextFrame();
+    TEST_ASSERT_EQUAL_UINT64(2250000 + AnimationTicker::DEFAULT_MAX_IDLE_MICROS, last_wait_deadline);
+}
+
+// Deferred job step taking 1 ms of virtual time
+static bool oneMillisecondStep(void* context, uint32_t budget_us) {
+    mock_current_time_micros += 1000;
+    return false;
+}
+
+/**
+ * Test: Pending jobs keep frames coming while idle
+ */
+void test_idle_defers_to_pending_jobs(void) {
+    AnimationTicker ticker(30);
+    JobScheduler scheduler;
+    ticker.setScheduler(&scheduler);
+    ticker.setIdle(true);
+    ticker.setMaxIdleMicros(5000000);
+
+    mock_current_time_micros = 1000000;
+    ticker.waitForNextFrame();
+
+    int32_t job = scheduler.submit(oneMillisecondStep, nullptr, JobScheduler::Priority::NORMAL, 0, 1000);
+    mock_current_time_micros += 1000;
+    ticker.waitForNextFrame();
+    TEST_ASSERT_EQUAL(0, wait_calls);
+    TEST_ASSERT_TRUE(scheduler.getStats().steps > 0);
+
+    scheduler.cancel(job);
+    ticker.waitForNextFrame();
+    TEST_ASSERT_EQUAL(1, wait_calls);
+    TEST_ASSERT_EQUAL_UINT64(mock_current_time_micros, last_wait_deadline);
+}
+
 int main(int argc, char **argv) {
     UNITY_BEGIN();
 
@@ -197,6 +443,12 @@ int main(int argc, char **argv) {
     RUN_TEST(test_death_spiral_guard_resets_schedule);
     RUN_TEST(test_frame_rate_30fps);
     RUN_TEST(test_returns_correct_delta_time);
+    RUN_TEST(test_scheduler_runs_in_frame_slack);
+    RUN_TEST(test_target_fps_changes_frame_time);
+    RUN_TEST(test_jitter_statistics);
+    RUN_TEST(test_idle_waits_for_wake);
+    RUN_TEST(test_idle_deadline_ends_wait);
+    RUN_TEST(test_idle_defers_to_pending_jobs);
 
     return UNITY_END();
 }
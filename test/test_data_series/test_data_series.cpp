@@ -8,6 +8,13 @@
 #include "data/data_item_time_series.h"
 #include <cmath>
 
+// Counts UI wake-ups (overrides the weak stub in hal/timer_stub.cpp)
+static int g_wakeCount = 0;
+
+extern "C" void hal_timer_wake(void) {
+    g_wakeCount++;
+}
+
 // Helper to compare doubles with tolerance
 bool doubles_equal(double a, double b, double epsilon = 0.0001) {
     return std::fabs(a - b) < epsilon;
@@ -160,6 +167,22 @@ void test_metadata() {
     TEST_ASSERT_TRUE(t2 >= t1);
 }
 
+// Every modification wakes an idle UI task so the change gets drawn
+void test_updates_wake_ui() {
+    DataItemTimeSeries ts("Wake", 4);
+    g_wakeCount = 0;
+
+    ts.addDataPoint(1, 1.0);
+    ts.addDataPoint(2, 2.0);
+    TEST_ASSERT_EQUAL(2, g_wakeCount);
+
+    ts.getGraphData();
+    TEST_ASSERT_EQUAL(2, g_wakeCount);
+
+    ts.clear();
+    TEST_ASSERT_EQUAL(3, g_wakeCount);
+}
+
 int main(int argc, char **argv) {
     UNITY_BEGIN();
 
@@ -170,6 +193,7 @@ int main(int argc, char **argv) {
     RUN_TEST(test_empty_series);
     RUN_TEST(test_clear);
     RUN_TEST(test_metadata);
+    RUN_TEST(test_updates_wake_ui);
 
     return UNITY_END();
 }
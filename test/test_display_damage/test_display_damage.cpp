@@ -0,0 +1,133 @@
+/**
+ * @file test_display_damage.cpp
+ * @brief Unity tests for display damage tracking
+ *
+ * These tests verify the rectangle accumulation used by the shadow-primary
+ * display mode (features/hal_spec_display.md).
+ */
+
+#include <unity.h>
+#include "../hal/display_damage.h"
+
+static hal_damage_t damage;
+
+void setUp(void) {
+    hal_damage_reset(&damage);
+}
+
+void tearDown(void) {
+}
+
+void test_empty_rects_are_ignored(void) {
+    hal_damage_add(&damage, 10, 10, 0, 5);
+    hal_damage_add(&damage, 10, 10, 5, -1);
+
+    TEST_ASSERT_EQUAL_INT32(0, damage.count);
+    TEST_ASSERT_EQUAL_INT32(0, hal_damage_area(&damage));
+}
+
+void test_contained_rect_is_absorbed(void) {
+    hal_damage_add(&damage, 0, 0, 100, 100);
+    hal_damage_add(&damage, 10, 10, 1, 1);
+    hal_damage_add(&damage, 50, 50, 50, 50);
+
+    TEST_ASSERT_EQUAL_INT32(1, damage.count);
+    TEST_ASSERT_EQUAL_INT32(100 * 100, hal_damage_area(&damage));
+}
+
+void test_disjoint_rects_stay_separate(void) {
+    hal_damage_add(&damage, 0, 0, 10, 10);
+    hal_damage_add(&damage, 100, 100, 10, 10);
+
+    TEST_ASSERT_EQUAL_INT32(2, damage.count);
+    TEST_ASSERT_EQUAL_INT32(200, hal_damage_area(&damage));
+}
+
+void test_adjacent_pixels_merge_into_span(void) {
+    // Per-pixel writes along a row collapse into one rectangle
+    for (int32_t x = 20; x < 60; x++) {
+        hal_damage_add(&damage, x, 7, 1, 1);
+    }
+
+    TEST_ASSERT_EQUAL_INT32(1, damage.count);
+    TEST_ASSERT_EQUAL_INT32(20, damage.rects[0].x);
+    TEST_ASSERT_EQUAL_INT32(7, damage.rects[0].y);
+    TEST_ASSERT_EQUAL_INT32(40, damage.rects[0].w);
+    TEST_ASSERT_EQUAL_INT32(1, damage.rects[0].h);
+}
+
+void test_bridging_rect_merges_chain(void) {
+    hal_damage_add(&damage, 0, 0, 10, 10);
+    hal_damage_add(&damage, 20, 0, 10, 10);
+    TEST_ASSERT_EQUAL_INT32(2, damage.count);
+
+    // Overlaps both: all three collapse into one
+    hal_damage_add(&damage, 5, 0, 20, 10);
+    TEST_ASSERT_EQUAL_INT32(1, damage.count);
+    TEST_ASSERT_EQUAL_INT32(0, damage.rects[0].x);
+    TEST_ASSERT_EQUAL_INT32(30, damage.rects[0].w);
+}
+
+void test_overflow_merges_cheapest_pair(void) {
+    // Fill the set with well-separated rects along a diagonal
+    for (int32_t i = 0; i < HAL_DAMAGE_MAX_RECTS; i++) {
+        hal_damage_add(&damage, i * 40, i * 40, 10, 10);
+    }
+    TEST_ASSERT_EQUAL_INT32(HAL_DAMAGE_MAX_RECTS, damage.count);
+
+    // One more rect near the first one: must merge rather than overflow
+    hal_damage_add(&damage, 12, 0, 4, 4);
+    TEST_ASSERT_EQUAL_INT32(HAL_DAMAGE_MAX_RECTS, damage.count);
+
+    // The merged rect covers both the original and the new one
+    bool found = false;
+    for (int32_t i = 0; i < damage.count; i++) {
+        const hal_rect_t& r = damage.rects[i];
+        if (r.x == 0 && r.y == 0 && r.w == 16 && r.h == 10) {
+            found = true;
+        }
+    }
+    TEST_ASSERT_TRUE(found);
+}
+
+void test_rects_never_overlap(void) {
+    // Pseudo-random pattern; area must equal the union of covered pixels
+    static bool covered[64][64];
+    for (int32_t y = 0; y < 64; y++) {
+        for (int32_t x = 0; x < 64; x++) {
+            covered[y][x] = false;
+        }
+    }
+
+    uint32_t seed = 12345;
+    for (int32_t n = 0; n < 40; n++) {
+        seed = seed * 1103515245u + 12345u;
+        int32_t x = (seed >> 8) % 56;
+        int32_t y = (seed >> 16) % 56;
+        hal_damage_add(&damage, x, y, 8, 8);
+    }
+
+    for (int32_t i = 0; i < damage.count; i++) {
+        const hal_rect_t& r = damage.rects[i];
+        for (int32_t y = r.y; y < r.y + r.h; y++) {
+            for (int32_t x = r.x; x < r.x + r.w; x++) {
+                TEST_ASSERT_FALSE(covered[y][x]);
+                covered[y][x] = true;
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_empty_rects_are_ignored);
+    RUN_TEST(test_contained_rect_is_absorbed);
+    RUN_TEST(test_disjoint_rects_stay_separate);
+    RUN_TEST(test_adjacent_pixels_merge_into_span);
+    RUN_TEST(test_bridging_rect_merges_chain);
+    RUN_TEST(test_overflow_merges_cheapest_pair);
+    RUN_TEST(test_rects_never_overlap);
+
+    return UNITY_END();
+}
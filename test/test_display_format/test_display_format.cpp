@@ -0,0 +1,70 @@
+/**
+ * @file test_display_format.cpp
+ * @brief Unity tests for pixel format conversion
+ *
+ * These tests verify the byte-order helpers used to keep surfaces in the
+ * panel's native format (features/hal_spec_display.md, Pixel Formats).
+ */
+
+#include <unity.h>
+#include "../hal/display_format.h"
+#include <vector>
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_color_conversion_round_trips(void) {
+    TEST_ASSERT_EQUAL_HEX16(0x00F8, hal_color_to_format(0xF800, HAL_PIXEL_FORMAT_RGB565_BE));
+    TEST_ASSERT_EQUAL_HEX16(0xF800, hal_color_to_format(0xF800, HAL_PIXEL_FORMAT_RGB565));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, hal_color_from_format(0x3412, HAL_PIXEL_FORMAT_RGB565_BE));
+
+    // Big-endian storage puts the high byte first in memory
+    uint16_t px = hal_color_to_format(0xABCD, HAL_PIXEL_FORMAT_RGB565_BE);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&px);
+    TEST_ASSERT_EQUAL_HEX8(0xAB, bytes[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xCD, bytes[1]);
+}
+
+void test_row_conversion_matches_per_pixel(void) {
+    // Odd count and an odd start offset exercise the tail and unaligned paths
+    std::vector<uint16_t> src(67);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = static_cast<uint16_t>(i * 0x0901 + 0x0102);
+    }
+    std::vector<uint16_t> dst(src.size() + 1, 0);
+
+    hal_pixels_convert(&dst[1], &src[0], src.size(),
+                       HAL_PIXEL_FORMAT_RGB565, HAL_PIXEL_FORMAT_RGB565_BE);
+    TEST_ASSERT_EQUAL_HEX16(0, dst[0]);
+    for (size_t i = 0; i < src.size(); i++) {
+        TEST_ASSERT_EQUAL_HEX16(hal_color_to_format(src[i], HAL_PIXEL_FORMAT_RGB565_BE), dst[i + 1]);
+    }
+}
+
+void test_in_place_and_same_format(void) {
+    std::vector<uint16_t> row = { 0x1234, 0x5678, 0x9ABC };
+
+    hal_pixels_convert(row.data(), row.data(), row.size(),
+                       HAL_PIXEL_FORMAT_RGB565_BE, HAL_PIXEL_FORMAT_RGB565);
+    TEST_ASSERT_EQUAL_HEX16(0x3412, row[0]);
+    TEST_ASSERT_EQUAL_HEX16(0xBC9A, row[2]);
+
+    // Same format is a plain copy
+    std::vector<uint16_t> copy(row.size(), 0);
+    hal_pixels_convert(copy.data(), row.data(), row.size(),
+                       HAL_PIXEL_FORMAT_RGB565, HAL_PIXEL_FORMAT_RGB565);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(row.data(), copy.data(), row.size());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_color_conversion_round_trips);
+    RUN_TEST(test_row_conversion_matches_per_pixel);
+    RUN_TEST(test_in_place_and_same_format);
+
+    return UNITY_END();
+}
@@ -132,6 +132,44 @@ void test_hal_display_clear_multiple_colors(void) {
     TEST_PASS();
 }
 
+/**
+ * Test: hal_display_lock_surface contract
+ * Verifies that a failed lock leaves the output surface untouched
+ */
+void test_hal_display_lock_surface_failure_leaves_output(void) {
+    hal_surface_t surface = { nullptr, -1, -1, -1, HAL_PIXEL_FORMAT_RGB565 };
+
+    // The stub has no pixel memory, so locking the shadow framebuffer fails
+    bool locked = hal_display_lock_surface(nullptr, &surface);
+    TEST_ASSERT_FALSE(locked);
+    TEST_ASSERT_NULL(surface.pixels);
+    TEST_ASSERT_EQUAL_INT32(-1, surface.width);
+    TEST_ASSERT_EQUAL_INT32(-1, surface.stride);
+
+    // Null output is rejected rather than dereferenced
+    TEST_ASSERT_FALSE(hal_display_lock_surface(nullptr, nullptr));
+}
+
+/**
+ * Test: hal_display_unlock_surface contract
+ * Verifies that unlock accepts empty, clipped and out-of-range damage rects
+ */
+void test_hal_display_unlock_surface_accepts_damage(void) {
+    hal_display_unlock_surface(nullptr, 0, 0, 0, 0);
+    hal_display_unlock_surface(nullptr, 10, 10, 20, 20);
+    hal_display_unlock_surface(nullptr, -5, -5, 1000, 1000);
+
+    TEST_PASS();
+}
+
+/**
+ * Test: shadow-primary mode is reported off when it can't be enabled
+ */
+void test_hal_display_shadow_primary_reports_state(void) {
+    TEST_ASSERT_FALSE(hal_display_set_shadow_primary(true));
+    TEST_ASSERT_FALSE(hal_display_is_shadow_primary());
+}
+
 int main(int argc, char **argv) {
     UNITY_BEGIN();
 
@@ -142,6 +180,9 @@ int main(int argc, char **argv) {
     RUN_TEST(test_hal_display_typical_usage_sequence);
     RUN_TEST(test_hal_display_multiple_draws_before_flush);
     RUN_TEST(test_hal_display_clear_multiple_colors);
+    RUN_TEST(test_hal_display_lock_surface_failure_leaves_output);
+    RUN_TEST(test_hal_display_unlock_surface_accepts_damage);
+    RUN_TEST(test_hal_display_shadow_primary_reports_state);
 
     return UNITY_END();
 }
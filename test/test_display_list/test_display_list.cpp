@@ -0,0 +1,263 @@
+/**
+ * @file test_display_list.cpp
+ * @brief Unity tests for DisplayList recording and replay
+ *
+ * Verifies that a RelativeDisplay in recording mode resolves its draw calls
+ * to pixels without drawing, and that replaying the list reproduces the
+ * immediate-mode output, translated and clipped
+ * (features/display_relative_drawing.md, Display Lists).
+ */
+
+#include <unity.h>
+#include "../../src/relative_display.h"
+#include "../../src/display_list.h"
+#include <string>
+#include <vector>
+
+// Framebuffer-backed GFX that also logs text output
+class MockCanvas : public Arduino_GFX {
+public:
+    struct TextCall {
+        std::string text;
+        int16_t x, y;
+        uint16_t color;
+        uint8_t size;
+    };
+
+    std::vector<uint16_t> pixels;
+    std::vector<TextCall> texts;
+    int drawCalls = 0;
+
+    MockCanvas(int16_t w, int16_t h) : Arduino_GFX(w, h), pixels(w * h, 0) {}
+
+    bool begin(int32_t speed = 0) override { return true; }
+    void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override {}
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        drawCalls++;
+        put(x, y, color);
+    }
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override {
+        drawCalls++;
+        for (int16_t i = 0; i < w; i++) put(x + i, y, color);
+    }
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override {
+        drawCalls++;
+        for (int16_t i = 0; i < h; i++) put(x, y + i, color);
+    }
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+        drawCalls++;
+        for (int16_t r = 0; r < h; r++) {
+            for (int16_t c = 0; c < w; c++) put(x + c, y + r, color);
+        }
+    }
+
+    // Built-in font: 6x8 cells, cursor at the top-left corner
+    void setTextColor(uint16_t color) override { m_color = color; }
+    void setTextSize(uint8_t s) override { m_size = s; }
+    void setCursor(int16_t x, int16_t y) override { m_x = x; m_y = y; }
+    size_t print(const char* str) override {
+        drawCalls++;
+        texts.push_back({ str, m_x, m_y, m_color, m_size });
+        return 0;
+    }
+    void getTextBounds(const char* str, int16_t x, int16_t y, int16_t* x1, int16_t* y1,
+                       uint16_t* w, uint16_t* h) override {
+        *x1 = x;
+        *y1 = y;
+        *w = static_cast<uint16_t>(6 * m_size * std::string(str).size());
+        *h = static_cast<uint16_t>(8 * m_size);
+    }
+
+    uint16_t at(int32_t x, int32_t y) const { return pixels[y * _width + x]; }
+
+private:
+    uint16_t m_color = 0;
+    uint8_t m_size = 1;
+    int16_t m_x = 0;
+    int16_t m_y = 0;
+
+    void put(int32_t x, int32_t y, uint16_t color) {
+        if (x >= 0 && x < _width && y >= 0 && y < _height) pixels[y * _width + x] = color;
+    }
+};
+
+static constexpr int16_t W = 200;
+static constexpr int16_t H = 100;
+
+// A little of everything, in relative and pixel coordinates
+static void drawScene(RelativeDisplay& display) {
+    display.fillRect(10.0f, 10.0f, 30.0f, 40.0f, 0x1111);
+    display.drawHorizontalLine(80.0f, 0.0f, 100.0f, 0x2222);
+    display.drawVerticalLine(50.0f, 0.0f, 100.0f, 0x3333);
+    display.drawPixel(75.0f, 25.0f, 0x4444);
+    display.drawText(150, 60, "12", 0x5555, 2);
+
+    const uint16_t key = 0x0001;
+    const uint16_t bitmap[6] = { key, 0x6666, key,
+                                 0x7777, key, 0x8888 };
+    display.drawKeyedBitmap(5, 90, bitmap, 3, 2, key);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_recording_resolves_pixels_without_drawing(void) {
+    MockCanvas canvas(W, H);
+    RelativeDisplay display(&canvas, W, H);
+    DisplayList list;
+
+    display.beginRecording(&list);
+    TEST_ASSERT_TRUE(display.isRecording());
+    drawScene(display);
+    display.endRecording();
+    TEST_ASSERT_FALSE(display.isRecording());
+
+    TEST_ASSERT_EQUAL(0, canvas.drawCalls);
+    TEST_ASSERT_EQUAL(6, list.getCommandCount());
+
+    const DisplayList::Command& rect = list.getCommand(0);
+    TEST_ASSERT_EQUAL(DisplayList::Op::FILL_RECT, rect.op);
+    TEST_ASSERT_EQUAL_INT16(20, rect.x);
+    TEST_ASSERT_EQUAL_INT16(10, rect.y);
+    TEST_ASSERT_EQUAL_INT16(60, rect.w);
+    TEST_ASSERT_EQUAL_INT16(40, rect.h);
+
+    // Text is measured once, at record time
+    const DisplayList::Command& text = list.getCommand(4);
+    TEST_ASSERT_EQUAL(DisplayList::Op::TEXT, text.op);
+    TEST_ASSERT_EQUAL_INT16(24, text.w);
+    TEST_ASSERT_EQUAL_INT16(16, text.h);
+
+    TEST_ASSERT_EQUAL(20u, sizeof(DisplayList::Command));
+    TEST_ASSERT_EQUAL(6 * 20 + 3 + 6 * 2, list.getMemoryUsage());
+}
+
+void test_replay_matches_immediate_drawing(void) {
+    MockCanvas immediate(W, H);
+    RelativeDisplay direct(&immediate, W, H);
+    drawScene(direct);
+
+    MockCanvas replayed(W, H);
+    RelativeDisplay recorder(&replayed, W, H);
+    DisplayList list;
+    recorder.beginRecording(&list);
+    drawScene(recorder);
+    recorder.endRecording();
+    list.replay(&replayed);
+
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(immediate.pixels.data(), replayed.pixels.data(), W * H);
+    TEST_ASSERT_EQUAL(1, replayed.texts.size());
+    TEST_ASSERT_EQUAL_STRING("12", replayed.texts[0].text.c_str());
+    TEST_ASSERT_EQUAL_INT16(150, replayed.texts[0].x);
+    TEST_ASSERT_EQUAL_UINT8(2, replayed.texts[0].size);
+    TEST_ASSERT_EQUAL_HEX16(0x5555, replayed.texts[0].color);
+
+    // Keyed bitmap pixels leave the background alone
+    TEST_ASSERT_EQUAL_HEX16(0x0000, replayed.at(5, 90));
+    TEST_ASSERT_EQUAL_HEX16(0x6666, replayed.at(6, 90));
+}
+
+void test_replay_with_translate_and_clip(void) {
+    MockCanvas canvas(W, H);
+    RelativeDisplay recorder(&canvas, W, H);
+    DisplayList list;
+    recorder.beginRecording(&list);
+    drawScene(recorder);
+    recorder.endRecording();
+
+    MockCanvas reference(W, H);
+    list.replay(&reference, 3, -2);
+
+    // Only the clip changes; everything else keeps its initial color
+    hal_rect_t clip = { 30, 20, 80, 50 };
+    MockCanvas target(W, H);
+    for (auto& p : target.pixels) p = 0xDEAD;
+    list.replay(&target, 3, -2, &clip);
+
+    for (int32_t y = 0; y < H; y++) {
+        for (int32_t x = 0; x < W; x++) {
+            bool inside = x >= clip.x && x < clip.x + clip.w && y >= clip.y && y < clip.y + clip.h;
+            uint16_t expected = inside ? reference.at(x, y) : 0xDEAD;
+            if (inside && expected == 0x0000) expected = 0xDEAD;  // Nothing drawn there
+            TEST_ASSERT_EQUAL_HEX16(expected, target.at(x, y));
+        }
+    }
+
+    // Text at (153, 58) lies outside the clip, so it is skipped
+    TEST_ASSERT_EQUAL(0, target.texts.size());
+
+    // Text that touches the clip is drawn whole, at its translated cursor
+    hal_rect_t corner = { 170, 70, 10, 10 };
+    list.replay(&target, 3, -2, &corner);
+    TEST_ASSERT_EQUAL(1, target.texts.size());
+    TEST_ASSERT_EQUAL_INT16(153, target.texts[0].x);
+    TEST_ASSERT_EQUAL_INT16(58, target.texts[0].y);
+}
+
+void test_replay_in_slices_matches_replay(void) {
+    MockCanvas canvas(W, H);
+    RelativeDisplay recorder(&canvas, W, H);
+    DisplayList list;
+    recorder.beginRecording(&list);
+    drawScene(recorder);
+    recorder.endRecording();
+
+    hal_rect_t clip = { 0, 0, 160, 100 };
+    MockCanvas whole(W, H);
+    list.replay(&whole, 0, 0, &clip);
+
+    // Two commands per slice, the last slice running past the end
+    MockCanvas sliced(W, H);
+    for (size_t first = 0; first < list.getCommandCount(); first += 2) {
+        list.replayRange(&sliced, first, 2, 0, 0, &clip);
+    }
+    list.replayRange(&sliced, list.getCommandCount(), 2);
+
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(whole.pixels.data(), sliced.pixels.data(), W * H);
+    TEST_ASSERT_EQUAL(whole.drawCalls, sliced.drawCalls);
+}
+
+void test_clear_and_bounds(void) {
+    MockCanvas canvas(W, H);
+    RelativeDisplay recorder(&canvas, W, H);
+    DisplayList list;
+
+    TEST_ASSERT_TRUE(list.isEmpty());
+    TEST_ASSERT_EQUAL_INT32(0, list.getBounds().w);
+
+    recorder.beginRecording(&list);
+    recorder.drawPixel(10.0f, 10.0f, 0xFFFF);
+    recorder.fillRect(50.0f, 50.0f, 10.0f, 10.0f, 0xFFFF);
+    recorder.endRecording();
+
+    hal_rect_t bounds = list.getBounds();
+    TEST_ASSERT_EQUAL_INT32(20, bounds.x);
+    TEST_ASSERT_EQUAL_INT32(10, bounds.y);
+    TEST_ASSERT_EQUAL_INT32(100, bounds.w);
+    TEST_ASSERT_EQUAL_INT32(50, bounds.h);
+
+    list.clear();
+    TEST_ASSERT_TRUE(list.isEmpty());
+    TEST_ASSERT_EQUAL(0, list.getMemoryUsage());
+
+    // Drawing after endRecording() goes straight to the target
+    recorder.drawPixel(10.0f, 10.0f, 0xFFFF);
+    TEST_ASSERT_EQUAL(1, canvas.drawCalls);
+    TEST_ASSERT_TRUE(list.isEmpty());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_recording_resolves_pixels_without_drawing);
+    RUN_TEST(test_replay_matches_immediate_drawing);
+    RUN_TEST(test_replay_with_translate_and_clip);
+    RUN_TEST(test_replay_in_slices_matches_replay);
+    RUN_TEST(test_clear_and_bounds);
+
+    return UNITY_END();
+}
@@ -0,0 +1,131 @@
+/**
+ * @file test_display_rle.cpp
+ * @brief Unity tests for RLE sprite decoding
+ *
+ * These tests verify the run stream consumed by hal_display_blit_rle()
+ * (features/hal_spec_display.md, RLE Sprite Blit).
+ */
+
+#include <unity.h>
+#include "../hal/display_rle.h"
+#include "../../src/rle_sprite.h"
+#include <vector>
+
+static constexpr uint16_t KEY = 0xF81F;
+
+static hal_surface_t makeSurface(std::vector<uint16_t>& buf, int32_t w, int32_t h, uint16_t fill) {
+    buf.assign(static_cast<size_t>(w) * h, fill);
+    hal_surface_t s = { buf.data(), w, h, w, HAL_PIXEL_FORMAT_RGB565 };
+    return s;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_written_rect_bounds_opaque_runs(void) {
+    // Two rows: run at cols 1-2, then a fully transparent row, then col 3
+    const uint16_t rle[] = {
+        1, 1, 2, 0x1111, 0x2222,
+        0,
+        1, 3, 1, 0x3333,
+    };
+
+    std::vector<uint16_t> buf;
+    hal_surface_t dst = makeSurface(buf, 8, 8, 0);
+    hal_rect_t written;
+    TEST_ASSERT_TRUE(hal_rle_blit_to_surface(&dst, 2, 2, 3, rle, &written));
+
+    TEST_ASSERT_EQUAL_INT32(3, written.x);
+    TEST_ASSERT_EQUAL_INT32(2, written.y);
+    TEST_ASSERT_EQUAL_INT32(3, written.w);
+    TEST_ASSERT_EQUAL_INT32(3, written.h);
+
+    TEST_ASSERT_EQUAL_HEX16(0x1111, buf[2 * 8 + 3]);
+    TEST_ASSERT_EQUAL_HEX16(0x2222, buf[2 * 8 + 4]);
+    TEST_ASSERT_EQUAL_HEX16(0x0000, buf[2 * 8 + 5]);
+    TEST_ASSERT_EQUAL_HEX16(0x3333, buf[4 * 8 + 5]);
+}
+
+void test_written_rect_is_clipped(void) {
+    const uint16_t rle[] = { 1, 0, 4, 0x0001, 0x0002, 0x0003, 0x0004 };
+
+    std::vector<uint16_t> buf;
+    hal_surface_t dst = makeSurface(buf, 4, 4, 0);
+    hal_rect_t written;
+    TEST_ASSERT_TRUE(hal_rle_blit_to_surface(&dst, 2, 0, 1, rle, &written));
+
+    TEST_ASSERT_EQUAL_INT32(2, written.x);
+    TEST_ASSERT_EQUAL_INT32(2, written.w);
+    TEST_ASSERT_EQUAL_HEX16(0x0001, buf[2]);
+    TEST_ASSERT_EQUAL_HEX16(0x0002, buf[3]);
+}
+
+void test_fully_clipped_sprite_writes_nothing(void) {
+    const uint16_t rle[] = { 1, 0, 2, 0x0001, 0x0002 };
+
+    std::vector<uint16_t> buf;
+    hal_surface_t dst = makeSurface(buf, 4, 4, 0);
+    hal_rect_t written = { 9, 9, 9, 9 };
+    TEST_ASSERT_FALSE(hal_rle_blit_to_surface(&dst, 0, 4, 1, rle, &written));
+    TEST_ASSERT_EQUAL_INT32(0, written.w);
+    TEST_ASSERT_EQUAL_INT32(0, written.h);
+    TEST_ASSERT_FALSE(hal_rle_blit_to_surface(&dst, -2, 0, 1, rle, nullptr));
+}
+
+void test_big_endian_target_receives_swapped_runs(void) {
+    const uint16_t rle[] = { 1, 1, 2, 0x1234, 0xF800 };
+
+    std::vector<uint16_t> buf;
+    hal_surface_t dst = makeSurface(buf, 4, 1, 0xAAAA);
+    dst.format = HAL_PIXEL_FORMAT_RGB565_BE;
+    TEST_ASSERT_TRUE(hal_rle_blit_to_surface(&dst, 0, 0, 1, rle, nullptr));
+
+    TEST_ASSERT_EQUAL_HEX16(0xAAAA, buf[0]);
+    TEST_ASSERT_EQUAL_HEX16(0x3412, buf[1]);
+    TEST_ASSERT_EQUAL_HEX16(0x00F8, buf[2]);
+    TEST_ASSERT_EQUAL_HEX16(0xAAAA, buf[3]);
+}
+
+void test_encoder_output_matches_stream_format(void) {
+    const uint16_t src[] = {
+        KEY,    0x1111, KEY,    0x2222,
+        KEY,    KEY,    KEY,    KEY,
+    };
+    RleSprite sprite;
+    TEST_ASSERT_TRUE(sprite.encode(src, 4, 2, 4, KEY));
+
+    // Row 0: two runs, second skip is relative to the end of the first
+    // Row 1: empty
+    TEST_ASSERT_EQUAL((1 + 3 + 3 + 1) * sizeof(uint16_t), sprite.getDataSize());
+
+    std::vector<uint16_t> buf;
+    hal_surface_t dst = makeSurface(buf, 4, 2, 0);
+    sprite.blitTo(dst, 0, 0);
+    TEST_ASSERT_EQUAL_HEX16(0x0000, buf[0]);
+    TEST_ASSERT_EQUAL_HEX16(0x1111, buf[1]);
+    TEST_ASSERT_EQUAL_HEX16(0x0000, buf[2]);
+    TEST_ASSERT_EQUAL_HEX16(0x2222, buf[3]);
+}
+
+void test_canvas_encode_fails_without_surface_access(void) {
+    // The stub HAL has no canvases with accessible framebuffers
+    RleSprite sprite;
+    TEST_ASSERT_FALSE(sprite.encodeCanvas(nullptr, KEY));
+    TEST_ASSERT_TRUE(sprite.isEmpty());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_written_rect_bounds_opaque_runs);
+    RUN_TEST(test_written_rect_is_clipped);
+    RUN_TEST(test_fully_clipped_sprite_writes_nothing);
+    RUN_TEST(test_big_endian_target_receives_swapped_runs);
+    RUN_TEST(test_encoder_output_matches_stream_format);
+    RUN_TEST(test_canvas_encode_fails_without_surface_access);
+
+    return UNITY_END();
+}
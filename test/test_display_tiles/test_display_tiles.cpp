@@ -0,0 +1,232 @@
+/**
+ * @file test_display_tiles.cpp
+ * @brief Unity tests for tile-hash damage detection
+ *
+ * These tests verify how flush damage is filtered down to changed tiles
+ * (features/hal_spec_display.md, Tile-Hash Damage Detection), and include a
+ * host benchmark of hash throughput against the bus time it saves.
+ */
+
+#include <unity.h>
+#include "../hal/display_tiles.h"
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+static constexpr int32_t W = 368;
+static constexpr int32_t H = 448;
+
+static std::vector<uint16_t> g_frame;
+static hal_surface_t g_surface;
+static hal_tile_hashes_t g_tiles;
+static hal_damage_t g_damage;
+static hal_rect_t g_rects[HAL_TILE_MAX_RECTS];
+
+static void fillFrame(uint16_t color) {
+    for (auto& px : g_frame) px = color;
+}
+
+static void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+    for (int32_t row = y; row < y + h; row++) {
+        for (int32_t col = x; col < x + w; col++) {
+            g_frame[row * W + col] = color;
+        }
+    }
+}
+
+static int32_t diffFullFrame(hal_tile_stats_t* stats = nullptr) {
+    hal_damage_reset(&g_damage);
+    hal_damage_add(&g_damage, 0, 0, W, H);
+    return hal_tile_hashes_diff(&g_tiles, &g_surface, &g_damage, g_rects, HAL_TILE_MAX_RECTS, stats);
+}
+
+void setUp(void) {
+    g_frame.assign(W * H, 0x0000);
+    g_surface = { g_frame.data(), W, H, W, HAL_PIXEL_FORMAT_RGB565 };
+    hal_tile_hashes_free(&g_tiles);
+    hal_damage_reset(&g_damage);
+}
+
+void tearDown(void) {
+    hal_tile_hashes_free(&g_tiles);
+}
+
+void test_first_diff_sends_all_damage(void) {
+    hal_damage_add(&g_damage, 10, 10, 20, 20);
+    int32_t n = hal_tile_hashes_diff(&g_tiles, &g_surface, &g_damage, g_rects, HAL_TILE_MAX_RECTS, nullptr);
+
+    // Tiles 0..1 in both directions, as one rectangle
+    TEST_ASSERT_EQUAL_INT32(1, n);
+    TEST_ASSERT_EQUAL_INT32(0, g_rects[0].x);
+    TEST_ASSERT_EQUAL_INT32(0, g_rects[0].y);
+    TEST_ASSERT_EQUAL_INT32(32, g_rects[0].w);
+    TEST_ASSERT_EQUAL_INT32(32, g_rects[0].h);
+}
+
+void test_unchanged_redraw_sends_nothing(void) {
+    fillFrame(0x1234);
+    TEST_ASSERT_EQUAL_INT32(1, diffFullFrame());
+
+    // A component repaints everything with the same pixels
+    fillFrame(0x1234);
+    hal_tile_stats_t stats;
+    TEST_ASSERT_EQUAL_INT32(0, diffFullFrame(&stats));
+    TEST_ASSERT_EQUAL_INT32(23 * 28, stats.tiles_hashed);
+    TEST_ASSERT_EQUAL_INT32(0, stats.tiles_changed);
+    TEST_ASSERT_EQUAL_INT32(W * H, stats.pixels_damaged);
+    TEST_ASSERT_EQUAL_INT32(0, stats.pixels_sent);
+}
+
+void test_single_pixel_change_sends_its_tile(void) {
+    diffFullFrame();
+
+    g_frame[100 * W + 50] = 0xFFFF;
+    TEST_ASSERT_EQUAL_INT32(1, diffFullFrame());
+    TEST_ASSERT_EQUAL_INT32(48, g_rects[0].x);
+    TEST_ASSERT_EQUAL_INT32(96, g_rects[0].y);
+    TEST_ASSERT_EQUAL_INT32(16, g_rects[0].w);
+    TEST_ASSERT_EQUAL_INT32(16, g_rects[0].h);
+}
+
+void test_changed_tiles_coalesce_into_rects(void) {
+    diffFullFrame();
+
+    // 3x2 block of tiles, plus an L-shaped group next to it
+    fillRect(16, 16, 48, 32, 0xF800);
+    fillRect(160, 160, 32, 16, 0x07E0);
+    fillRect(160, 176, 16, 16, 0x07E0);
+    TEST_ASSERT_EQUAL_INT32(3, diffFullFrame());
+
+    TEST_ASSERT_EQUAL_INT32(16, g_rects[0].x);
+    TEST_ASSERT_EQUAL_INT32(48, g_rects[0].w);
+    TEST_ASSERT_EQUAL_INT32(32, g_rects[0].h);
+
+    // The L's rows have different spans, so they stay separate
+    TEST_ASSERT_EQUAL_INT32(160, g_rects[1].y);
+    TEST_ASSERT_EQUAL_INT32(32, g_rects[1].w);
+    TEST_ASSERT_EQUAL_INT32(176, g_rects[2].y);
+    TEST_ASSERT_EQUAL_INT32(16, g_rects[2].w);
+}
+
+void test_only_damaged_tiles_are_considered(void) {
+    diffFullFrame();
+
+    // Two changes, but only one is reported as damage
+    g_frame[5 * W + 5] = 0xFFFF;
+    g_frame[300 * W + 300] = 0xFFFF;
+    hal_damage_reset(&g_damage);
+    hal_damage_add(&g_damage, 0, 0, 8, 8);
+    TEST_ASSERT_EQUAL_INT32(1, hal_tile_hashes_diff(&g_tiles, &g_surface, &g_damage,
+                                                    g_rects, HAL_TILE_MAX_RECTS, nullptr));
+    TEST_ASSERT_EQUAL_INT32(0, g_rects[0].x);
+    TEST_ASSERT_EQUAL_INT32(0, g_rects[0].y);
+}
+
+void test_edge_tiles_are_clipped(void) {
+    // 368 = 23 * 16 exactly; 440 leaves a partial 8-pixel tile row
+    g_surface.height = 440;
+    diffFullFrame();
+
+    fillRect(W - 4, 436, 4, 4, 0xFFFF);
+    TEST_ASSERT_EQUAL_INT32(1, diffFullFrame());
+    TEST_ASSERT_EQUAL_INT32(W - 16, g_rects[0].x);
+    TEST_ASSERT_EQUAL_INT32(432, g_rects[0].y);
+    TEST_ASSERT_EQUAL_INT32(16, g_rects[0].w);
+    TEST_ASSERT_EQUAL_INT32(8, g_rects[0].h);
+}
+
+void test_size_change_and_invalidate_resend(void) {
+    diffFullFrame();
+
+    // Rotated frame: grid is reshaped and every damaged tile is sent again
+    g_surface = { g_frame.data(), H, W, H, HAL_PIXEL_FORMAT_RGB565 };
+    hal_damage_reset(&g_damage);
+    hal_damage_add(&g_damage, 0, 0, 16, 16);
+    TEST_ASSERT_EQUAL_INT32(1, hal_tile_hashes_diff(&g_tiles, &g_surface, &g_damage,
+                                                    g_rects, HAL_TILE_MAX_RECTS, nullptr));
+    TEST_ASSERT_EQUAL_INT32(0, hal_tile_hashes_diff(&g_tiles, &g_surface, &g_damage,
+                                                    g_rects, HAL_TILE_MAX_RECTS, nullptr));
+
+    hal_tile_hashes_invalidate(&g_tiles);
+    TEST_ASSERT_EQUAL_INT32(1, hal_tile_hashes_diff(&g_tiles, &g_surface, &g_damage,
+                                                    g_rects, HAL_TILE_MAX_RECTS, nullptr));
+}
+
+void test_rect_overflow_merges_least_growth(void) {
+    diffFullFrame();
+
+    // Four isolated tiles in a column, but room for only two rectangles
+    for (int32_t i = 0; i < 4; i++) {
+        g_frame[(i * 64) * W] = 0xFFFF;
+    }
+    hal_rect_t rects[2];
+    hal_tile_stats_t stats;
+    int32_t n = hal_tile_hashes_diff(&g_tiles, &g_surface, &g_damage, rects, 2, &stats);
+    TEST_ASSERT_EQUAL_INT32(2, n);
+    TEST_ASSERT_EQUAL_INT32(4, stats.tiles_changed);
+
+    // Every changed tile is still covered
+    for (int32_t i = 0; i < 4; i++) {
+        int32_t y = i * 64;
+        bool covered = false;
+        for (int32_t r = 0; r < n; r++) {
+            covered |= y >= rects[r].y && y < rects[r].y + rects[r].h && rects[r].x == 0;
+        }
+        TEST_ASSERT_TRUE(covered);
+    }
+}
+
+/**
+ * Benchmark: a dashboard-style redraw repaints the whole screen but only a
+ * price label and the newest graph segment actually change. Reports host
+ * hash throughput next to the panel bus time the filtering saves.
+ */
+void test_benchmark_hash_throughput_vs_bus_savings(void) {
+    for (size_t i = 0; i < g_frame.size(); i++) {
+        g_frame[i] = static_cast<uint16_t>((i * 2654435761u) >> 16);
+    }
+    diffFullFrame();
+
+    const int iterations = 50;
+    int64_t sent = 0;
+    hal_tile_stats_t stats = { 0, 0, 0, 0 };
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        fillRect(20, 40, 120, 24, static_cast<uint16_t>(it * 37));   // Price label
+        fillRect(300 + (it % 8), 200, 2, 120, static_cast<uint16_t>(it));  // Graph head
+        TEST_ASSERT_TRUE(diffFullFrame(&stats) >= 0);
+        sent += stats.pixels_sent;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    double hashed_mb = static_cast<double>(W) * H * 2 * iterations / 1e6;
+    double saved_mb = (static_cast<double>(W) * H * iterations - sent) * 2 / 1e6;
+
+    // Panel links: SH8601 QSPI at 40 MHz (20 MB/s), RM67162 SPI at 40 MHz (5 MB/s)
+    printf("[BENCH] tile hash: %.1f MB/s on host, %.2f ms per full frame\n",
+           hashed_mb / seconds, seconds * 1000.0 / iterations);
+    printf("[BENCH] sent %.1f%% of damaged pixels; bus time saved per frame: "
+           "%.2f ms (QSPI 20 MB/s), %.2f ms (SPI 5 MB/s)\n",
+           100.0 * sent / (static_cast<double>(W) * H * iterations),
+           saved_mb / iterations / 20.0 * 1000.0, saved_mb / iterations / 5.0 * 1000.0);
+
+    // Only the tiles under the two changed areas go out
+    TEST_ASSERT_TRUE(sent < static_cast<int64_t>(W) * H * iterations / 10);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_first_diff_sends_all_damage);
+    RUN_TEST(test_unchanged_redraw_sends_nothing);
+    RUN_TEST(test_single_pixel_change_sends_its_tile);
+    RUN_TEST(test_changed_tiles_coalesce_into_rects);
+    RUN_TEST(test_only_damaged_tiles_are_considered);
+    RUN_TEST(test_edge_tiles_are_clipped);
+    RUN_TEST(test_size_change_and_invalidate_resend);
+    RUN_TEST(test_rect_overflow_merges_least_growth);
+    RUN_TEST(test_benchmark_hash_throughput_vs_bus_savings);
+
+    return UNITY_END();
+}
@@ -0,0 +1,231 @@
+/**
+ * @file test_indexed_surface.cpp
+ * @brief Unity tests for IndexedSurface and IndexedCanvas
+ *
+ * Verifies bit packing at every depth, palette building, and that compositing
+ * an indexed layer is pixel-exact against the RGB565 chroma-key path it
+ * replaces in TimeSeriesGraph.
+ */
+
+#include <unity.h>
+#include "../../src/indexed_surface.h"
+#include "../../src/indexed_canvas.h"
+#include "../../hal/display_format.h"
+#include <vector>
+
+static constexpr uint16_t KEY = 0x0001;
+static const uint8_t kDepths[] = { 1, 2, 4, 8 };
+
+static uint32_t g_seed = 1;
+static uint32_t nextRandom() {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return g_seed >> 8;
+}
+
+void setUp(void) {
+    g_seed = 1;
+}
+
+void tearDown(void) {
+}
+
+void test_init_validates_arguments(void) {
+    IndexedSurface s;
+    TEST_ASSERT_FALSE(s.init(10, 10, 3));
+    TEST_ASSERT_FALSE(s.init(0, 10, 8));
+    TEST_ASSERT_FALSE(s.isValid());
+
+    TEST_ASSERT_TRUE(s.init(368, 448, 1, KEY));
+    TEST_ASSERT_EQUAL_INT32(46, s.getStride());
+    TEST_ASSERT_EQUAL(46 * 448, s.getDataSize());
+
+    // Rows are padded to whole bytes
+    TEST_ASSERT_TRUE(s.init(5, 2, 2));
+    TEST_ASSERT_EQUAL_INT32(2, s.getStride());
+}
+
+void test_pixels_round_trip_at_every_depth(void) {
+    const int16_t W = 37, H = 5;
+    for (uint8_t bpp : kDepths) {
+        IndexedSurface s;
+        TEST_ASSERT_TRUE(s.init(W, H, bpp));
+
+        std::vector<uint8_t> expected(W * H);
+        for (int i = 0; i < W * H; i++) {
+            expected[i] = static_cast<uint8_t>(nextRandom() % s.getPaletteSize());
+            s.setPixel(i % W, i / W, expected[i]);
+        }
+        for (int i = 0; i < W * H; i++) {
+            TEST_ASSERT_EQUAL_UINT8(expected[i], s.getPixel(i % W, i / W));
+        }
+
+        // Out-of-range writes are ignored
+        s.setPixel(-1, 0, 1);
+        s.setPixel(W, 0, 1);
+        TEST_ASSERT_EQUAL_UINT8(0, s.getPixel(W, 0));
+    }
+}
+
+void test_palette_maps_and_falls_back_to_nearest(void) {
+    IndexedSurface s;
+    TEST_ASSERT_TRUE(s.init(4, 4, 2, KEY));
+
+    TEST_ASSERT_EQUAL_UINT8(IndexedSurface::TRANSPARENT_INDEX, s.mapColor(KEY));
+    TEST_ASSERT_EQUAL_UINT8(1, s.mapColor(0xF800));
+    TEST_ASSERT_EQUAL_UINT8(2, s.mapColor(0x07E0));
+    TEST_ASSERT_EQUAL_UINT8(1, s.mapColor(0xF800));
+    TEST_ASSERT_EQUAL_UINT8(3, s.mapColor(0x001F));
+    TEST_ASSERT_EQUAL_UINT16(4, s.getPaletteUsed());
+
+    // Full: a near-red maps to red, never to the transparent entry
+    TEST_ASSERT_EQUAL_UINT8(1, s.mapColor(0xE000));
+    TEST_ASSERT_NOT_EQUAL(IndexedSurface::TRANSPARENT_INDEX, s.mapColor(0x0000));  // KEY is nearer, but skipped
+
+    s.resetPalette();
+    TEST_ASSERT_EQUAL_UINT16(1, s.getPaletteUsed());
+    TEST_ASSERT_EQUAL_UINT8(1, s.mapColor(0x001F));
+}
+
+void test_composite_matches_rgb565_chroma_key_path(void) {
+    const int16_t W = 45, H = 9;
+
+    for (uint8_t bpp : kDepths) {
+        IndexedSurface layer;
+        TEST_ASSERT_TRUE(layer.init(W, H, bpp, KEY));
+        IndexedCanvas canvas(&layer);
+        TEST_ASSERT_TRUE(canvas.begin());
+
+        // Reference: RGB565 layer cleared to the chroma key
+        std::vector<uint16_t> rgb(W * H, KEY);
+        std::vector<uint16_t> bg(W * H);
+        for (auto& px : bg) px = static_cast<uint16_t>(nextRandom());
+
+        // Draw with as many colors as the palette holds (minus transparency)
+        uint16_t colors[255];
+        int num_colors = layer.getPaletteSize() - 1;
+        for (int c = 0; c < num_colors; c++) {
+            colors[c] = static_cast<uint16_t>(0x0100 + c * 97);
+        }
+
+        for (int n = 0; n < 60; n++) {
+            uint16_t color = colors[nextRandom() % num_colors];
+            int16_t x = static_cast<int16_t>(nextRandom() % W);
+            int16_t y = static_cast<int16_t>(nextRandom() % H);
+            if (n % 3 == 0) {
+                int16_t w = static_cast<int16_t>(1 + nextRandom() % (W - x));
+                canvas.writeFillRectPreclipped(x, y, w, 1, color);
+                for (int i = 0; i < w; i++) rgb[y * W + x + i] = color;
+            } else {
+                canvas.writePixelPreclipped(x, y, color);
+                rgb[y * W + x] = color;
+            }
+        }
+
+        std::vector<uint16_t> out(W * H, 0xDEAD);
+        hal_surface_t target = { out.data(), W, H, W, HAL_PIXEL_FORMAT_RGB565 };
+        hal_surface_t below = { bg.data(), W, H, W, HAL_PIXEL_FORMAT_RGB565 };
+        layer.compositeTo(target, below);
+
+        for (int i = 0; i < W * H; i++) {
+            uint16_t expected = (rgb[i] != KEY) ? rgb[i] : bg[i];
+            TEST_ASSERT_EQUAL_HEX16(expected, out[i]);
+        }
+    }
+}
+
+void test_composite_without_below_keeps_destination(void) {
+    IndexedSurface layer;
+    TEST_ASSERT_TRUE(layer.init(20, 1, 1, KEY));
+    layer.setPixel(17, 0, layer.mapColor(0x1234));
+
+    std::vector<uint16_t> out(20, 0xAAAA);
+    layer.compositeRow(0, nullptr, out.data());
+    for (int x = 0; x < 20; x++) {
+        TEST_ASSERT_EQUAL_HEX16(x == 17 ? 0x1234 : 0xAAAA, out[x]);
+    }
+}
+
+void test_composite_in_panel_byte_order(void) {
+    const int16_t W = 19;
+    for (uint8_t bpp : kDepths) {
+        IndexedSurface layer;
+        TEST_ASSERT_TRUE(layer.init(W, 1, bpp, KEY));
+        // 1 bpp only has room for one opaque color
+        const uint16_t second = (bpp == 1) ? 0x1234 : 0xF800;
+        layer.setPixel(2, 0, layer.mapColor(0x1234));
+        layer.setPixel(W - 1, 0, layer.mapColor(second));
+
+        // Background already in big-endian order, as render() keeps it
+        std::vector<uint16_t> bg(W);
+        for (auto& px : bg) px = static_cast<uint16_t>(nextRandom());
+        std::vector<uint16_t> bg_be(W);
+        hal_pixels_convert(bg_be.data(), bg.data(), W, HAL_PIXEL_FORMAT_RGB565, HAL_PIXEL_FORMAT_RGB565_BE);
+
+        std::vector<uint16_t> out(W, 0);
+        hal_surface_t target = { out.data(), W, 1, W, HAL_PIXEL_FORMAT_RGB565_BE };
+        hal_surface_t below = { bg_be.data(), W, 1, W, HAL_PIXEL_FORMAT_RGB565_BE };
+        layer.compositeTo(target, below);
+
+        for (int x = 0; x < W; x++) {
+            uint16_t expected = (x == 2) ? 0x1234 : (x == W - 1) ? second : bg[x];
+            TEST_ASSERT_EQUAL_HEX16(expected, hal_color_from_format(out[x], HAL_PIXEL_FORMAT_RGB565_BE));
+        }
+
+        // Mismatched formats are rejected rather than mixed
+        std::vector<uint16_t> untouched(W, 0x5555);
+        hal_surface_t cpu_target = { untouched.data(), W, 1, W, HAL_PIXEL_FORMAT_RGB565 };
+        layer.compositeTo(cpu_target, below);
+        TEST_ASSERT_EQUAL_HEX16(0x5555, untouched[2]);
+    }
+}
+
+void test_canvas_requires_valid_surface(void) {
+    IndexedSurface empty;
+    IndexedCanvas canvas(&empty);
+    TEST_ASSERT_FALSE(canvas.begin());
+
+    IndexedCanvas none(nullptr);
+    TEST_ASSERT_FALSE(none.begin());
+}
+
+void test_swap_flips_back_surface_to_front(void) {
+    // A canvas keeps drawing into the same surface object across a swap
+    IndexedSurface front;
+    IndexedSurface back;
+    TEST_ASSERT_TRUE(front.init(8, 4, 1, 0x0001));
+    TEST_ASSERT_TRUE(back.init(8, 4, 8, 0x0001));
+    IndexedCanvas canvas(&front);
+    TEST_ASSERT_TRUE(canvas.begin());
+
+    front.setPixel(1, 1, front.mapColor(0xF800));
+    back.setPixel(2, 2, back.mapColor(0x07E0));
+    back.setPixel(3, 2, back.mapColor(0x001F));
+
+    front.swap(back);
+    TEST_ASSERT_EQUAL_UINT8(8, front.getBitsPerPixel());
+    TEST_ASSERT_EQUAL_UINT16(3, front.getPaletteUsed());
+    TEST_ASSERT_EQUAL_HEX16(0x07E0, front.getPaletteColor(front.getPixel(2, 2)));
+    TEST_ASSERT_EQUAL_UINT8(0, front.getPixel(1, 1));
+    TEST_ASSERT_EQUAL_UINT8(1, back.getBitsPerPixel());
+    TEST_ASSERT_EQUAL_HEX16(0xF800, back.getPaletteColor(back.getPixel(1, 1)));
+
+    // The cached last color follows its palette
+    canvas.writePixelPreclipped(5, 0, 0x001F);
+    TEST_ASSERT_EQUAL_HEX16(0x001F, front.getPaletteColor(front.getPixel(5, 0)));
+    TEST_ASSERT_EQUAL_UINT16(3, front.getPaletteUsed());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_init_validates_arguments);
+    RUN_TEST(test_pixels_round_trip_at_every_depth);
+    RUN_TEST(test_palette_maps_and_falls_back_to_nearest);
+    RUN_TEST(test_composite_matches_rgb565_chroma_key_path);
+    RUN_TEST(test_composite_without_below_keeps_destination);
+    RUN_TEST(test_composite_in_panel_byte_order);
+    RUN_TEST(test_canvas_requires_valid_surface);
+    RUN_TEST(test_swap_flips_back_surface_to_front);
+
+    return UNITY_END();
+}
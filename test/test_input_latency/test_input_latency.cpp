@@ -0,0 +1,262 @@
+/**
+ * @file test_input_latency.cpp
+ * @brief Unity tests for InputLatency and the render task's latency stamps
+ *
+ * Host mode of the input-to-photon measurement: a virtual clock, a component
+ * whose render and input handling take a set time, and a simulated panel
+ * whose flush takes the configured bus time (features/sys_render_task.md).
+ */
+
+#include <unity.h>
+#include "../../src/input_latency.h"
+#include "../../src/render_task.h"
+#include "../../src/animation_ticker.h"
+#include "../../src/ui/ui_render_manager.h"
+#include <stdio.h>
+#include <string.h>
+
+// Virtual clock (overrides the weak stubs in hal/timer_stub.cpp)
+static uint64_t g_now = 0;
+static bool g_woken = false;
+
+extern "C" uint64_t hal_timer_get_micros(void) {
+    return g_now;
+}
+
+extern "C" void hal_timer_sleep_until(uint64_t deadline_micros) {
+    if (deadline_micros > g_now) g_now = deadline_micros;
+}
+
+extern "C" bool hal_timer_wait_for_wake(uint64_t deadline_micros) {
+    if (g_woken) {
+        g_woken = false;
+        return true;
+    }
+    hal_timer_sleep_until(deadline_micros);
+    return false;
+}
+
+extern "C" void hal_timer_wake(void) {
+    g_woken = true;
+}
+
+// Simulated panel: the flush returns once the frame has crossed the bus
+static uint64_t g_busMicros = 0;
+
+static void simulatedFlush() {
+    g_now += g_busMicros;
+}
+
+// Takes a fixed time to route a gesture and to draw
+class TimedApp : public AppComponent {
+public:
+    uint64_t inputMicros = 0;
+    uint64_t renderMicros = 0;
+
+    void render() override { g_now += renderMicros; }
+    bool handleInput(const touch_gesture_event_t& event) override {
+        (void)event;
+        g_now += inputMicros;
+        return true;
+    }
+    uint32_t getTargetFps() const override { return FPS_STATIC; }
+};
+
+static touch_gesture_event_t tap() {
+    touch_gesture_event_t event = {};
+    event.type = TOUCH_TAP;
+    return event;
+}
+
+static InputLatency::Stamps stampsWithTotal(uint64_t total) {
+    InputLatency::Stamps stamps = { 1000, 1000, 1000, 1000, 1000 + total };
+    return stamps;
+}
+
+void setUp(void) {
+    UIRenderManager::getInstance().reset();
+    UIRenderManager::getInstance().setFlushCallback(simulatedFlush);
+    g_now = 1000000;
+    g_woken = false;
+    g_busMicros = 0;
+}
+
+void tearDown(void) {
+    UIRenderManager::getInstance().setFlushCallback(nullptr);
+    UIRenderManager::getInstance().reset();
+}
+
+void test_percentiles_use_nearest_rank(void) {
+    InputLatency latency;
+    InputLatency::Summary empty = latency.summarize(InputLatency::TOTAL);
+    TEST_ASSERT_EQUAL_UINT32(0, empty.count);
+    TEST_ASSERT_EQUAL_UINT32(0, empty.max);
+
+    // Recorded out of order: 100..1 ms
+    for (int ms = 100; ms >= 1; ms--) latency.record(stampsWithTotal(ms * 1000));
+
+    InputLatency::Summary s = latency.summarize(InputLatency::TOTAL);
+    TEST_ASSERT_EQUAL_UINT32(100, s.count);
+    TEST_ASSERT_EQUAL_UINT32(50000, s.p50);
+    TEST_ASSERT_EQUAL_UINT32(90000, s.p90);
+    TEST_ASSERT_EQUAL_UINT32(99000, s.p99);
+    TEST_ASSERT_EQUAL_UINT32(100000, s.max);
+    TEST_ASSERT_EQUAL_UINT32(100000, latency.summarize(InputLatency::RENDER_TO_PRESENT).max);
+    TEST_ASSERT_EQUAL_UINT32(0, latency.summarize(InputLatency::SAMPLE_TO_POST).max);
+
+    // A single measurement is every percentile
+    latency.reset();
+    latency.record(stampsWithTotal(7000));
+    s = latency.summarize(InputLatency::TOTAL);
+    TEST_ASSERT_EQUAL_UINT32(7000, s.p50);
+    TEST_ASSERT_EQUAL_UINT32(7000, s.p99);
+}
+
+void test_window_keeps_the_latest_measurements(void) {
+    InputLatency latency;
+    for (int i = 1; i <= InputLatency::WINDOW + 72; i++) latency.record(stampsWithTotal(i));
+
+    InputLatency::Summary s = latency.summarize(InputLatency::TOTAL);
+    TEST_ASSERT_EQUAL_UINT32(InputLatency::WINDOW, s.count);
+    TEST_ASSERT_EQUAL_UINT32(InputLatency::WINDOW + 72, latency.getTotalCount());
+    TEST_ASSERT_EQUAL_UINT32(InputLatency::WINDOW + 72, s.max);
+    TEST_ASSERT_EQUAL_UINT32(73 + InputLatency::WINDOW / 2 - 1, s.p50);
+
+    // Stamps out of order (a clock mix-up) count as zero, not as wrapped values
+    latency.reset();
+    InputLatency::Stamps backwards = { 5000, 4000, 4000, 4000, 4000 };
+    latency.record(backwards);
+    TEST_ASSERT_EQUAL_UINT32(0, latency.summarize(InputLatency::SAMPLE_TO_POST).max);
+    TEST_ASSERT_EQUAL_UINT32(0, latency.summarize(InputLatency::TOTAL).max);
+}
+
+void test_format_reports_every_stage(void) {
+    InputLatency latency;
+    InputLatency::Stamps stamps = { 1000, 4000, 4500, 6500, 14500 };
+    latency.record(stamps);
+
+    char report[512];
+    size_t length = latency.format(report, sizeof(report));
+    TEST_ASSERT_EQUAL(strlen(report), length);
+    TEST_ASSERT_NOT_NULL(strstr(report, "[Latency] 1 gestures"));
+    TEST_ASSERT_NOT_NULL(strstr(report, "sample->post"));
+    TEST_ASSERT_NOT_NULL(strstr(report, "render->present"));
+    TEST_ASSERT_NOT_NULL(strstr(report, "  13500"));
+
+    // A short buffer is cut off, still terminated
+    char small[20];
+    length = latency.format(small, sizeof(small));
+    TEST_ASSERT_EQUAL(sizeof(small) - 1, length);
+    TEST_ASSERT_EQUAL(sizeof(small) - 1, strlen(small));
+}
+
+void test_render_task_stamps_each_stage(void) {
+    AnimationTicker ticker(60);
+    RenderTask task(&ticker);
+    TimedApp app;
+    app.inputMicros = 500;
+    app.renderMicros = 2000;
+    g_busMicros = 8000;
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.setActiveApp(&app);
+
+    task.runFrame();
+    TEST_ASSERT_TRUE(ticker.isIdle());
+    TEST_ASSERT_EQUAL_UINT32(0, task.getLatency().getTotalCount());
+
+    // Sampled 3 ms before the input loop posts it; the idle task wakes at once
+    g_now += 20000;
+    TEST_ASSERT_TRUE(task.postGesture(tap(), g_now - 3000));
+    TEST_ASSERT_TRUE(task.postGesture(tap()));  // Untracked
+    task.runFrame();
+
+    const InputLatency& latency = task.getLatency();
+    TEST_ASSERT_EQUAL_UINT32(1, latency.getTotalCount());
+    TEST_ASSERT_EQUAL_UINT32(3000, latency.summarize(InputLatency::SAMPLE_TO_POST).max);
+    TEST_ASSERT_EQUAL_UINT32(500, latency.summarize(InputLatency::POST_TO_ROUTE).max);
+    // The untracked tap's routing and the drawing
+    TEST_ASSERT_EQUAL_UINT32(2500, latency.summarize(InputLatency::ROUTE_TO_RENDER).max);
+    TEST_ASSERT_EQUAL_UINT32(8000, latency.summarize(InputLatency::RENDER_TO_PRESENT).max);
+    TEST_ASSERT_EQUAL_UINT32(14000, latency.summarize(InputLatency::TOTAL).max);
+
+    // The report resets the statistics
+    RenderTask::Command report = {};
+    report.type = RenderTask::Command::Type::LATENCY_REPORT;
+    TEST_ASSERT_TRUE(task.post(report));
+    task.runFrame();
+    TEST_ASSERT_EQUAL_UINT32(0, task.getLatency().getTotalCount());
+}
+
+// Posted mid-frame: waits out the frame being drawn, then the frame period
+void test_gesture_posted_during_a_frame_waits_for_the_next(void) {
+    AnimationTicker ticker(60);
+    RenderTask task(&ticker);
+    TimedApp app;
+    app.renderMicros = 4000;
+    g_busMicros = 6000;
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.setActiveApp(&app);
+
+    task.publishInput(RenderTask::InputState{ true });  // Full rate, no idling
+    task.runFrame();
+    TEST_ASSERT_FALSE(ticker.isIdle());
+
+    TEST_ASSERT_TRUE(task.postGesture(tap(), g_now));
+    task.runFrame();
+
+    // Routed at the next frame boundary, 1/60 s after the last one began
+    uint32_t waited = task.getLatency().summarize(InputLatency::POST_TO_ROUTE).max;
+    TEST_ASSERT_EQUAL_UINT32(1000000 / 60 - 10000, waited);
+    TEST_ASSERT_EQUAL_UINT32(waited + 10000, task.getLatency().summarize(InputLatency::TOTAL).max);
+}
+
+// Full-frame flushes of the 368x448 AMOLED over QSPI at a few bus clocks
+void test_bench_latency_by_bus_time(void) {
+    static const uint32_t busMHz[] = { 80, 40, 20 };
+    const uint32_t pixels = 368 * 448;
+
+    uint32_t lastTotal = 0;
+    for (uint32_t mhz : busMHz) {
+        setUp();
+        AnimationTicker ticker(60);
+        RenderTask task(&ticker);
+        TimedApp app;
+        app.inputMicros = 200;
+        app.renderMicros = 3000;
+        g_busMicros = pixels * 16 / (4 * mhz);  // RGB565, four bits per clock
+        auto& mgr = UIRenderManager::getInstance();
+        mgr.registerComponent(&app, 1);
+        mgr.setActiveApp(&app);
+        task.runFrame();
+
+        for (int i = 0; i < 20; i++) {
+            g_now += 50000;
+            TEST_ASSERT_TRUE(task.postGesture(tap(), g_now - 1000 - i * 100));
+            task.runFrame();
+        }
+
+        InputLatency::Summary total = task.getLatency().summarize(InputLatency::TOTAL);
+        TEST_ASSERT_EQUAL_UINT32(20, total.count);
+        TEST_ASSERT_TRUE(total.p50 > lastTotal);
+        lastTotal = total.p50;
+        printf("[BENCH] %2u MHz bus (%6u us/frame): input-to-photon p50 %6u us, p99 %6u us\n",
+               static_cast<unsigned>(mhz), static_cast<unsigned>(g_busMicros),
+               static_cast<unsigned>(total.p50), static_cast<unsigned>(total.p99));
+        tearDown();
+    }
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_percentiles_use_nearest_rank);
+    RUN_TEST(test_window_keeps_the_latest_measurements);
+    RUN_TEST(test_format_reports_every_stage);
+    RUN_TEST(test_render_task_stamps_each_stage);
+    RUN_TEST(test_gesture_posted_during_a_frame_waits_for_the_next);
+    RUN_TEST(test_bench_latency_by_bus_time);
+
+    return UNITY_END();
+}
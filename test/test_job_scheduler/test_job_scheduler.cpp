@@ -0,0 +1,210 @@
+/**
+ * @file test_job_scheduler.cpp
+ * @brief Unity tests for JobScheduler
+ *
+ * Runs the scheduler against a virtual clock: each job step advances the
+ * mocked hal_timer_get_micros() by its cost, so ordering, budgets and
+ * deadlines can be checked exactly (features/sys_animation_ticker.md,
+ * Frame-Slack Job Scheduler).
+ */
+
+#include <unity.h>
+#include "../../src/job_scheduler.h"
+#include <string>
+
+// Virtual clock (overrides the weak stub in hal/timer_stub.cpp)
+static uint64_t mock_now = 0;
+
+extern "C" uint64_t hal_timer_get_micros(void) {
+    return mock_now;
+}
+
+// A job that takes a fixed time per step and finishes after a number of steps
+struct FakeJob {
+    char name;
+    uint32_t step_cost;
+    int steps_left;
+    uint32_t last_budget;
+};
+
+static std::string g_order;
+
+static bool fakeStep(void* context, uint32_t budget_us) {
+    FakeJob* job = static_cast<FakeJob*>(context);
+    g_order += job->name;
+    job->last_budget = budget_us;
+    mock_now += job->step_cost;
+    return --job->steps_left <= 0;
+}
+
+void setUp(void) {
+    mock_now = 1000000;
+    g_order.clear();
+}
+
+void tearDown(void) {
+}
+
+void test_priority_then_fifo_order(void) {
+    JobScheduler scheduler;
+    FakeJob low = { 'L', 10, 1, 0 };
+    FakeJob normal1 = { 'a', 10, 1, 0 };
+    FakeJob high = { 'H', 10, 1, 0 };
+    FakeJob normal2 = { 'b', 10, 1, 0 };
+
+    scheduler.submit(fakeStep, &low, JobScheduler::Priority::BACKGROUND);
+    scheduler.submit(fakeStep, &normal1, JobScheduler::Priority::NORMAL);
+    scheduler.submit(fakeStep, &high, JobScheduler::Priority::URGENT);
+    scheduler.submit(fakeStep, &normal2, JobScheduler::Priority::NORMAL);
+
+    TEST_ASSERT_EQUAL(4, scheduler.runUntil(mock_now + 100000));
+    TEST_ASSERT_EQUAL_STRING("HabL", g_order.c_str());
+    TEST_ASSERT_EQUAL(0, scheduler.getPendingCount());
+    TEST_ASSERT_EQUAL_UINT32(4, scheduler.getStats().completed);
+    TEST_ASSERT_EQUAL_UINT64(40, scheduler.getStats().busy_micros);
+}
+
+void test_earliest_deadline_first_within_priority(void) {
+    JobScheduler scheduler;
+    FakeJob none = { 'n', 10, 1, 0 };
+    FakeJob late = { 'l', 10, 1, 0 };
+    FakeJob soon = { 's', 10, 1, 0 };
+
+    scheduler.submit(fakeStep, &none);
+    scheduler.submit(fakeStep, &late, JobScheduler::Priority::NORMAL, mock_now + 5000);
+    scheduler.submit(fakeStep, &soon, JobScheduler::Priority::NORMAL, mock_now + 1000);
+
+    scheduler.runUntil(mock_now + 100000);
+    TEST_ASSERT_EQUAL_STRING("sln", g_order.c_str());
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getStats().late);
+}
+
+void test_stops_before_limit(void) {
+    JobScheduler scheduler;
+    FakeJob job = { 'j', 300, 100, 0 };
+    scheduler.submit(fakeStep, &job, JobScheduler::Priority::NORMAL, 0, 300);
+
+    // 1000 us of slack fits three 300 us steps, not a fourth
+    uint64_t limit = mock_now + 1000;
+    TEST_ASSERT_EQUAL(3, scheduler.runUntil(limit));
+    TEST_ASSERT_TRUE(mock_now <= limit);
+    TEST_ASSERT_EQUAL_UINT32(400, job.last_budget);
+    TEST_ASSERT_EQUAL(1, scheduler.getPendingCount());
+
+    // No slack at all: nothing runs
+    TEST_ASSERT_EQUAL(0, scheduler.runUntil(mock_now));
+    TEST_ASSERT_EQUAL(0, scheduler.runUntil(mock_now - 1));
+}
+
+void test_estimate_tracks_measured_step_cost(void) {
+    JobScheduler scheduler;
+    // Claims 100 us per step, really takes 800 us
+    FakeJob job = { 'j', 800, 100, 0 };
+    scheduler.submit(fakeStep, &job, JobScheduler::Priority::NORMAL, 0, 100);
+
+    // The first step runs on the estimate; after it the average (450 us)
+    // no longer fits in the 400 us left
+    uint64_t limit = mock_now + 1200;
+    TEST_ASSERT_EQUAL(1, scheduler.runUntil(limit));
+    TEST_ASSERT_TRUE(mock_now <= limit);
+
+    // A few frames later the estimate has converged close to 800 us
+    for (int frame = 0; frame < 4; frame++) {
+        scheduler.runUntil(mock_now + 2000);
+    }
+    limit = mock_now + 790;
+    TEST_ASSERT_EQUAL(0, scheduler.runUntil(limit));
+}
+
+void test_best_job_is_not_overtaken_by_cheaper_work(void) {
+    JobScheduler scheduler;
+    FakeJob big = { 'B', 2000, 1, 0 };
+    FakeJob small = { 's', 10, 1, 0 };
+    scheduler.submit(fakeStep, &big, JobScheduler::Priority::URGENT, 0, 2000);
+    scheduler.submit(fakeStep, &small, JobScheduler::Priority::BACKGROUND);
+
+    // The high-priority step doesn't fit, so the low one waits too
+    TEST_ASSERT_EQUAL(0, scheduler.runUntil(mock_now + 1000));
+    TEST_ASSERT_EQUAL(2, scheduler.runUntil(mock_now + 3000));
+    TEST_ASSERT_EQUAL_STRING("Bs", g_order.c_str());
+}
+
+void test_deadline_misses_are_counted(void) {
+    JobScheduler scheduler;
+    FakeJob job = { 'j', 500, 4, 0 };
+    scheduler.submit(fakeStep, &job, JobScheduler::Priority::NORMAL, mock_now + 1500, 500);
+
+    // Two steps per "frame"; the job finishes in the second, after its deadline
+    scheduler.runUntil(mock_now + 1000);
+    TEST_ASSERT_EQUAL(1, scheduler.getPendingCount());
+    scheduler.runUntil(mock_now + 1000);
+    TEST_ASSERT_EQUAL(0, scheduler.getPendingCount());
+
+    TEST_ASSERT_EQUAL_UINT32(4, scheduler.getStats().steps);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getStats().completed);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getStats().late);
+
+    scheduler.resetStats();
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getStats().steps);
+}
+
+void test_cancel_and_full_queue(void) {
+    JobScheduler scheduler;
+    FakeJob jobs[JobScheduler::MAX_JOBS + 1];
+    int32_t ids[JobScheduler::MAX_JOBS + 1];
+    for (int i = 0; i <= JobScheduler::MAX_JOBS; i++) {
+        jobs[i] = { static_cast<char>('A' + i), 10, 1, 0 };
+        ids[i] = scheduler.submit(fakeStep, &jobs[i]);
+    }
+    TEST_ASSERT_EQUAL_INT32(JobScheduler::INVALID_JOB, ids[JobScheduler::MAX_JOBS]);
+    TEST_ASSERT_EQUAL_INT32(JobScheduler::INVALID_JOB, scheduler.submit(nullptr, nullptr));
+    TEST_ASSERT_EQUAL(JobScheduler::MAX_JOBS, scheduler.getPendingCount());
+
+    TEST_ASSERT_TRUE(scheduler.cancel(ids[1]));
+    TEST_ASSERT_FALSE(scheduler.cancel(ids[1]));
+    TEST_ASSERT_FALSE(scheduler.isQueued(ids[1]));
+    TEST_ASSERT_TRUE(scheduler.isQueued(ids[2]));
+
+    scheduler.runUntil(mock_now + 100000);
+    TEST_ASSERT_EQUAL_STRING("ACDEFGHIJKLMNOP", g_order.c_str());
+    TEST_ASSERT_FALSE(scheduler.isQueued(ids[2]));
+}
+
+// A job that cancels itself and submits a follow-up from inside its step
+static JobScheduler* g_scheduler = nullptr;
+static int32_t g_selfId = JobScheduler::INVALID_JOB;
+static FakeJob g_followUp;
+
+static bool chainingStep(void* context, uint32_t budget_us) {
+    g_order += 'c';
+    mock_now += 10;
+    g_scheduler->cancel(g_selfId);
+    g_scheduler->submit(fakeStep, &g_followUp);
+    return false;
+}
+
+void test_steps_may_cancel_and_submit(void) {
+    JobScheduler scheduler;
+    g_scheduler = &scheduler;
+    g_followUp = { 'f', 10, 1, 0 };
+    g_selfId = scheduler.submit(chainingStep, nullptr);
+
+    scheduler.runUntil(mock_now + 100000);
+    TEST_ASSERT_EQUAL_STRING("cf", g_order.c_str());
+    TEST_ASSERT_EQUAL(0, scheduler.getPendingCount());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_priority_then_fifo_order);
+    RUN_TEST(test_earliest_deadline_first_within_priority);
+    RUN_TEST(test_stops_before_limit);
+    RUN_TEST(test_estimate_tracks_measured_step_cost);
+    RUN_TEST(test_best_job_is_not_overtaken_by_cheaper_work);
+    RUN_TEST(test_deadline_misses_are_counted);
+    RUN_TEST(test_cancel_and_full_queue);
+    RUN_TEST(test_steps_may_cancel_and_submit);
+
+    return UNITY_END();
+}
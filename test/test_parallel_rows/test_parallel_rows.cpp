@@ -0,0 +1,303 @@
+/**
+ * @file test_parallel_rows.cpp
+ * @brief Unity tests and benchmarks for ParallelRows and its kernels
+ *
+ * Checks the band split, that every row runs exactly once, and that each
+ * parallel kernel (gradient fill, layer composition, mesh rasterization)
+ * is bit-identical to its serial run. The benchmarks print the speedup of
+ * each kernel with helper threads; it depends on the host's core count
+ * (features/sys_parallel_rows.md).
+ */
+
+#include <unity.h>
+#include "../../src/parallel_rows.h"
+#include "../../src/gradient_fill.h"
+#include "../../src/triangle_rasterizer.h"
+#include "../../src/ui/ui_render_manager.h"
+#include "../../hal/display_format.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include <vector>
+
+static int helperCount() {
+    unsigned cores = std::thread::hardware_concurrency();
+    int helpers = cores > 1 ? static_cast<int>(cores) - 1 : 1;
+    return helpers > ParallelRows::MAX_HELPERS ? ParallelRows::MAX_HELPERS : helpers;
+}
+
+// Median-free but warm: best of a few runs, in milliseconds
+static double bestMillis(const std::function<void()>& work, int runs = 5) {
+    double best = 1e9;
+    for (int i = 0; i < runs; i++) {
+        auto start = std::chrono::steady_clock::now();
+        work();
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+static void reportSpeedup(const char* kernel, double serial_ms, double parallel_ms) {
+    printf("[BENCH] %s: serial %.2f ms, %d workers %.2f ms, speedup %.2fx (%u host cores)\n",
+           kernel, serial_ms, ParallelRows::getInstance().getWorkerCount(), parallel_ms,
+           serial_ms / parallel_ms, std::thread::hardware_concurrency());
+}
+
+void setUp(void) {
+    ParallelRows::getInstance().end();
+    ParallelRows::getInstance().resetStats();
+}
+
+void tearDown(void) {
+    ParallelRows::getInstance().end();
+}
+
+// ==========================================
+// Splitting
+// ==========================================
+
+void test_band_bounds_partition_the_range(void) {
+    int32_t expected_y0 = 5;
+    for (int k = 0; k < 3; k++) {
+        int32_t y0, y1;
+        ParallelRows::bandBounds(5, 15, 3, k, &y0, &y1);
+        TEST_ASSERT_EQUAL_INT32(expected_y0, y0);
+        TEST_ASSERT_EQUAL_INT32(k == 0 ? 4 : 3, y1 - y0);  // Remainder goes first
+        expected_y0 = y1;
+    }
+    TEST_ASSERT_EQUAL_INT32(15, expected_y0);
+}
+
+struct RowCounts {
+    std::vector<int> hits;
+    std::atomic<int> bands{ 0 };
+};
+
+static void countRows(void* context, int32_t y0, int32_t y1) {
+    RowCounts* counts = static_cast<RowCounts*>(context);
+    for (int32_t y = y0; y < y1; y++) counts->hits[y]++;   // Rows are disjoint
+    counts->bands.fetch_add(1);
+}
+
+void test_serial_without_helpers(void) {
+    RowCounts counts;
+    counts.hits.assign(100, 0);
+    ParallelRows::getInstance().run(0, 100, countRows, &counts);
+
+    TEST_ASSERT_EQUAL(1, counts.bands.load());
+    for (int y = 0; y < 100; y++) TEST_ASSERT_EQUAL(1, counts.hits[y]);
+    TEST_ASSERT_EQUAL_UINT32(1, ParallelRows::getInstance().getStats().runs);
+    TEST_ASSERT_EQUAL_UINT32(0, ParallelRows::getInstance().getStats().parallel_runs);
+}
+
+void test_every_row_runs_once_across_helpers(void) {
+    auto& rows = ParallelRows::getInstance();
+    TEST_ASSERT_TRUE(rows.begin(3));
+    TEST_ASSERT_EQUAL(4, rows.getWorkerCount());
+
+    for (int round = 0; round < 200; round++) {
+        RowCounts counts;
+        counts.hits.assign(1000, 0);
+        rows.run(0, 1000, countRows, &counts);
+        TEST_ASSERT_EQUAL(4, counts.bands.load());
+        for (int y = 0; y < 1000; y++) TEST_ASSERT_EQUAL(1, counts.hits[y]);
+    }
+
+    // Too few rows for four bands of eight
+    RowCounts small;
+    small.hits.assign(20, 0);
+    rows.run(0, 20, countRows, &small);
+    TEST_ASSERT_EQUAL(2, small.bands.load());
+    TEST_ASSERT_EQUAL_UINT32(201, rows.getStats().parallel_runs);
+}
+
+static void nestedRun(void* context, int32_t y0, int32_t y1) {
+    // Runs inline: the helpers are busy with the outer run
+    ParallelRows::getInstance().run(y0, y1, countRows, context);
+}
+
+void test_nested_run_is_serial(void) {
+    auto& rows = ParallelRows::getInstance();
+    rows.begin(1);
+    RowCounts counts;
+    counts.hits.assign(64, 0);
+    rows.run(0, 64, nestedRun, &counts);
+
+    TEST_ASSERT_EQUAL(2, counts.bands.load());
+    for (int y = 0; y < 64; y++) TEST_ASSERT_EQUAL(1, counts.hits[y]);
+    TEST_ASSERT_EQUAL_UINT32(1, rows.getStats().runs);
+}
+
+// ==========================================
+// Kernels: deterministic, then benchmarked
+// ==========================================
+
+static constexpr int32_t W = 480;
+static constexpr int32_t H = 480;
+
+void test_gradient_fill_matches_serial(void) {
+    LinearGradient gradient = { 33.0f, { 0x1234, 0xF800, 0x07FF }, 3 };
+    std::vector<uint16_t> serial(W * H), parallel(W * H, 0);
+    hal_surface_t s = { serial.data(), W, H, W, HAL_PIXEL_FORMAT_RGB565 };
+    hal_surface_t p = { parallel.data(), W, H, W, HAL_PIXEL_FORMAT_RGB565 };
+
+    double serial_ms = bestMillis([&]() { gradient_fill_linear(s, 0, 0, W, H, gradient, false); });
+    ParallelRows::getInstance().begin(helperCount());
+    double parallel_ms = bestMillis([&]() { gradient_fill_linear(p, 0, 0, W, H, gradient); });
+    reportSpeedup("gradient fill 480x480", serial_ms, parallel_ms);
+
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(serial.data(), parallel.data(), W * H);
+    TEST_ASSERT_EQUAL_HEX16(gradient_color_at(gradient, 100, 200, W, H), parallel[200 * W + 100]);
+
+    // A clipped partial fill leaves the rest alone
+    std::vector<uint16_t> partial(W * H, 0xDEAD);
+    hal_surface_t q = { partial.data(), W, H, W, HAL_PIXEL_FORMAT_RGB565 };
+    gradient_fill_linear(q, -10, 400, 20, 200, gradient);
+    TEST_ASSERT_EQUAL_HEX16(serial[400 * W + 9], partial[400 * W + 9]);
+    TEST_ASSERT_EQUAL_HEX16(0xDEAD, partial[400 * W + 10]);
+    TEST_ASSERT_EQUAL_HEX16(0xDEAD, partial[399 * W + 0]);
+}
+
+// A thick zig-zag "data line" as a strip of triangles
+static std::vector<RasterTriangle> makeStrip() {
+    std::vector<RasterTriangle> tris;
+    const int points = 120;
+    for (int i = 0; i + 1 < points; i++) {
+        float x0 = 4.0f + i * 3.9f, x1 = 4.0f + (i + 1) * 3.9f;
+        float y0 = 240.0f + 200.0f * ((i * 37) % 11 - 5) / 5.0f;
+        float y1 = 240.0f + 200.0f * (((i + 1) * 37) % 11 - 5) / 5.0f;
+        RasterTriangle a, b;
+        a.v[0] = { TriangleRasterizer::toFixed(x0), TriangleRasterizer::toFixed(y0 - 3.0f) };
+        a.v[1] = { TriangleRasterizer::toFixed(x1), TriangleRasterizer::toFixed(y1 - 3.0f) };
+        a.v[2] = { TriangleRasterizer::toFixed(x1), TriangleRasterizer::toFixed(y1 + 3.0f) };
+        b.v[0] = a.v[0];
+        b.v[1] = a.v[2];
+        b.v[2] = { TriangleRasterizer::toFixed(x0), TriangleRasterizer::toFixed(y0 + 3.0f) };
+        tris.push_back(a);
+        tris.push_back(b);
+    }
+    // And a filled area under it
+    RasterTriangle area;
+    area.v[0] = { TriangleRasterizer::toFixed(0.0f), TriangleRasterizer::toFixed(470.0f) };
+    area.v[1] = { TriangleRasterizer::toFixed(470.0f), TriangleRasterizer::toFixed(470.0f) };
+    area.v[2] = { TriangleRasterizer::toFixed(240.0f), TriangleRasterizer::toFixed(60.0f) };
+    tris.push_back(area);
+    return tris;
+}
+
+void test_mesh_rasterization_matches_serial(void) {
+    std::vector<RasterTriangle> tris = makeStrip();
+    std::vector<uint16_t> serial(W * H), parallel(W * H);
+    hal_surface_t s = { serial.data(), W, H, W, HAL_PIXEL_FORMAT_RGB565_BE };
+    hal_surface_t p = { parallel.data(), W, H, W, HAL_PIXEL_FORMAT_RGB565_BE };
+    int32_t sx, sy, sw, sh, px, py, pw, ph;
+
+    auto drawInto = [&](hal_surface_t& target, std::vector<uint16_t>& pixels,
+                        int32_t& x, int32_t& y, int32_t& w, int32_t& h) {
+        for (auto& v : pixels) v = 0x1111;
+        TriangleRasterizer r(target);
+        r.setAntiAlias(true);
+        r.fillMesh(tris.data(), tris.size(), 0xFFE0);
+        r.fillMesh(tris.data(), tris.size() - 1, 0x001F);
+        r.getDirtyRect(x, y, w, h);
+    };
+
+    double serial_ms = bestMillis([&]() { drawInto(s, serial, sx, sy, sw, sh); });
+    ParallelRows::getInstance().begin(helperCount());
+    double parallel_ms = bestMillis([&]() { drawInto(p, parallel, px, py, pw, ph); });
+    reportSpeedup("mesh rasterization 4x AA", serial_ms, parallel_ms);
+
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(serial.data(), parallel.data(), W * H);
+    TEST_ASSERT_EQUAL_INT32(sx, px);
+    TEST_ASSERT_EQUAL_INT32(sy, py);
+    TEST_ASSERT_EQUAL_INT32(sw, pw);
+    TEST_ASSERT_EQUAL_INT32(sh, ph);
+}
+
+static std::vector<uint16_t> g_screen;
+
+static void capturePresent(int16_t x, int16_t y, const hal_surface_t* surface) {
+    for (int32_t row = 0; row < surface->height; row++) {
+        for (int32_t col = 0; col < surface->width; col++) {
+            g_screen[(y + row) * W + x + col] = surface->pixels[row * surface->stride + col];
+        }
+    }
+}
+
+class LayerApp : public AppComponent {
+public:
+    UILayer layer;
+    LayerApp() { layer.init(0, 0, W, H); }
+    void render() override {}
+    UILayer* getLayer() override { return &layer; }
+};
+
+class LayerOverlay : public SystemComponent {
+public:
+    UILayer layer;
+    LayerOverlay() {
+        layer.init(40, 60, 400, 300);
+        layer.setOpacity(160);
+        layer.setBlendMode(UILayer::BlendMode::KEYED, 0x0000);
+    }
+    void render() override {}
+    UILayer* getLayer() override { return &layer; }
+};
+
+void test_layer_composition_matches_serial(void) {
+    LayerApp app;
+    LayerOverlay overlay;
+    LinearGradient gradient = { 90.0f, { 0x001F, 0xF81F }, 2 };
+    gradient_fill_linear(app.layer.getSurface(), 0, 0, W, H, gradient, false);
+    hal_surface_t o = overlay.layer.getSurface();
+    for (int32_t y = 0; y < o.height; y++) {
+        for (int32_t x = 0; x < o.width; x++) {
+            o.pixels[y * o.stride + x] = ((x / 8 + y / 8) & 1) ? 0xFFE0 : 0x0000;
+        }
+    }
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.reset();
+    mgr.setPresentCallback(capturePresent);
+    mgr.registerComponent(&app, 1);
+    mgr.registerComponent(&overlay, 10);
+
+    auto composeAll = [&]() {
+        app.layer.invalidate();
+        overlay.layer.invalidate();
+        mgr.renderAll();
+    };
+
+    g_screen.assign(W * H, 0);
+    double serial_ms = bestMillis(composeAll);
+    std::vector<uint16_t> serial = g_screen;
+
+    ParallelRows::getInstance().begin(helperCount());
+    g_screen.assign(W * H, 0);
+    double parallel_ms = bestMillis(composeAll);
+    reportSpeedup("layer composition 480x480", serial_ms, parallel_ms);
+
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(serial.data(), g_screen.data(), W * H);
+    TEST_ASSERT_TRUE(ParallelRows::getInstance().getStats().parallel_runs > 0);
+
+    mgr.reset();
+    mgr.setPresentCallback(hal_display_blit_surface);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_band_bounds_partition_the_range);
+    RUN_TEST(test_serial_without_helpers);
+    RUN_TEST(test_every_row_runs_once_across_helpers);
+    RUN_TEST(test_nested_run_is_serial);
+    RUN_TEST(test_gradient_fill_matches_serial);
+    RUN_TEST(test_mesh_rasterization_matches_serial);
+    RUN_TEST(test_layer_composition_matches_serial);
+
+    return UNITY_END();
+}
@@ -8,7 +8,9 @@
 
 #include <unity.h>
 #include "../../src/relative_display.h"
+#include <chrono>
 #include <cmath>
+#include <stdio.h>
 #include <vector>
 
 // RGB565 color definitions
@@ -80,6 +82,22 @@ public:
     }
 };
 
+// GFX that only counts calls, so benchmarks time the caller's work
+class CountingGFX : public Arduino_GFX {
+public:
+    uint32_t count = 0;
+    int64_t sum = 0;
+
+    CountingGFX(int16_t w, int16_t h) : Arduino_GFX(w, h) {}
+
+    bool begin(int32_t speed = 0) override { return true; }
+    void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override {}
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        count++;
+        sum += x + y;
+    }
+};
+
 // Global test fixtures
 MockArduinoGFX* mockGfx = nullptr;
 RelativeDisplay* relDisplay = nullptr;
@@ -279,6 +297,133 @@ void test_c_style_solid_background(void) {
     // would require HAL mocking which is beyond the scope of this unit test
 }
 
+/**
+ * Test: Fixed-point conversion (features/display_relative_drawing.md, Fixed-Point Coordinates)
+ * Every 0.01% step from -200% to 200% converts to the exactly rounded pixel,
+ * and agrees with the float formula wherever that one isn't sitting on a tie
+ */
+void test_fixed_point_matches_exact_rounding(void) {
+    const int32_t dims[] = { 135, 170, 200, 240, 320, 368, 466, 536 };
+    for (int32_t dim : dims) {
+        RelativeCoords coords(dim, dim);
+        for (int32_t i = -20000; i <= 20000; i++) {
+            rel_fixed_t fx = relFixed(i * 0.01f);
+
+            // Half away from zero on the exact value fx * dim / (100 << 16)
+            int64_t num = static_cast<int64_t>(fx < 0 ? -fx : fx) * dim;
+            int64_t den = static_cast<int64_t>(100) << REL_FIXED_SHIFT;
+            int32_t exact = static_cast<int32_t>((num + den / 2) / den);
+            if (fx < 0) exact = -exact;
+            TEST_ASSERT_EQUAL_INT32(exact, coords.x(fx));
+
+            bool tie = (num * 2) % den == 0 && (num * 2 / den) % 2 == 1;
+            if (!tie) {
+                float pct = i * 0.01f;
+                TEST_ASSERT_EQUAL_INT32(static_cast<int32_t>(roundf((pct / 100.0f) * dim)), coords.x(fx));
+            }
+        }
+    }
+
+    // Round trip from pixels
+    RelativeCoords coords(240, 536);
+    for (int32_t px = 0; px <= 536; px++) {
+        TEST_ASSERT_EQUAL_INT32(px, coords.y(relFromPixels(px, 536)));
+    }
+}
+
+/**
+ * Test: Fixed-point, pixel-space and compile-time primitives draw what the
+ * float API draws
+ */
+void test_fixed_and_panel_primitives_match_float(void) {
+    delete relDisplay;
+    delete mockGfx;
+    mockGfx = new MockArduinoGFX(240, 536);
+    relDisplay = new RelativeDisplay(mockGfx, 240, 536);
+
+    MockArduinoGFX panelGfx(240, 536);
+    PanelRelativeDisplay<240, 536> panel(&panelGfx);
+
+    relDisplay->drawPixel(33.3f, 66.6f, RGB565_RED);
+    relDisplay->drawHorizontalLine(12.5f, 90.0f, 10.0f, RGB565_GREEN);
+    relDisplay->drawVerticalLine(75.0f, 5.0f, 95.0f, RGB565_BLUE);
+    relDisplay->fillRect(10.0f, 10.0f, 80.0f, 80.0f, RGB565_WHITE);
+
+    panel.drawPixelFixed(relFixed(33.3f), relFixed(66.6f), RGB565_RED);
+    panel.drawHorizontalLineFixed(relFixed(12.5f), relFixedPercent(90), relFixedPercent(10), RGB565_GREEN);
+    panel.drawVerticalLineFixed(relFixedPercent(75), relFixedPercent(5), relFixedPercent(95), RGB565_BLUE);
+    panel.fillRectFixed(relFixedPercent(10), relFixedPercent(10), relFixedPercent(80), relFixedPercent(80),
+                        RGB565_WHITE);
+
+    TEST_ASSERT_EQUAL_UINT32(4, mockGfx->calls.size());
+    TEST_ASSERT_EQUAL_UINT32(4, panelGfx.calls.size());
+    for (size_t i = 0; i < 4; i++) {
+        const MockArduinoGFX::DrawCall& a = mockGfx->calls[i];
+        const MockArduinoGFX::DrawCall& b = panelGfx.calls[i];
+        TEST_ASSERT_EQUAL(a.type, b.type);
+        TEST_ASSERT_EQUAL_INT16(a.x, b.x);
+        TEST_ASSERT_EQUAL_INT16(a.y, b.y);
+        TEST_ASSERT_EQUAL_UINT16(a.color, b.color);
+        if (a.type != MockArduinoGFX::DrawCall::PIXEL) {
+            TEST_ASSERT_EQUAL_INT16(a.type == MockArduinoGFX::DrawCall::VLINE ? a.h : a.w,
+                                    b.type == MockArduinoGFX::DrawCall::VLINE ? b.h : b.w);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT16(24, panelGfx.calls[1].x);    // 10% of 240, ends swapped
+    TEST_ASSERT_EQUAL_INT16(193, panelGfx.calls[1].w);   // 216 - 24 + 1
+    TEST_ASSERT_EQUAL_INT16(429, panelGfx.calls[3].h);   // 80% of 536 (rounded)
+
+    // Pixel-space entry point, as used by the graph's line rasterizer
+    mockGfx->clearCalls();
+    relDisplay->drawAbsolutePixel(17, 400, RGB565_RED);
+    TEST_ASSERT_EQUAL_UINT32(1, mockGfx->calls.size());
+    TEST_ASSERT_EQUAL_INT16(17, mockGfx->calls[0].x);
+    TEST_ASSERT_EQUAL_INT16(400, mockGfx->calls[0].y);
+}
+
+/**
+ * Benchmark: per-pixel cost of the relative API against raw pixel calls
+ */
+void test_benchmark_relative_vs_raw_pixels(void) {
+    const int32_t W = 240;
+    const int32_t H = 536;
+    const int32_t iterations = 2000000;
+    CountingGFX counter(W, H);
+    Arduino_GFX* gfx = &counter;
+    RelativeDisplay display(gfx, W, H);
+    PanelRelativeDisplay<W, H> panel(gfx);
+
+    // Same walk over the panel in every mode: pixels, float percent, 16.16 percent
+    const float step_x = 100.0f / W;
+    const float step_y = 100.0f / H;
+    const rel_fixed_t fstep_x = relFromPixels(1, W);
+    const rel_fixed_t fstep_y = relFromPixels(1, H);
+
+    double ns[4];
+    for (int mode = 0; mode < 4; mode++) {
+        counter.count = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int32_t i = 0; i < iterations; i++) {
+            int32_t x = i % W;
+            int32_t y = (i / W) % H;
+            switch (mode) {
+                case 0: gfx->drawPixel(x, y, 0xFFFF); break;
+                case 1: display.drawPixel(x * step_x, y * step_y, 0xFFFF); break;
+                case 2: display.drawPixelFixed(x * fstep_x, y * fstep_y, 0xFFFF); break;
+                case 3: panel.drawPixelFixed(x * fstep_x, y * fstep_y, 0xFFFF); break;
+            }
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        ns[mode] = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+        TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(iterations), counter.count);
+    }
+
+    printf("[BENCH] drawPixel ns/call: raw %.2f, float %.2f (+%.2f), fixed %.2f (+%.2f), "
+           "panel<%d,%d> %.2f (+%.2f)\n",
+           ns[0], ns[1], ns[1] - ns[0], ns[2], ns[2] - ns[0], static_cast<int>(W), static_cast<int>(H),
+           ns[3], ns[3] - ns[0]);
+}
+
 int main(int argc, char **argv) {
     UNITY_BEGIN();
 
@@ -294,6 +439,9 @@ int main(int argc, char **argv) {
     RUN_TEST(test_non_square_surface);
     RUN_TEST(test_draw_solid_background);
     RUN_TEST(test_c_style_solid_background);
+    RUN_TEST(test_fixed_point_matches_exact_rounding);
+    RUN_TEST(test_fixed_and_panel_primitives_match_float);
+    RUN_TEST(test_benchmark_relative_vs_raw_pixels);
 
     return UNITY_END();
 }
@@ -9,10 +9,23 @@
  * - App switching (Pause/Resume via activation events)
  * - System Menu closing (systemPause)
  * - Event routing (highest Z first, propagation stop)
+ * - Layer mode (composition of changed layers only, exposure, translucency)
+ * - Rectangle-level occlusion culling (render clips, stacked overlays, exposure)
+ * - Frame rate requests (fastest among drawn components)
+ * - Staged frames (update, late input, late update, render)
+ * - Update rates and wake-up requests
  */
 
 #include <unity.h>
 #include "ui/ui_render_manager.h"
+#include <string.h>
+
+// Virtual clock for wake-up requests (overrides the weak stub in hal/timer_stub.cpp)
+static uint64_t g_now = 0;
+
+extern "C" uint64_t hal_timer_get_micros(void) {
+    return g_now;
+}
 
 // ==========================================
 // Render-order tracking
@@ -42,6 +55,11 @@ public:
     int closeCalls = 0;
     int updateCalls = 0;
     float lastDt = 0.0f;
+    uint32_t fps = FPS_DEFAULT;
+
+    bool lastClipped = false;
+    bool lastExposed = false;
+    hal_rect_t lastClip = { 0, 0, 0, 0 };
 
     MockApp(int id) : id(id) {}
 
@@ -52,6 +70,9 @@ public:
 
     void render() override {
         if (g_renderCount < 16) g_renderOrder[g_renderCount++] = id;
+        lastClipped = isRenderClipped();
+        lastExposed = isExposed();
+        lastClip = getRenderClip();
     }
 
     void update(float dt) override {
@@ -66,6 +87,7 @@ public:
 
     bool isOpaque() const override { return opaqueFlag; }
     bool isFullscreen() const override { return fullscreenFlag; }
+    uint32_t getTargetFps() const override { return fps; }
 };
 
 class MockSystem : public SystemComponent {
@@ -79,6 +101,7 @@ public:
     int unpauseCalls = 0;
     int updateCalls = 0;
     float lastDt = 0.0f;
+    uint32_t fps = FPS_DEFAULT;
 
     MockSystem(int id) : id(id) {}
 
@@ -101,15 +124,114 @@ public:
 
     bool isOpaque() const override { return opaqueFlag; }
     bool isFullscreen() const override { return fullscreenFlag; }
+    uint32_t getTargetFps() const override { return fps; }
+};
+
+// Direct-drawing overlay that paints an opaque rectangle
+class MockPanel : public SystemComponent {
+public:
+    int id;
+    hal_rect_t rect;
+
+    MockPanel(int id, int32_t x, int32_t y, int32_t w, int32_t h) : id(id), rect{ x, y, w, h } {}
+
+    void render() override {
+        if (g_renderCount < 16) g_renderOrder[g_renderCount++] = id;
+    }
+
+    bool getBounds(hal_rect_t& out) const override { out = rect; return true; }
+    bool getOpaqueBounds(hal_rect_t& out) const override { out = rect; return true; }
 };
 
+// ==========================================
+// Layer-mode mocks: a captured 240x240 "screen" (the stub display size)
+// ==========================================
+static constexpr int32_t SCREEN = 240;
+static uint16_t g_screen[SCREEN * SCREEN];
+static int32_t g_presentedPixels = 0;
+
+static void capturePresent(int16_t x, int16_t y, const hal_surface_t* surface) {
+    for (int32_t row = 0; row < surface->height; row++) {
+        for (int32_t col = 0; col < surface->width; col++) {
+            g_screen[(y + row) * SCREEN + x + col] = surface->pixels[row * surface->stride + col];
+        }
+    }
+    g_presentedPixels += surface->width * surface->height;
+}
+
+class LayeredApp : public AppComponent {
+public:
+    UILayer layer;
+    uint16_t color;
+    bool contentDirty = true;
+    int drawCalls = 0;
+    uint32_t fps = FPS_DEFAULT;
+
+    LayeredApp(uint16_t color) : color(color) {
+        layer.init(0, 0, SCREEN, SCREEN);
+    }
+
+    void render() override {
+        if (contentDirty) {
+            layer.fill(color);
+            contentDirty = false;
+            drawCalls++;
+        }
+    }
+
+    UILayer* getLayer() override { return &layer; }
+    bool isOpaque() const override { return true; }
+    bool isFullscreen() const override { return true; }
+    uint32_t getTargetFps() const override { return fps; }
+};
+
+class LayeredOverlay : public SystemComponent {
+public:
+    UILayer layer;
+    int drawCalls = 0;
+    bool drawn = false;
+
+    // 20x10 red box with a transparent (key) left half
+    LayeredOverlay() {
+        layer.init(200, 10, 20, 10);
+        layer.setBlendMode(UILayer::BlendMode::KEYED, KEY);
+    }
+
+    void render() override {
+        if (!drawn) {
+            layer.fill(KEY);
+            const hal_surface_t& s = layer.getSurface();
+            for (int32_t row = 0; row < s.height; row++) {
+                for (int32_t col = 10; col < s.width; col++) {
+                    s.pixels[row * s.stride + col] = 0xF800;
+                }
+            }
+            drawn = true;
+            drawCalls++;
+        }
+    }
+
+    UILayer* getLayer() override { return &layer; }
+
+    static constexpr uint16_t KEY = 0xF81F;
+};
+
+static uint16_t screenAt(int32_t x, int32_t y) {
+    return g_screen[y * SCREEN + x];
+}
+
 // ==========================================
 // Setup & Teardown
 // ==========================================
 
 void setUp(void) {
     UIRenderManager::getInstance().reset();
+    UIRenderManager::getInstance().setPresentCallback(capturePresent);
+    UIRenderManager::getInstance().setLayerBackdrop(0x0000);
     resetTracking();
+    g_now = 0;
+    for (int32_t i = 0; i < SCREEN * SCREEN; i++) g_screen[i] = 0xDEAD;
+    g_presentedPixels = 0;
 }
 
 void tearDown(void) {}
@@ -536,6 +658,523 @@ void test_update_skips_hidden_system() {
     TEST_ASSERT_EQUAL(0, overlay.updateCalls); // Hidden — skipped
 }
 
+// ==========================================
+// Staged frame: update → input drain → late update → render
+// ==========================================
+
+// Logs its stages; the drawn position is what the frame shows
+class StagedApp : public AppComponent {
+public:
+    char log[16] = {};
+    int logLength = 0;
+    float position = 0.0f;      // Animated by update()
+    float drawnPosition = -1.0f;
+    int16_t fingerX = 0;        // Latest drag, followed in lateUpdate()
+    int16_t cursorX = 0;
+    int16_t drawnCursorX = -1;
+    int16_t updateSawX = -1;    // fingerX as update() saw it
+
+    void stage(char c) { if (logLength < 15) log[logLength++] = c; }
+
+    void update(float dt) override {
+        stage('U');
+        position += 100.0f * dt;
+        updateSawX = fingerX;
+    }
+    bool handleInput(const touch_gesture_event_t& event) override {
+        stage('I');
+        fingerX = event.x_px;
+        return true;
+    }
+    void lateUpdate() override { stage('L'); cursorX = fingerX; }
+    void render() override {
+        stage('R');
+        drawnPosition = position;
+        drawnCursorX = cursorX;
+    }
+};
+
+static int g_flushes = 0;
+static void countFlush() { g_flushes++; }
+
+static void drainOneDrag(void* context) {
+    touch_gesture_event_t event = {};
+    event.type = TOUCH_DRAG;
+    event.x_px = *static_cast<int16_t*>(context);
+    UIRenderManager::getInstance().routeInput(event);
+}
+
+void test_run_frame_stages_in_order() {
+    StagedApp app;
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.setActiveApp(&app);
+    g_flushes = 0;
+    mgr.setFlushCallback(countFlush);
+
+    int16_t x = 42;
+    mgr.runFrame(0.5f, drainOneDrag, &x);
+    mgr.setFlushCallback(nullptr);
+
+    TEST_ASSERT_EQUAL_STRING("UILR", app.log);
+    TEST_ASSERT_EQUAL(1, g_flushes);
+
+    // The animation is drawn where this frame's dt put it, not a frame late,
+    // and the cursor where this frame's input left it
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 50.0f, app.drawnPosition);
+    TEST_ASSERT_EQUAL_INT16(42, app.drawnCursorX);
+
+    // Without input: no drain stage
+    app.logLength = 0;
+    memset(app.log, 0, sizeof(app.log));
+    mgr.runFrame(0.5f);
+    TEST_ASSERT_EQUAL_STRING("ULR", app.log);
+}
+
+// The drain stage runs between update() and lateUpdate(): a gesture drained
+// in frame N reaches lateUpdate() (and the drawing) in frame N, and update()
+// only in frame N + 1
+void test_drained_gesture_reaches_late_update_same_frame() {
+    StagedApp app;
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.setActiveApp(&app);
+
+    static const int16_t xs[] = { 10, 20, 30 };
+    int16_t previous = 0;
+    for (int16_t x : xs) {
+        int16_t drained = x;
+        app.logLength = 0;
+        memset(app.log, 0, sizeof(app.log));
+        mgr.runFrame(0.5f, drainOneDrag, &drained);
+
+        TEST_ASSERT_EQUAL_STRING("UILR", app.log);
+        TEST_ASSERT_EQUAL_INT16(x, app.cursorX);
+        TEST_ASSERT_EQUAL_INT16(x, app.drawnCursorX);
+        TEST_ASSERT_EQUAL_INT16(previous, app.updateSawX);
+        previous = x;
+    }
+
+    // No input this frame: the last drag stays where it was drawn
+    mgr.runFrame(0.5f);
+    TEST_ASSERT_EQUAL_INT16(30, app.drawnCursorX);
+}
+
+void test_late_update_skips_hidden_and_paused() {
+    StagedApp app;
+    StagedApp other;
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.registerComponent(&other, 2);
+    mgr.setActiveApp(&other);
+    mgr.setActiveApp(&app);     // Pauses other
+    app.setVisible(false);
+
+    mgr.lateUpdateAll();
+    TEST_ASSERT_EQUAL(0, app.logLength);
+    TEST_ASSERT_EQUAL(0, other.logLength);
+
+    app.setVisible(true);
+    mgr.lateUpdateAll();
+    TEST_ASSERT_EQUAL_STRING("L", app.log);
+}
+
+// ==========================================
+// Update rates and wake-ups
+// ==========================================
+
+void test_update_rate_ticks_only_due_components() {
+    MockApp app(1);
+    MockSystem indicator(10);
+    MockSystem logo(20);
+    app.fps = UIComponent::FPS_ANIMATION;
+    indicator.fps = UIComponent::FPS_DEFAULT;
+    logo.fps = UIComponent::FPS_STATIC;
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.registerComponent(&indicator, 10);
+    mgr.registerComponent(&logo, 20);
+    mgr.setActiveApp(&app);
+
+    // Six 60fps frames: everyone's first update is due at once
+    for (int i = 0; i < 6; i++) mgr.updateAll(1.0f / 60.0f);
+
+    TEST_ASSERT_EQUAL(6, app.updateCalls);
+    TEST_ASSERT_EQUAL(3, indicator.updateCalls);   // Frames 1, 3, 5
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 2.0f / 60.0f, indicator.lastDt);
+    TEST_ASSERT_EQUAL(1, logo.updateCalls);
+
+    // Frames that come a little early still tick a component at the loop's rate
+    indicator.updateCalls = 0;
+    for (int i = 0; i < 4; i++) mgr.updateAll(0.030f);
+    TEST_ASSERT_EQUAL(4, indicator.updateCalls);
+
+    // A paused component's frames don't count towards its next update
+    indicator.hide();
+    mgr.updateAll(1.0f);
+    indicator.show();
+    mgr.updateAll(0.010f);
+    TEST_ASSERT_EQUAL(4, indicator.updateCalls);
+}
+
+// The stock ticker case: a minute at FPS_STATIC, then a 30 Hz pulse
+void test_static_period_is_not_handed_to_next_update() {
+    MockSystem indicator(10);
+    indicator.fps = UIComponent::FPS_STATIC;
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&indicator, 10);
+    for (int i = 0; i < 60; i++) mgr.updateAll(1.0f);
+    TEST_ASSERT_EQUAL(1, indicator.updateCalls);
+
+    indicator.fps = UIComponent::FPS_DEFAULT;
+    mgr.updateAll(1.0f / 30.0f);
+    TEST_ASSERT_EQUAL(2, indicator.updateCalls);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 1.0f / 30.0f, indicator.lastDt);
+}
+
+void test_wake_request_updates_static_component() {
+    MockSystem logo(10);
+    logo.fps = UIComponent::FPS_STATIC;
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&logo, 10);
+    mgr.updateAll(0.1f);
+    TEST_ASSERT_EQUAL(1, logo.updateCalls);
+    TEST_ASSERT_EQUAL_UINT64(0, mgr.getNextWakeMicros());
+
+    logo.requestWakeAt(60000000);
+    TEST_ASSERT_EQUAL_UINT64(60000000, mgr.getNextWakeMicros());
+
+    g_now = 59999999;
+    mgr.updateAll(0.1f);
+    TEST_ASSERT_EQUAL(1, logo.updateCalls);
+
+    // Due from the requested time on; the static frames before don't count
+    g_now = 60010000;
+    mgr.updateAll(0.1f);
+    TEST_ASSERT_EQUAL(2, logo.updateCalls);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.1f, logo.lastDt);
+    TEST_ASSERT_EQUAL_UINT64(0, logo.getWakeMicros());
+    TEST_ASSERT_EQUAL_UINT64(0, mgr.getNextWakeMicros());
+
+    // Hidden components don't hold the loop awake
+    logo.requestWakeAt(70000000);
+    logo.hide();
+    TEST_ASSERT_EQUAL_UINT64(0, mgr.getNextWakeMicros());
+}
+
+// ==========================================
+// Frame rate requests
+// ==========================================
+
+void test_target_fps_is_fastest_drawn_request() {
+    auto& mgr = UIRenderManager::getInstance();
+    TEST_ASSERT_EQUAL_UINT32(UIComponent::FPS_STATIC, mgr.getTargetFps());
+
+    MockApp app(1);
+    MockSystem logo(10);
+    MockSystem menu(20);
+    app.fps = 1;
+    logo.fps = UIComponent::FPS_STATIC;
+    menu.fps = UIComponent::FPS_ANIMATION;
+    menu.opaqueFlag = true;
+    menu.fullscreenFlag = true;
+    menu.hide();
+
+    mgr.registerComponent(&app, 1);
+    mgr.registerComponent(&logo, 10);
+    mgr.registerComponent(&menu, 20);
+    mgr.setActiveApp(&app);
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL_UINT32(1, mgr.getTargetFps());
+
+    // A sliding menu drives the rate
+    menu.show();
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL_UINT32(UIComponent::FPS_ANIMATION, mgr.getTargetFps());
+
+    // Once it is static, the app hidden beneath it no longer counts
+    menu.fps = UIComponent::FPS_STATIC;
+    app.fps = UIComponent::FPS_DEFAULT;
+    TEST_ASSERT_EQUAL_UINT32(UIComponent::FPS_STATIC, mgr.getTargetFps());
+
+    menu.hide();
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL_UINT32(UIComponent::FPS_DEFAULT, mgr.getTargetFps());
+}
+
+// ==========================================
+// Layer Mode
+// ==========================================
+
+void test_layers_composed_once_until_changed() {
+    LayeredApp app(0x1234);
+    LayeredOverlay logo;
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.registerComponent(&logo, 10);
+
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL_INT32(SCREEN * SCREEN, g_presentedPixels);
+    TEST_ASSERT_EQUAL_HEX16(0x1234, screenAt(0, 0));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, screenAt(205, 15));   // Key shows the app
+    TEST_ASSERT_EQUAL_HEX16(0xF800, screenAt(215, 15));
+
+    // Nothing changed: nothing is composed or presented
+    g_presentedPixels = 0;
+    mgr.renderAll();
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL_INT32(0, g_presentedPixels);
+    TEST_ASSERT_EQUAL(1, app.drawCalls);
+    TEST_ASSERT_EQUAL(1, logo.drawCalls);
+}
+
+void test_idle_needs_static_components_and_no_damage() {
+    LayeredApp app(0x1234);
+    app.fps = UIComponent::FPS_STATIC;
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+
+    // Not composed yet
+    TEST_ASSERT_FALSE(mgr.isIdle());
+    mgr.renderAll();
+    TEST_ASSERT_TRUE(mgr.isIdle());
+
+    // Drawn into outside render(): the change still has to reach the screen
+    app.layer.fill(0x4321);
+    TEST_ASSERT_FALSE(mgr.isIdle());
+    mgr.renderAll();
+    TEST_ASSERT_TRUE(mgr.isIdle());
+
+    app.fps = UIComponent::FPS_DEFAULT;
+    TEST_ASSERT_FALSE(mgr.isIdle());
+}
+
+void test_overlay_change_does_not_rerender_app() {
+    LayeredApp app(0x0000);
+    LayeredOverlay logo;
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.registerComponent(&logo, 10);
+    mgr.renderAll();
+
+    // Fade to 50%: only the overlay's bounds are composed, from cached layers
+    g_presentedPixels = 0;
+    logo.layer.setOpacity(128);
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL_INT32(20 * 10, g_presentedPixels);
+    TEST_ASSERT_EQUAL(1, app.drawCalls);
+    TEST_ASSERT_EQUAL_HEX16(15 << 11, screenAt(215, 15));  // Red (31) at half intensity over black
+
+    // Move: old and new bounds are composed, the old area shows the app again
+    g_presentedPixels = 0;
+    logo.layer.setPosition(100, 100);
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL_INT32(2 * 20 * 10, g_presentedPixels);
+    TEST_ASSERT_EQUAL_HEX16(0x0000, screenAt(215, 15));
+    TEST_ASSERT_EQUAL_HEX16(15 << 11, screenAt(115, 105));
+    TEST_ASSERT_EQUAL(1, app.drawCalls);
+}
+
+void test_partial_invalidate_composes_only_that_region() {
+    LayeredApp app(0x1111);
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.renderAll();
+
+    g_presentedPixels = 0;
+    app.layer.invalidate(8, 8, 4, 4);
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL_INT32(16, g_presentedPixels);
+
+    // Layer-local rectangles are clipped to the layer
+    g_presentedPixels = 0;
+    app.layer.invalidate(-4, SCREEN - 4, 8, 8);
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL_INT32(16, g_presentedPixels);
+}
+
+void test_closing_direct_menu_recomposes_cached_layers() {
+    LayeredApp app(0x2222);
+    LayeredOverlay logo;
+    MockSystem menu(20);
+    menu.opaqueFlag = true;
+    menu.fullscreenFlag = true;
+    menu.setActivationEvent(TOUCH_EDGE_DRAG, TOUCH_DIR_UP);
+    menu.hide();
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.registerComponent(&logo, 10);
+    mgr.registerComponent(&menu, 20);
+    mgr.setActiveApp(&app);
+    mgr.renderAll();
+
+    // Open the menu: it draws directly, nothing beneath is composed
+    touch_gesture_event_t event = {};
+    event.type = TOUCH_EDGE_DRAG;
+    event.direction = TOUCH_DIR_UP;
+    mgr.routeInput(event);
+    g_presentedPixels = 0;
+    resetTracking();
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL_INT32(0, g_presentedPixels);
+    TEST_ASSERT_EQUAL(1, g_renderCount);
+    TEST_ASSERT_EQUAL(20, g_renderOrder[0]);
+    for (int32_t i = 0; i < SCREEN * SCREEN; i++) g_screen[i] = 0xBEEF;
+
+    // Close it: the screen is restored from the cached layers, no app redraw
+    menu.systemPause();
+    g_presentedPixels = 0;
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL_INT32(SCREEN * SCREEN, g_presentedPixels);
+    TEST_ASSERT_EQUAL_HEX16(0x2222, screenAt(0, 0));
+    TEST_ASSERT_EQUAL_HEX16(0x2222, screenAt(SCREEN - 1, SCREEN - 1));
+    TEST_ASSERT_EQUAL_HEX16(0xF800, screenAt(215, 15));
+    TEST_ASSERT_EQUAL(1, app.drawCalls);
+    TEST_ASSERT_EQUAL(1, logo.drawCalls);
+}
+
+void test_hidden_direct_overlay_exposes_layers() {
+    LayeredApp app(0x4444);
+    MockSystem status(10);  // Direct-drawing, not full-screen
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.registerComponent(&status, 10);
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL(1, g_renderCount);
+
+    // The overlay's pixels stay on screen until the layers are composed again
+    status.hide();
+    g_presentedPixels = 0;
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL_INT32(SCREEN * SCREEN, g_presentedPixels);
+    TEST_ASSERT_EQUAL(1, app.drawCalls);
+
+    g_presentedPixels = 0;
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL_INT32(0, g_presentedPixels);
+}
+
+void test_translucent_layer_does_not_occlude() {
+    MockApp below(1);
+    LayeredApp app(0x3333);
+    app.layer.setOpacity(200);
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&below, 1);
+    mgr.registerComponent(&app, 5);
+    mgr.renderAll();
+
+    // The opaque full-screen app is faded, so the component below still draws
+    TEST_ASSERT_EQUAL(1, g_renderCount);
+    TEST_ASSERT_EQUAL(1, g_renderOrder[0]);
+
+    app.layer.setOpacity(255);
+    resetTracking();
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL(0, g_renderCount);
+}
+
+// ==========================================
+// Scenario: Rectangle-Level Occlusion Culling
+// ==========================================
+
+void test_partial_overlay_clips_component_below() {
+    MockApp app(1);
+    MockPanel sheet(10, 0, 0, SCREEN, 100);
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.registerComponent(&sheet, 10);
+    mgr.renderAll();
+
+    TEST_ASSERT_EQUAL(2, g_renderCount);
+    TEST_ASSERT_TRUE(app.lastClipped);
+    TEST_ASSERT_EQUAL_INT32(0, app.lastClip.x);
+    TEST_ASSERT_EQUAL_INT32(100, app.lastClip.y);
+    TEST_ASSERT_EQUAL_INT32(SCREEN, app.lastClip.w);
+    TEST_ASSERT_EQUAL_INT32(SCREEN - 100, app.lastClip.h);
+    TEST_ASSERT_FALSE(app.lastExposed);
+}
+
+void test_stacked_overlays_cull_covered_component() {
+    MockApp app(1);
+    MockPanel top(10, 0, 0, SCREEN, 100);
+    MockPanel bottom(20, 0, 80, SCREEN, SCREEN - 80);
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.registerComponent(&top, 10);
+    mgr.registerComponent(&bottom, 20);
+    mgr.renderAll();
+
+    // Neither overlay covers the app alone, together they do
+    TEST_ASSERT_EQUAL(2, g_renderCount);
+    TEST_ASSERT_EQUAL(10, g_renderOrder[0]);
+    TEST_ASSERT_EQUAL(20, g_renderOrder[1]);
+}
+
+void test_uncovered_component_is_exposed() {
+    MockApp app(1);
+    MockPanel top(10, 0, 0, SCREEN, 100);
+    MockPanel bottom(20, 0, 100, SCREEN, SCREEN - 100);
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.registerComponent(&top, 10);
+    mgr.registerComponent(&bottom, 20);
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL(2, g_renderCount);
+
+    // The bottom overlay goes away: the app draws again, told that pixels it
+    // drew before were painted over
+    bottom.hide();
+    resetTracking();
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL(1, g_renderOrder[0]);
+    TEST_ASSERT_TRUE(app.lastExposed);
+    TEST_ASSERT_EQUAL_INT32(100, app.lastClip.y);
+
+    resetTracking();
+    mgr.renderAll();
+    TEST_ASSERT_FALSE(app.lastExposed);
+}
+
+void test_direct_cover_trims_layer_composition() {
+    LayeredApp app(0x5555);
+    LayeredOverlay logo;  // At (200, 10), under the panel
+    MockPanel panel(20, 120, 0, SCREEN - 120, SCREEN);
+
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.registerComponent(&logo, 10);
+    mgr.registerComponent(&panel, 20);
+    mgr.renderAll();
+
+    // Only the uncovered half is composed; the hidden overlay is not drawn
+    TEST_ASSERT_EQUAL_INT32(120 * SCREEN, g_presentedPixels);
+    TEST_ASSERT_EQUAL(0, logo.drawCalls);
+    TEST_ASSERT_EQUAL_HEX16(0x5555, screenAt(0, 0));
+    TEST_ASSERT_EQUAL_HEX16(0xDEAD, screenAt(SCREEN - 1, 0));
+
+    // Moving the panel away composes what it uncovered, overlay included
+    g_presentedPixels = 0;
+    panel.rect = { 0, SCREEN - 20, SCREEN, 20 };
+    mgr.renderAll();
+    TEST_ASSERT_EQUAL(1, logo.drawCalls);
+    TEST_ASSERT_EQUAL(1, app.drawCalls);
+    TEST_ASSERT_EQUAL_HEX16(0x5555, screenAt(SCREEN - 1, 0));
+    TEST_ASSERT_EQUAL_HEX16(0xF800, screenAt(215, 15));
+    TEST_ASSERT_EQUAL_INT32(120 * (SCREEN - 20), g_presentedPixels);
+}
+
 // ==========================================
 // Main
 // ==========================================
@@ -581,5 +1220,33 @@ int main(int argc, char** argv) {
     RUN_TEST(test_update_skips_paused_app);
     RUN_TEST(test_update_skips_hidden_system);
 
+    // Staged frame
+    RUN_TEST(test_run_frame_stages_in_order);
+    RUN_TEST(test_drained_gesture_reaches_late_update_same_frame);
+    RUN_TEST(test_late_update_skips_hidden_and_paused);
+
+    // Update rates and wake-ups
+    RUN_TEST(test_update_rate_ticks_only_due_components);
+    RUN_TEST(test_static_period_is_not_handed_to_next_update);
+    RUN_TEST(test_wake_request_updates_static_component);
+
+    // Frame rate requests
+    RUN_TEST(test_target_fps_is_fastest_drawn_request);
+
+    // Layer mode
+    RUN_TEST(test_layers_composed_once_until_changed);
+    RUN_TEST(test_idle_needs_static_components_and_no_damage);
+    RUN_TEST(test_overlay_change_does_not_rerender_app);
+    RUN_TEST(test_partial_invalidate_composes_only_that_region);
+    RUN_TEST(test_closing_direct_menu_recomposes_cached_layers);
+    RUN_TEST(test_hidden_direct_overlay_exposes_layers);
+    RUN_TEST(test_translucent_layer_does_not_occlude);
+
+    // Rectangle-level occlusion culling
+    RUN_TEST(test_partial_overlay_clips_component_below);
+    RUN_TEST(test_stacked_overlays_cull_covered_component);
+    RUN_TEST(test_uncovered_component_is_exposed);
+    RUN_TEST(test_direct_cover_trims_layer_composition);
+
     return UNITY_END();
 }
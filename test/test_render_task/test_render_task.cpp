@@ -0,0 +1,231 @@
+/**
+ * @file test_render_task.cpp
+ * @brief Unity tests for RenderTask, SpscQueue and TripleBuffer
+ *
+ * The producer/consumer tests use real std::threads on the host, as the
+ * firmware uses two cores, so they are meaningful under -fsanitize=thread
+ * (features/sys_render_task.md).
+ */
+
+#include <unity.h>
+#include "../../src/render_task.h"
+#include "../../src/animation_ticker.h"
+#include "../../src/ui/ui_render_manager.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Real clock, so the render thread paces and sleeps like on hardware
+// (overrides the weak stubs in hal/timer_stub.cpp)
+static const auto g_epoch = std::chrono::steady_clock::now();
+
+extern "C" uint64_t hal_timer_get_micros(void) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - g_epoch).count();
+}
+
+extern "C" void hal_timer_sleep_until(uint64_t deadline_micros) {
+    std::this_thread::sleep_until(g_epoch + std::chrono::microseconds(deadline_micros));
+}
+
+// Counts wake-ups requested by the input side
+static std::atomic<int> g_wakes(0);
+
+extern "C" void hal_timer_wake(void) {
+    g_wakes.fetch_add(1);
+}
+
+// Records the gestures it is routed; only touched by the render thread
+class RecordingApp : public AppComponent {
+public:
+    std::vector<int16_t> xs;
+    std::atomic<int> received{ 0 };
+    uint32_t fps = FPS_STATIC;
+
+    void render() override {}
+    bool handleInput(const touch_gesture_event_t& event) override {
+        xs.push_back(event.x_px);
+        received.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+    uint32_t getTargetFps() const override { return fps; }
+};
+
+static touch_gesture_event_t tapAt(int16_t x) {
+    touch_gesture_event_t event = {};
+    event.type = TOUCH_TAP;
+    event.x_px = x;
+    return event;
+}
+
+void setUp(void) {
+    UIRenderManager::getInstance().reset();
+    g_wakes = 0;
+}
+
+void tearDown(void) {
+    UIRenderManager::getInstance().reset();
+}
+
+void test_spsc_queue_fifo_and_full(void) {
+    SpscQueue<int, 4> queue;
+    int value = 0;
+    TEST_ASSERT_TRUE(queue.isEmpty());
+    TEST_ASSERT_FALSE(queue.pop(&value));
+
+    for (int i = 0; i < 4; i++) TEST_ASSERT_TRUE(queue.push(i));
+    TEST_ASSERT_FALSE(queue.push(99));
+
+    // Indices keep counting across the wrap-around
+    for (int round = 0; round < 10; round++) {
+        TEST_ASSERT_TRUE(queue.pop(&value));
+        TEST_ASSERT_EQUAL(round, value);
+        TEST_ASSERT_TRUE(queue.push(round + 4));
+    }
+}
+
+void test_spsc_queue_across_threads(void) {
+    static SpscQueue<uint32_t, 8> queue;
+    const uint32_t count = 100000;
+
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < count; i++) {
+            while (!queue.push(i)) std::this_thread::yield();
+        }
+    });
+
+    uint32_t expected = 0;
+    bool ordered = true;
+    while (expected < count) {
+        uint32_t value;
+        if (!queue.pop(&value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (value != expected) ordered = false;
+        expected++;
+    }
+    producer.join();
+
+    TEST_ASSERT_TRUE(ordered);
+    TEST_ASSERT_TRUE(queue.isEmpty());
+}
+
+struct Pair {
+    uint32_t a;
+    uint32_t b;   // Always 2 * a: a torn read would break it
+};
+
+void test_triple_buffer_latest_value_is_never_torn(void) {
+    TripleBuffer<Pair> buffer(Pair{ 0, 0 });
+    const uint32_t count = 100000;
+
+    std::thread writer([&]() {
+        for (uint32_t i = 1; i <= count; i++) buffer.write(Pair{ i, 2 * i });
+    });
+
+    bool consistent = true;
+    bool monotonic = true;
+    uint32_t last = 0;
+    while (last < count) {
+        const Pair& pair = buffer.read();
+        if (pair.b != 2 * pair.a) consistent = false;
+        if (pair.a < last) monotonic = false;
+        last = pair.a;
+    }
+    writer.join();
+
+    TEST_ASSERT_TRUE(consistent);
+    TEST_ASSERT_TRUE(monotonic);
+    TEST_ASSERT_EQUAL_UINT32(count, buffer.read().a);
+}
+
+void test_frame_executes_commands_and_paces_for_input(void) {
+    AnimationTicker ticker(30);
+    RenderTask task(&ticker);
+    RecordingApp app;
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.setActiveApp(&app);
+
+    TEST_ASSERT_TRUE(task.postGesture(tapAt(1)));
+    TEST_ASSERT_TRUE(task.postGesture(tapAt(2)));
+    TEST_ASSERT_EQUAL(2, g_wakes.load());
+
+    task.runFrame();
+    TEST_ASSERT_EQUAL(2, app.xs.size());
+    TEST_ASSERT_EQUAL_INT16(1, app.xs[0]);
+    TEST_ASSERT_EQUAL_INT16(2, app.xs[1]);
+    TEST_ASSERT_TRUE(ticker.isIdle());   // Static app, nothing queued
+
+    // A finger down wakes the task once and holds the full rate
+    task.publishInput(RenderTask::InputState{ true });
+    task.publishInput(RenderTask::InputState{ true });
+    TEST_ASSERT_EQUAL(3, g_wakes.load());
+    task.runFrame();
+    TEST_ASSERT_EQUAL_UINT32(UIComponent::FPS_ANIMATION, ticker.getTargetFps());
+    TEST_ASSERT_FALSE(ticker.isIdle());
+
+    task.publishInput(RenderTask::InputState{ false });
+    task.runFrame();
+    TEST_ASSERT_TRUE(ticker.isIdle());
+    TEST_ASSERT_EQUAL_UINT32(3, task.getFrameCount());
+}
+
+void test_full_queue_drops_and_counts(void) {
+    AnimationTicker ticker(30);
+    RenderTask task(&ticker);
+    for (size_t i = 0; i < RenderTask::COMMAND_QUEUE_SIZE; i++) {
+        TEST_ASSERT_TRUE(task.postGesture(tapAt(static_cast<int16_t>(i))));
+    }
+    TEST_ASSERT_FALSE(task.postGesture(tapAt(-1)));
+    TEST_ASSERT_EQUAL_UINT32(1, task.getDroppedCommands());
+}
+
+void test_render_thread_receives_every_gesture_in_order(void) {
+    // Fast frames so the test is quick; the input side outruns them anyway
+    AnimationTicker ticker(1000);
+    ticker.setFpsLimits(1000, 1000);
+    RenderTask task(&ticker);
+    RecordingApp app;
+    app.fps = UIComponent::FPS_DEFAULT;
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.setActiveApp(&app);
+
+    TEST_ASSERT_TRUE(task.start());
+    TEST_ASSERT_TRUE(task.isRunning());
+    TEST_ASSERT_FALSE(task.start());
+
+    const int count = 500;
+    for (int i = 0; i < count; i++) {
+        while (!task.postGesture(tapAt(static_cast<int16_t>(i)))) std::this_thread::yield();
+        task.publishInput(RenderTask::InputState{ (i & 1) != 0 });
+    }
+    while (app.received.load(std::memory_order_acquire) < count) std::this_thread::yield();
+    task.stop();
+    TEST_ASSERT_FALSE(task.isRunning());
+
+    // Joined: the render thread's writes are visible
+    TEST_ASSERT_EQUAL(count, app.xs.size());
+    for (int i = 0; i < count; i++) TEST_ASSERT_EQUAL_INT16(i, app.xs[i]);
+    TEST_ASSERT_TRUE(task.getFrameCount() > 0);
+
+    // Restartable after stop()
+    TEST_ASSERT_TRUE(task.start());
+    task.stop();
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_spsc_queue_fifo_and_full);
+    RUN_TEST(test_spsc_queue_across_threads);
+    RUN_TEST(test_triple_buffer_latest_value_is_never_torn);
+    RUN_TEST(test_frame_executes_commands_and_paces_for_input);
+    RUN_TEST(test_full_queue_drops_and_counts);
+    RUN_TEST(test_render_thread_receives_every_gesture_in_order);
+
+    return UNITY_END();
+}
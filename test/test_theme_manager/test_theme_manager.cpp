@@ -1,5 +1,6 @@
 #include <unity.h>
 #include "theme_manager.h"
+#include "../../hal/display_format.h"
 
 using namespace LPad;
 
@@ -173,6 +174,30 @@ void test_graph_semantic_colors() {
     TEST_ASSERT_EQUAL_UINT16(THEME_DATA_LABELS, theme->colors.data_labels);
 }
 
+/**
+ * Test: Native-format colors follow the active theme
+ * Converted once per setTheme(), matching a per-color conversion
+ */
+void test_native_colors_follow_theme() {
+    ThemeManager& manager = ThemeManager::getInstance();
+    hal_pixel_format_t format = hal_display_get_native_format();
+
+    Theme custom = *ThemeManager::getDefaultTheme();
+    custom.colors.background = 0x1234;
+    custom.colors.scroll_indicator = 0xABCD;
+    manager.setTheme(&custom);
+
+    const ThemeColors& native = manager.getNativeColors();
+    TEST_ASSERT_EQUAL_HEX16(hal_color_to_format(0x1234, format), native.background);
+    TEST_ASSERT_EQUAL_HEX16(hal_color_to_format(0xABCD, format), native.scroll_indicator);
+    TEST_ASSERT_EQUAL_HEX16(hal_color_to_format(custom.colors.primary, format), native.primary);
+
+    // Switching back rebuilds the table
+    manager.setTheme(ThemeManager::getDefaultTheme());
+    TEST_ASSERT_EQUAL_HEX16(hal_color_to_format(THEME_BACKGROUND, format),
+                            manager.getNativeColors().background);
+}
+
 // ==========================================
 // Main Test Runner
 // ==========================================
@@ -188,6 +213,7 @@ int main(int argc, char** argv) {
     RUN_TEST(test_set_theme_null_ignored);
     RUN_TEST(test_get_default_theme);
     RUN_TEST(test_graph_semantic_colors);
+    RUN_TEST(test_native_colors_follow_theme);
 
     return UNITY_END();
 }
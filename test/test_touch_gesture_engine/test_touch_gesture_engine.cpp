@@ -0,0 +1,217 @@
+/**
+ * @file test_touch_gesture_engine.cpp
+ * @brief Unity tests for TouchGestureEngine velocity, DRAG, FLING and prediction
+ *
+ * Feeds timestamped strokes to updateAt() on a 400x400 screen: movement
+ * threshold 20 px, center swipe 32 px (edge zones reach 120 px in), fling
+ * 200 px/s (features/touch_gesture_engine.md, Velocity & Fling).
+ */
+
+#include <unity.h>
+#include "../../src/input/touch_gesture_engine.h"
+#include <vector>
+
+static constexpr int16_t SCREEN = 400;
+static constexpr uint64_t SAMPLE_US = 10000;  // 100 Hz panel
+
+// Every event from one sample, the pending one included
+static void feed(TouchGestureEngine& engine, int16_t x, int16_t y, bool pressed,
+                 uint64_t t_us, std::vector<touch_gesture_event_t>* events) {
+    touch_gesture_event_t event = {};
+    if (engine.updateAt(x, y, pressed, t_us, &event)) events->push_back(event);
+    if (engine.takePendingEvent(&event)) events->push_back(event);
+}
+
+// Touch down at (200, y0), then move down by step px per sample
+static uint64_t stroke(TouchGestureEngine& engine, int16_t y0, int16_t step, int samples,
+                       std::vector<touch_gesture_event_t>* events) {
+    uint64_t t = 1000000;
+    for (int i = 0; i <= samples; i++) {
+        feed(engine, 200, y0 + step * i, true, t, events);
+        t += SAMPLE_US;
+    }
+    return t;
+}
+
+static int count(const std::vector<touch_gesture_event_t>& events, touch_gesture_type_t type) {
+    int n = 0;
+    for (const auto& e : events) {
+        if (e.type == type) n++;
+    }
+    return n;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_velocity_of_constant_motion(void) {
+    TouchGestureEngine engine(SCREEN, SCREEN);
+    std::vector<touch_gesture_event_t> events;
+    stroke(engine, 100, 5, 10, &events);  // 5 px per 10 ms
+
+    float vx, vy;
+    engine.getVelocity(&vx, &vy);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.0f, vx);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 500.0f, vy);
+}
+
+void test_drag_deltas_add_up_to_the_movement(void) {
+    TouchGestureEngine engine(SCREEN, SCREEN);
+    std::vector<touch_gesture_event_t> events;
+    uint64_t t = stroke(engine, 100, 5, 20, &events);
+
+    int drags = count(events, TOUCH_DRAG);
+    TEST_ASSERT_TRUE(drags >= 15);
+    TEST_ASSERT_EQUAL(TOUCH_DRAG, events[0].type);
+    TEST_ASSERT_EQUAL_INT16(100, events[0].start_y_px);
+
+    int sum = 0;
+    for (const auto& e : events) sum += e.delta_y;
+    TEST_ASSERT_EQUAL(100, sum);
+    TEST_ASSERT_EQUAL_INT16(200, events.back().y_px);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 500.0f, events.back().velocity_y);
+
+    // A finger at rest reports nothing new
+    events.clear();
+    feed(engine, 200, 200, true, t, &events);
+    TEST_ASSERT_EQUAL(0, events.size());
+}
+
+void test_fast_release_is_swipe_then_fling(void) {
+    TouchGestureEngine engine(SCREEN, SCREEN);
+    std::vector<touch_gesture_event_t> events;
+    uint64_t t = stroke(engine, 150, 5, 10, &events);
+
+    events.clear();
+    feed(engine, 0, 0, false, t, &events);
+    TEST_ASSERT_EQUAL(2, events.size());
+
+    TEST_ASSERT_EQUAL(TOUCH_SWIPE, events[0].type);
+    TEST_ASSERT_EQUAL(TOUCH_DIR_DOWN, events[0].direction);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 500.0f, events[0].velocity_y);
+
+    TEST_ASSERT_EQUAL(TOUCH_FLING, events[1].type);
+    TEST_ASSERT_EQUAL(TOUCH_DIR_DOWN, events[1].direction);
+    TEST_ASSERT_EQUAL_INT16(200, events[1].y_px);
+    TEST_ASSERT_EQUAL_INT16(0, events[1].delta_y);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 500.0f, events[1].velocity_y);
+
+    // Taken once
+    touch_gesture_event_t event;
+    TEST_ASSERT_FALSE(engine.takePendingEvent(&event));
+}
+
+void test_short_fast_drag_flings_without_swipe(void) {
+    TouchGestureEngine engine(SCREEN, SCREEN);
+    std::vector<touch_gesture_event_t> events;
+    // 25 px: past the movement threshold, short of a swipe
+    uint64_t t = stroke(engine, 100, 5, 5, &events);
+
+    events.clear();
+    feed(engine, 0, 0, false, t, &events);
+    TEST_ASSERT_EQUAL(1, events.size());
+    TEST_ASSERT_EQUAL(TOUCH_FLING, events[0].type);
+}
+
+void test_no_fling_after_a_pause(void) {
+    TouchGestureEngine engine(SCREEN, SCREEN);
+    std::vector<touch_gesture_event_t> events;
+    uint64_t t = stroke(engine, 150, 5, 10, &events);
+
+    // Still for longer than the velocity window, then lift
+    for (int i = 0; i < 15; i++) {
+        feed(engine, 200, 200, true, t, &events);
+        t += SAMPLE_US;
+    }
+    float vx, vy;
+    engine.getVelocity(&vx, &vy);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, vy);
+
+    events.clear();
+    feed(engine, 0, 0, false, t, &events);
+    TEST_ASSERT_EQUAL(1, events.size());
+    TEST_ASSERT_EQUAL(TOUCH_SWIPE, events[0].type);
+    TEST_ASSERT_EQUAL(0, count(events, TOUCH_FLING));
+}
+
+void test_slow_drag_does_not_fling(void) {
+    TouchGestureEngine engine(SCREEN, SCREEN);
+    std::vector<touch_gesture_event_t> events;
+    uint64_t t = stroke(engine, 100, 1, 40, &events);  // 100 px/s
+
+    events.clear();
+    feed(engine, 0, 0, false, t, &events);
+    TEST_ASSERT_EQUAL(0, count(events, TOUCH_FLING));
+}
+
+void test_prediction_leads_and_fling_corrects(void) {
+    TouchGestureEngine engine(SCREEN, SCREEN);
+    engine.setPredictionMicros(20000);
+    std::vector<touch_gesture_event_t> events;
+    uint64_t t = stroke(engine, 100, 5, 10, &events);
+
+    // 20 ms ahead at 500 px/s
+    TEST_ASSERT_EQUAL(TOUCH_DRAG, events.back().type);
+    TEST_ASSERT_INT_WITHIN(1, 160, events.back().y_px);
+
+    feed(engine, 0, 0, false, t, &events);
+    TEST_ASSERT_EQUAL(TOUCH_FLING, events.back().type);
+    TEST_ASSERT_EQUAL_INT16(150, events.back().y_px);
+
+    // The FLING's correction brings the total back to the real movement
+    int sum = 0;
+    for (const auto& e : events) {
+        if (e.type == TOUCH_DRAG || e.type == TOUCH_FLING) sum += e.delta_y;
+    }
+    TEST_ASSERT_EQUAL(50, sum);
+}
+
+void test_prediction_is_clamped_to_the_screen(void) {
+    TouchGestureEngine engine(SCREEN, SCREEN);
+    engine.setPredictionMicros(200000);
+    std::vector<touch_gesture_event_t> events;
+    stroke(engine, 300, 9, 10, &events);
+
+    TEST_ASSERT_EQUAL_INT16(SCREEN - 1, events.back().y_px);
+}
+
+void test_tap_and_hold_drag_unchanged(void) {
+    TouchGestureEngine engine(SCREEN, SCREEN);
+    std::vector<touch_gesture_event_t> events;
+    feed(engine, 200, 200, true, 1000000, &events);
+    feed(engine, 201, 200, true, 1050000, &events);
+    feed(engine, 0, 0, false, 1100000, &events);
+    TEST_ASSERT_EQUAL(1, events.size());
+    TEST_ASSERT_EQUAL(TOUCH_TAP, events[0].type);
+    TEST_ASSERT_EQUAL(0.0f, events[0].velocity_y);
+
+    // Hold, then a fast drag: HOLD_DRAG only, never DRAG or FLING
+    events.clear();
+    uint64_t t = 2000000;
+    for (int i = 0; i <= 60; i++, t += SAMPLE_US) feed(engine, 200, 200, true, t, &events);
+    for (int i = 1; i <= 10; i++, t += SAMPLE_US) feed(engine, 200, 200 + 8 * i, true, t, &events);
+    feed(engine, 0, 0, false, t, &events);
+    TEST_ASSERT_EQUAL(1, count(events, TOUCH_HOLD));
+    TEST_ASSERT_TRUE(count(events, TOUCH_HOLD_DRAG) > 0);
+    TEST_ASSERT_EQUAL(0, count(events, TOUCH_DRAG));
+    TEST_ASSERT_EQUAL(0, count(events, TOUCH_FLING));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_velocity_of_constant_motion);
+    RUN_TEST(test_drag_deltas_add_up_to_the_movement);
+    RUN_TEST(test_fast_release_is_swipe_then_fling);
+    RUN_TEST(test_short_fast_drag_flings_without_swipe);
+    RUN_TEST(test_no_fling_after_a_pause);
+    RUN_TEST(test_slow_drag_does_not_fling);
+    RUN_TEST(test_prediction_leads_and_fling_corrects);
+    RUN_TEST(test_prediction_is_clamped_to_the_screen);
+    RUN_TEST(test_tap_and_hold_drag_unchanged);
+
+    return UNITY_END();
+}
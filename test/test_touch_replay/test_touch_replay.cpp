@@ -0,0 +1,357 @@
+/**
+ * @file test_touch_replay.cpp
+ * @brief Unity tests for touch trace recording and TouchReplay
+ *
+ * Encodes touch sessions in the trace format, records them through the
+ * sample queue the way the firmware does, and replays them through
+ * TouchGestureEngine and UIRenderManager::routeInput() at full and scaled
+ * speed (features/hal_spec_touch.md, Touch Traces;
+ * features/touch_gesture_engine.md, Trace Replay).
+ *
+ * Captured sessions (scripts/capture_touch_trace.py --header) replay the
+ * same way as the synthetic one here.
+ */
+
+#include <unity.h>
+#include "../../hal/touch_trace.h"
+#include "../../hal/touch_sampler.h"
+#include "../../src/input/touch_replay.h"
+#include "ui/ui_render_manager.h"
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Real clock (overrides the weak stubs in hal/timer_stub.cpp), so replay
+// pacing and processing cost are measured
+extern "C" uint64_t hal_timer_get_micros(void) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+extern "C" void hal_timer_sleep_until(uint64_t deadline_micros) {
+    uint64_t now = hal_timer_get_micros();
+    if (deadline_micros > now) {
+        std::this_thread::sleep_for(std::chrono::microseconds(deadline_micros - now));
+    }
+}
+
+static constexpr uint16_t SCREEN = 400;  // Edge zones reach 120 px in
+static constexpr uint64_t SAMPLE_US = 10000;
+
+// Builds a trace sample by sample
+class TraceBuilder {
+public:
+    std::vector<uint8_t> bytes;
+    uint64_t now = 5000000;  // Recording started a while after boot
+
+    TraceBuilder() {
+        bytes.resize(HAL_TOUCH_TRACE_HEADER_SIZE);
+        hal_touch_trace_write_header(bytes.data(), SCREEN, SCREEN);
+    }
+
+    void sample(int16_t x, int16_t y, bool pressed, bool home = false) {
+        hal_touch_sample_t s = { { x, y, pressed, home }, now };
+        uint8_t record[HAL_TOUCH_TRACE_MAX_RECORD_SIZE];
+        size_t n = hal_touch_trace_encode(&m_state, &s, record);
+        bytes.insert(bytes.end(), record, record + n);
+        now += SAMPLE_US;
+    }
+
+    // Press at (x, y), move by (dx, dy) per sample, release
+    void stroke(int16_t x, int16_t y, int16_t dx, int16_t dy, int moves, int still = 0) {
+        for (int i = 0; i <= moves; i++) sample(x + dx * i, y + dy * i, true);
+        for (int i = 0; i < still; i++) sample(x + dx * moves, y + dy * moves, true);
+        sample(0, 0, false);
+        now += 200000;
+    }
+
+    // Tap, center swipe up (a fling too), hold, top edge drag (opens the
+    // menu), home button
+    void session() {
+        stroke(200, 200, 1, 0, 2);
+        stroke(200, 260, 0, -8, 10);
+        stroke(200, 200, 0, 0, 0, 70);
+        stroke(200, 20, 0, 15, 10);
+        sample(200, 399, true, true);
+        now += 200000;
+    }
+
+private:
+    hal_touch_trace_state_t m_state = {};
+};
+
+class RecordingApp : public AppComponent {
+public:
+    std::vector<touch_gesture_type_t> events;
+    void render() override {}
+    bool handleInput(const touch_gesture_event_t& event) override {
+        events.push_back(event.type);
+        return true;
+    }
+};
+
+class RecordingMenu : public SystemComponent {
+public:
+    std::vector<touch_gesture_type_t> events;
+    void render() override {}
+    bool handleInput(const touch_gesture_event_t& event) override {
+        events.push_back(event.type);
+        return true;
+    }
+};
+
+static std::string g_types;
+
+static void logEvent(const touch_gesture_event_t& event, void* context) {
+    (void)context;
+    static const char CODES[] = "-THhSEDF";  // By touch_gesture_type_t
+    if (event.type != TOUCH_DRAG) g_types += CODES[event.type];
+}
+
+void setUp(void) {
+    UIRenderManager::getInstance().reset();
+    g_types.clear();
+    hal_touch_sample_t sample;
+    while (hal_touch_pop_sample(&sample)) {
+    }
+}
+
+void tearDown(void) {
+    hal_touch_trace_stop();
+    UIRenderManager::getInstance().reset();
+}
+
+// ==========================================
+// Trace format
+// ==========================================
+
+void test_records_round_trip(void) {
+    const hal_touch_sample_t samples[] = {
+        { { 10, 20, true, false }, 1000 },
+        { { 13, 18, true, false }, 11000 },           // Small steps: 5 bytes
+        { { -5, 399, true, false }, 11000 },          // Same time, big jump
+        { { 32767, -32768, false, true }, 90000000 },  // Extremes, home button
+        { { 0, 0, false, false }, 80000000 },          // Out of order: clamped
+    };
+    uint8_t buffer[5 * HAL_TOUCH_TRACE_MAX_RECORD_SIZE];
+    size_t sizes[5];
+    size_t length = 0;
+    hal_touch_trace_state_t encoder = {};
+    for (int i = 0; i < 5; i++) {
+        sizes[i] = hal_touch_trace_encode(&encoder, &samples[i], buffer + length);
+        TEST_ASSERT_TRUE(sizes[i] <= HAL_TOUCH_TRACE_MAX_RECORD_SIZE);
+        length += sizes[i];
+    }
+    TEST_ASSERT_EQUAL(5, sizes[1]);
+
+    hal_touch_trace_state_t decoder = {};
+    size_t pos = 0;
+    for (int i = 0; i < 5; i++) {
+        hal_touch_sample_t out;
+        size_t used = hal_touch_trace_decode(&decoder, buffer + pos, length - pos, &out);
+        TEST_ASSERT_EQUAL(sizes[i], used);
+        pos += used;
+        TEST_ASSERT_EQUAL_INT16(samples[i].point.x, out.point.x);
+        TEST_ASSERT_EQUAL_INT16(samples[i].point.y, out.point.y);
+        TEST_ASSERT_EQUAL(samples[i].point.is_pressed, out.point.is_pressed);
+        TEST_ASSERT_EQUAL(samples[i].point.is_home_button, out.point.is_home_button);
+        uint64_t expected = i == 4 ? samples[3].timestamp_us : samples[i].timestamp_us;
+        TEST_ASSERT_EQUAL_UINT64(expected, out.timestamp_us);
+    }
+
+    // A record cut short doesn't decode
+    hal_touch_trace_state_t partial = {};
+    hal_touch_sample_t out;
+    TEST_ASSERT_EQUAL(0, hal_touch_trace_decode(&partial, buffer, sizes[0] - 1, &out));
+}
+
+void test_header_is_checked(void) {
+    uint8_t header[HAL_TOUCH_TRACE_HEADER_SIZE];
+    TEST_ASSERT_EQUAL(HAL_TOUCH_TRACE_HEADER_SIZE, hal_touch_trace_write_header(header, 466, 368));
+
+    uint16_t w = 0, h = 0;
+    TEST_ASSERT_TRUE(hal_touch_trace_read_header(header, sizeof(header), &w, &h));
+    TEST_ASSERT_EQUAL_UINT16(466, w);
+    TEST_ASSERT_EQUAL_UINT16(368, h);
+
+    TEST_ASSERT_FALSE(hal_touch_trace_read_header(header, sizeof(header) - 1, &w, &h));
+    header[4] = HAL_TOUCH_TRACE_VERSION + 1;
+    TEST_ASSERT_FALSE(hal_touch_trace_read_header(header, sizeof(header), &w, &h));
+    header[4] = HAL_TOUCH_TRACE_VERSION;
+    header[0] = 'X';
+    TEST_ASSERT_FALSE(hal_touch_trace_read_header(header, sizeof(header), &w, &h));
+
+    TouchGestureEngine engine(SCREEN, SCREEN);
+    TouchReplay replay(&engine);
+    TEST_ASSERT_FALSE(replay.load(header, sizeof(header)));
+    TEST_ASSERT_EQUAL_UINT32(0, replay.run().samples);
+}
+
+// ==========================================
+// Recording from the sample queue
+// ==========================================
+
+static void appendBytes(const uint8_t* data, size_t length, void* context) {
+    std::vector<uint8_t>* out = static_cast<std::vector<uint8_t>*>(context);
+    out->insert(out->end(), data, data + length);
+}
+
+void test_popped_samples_are_recorded(void) {
+    std::vector<uint8_t> recorded;
+    TEST_ASSERT_FALSE(hal_touch_trace_start(SCREEN, SCREEN, nullptr, nullptr));
+    TEST_ASSERT_TRUE(hal_touch_trace_start(SCREEN, SCREEN, appendBytes, &recorded));
+    TEST_ASSERT_TRUE(hal_touch_trace_is_recording());
+    TEST_ASSERT_EQUAL(HAL_TOUCH_TRACE_HEADER_SIZE, recorded.size());
+
+    // Queued but not yet taken: not recorded
+    hal_touch_point_t point = { 100, 150, true, false };
+    hal_touch_queue_sample(&point, 1000);
+    point.y = 140;
+    hal_touch_queue_sample(&point, 11000);
+    TEST_ASSERT_EQUAL(HAL_TOUCH_TRACE_HEADER_SIZE, recorded.size());
+
+    hal_touch_sample_t sample;
+    TEST_ASSERT_TRUE(hal_touch_pop_sample(&sample));
+    TEST_ASSERT_TRUE(hal_touch_pop_sample(&sample));
+    hal_touch_trace_stop();
+    TEST_ASSERT_FALSE(hal_touch_trace_is_recording());
+
+    point.is_pressed = false;
+    hal_touch_queue_sample(&point, 21000);
+    TEST_ASSERT_TRUE(hal_touch_pop_sample(&sample));
+
+    // Two records, the second 5 bytes
+    hal_touch_trace_state_t decoder = {};
+    size_t pos = HAL_TOUCH_TRACE_HEADER_SIZE;
+    pos += hal_touch_trace_decode(&decoder, &recorded[pos], recorded.size() - pos, &sample);
+    TEST_ASSERT_EQUAL_INT16(150, sample.point.y);
+    size_t used = hal_touch_trace_decode(&decoder, &recorded[pos], recorded.size() - pos, &sample);
+    TEST_ASSERT_EQUAL(5, used);
+    TEST_ASSERT_EQUAL_INT16(140, sample.point.y);
+    TEST_ASSERT_EQUAL_UINT64(11000, sample.timestamp_us);
+    TEST_ASSERT_EQUAL(recorded.size(), pos + used);
+}
+
+// ==========================================
+// Replay
+// ==========================================
+
+void test_replay_classifies_and_routes_a_session(void) {
+    TraceBuilder trace;
+    trace.session();
+
+    RecordingApp app;
+    RecordingMenu menu;
+    menu.setActivationEvent(TOUCH_EDGE_DRAG, TOUCH_DIR_UP);
+    menu.hide();
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.registerComponent(&menu, 20);
+    mgr.setActiveApp(&app);
+
+    TouchGestureEngine engine(SCREEN, SCREEN);
+    TouchReplay replay(&engine, &mgr);
+    TEST_ASSERT_TRUE(replay.load(trace.bytes.data(), trace.bytes.size()));
+    TEST_ASSERT_EQUAL_UINT16(SCREEN, replay.getWidth());
+    replay.setEventCallback(logEvent, nullptr);
+
+    const TouchReplay::Stats& stats = replay.run();
+    TEST_ASSERT_FALSE(stats.truncated);
+    TEST_ASSERT_EQUAL_UINT32(4 + 12 + 72 + 12 + 1, stats.samples);
+    TEST_ASSERT_EQUAL_STRING("TSFHEFE", g_types.c_str());
+    TEST_ASSERT_EQUAL_UINT32(1, stats.events_by_type[TOUCH_TAP]);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.events_by_type[TOUCH_FLING]);
+    TEST_ASSERT_TRUE(stats.events_by_type[TOUCH_DRAG] >= 10);
+    TEST_ASSERT_EQUAL_UINT64(trace.now - 200000 - SAMPLE_US - 5000000, stats.trace_micros);
+
+    // The top edge drag opened the menu; the rest went to it
+    TEST_ASSERT_TRUE(app.isPaused());
+    TEST_ASSERT_TRUE(menu.isVisible());
+    TEST_ASSERT_EQUAL(TOUCH_TAP, app.events.front());
+    TEST_ASSERT_EQUAL(TOUCH_DRAG, app.events.back());  // The edge drag's own moves
+    TEST_ASSERT_EQUAL(2, menu.events.size());
+    TEST_ASSERT_EQUAL(TOUCH_FLING, menu.events[0]);
+    TEST_ASSERT_EQUAL(TOUCH_EDGE_DRAG, menu.events[1]);
+}
+
+void test_scaled_speed_gives_the_same_gestures(void) {
+    TraceBuilder trace;
+    trace.stroke(200, 260, 0, -8, 10);
+    trace.stroke(200, 200, 1, 0, 2);
+
+    TouchGestureEngine fast_engine(SCREEN, SCREEN);
+    TouchReplay fast(&fast_engine);
+    fast.load(trace.bytes.data(), trace.bytes.size());
+    fast.setEventCallback(logEvent, nullptr);
+    TouchReplay::Stats unpaced = fast.run();
+    std::string unpaced_types = g_types;
+
+    // 10x: the trace spans ~0.35 s, so this takes ~35 ms
+    g_types.clear();
+    TouchGestureEngine paced_engine(SCREEN, SCREEN);
+    TouchReplay paced(&paced_engine);
+    paced.load(trace.bytes.data(), trace.bytes.size());
+    paced.setEventCallback(logEvent, nullptr);
+    uint64_t start = hal_timer_get_micros();
+    TouchReplay::Stats stats = paced.run(10.0f);
+    uint64_t elapsed = hal_timer_get_micros() - start;
+
+    TEST_ASSERT_EQUAL_STRING(unpaced_types.c_str(), g_types.c_str());
+    TEST_ASSERT_EQUAL_STRING("SFT", g_types.c_str());
+    TEST_ASSERT_EQUAL_UINT32(unpaced.events, stats.events);
+    TEST_ASSERT_TRUE(elapsed >= stats.trace_micros / 10);
+}
+
+void test_truncated_trace_stops_cleanly(void) {
+    TraceBuilder trace;
+    trace.stroke(200, 200, 1, 0, 2);
+    trace.bytes.push_back(0x01);  // A record's flags, nothing more
+
+    TouchGestureEngine engine(SCREEN, SCREEN);
+    TouchReplay replay(&engine);
+    replay.load(trace.bytes.data(), trace.bytes.size());
+    const TouchReplay::Stats& stats = replay.run();
+    TEST_ASSERT_TRUE(stats.truncated);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.events_by_type[TOUCH_TAP]);
+}
+
+void test_benchmark_replay_cost(void) {
+    TraceBuilder trace;
+    for (int i = 0; i < 50; i++) trace.session();
+
+    RecordingApp app;
+    auto& mgr = UIRenderManager::getInstance();
+    mgr.registerComponent(&app, 1);
+    mgr.setActiveApp(&app);
+
+    TouchGestureEngine engine(SCREEN, SCREEN);
+    TouchReplay replay(&engine, &mgr);
+    replay.load(trace.bytes.data(), trace.bytes.size());
+    const TouchReplay::Stats& stats = replay.run();
+
+    TEST_ASSERT_EQUAL_UINT32(50 * 101, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(50, stats.events_by_type[TOUCH_TAP]);
+    printf("[BENCH] replay: %u samples (%.1f bytes each) in %.2f ms, %.0f ns/sample avg, "
+           "%u us max, %u events\n",
+           stats.samples, static_cast<double>(trace.bytes.size() - HAL_TOUCH_TRACE_HEADER_SIZE) / stats.samples,
+           stats.busy_micros / 1000.0, stats.busy_micros * 1000.0 / stats.samples,
+           stats.max_sample_micros, stats.events);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_records_round_trip);
+    RUN_TEST(test_header_is_checked);
+    RUN_TEST(test_popped_samples_are_recorded);
+    RUN_TEST(test_replay_classifies_and_routes_a_session);
+    RUN_TEST(test_scaled_speed_gives_the_same_gestures);
+    RUN_TEST(test_truncated_trace_stops_cleanly);
+    RUN_TEST(test_benchmark_replay_cost);
+
+    return UNITY_END();
+}
@@ -0,0 +1,188 @@
+/**
+ * @file test_touch_samples.cpp
+ * @brief Unity tests for the touch sample queue and timestamped gestures
+ *
+ * Stands in for the INT-driven sampler task by queueing samples with
+ * hal_touch_queue_sample(), from a second thread where it matters, and
+ * feeds them to TouchGestureEngine::updateAt() the way the input loop does
+ * (features/hal_spec_touch.md, Interrupt-Driven Sampling).
+ */
+
+#include <unity.h>
+#include "../../hal/touch.h"
+#include "../../hal/touch_sampler.h"
+#include "../../src/input/touch_gesture_engine.h"
+#include <chrono>
+#include <thread>
+
+static hal_touch_point_t makePoint(int16_t x, int16_t y, bool pressed) {
+    hal_touch_point_t point = { x, y, pressed, false };
+    return point;
+}
+
+void setUp(void) {
+    hal_touch_sample_t sample;
+    while (hal_touch_pop_sample(&sample)) {
+    }
+}
+
+void tearDown(void) {
+}
+
+// ==========================================
+// Sample queue
+// ==========================================
+
+void test_samples_pop_in_order_with_timestamps(void) {
+    hal_touch_point_t down = makePoint(10, 20, true);
+    hal_touch_point_t moved = makePoint(12, 25, true);
+    hal_touch_point_t up = makePoint(0, 0, false);
+    TEST_ASSERT_TRUE(hal_touch_queue_sample(&down, 1000));
+    TEST_ASSERT_TRUE(hal_touch_queue_sample(&moved, 11000));
+    TEST_ASSERT_TRUE(hal_touch_queue_sample(&up, 19500));
+
+    hal_touch_sample_t sample;
+    TEST_ASSERT_TRUE(hal_touch_pop_sample(&sample));
+    TEST_ASSERT_EQUAL_UINT64(1000, sample.timestamp_us);
+    TEST_ASSERT_EQUAL_INT16(20, sample.point.y);
+    TEST_ASSERT_TRUE(hal_touch_pop_sample(&sample));
+    TEST_ASSERT_EQUAL_INT16(12, sample.point.x);
+    TEST_ASSERT_TRUE(hal_touch_pop_sample(&sample));
+    TEST_ASSERT_FALSE(sample.point.is_pressed);
+    TEST_ASSERT_EQUAL_UINT64(19500, sample.timestamp_us);
+
+    TEST_ASSERT_FALSE(hal_touch_pop_sample(&sample));
+    TEST_ASSERT_FALSE(hal_touch_pop_sample(nullptr));
+}
+
+void test_full_queue_drops_and_counts(void) {
+    uint32_t dropped = hal_touch_get_dropped_samples();
+    hal_touch_point_t point = makePoint(1, 1, true);
+    for (int i = 0; i < HAL_TOUCH_SAMPLE_QUEUE_SIZE; i++) {
+        TEST_ASSERT_TRUE(hal_touch_queue_sample(&point, i));
+    }
+    TEST_ASSERT_FALSE(hal_touch_queue_sample(&point, 999));
+    TEST_ASSERT_EQUAL_UINT32(dropped + 1, hal_touch_get_dropped_samples());
+
+    // The queued samples are intact; the dropped one never appears
+    hal_touch_sample_t sample;
+    int count = 0;
+    while (hal_touch_pop_sample(&sample)) {
+        TEST_ASSERT_EQUAL_UINT64(count, sample.timestamp_us);
+        count++;
+    }
+    TEST_ASSERT_EQUAL(HAL_TOUCH_SAMPLE_QUEUE_SIZE, count);
+}
+
+void test_wait_returns_when_a_sample_arrives(void) {
+    TEST_ASSERT_FALSE(hal_touch_wait_for_sample(0));
+    TEST_ASSERT_FALSE(hal_touch_wait_for_sample(5));
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread sampler([]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        hal_touch_point_t point = makePoint(5, 5, true);
+        hal_touch_queue_sample(&point, 42);
+    });
+    TEST_ASSERT_TRUE(hal_touch_wait_for_sample(5000));
+    auto waited = std::chrono::steady_clock::now() - start;
+    sampler.join();
+
+    TEST_ASSERT_TRUE(waited < std::chrono::milliseconds(2000));
+    hal_touch_sample_t sample;
+    TEST_ASSERT_TRUE(hal_touch_pop_sample(&sample));
+    TEST_ASSERT_EQUAL_UINT64(42, sample.timestamp_us);
+}
+
+void test_samples_cross_threads_in_order(void) {
+    const int total = 5000;
+    std::thread sampler([]() {
+        for (int i = 0; i < total; i++) {
+            hal_touch_point_t point = makePoint(static_cast<int16_t>(i % 300), 0, true);
+            while (!hal_touch_queue_sample(&point, static_cast<uint64_t>(i))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int next = 0;
+    while (next < total) {
+        hal_touch_wait_for_sample(10);
+        hal_touch_sample_t sample;
+        while (hal_touch_pop_sample(&sample)) {
+            TEST_ASSERT_EQUAL_UINT64(next, sample.timestamp_us);
+            TEST_ASSERT_EQUAL_INT16(next % 300, sample.point.x);
+            next++;
+        }
+    }
+    sampler.join();
+}
+
+// ==========================================
+// Timestamped gestures
+// ==========================================
+
+void test_hold_is_timed_from_sample_timestamps(void) {
+    TouchGestureEngine engine(368, 448);
+    touch_gesture_event_t event;
+
+    // 10 ms reports while the finger rests; the hold fires at 500 ms
+    int hold_at = -1;
+    for (int i = 0; i <= 60; i++) {
+        uint64_t t = 3000000 + static_cast<uint64_t>(i) * 10000;
+        if (engine.updateAt(100, 100, true, t, &event)) {
+            TEST_ASSERT_EQUAL(TOUCH_HOLD, event.type);
+            if (hold_at < 0) hold_at = i;
+        }
+    }
+    TEST_ASSERT_EQUAL(50, hold_at);
+}
+
+void test_sub_millisecond_intervals_accumulate(void) {
+    TouchGestureEngine engine(368, 448);
+    touch_gesture_event_t event;
+
+    // 1.5 ms apart: the half milliseconds must not be lost
+    int hold_at = -1;
+    for (int i = 0; i <= 400 && hold_at < 0; i++) {
+        if (engine.updateAt(100, 100, true, static_cast<uint64_t>(i) * 1500, &event)) hold_at = i;
+    }
+    TEST_ASSERT_EQUAL(334, hold_at);  // First sample at or past 500 ms
+}
+
+void test_tap_from_queued_samples(void) {
+    TouchGestureEngine engine(368, 448);
+    hal_touch_point_t down = makePoint(200, 220, true);
+    hal_touch_point_t up = makePoint(0, 0, false);
+    hal_touch_queue_sample(&down, 10000);
+    hal_touch_queue_sample(&down, 20000);
+    hal_touch_queue_sample(&up, 90000);
+
+    // Drained in one pass, as the input loop does between frames
+    hal_touch_sample_t sample;
+    touch_gesture_event_t event;
+    int taps = 0;
+    while (hal_touch_pop_sample(&sample)) {
+        if (engine.updateAt(sample.point.x, sample.point.y, sample.point.is_pressed,
+                            sample.timestamp_us, &event)) {
+            TEST_ASSERT_EQUAL(TOUCH_TAP, event.type);
+            TEST_ASSERT_EQUAL_INT16(200, event.x_px);
+            taps++;
+        }
+    }
+    TEST_ASSERT_EQUAL(1, taps);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_samples_pop_in_order_with_timestamps);
+    RUN_TEST(test_full_queue_drops_and_counts);
+    RUN_TEST(test_wait_returns_when_a_sample_arrives);
+    RUN_TEST(test_samples_cross_threads_in_order);
+    RUN_TEST(test_hold_is_timed_from_sample_timestamps);
+    RUN_TEST(test_sub_millisecond_intervals_accumulate);
+    RUN_TEST(test_tap_from_queued_samples);
+
+    return UNITY_END();
+}
@@ -0,0 +1,240 @@
+/**
+ * @file test_triangle_rasterizer.cpp
+ * @brief Unity tests for the fixed-point TriangleRasterizer
+ *
+ * Compares the tiled rasterizer against a brute-force reference, and checks
+ * the top-left fill rule, watertight shared edges and 4x AA coverage.
+ */
+
+#include <unity.h>
+#include "../../src/triangle_rasterizer.h"
+#include "../../hal/display_format.h"
+#include <vector>
+
+static constexpr int32_t W = 48;
+static constexpr int32_t H = 40;
+static constexpr uint16_t BG = 0x0000;
+static constexpr uint16_t FG = 0xFFFF;
+
+static std::vector<uint16_t> g_buf;
+
+static hal_surface_t makeSurface(uint16_t fill) {
+    g_buf.assign(W * H, fill);
+    hal_surface_t s = { g_buf.data(), W, H, W, HAL_PIXEL_FORMAT_RGB565 };
+    return s;
+}
+
+static RasterTriangle tri(float x0, float y0, float x1, float y1, float x2, float y2) {
+    RasterTriangle t;
+    t.v[0] = { TriangleRasterizer::toFixed(x0), TriangleRasterizer::toFixed(y0) };
+    t.v[1] = { TriangleRasterizer::toFixed(x1), TriangleRasterizer::toFixed(y1) };
+    t.v[2] = { TriangleRasterizer::toFixed(x2), TriangleRasterizer::toFixed(y2) };
+    return t;
+}
+
+// Brute-force reference: pixel-center sample, 64-bit edge functions, top-left rule
+static bool referenceCovers(const RasterTriangle& t, int32_t px, int32_t py) {
+    RasterVertex a = t.v[0], b = t.v[1], c = t.v[2];
+    int64_t area = (int64_t)(b.x - a.x) * (c.y - a.y) - (int64_t)(b.y - a.y) * (c.x - a.x);
+    if (area == 0) return false;
+    if (area < 0) { RasterVertex tmp = b; b = c; c = tmp; }
+
+    int64_t sx = px * 16 + 8;
+    int64_t sy = py * 16 + 8;
+    const RasterVertex* e[3][2] = { {&b, &c}, {&c, &a}, {&a, &b} };
+    for (int i = 0; i < 3; i++) {
+        const RasterVertex& p = *e[i][0];
+        const RasterVertex& q = *e[i][1];
+        int64_t w = (int64_t)(q.x - p.x) * (sy - p.y) - (int64_t)(q.y - p.y) * (sx - p.x);
+        bool top_left = (p.y == q.y && q.x > p.x) || (q.y < p.y);
+        if (w < 0 || (w == 0 && !top_left)) return false;
+    }
+    return true;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_matches_reference_for_random_triangles(void) {
+    uint32_t seed = 0xC0FFEE;
+    auto rnd = [&seed](int32_t range) {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<int32_t>((seed >> 8) % static_cast<uint32_t>(range));
+    };
+
+    for (int n = 0; n < 200; n++) {
+        RasterTriangle t;
+        for (int v = 0; v < 3; v++) {
+            // Range extends past the surface to exercise clipping
+            t.v[v].x = rnd((W + 16) * 16) - 8 * 16;
+            t.v[v].y = rnd((H + 16) * 16) - 8 * 16;
+        }
+
+        hal_surface_t s = makeSurface(BG);
+        TriangleRasterizer r(s);
+        r.fillMesh(&t, 1, FG);
+
+        for (int32_t y = 0; y < H; y++) {
+            for (int32_t x = 0; x < W; x++) {
+                uint16_t expected = referenceCovers(t, x, y) ? FG : BG;
+                TEST_ASSERT_EQUAL_HEX16_MESSAGE(expected, g_buf[y * W + x], "mismatch vs reference");
+            }
+        }
+    }
+}
+
+void test_top_left_rule_on_sample_aligned_edges(void) {
+    // Square whose edges pass exactly through pixel centers 0.5 .. 2.5
+    RasterTriangle t[2] = {
+        tri(0.5f, 0.5f, 2.5f, 0.5f, 2.5f, 2.5f),
+        tri(0.5f, 0.5f, 2.5f, 2.5f, 0.5f, 2.5f),
+    };
+    hal_surface_t s = makeSurface(BG);
+    TriangleRasterizer r(s);
+    r.fillMesh(t, 2, FG);
+
+    // Left/top edges included, right/bottom excluded: exactly pixels 0..1
+    for (int32_t y = 0; y < 4; y++) {
+        for (int32_t x = 0; x < 4; x++) {
+            uint16_t expected = (x < 2 && y < 2) ? FG : BG;
+            TEST_ASSERT_EQUAL_HEX16(expected, g_buf[y * W + x]);
+        }
+    }
+}
+
+void test_shared_edges_are_watertight(void) {
+    // Fan of triangles around an off-grid center; draw each separately and
+    // count how often each pixel is hit
+    const float cx = 20.3f, cy = 17.7f;
+    const float ring[][2] = {
+        {3.1f, 2.2f}, {25.7f, 1.4f}, {44.9f, 9.6f}, {41.2f, 36.3f},
+        {18.4f, 38.8f}, {2.6f, 27.1f},
+    };
+    const int n = 6;
+
+    std::vector<int> hits(W * H, 0);
+    int32_t covered = 0;
+    for (int i = 0; i < n; i++) {
+        const float* a = ring[i];
+        const float* b = ring[(i + 1) % n];
+        RasterTriangle t = tri(cx, cy, a[0], a[1], b[0], b[1]);
+
+        hal_surface_t s = makeSurface(BG);
+        TriangleRasterizer r(s);
+        r.fillMesh(&t, 1, FG);
+        for (int32_t p = 0; p < W * H; p++) {
+            if (g_buf[p] == FG) {
+                hits[p]++;
+                covered++;
+            }
+        }
+    }
+
+    // No pixel may be covered twice
+    for (int32_t p = 0; p < W * H; p++) {
+        TEST_ASSERT_LESS_OR_EQUAL_INT(1, hits[p]);
+    }
+    TEST_ASSERT_GREATER_THAN(0, covered);
+}
+
+void test_aa_partial_coverage_blends(void) {
+    // Rectangle from x=0 to x=2.5: pixel 2 has 2 of 4 samples covered
+    RasterTriangle t[2] = {
+        tri(0.0f, 0.0f, 2.5f, 0.0f, 2.5f, 4.0f),
+        tri(0.0f, 0.0f, 2.5f, 4.0f, 0.0f, 4.0f),
+    };
+    hal_surface_t s = makeSurface(BG);
+    TriangleRasterizer r(s);
+    r.setAntiAlias(true);
+    r.fillMesh(t, 2, FG);
+
+    // Interior, including the shared diagonal, is fully covered (no seam)
+    TEST_ASSERT_EQUAL_HEX16(FG, g_buf[0]);
+    TEST_ASSERT_EQUAL_HEX16(FG, g_buf[1 * W + 1]);
+    TEST_ASSERT_EQUAL_HEX16(FG, g_buf[2 * W + 1]);
+
+    // Half-covered column: 50% white over black
+    uint16_t half = g_buf[1 * W + 2];
+    TEST_ASSERT_EQUAL_HEX16(0x7BEF, half);
+
+    // Outside
+    TEST_ASSERT_EQUAL_HEX16(BG, g_buf[1 * W + 3]);
+}
+
+void test_big_endian_target_matches_cpu_order(void) {
+    // Same AA mesh over a non-symmetric background, rendered in both orders
+    RasterTriangle t[2] = {
+        tri(1.3f, 0.7f, 30.2f, 5.1f, 12.6f, 33.9f),
+        tri(30.2f, 5.1f, 44.0f, 30.0f, 12.6f, 33.9f),
+    };
+    const uint16_t bg = 0x18E3;
+    const uint16_t fg = 0xE8A4;
+
+    hal_surface_t s = makeSurface(bg);
+    TriangleRasterizer r(s);
+    r.setAntiAlias(true);
+    r.fillMesh(t, 2, fg);
+    std::vector<uint16_t> expected = g_buf;
+
+    hal_surface_t be = makeSurface(hal_color_to_format(bg, HAL_PIXEL_FORMAT_RGB565_BE));
+    be.format = HAL_PIXEL_FORMAT_RGB565_BE;
+    TriangleRasterizer r_be(be);
+    r_be.setAntiAlias(true);
+    r_be.fillMesh(t, 2, fg);
+
+    for (int32_t p = 0; p < W * H; p++) {
+        TEST_ASSERT_EQUAL_HEX16(expected[p], hal_color_from_format(g_buf[p], HAL_PIXEL_FORMAT_RGB565_BE));
+    }
+}
+
+void test_dirty_rect_bounds_written_pixels(void) {
+    hal_surface_t s = makeSurface(BG);
+    TriangleRasterizer r(s);
+
+    int32_t x, y, w, h;
+    r.getDirtyRect(x, y, w, h);
+    TEST_ASSERT_EQUAL_INT32(0, w);
+
+    RasterTriangle a = tri(4.0f, 4.0f, 10.0f, 4.0f, 4.0f, 10.0f);
+    RasterTriangle b = tri(30.0f, 20.0f, 36.0f, 20.0f, 36.0f, 30.0f);
+    r.fillMesh(&a, 1, FG);
+    r.fillMesh(&b, 1, FG);
+    r.getDirtyRect(x, y, w, h);
+
+    TEST_ASSERT_EQUAL_INT32(4, x);
+    TEST_ASSERT_EQUAL_INT32(4, y);
+    TEST_ASSERT_EQUAL_INT32(36 - 4, w);
+    // Row 29's sample (y = 29.5) misses b's tip, so the last written row is 28
+    TEST_ASSERT_EQUAL_INT32(29 - 4, h);
+}
+
+void test_degenerate_and_out_of_range_are_dropped(void) {
+    hal_surface_t s = makeSurface(BG);
+    TriangleRasterizer r(s);
+
+    RasterTriangle line = tri(1.0f, 1.0f, 20.0f, 20.0f, 10.0f, 10.0f);
+    RasterTriangle huge = tri(-5000.0f, 0.0f, 5000.0f, 0.0f, 0.0f, 30.0f);
+    r.fillMesh(&line, 1, FG);
+    r.fillMesh(&huge, 1, FG);
+
+    for (int32_t p = 0; p < W * H; p++) {
+        TEST_ASSERT_EQUAL_HEX16(BG, g_buf[p]);
+    }
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_matches_reference_for_random_triangles);
+    RUN_TEST(test_top_left_rule_on_sample_aligned_edges);
+    RUN_TEST(test_shared_edges_are_watertight);
+    RUN_TEST(test_aa_partial_coverage_blends);
+    RUN_TEST(test_big_endian_target_matches_cpu_order);
+    RUN_TEST(test_dirty_rect_bounds_written_pixels);
+    RUN_TEST(test_degenerate_and_out_of_range_are_dropped);
+
+    return UNITY_END();
+}
@@ -0,0 +1,149 @@
+/**
+ * @file test_ui_layer.cpp
+ * @brief Unity tests for UILayer
+ *
+ * Verifies span blending in both blend modes, at full and partial opacity,
+ * across pixel formats, and the layer's invalidation bookkeeping
+ * (features/core_ui_render_manager.md, §3.4 Layer Mode).
+ */
+
+#include <unity.h>
+#include "ui/ui_layer.h"
+#include "../hal/display_format.h"
+#include <vector>
+
+static constexpr uint16_t KEY = 0xF81F;
+
+// Per-channel reference blend, alpha in 0..32
+static uint16_t referenceBlend(uint16_t fg, uint16_t bg, uint32_t alpha) {
+    uint32_t r = (((fg >> 11) & 31) * alpha + ((bg >> 11) & 31) * (32 - alpha)) >> 5;
+    uint32_t g = (((fg >> 5) & 63) * alpha + ((bg >> 5) & 63) * (32 - alpha)) >> 5;
+    uint32_t b = ((fg & 31) * alpha + (bg & 31) * (32 - alpha)) >> 5;
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void fillPattern(UILayer& layer) {
+    const hal_surface_t& s = layer.getSurface();
+    for (int32_t i = 0; i < s.width; i++) {
+        uint16_t color = (i % 3 == 0) ? KEY : static_cast<uint16_t>(0x1000 + i * 0x0123);
+        s.pixels[i] = hal_color_to_format(color, s.format);
+    }
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_normal_opaque_span_is_a_copy(void) {
+    UILayer layer;
+    TEST_ASSERT_TRUE(layer.init(5, 5, 16, 1, HAL_PIXEL_FORMAT_RGB565));
+    fillPattern(layer);
+    TEST_ASSERT_TRUE(layer.isOpaque());
+
+    std::vector<uint16_t> dst(10, 0xAAAA);
+    layer.blendSpan(dst.data(), HAL_PIXEL_FORMAT_RGB565, 3, 0, 10);
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_HEX16(layer.getSurface().pixels[3 + i], dst[i]);
+    }
+}
+
+void test_keyed_span_skips_key_pixels(void) {
+    UILayer layer;
+    TEST_ASSERT_TRUE(layer.init(0, 0, 16, 1, HAL_PIXEL_FORMAT_RGB565));
+    fillPattern(layer);
+    layer.setBlendMode(UILayer::BlendMode::KEYED, KEY);
+    TEST_ASSERT_FALSE(layer.isOpaque());
+
+    std::vector<uint16_t> dst(16, 0xAAAA);
+    layer.blendSpan(dst.data(), HAL_PIXEL_FORMAT_RGB565, 0, 0, 16);
+    for (int i = 0; i < 16; i++) {
+        uint16_t expected = (i % 3 == 0) ? 0xAAAA : layer.getSurface().pixels[i];
+        TEST_ASSERT_EQUAL_HEX16(expected, dst[i]);
+    }
+}
+
+void test_alpha_matches_per_channel_reference(void) {
+    const uint8_t opacities[] = { 0, 37, 128, 200, 255 };
+    for (uint8_t opacity : opacities) {
+        UILayer layer;
+        TEST_ASSERT_TRUE(layer.init(0, 0, 16, 1, HAL_PIXEL_FORMAT_RGB565));
+        fillPattern(layer);
+        layer.setBlendMode(UILayer::BlendMode::KEYED, KEY);
+        layer.setOpacity(opacity);
+
+        std::vector<uint16_t> dst(16);
+        for (int i = 0; i < 16; i++) dst[i] = static_cast<uint16_t>(0xFFFF - i * 0x0707);
+        std::vector<uint16_t> before = dst;
+        layer.blendSpan(dst.data(), HAL_PIXEL_FORMAT_RGB565, 0, 0, 16);
+
+        uint32_t alpha = (static_cast<uint32_t>(opacity) + 4) >> 3;
+        for (int i = 0; i < 16; i++) {
+            uint16_t src = layer.getSurface().pixels[i];
+            uint16_t expected = (src == KEY || opacity == 0) ? before[i]
+                              : (opacity == 255) ? src
+                              : referenceBlend(src, before[i], alpha);
+            TEST_ASSERT_EQUAL_HEX16(expected, dst[i]);
+        }
+    }
+}
+
+void test_blending_across_byte_orders(void) {
+    // Layer in panel order, destination in panel order and in CPU order
+    UILayer layer;
+    TEST_ASSERT_TRUE(layer.init(0, 0, 16, 1, HAL_PIXEL_FORMAT_RGB565_BE));
+    fillPattern(layer);
+    layer.setBlendMode(UILayer::BlendMode::KEYED, KEY);
+    layer.setOpacity(96);
+
+    std::vector<uint16_t> cpu(16, 0x0841);
+    std::vector<uint16_t> be(16, hal_color_to_format(0x0841, HAL_PIXEL_FORMAT_RGB565_BE));
+    layer.blendSpan(cpu.data(), HAL_PIXEL_FORMAT_RGB565, 0, 0, 16);
+    layer.blendSpan(be.data(), HAL_PIXEL_FORMAT_RGB565_BE, 0, 0, 16);
+
+    for (int i = 0; i < 16; i++) {
+        uint16_t src = hal_color_from_format(layer.getSurface().pixels[i], HAL_PIXEL_FORMAT_RGB565_BE);
+        uint16_t expected = (src == KEY) ? 0x0841 : referenceBlend(src, 0x0841, 12);
+        TEST_ASSERT_EQUAL_HEX16(expected, cpu[i]);
+        TEST_ASSERT_EQUAL_HEX16(expected, hal_color_from_format(be[i], HAL_PIXEL_FORMAT_RGB565_BE));
+    }
+}
+
+void test_invalidation_bookkeeping(void) {
+    UILayer layer;
+    TEST_ASSERT_FALSE(layer.isValid());
+    TEST_ASSERT_FALSE(layer.init(0, 0, 0, 4));
+
+    TEST_ASSERT_TRUE(layer.init(10, 20, 32, 16));
+    TEST_ASSERT_EQUAL_INT32(1, layer.getDamage().count);
+    TEST_ASSERT_EQUAL_INT32(32 * 16, hal_damage_area(&layer.getDamage()));
+    hal_rect_t b = layer.getBounds();
+    TEST_ASSERT_EQUAL_INT32(10, b.x);
+    TEST_ASSERT_EQUAL_INT32(20, b.y);
+
+    // Attaching external pixels invalidates them; re-attaching the same
+    // memory (e.g. every frame) only moves the layer
+    std::vector<uint16_t> pixels(8 * 8, 0);
+    hal_surface_t external = { pixels.data(), 8, 8, 8, HAL_PIXEL_FORMAT_RGB565 };
+    layer.attach(external, 0, 0);
+    TEST_ASSERT_EQUAL_INT32(64, hal_damage_area(&layer.getDamage()));
+    layer.attach(external, 4, 4);
+    TEST_ASSERT_EQUAL_INT32(1, layer.getDamage().count);
+    TEST_ASSERT_EQUAL_INT32(4, layer.getBounds().x);
+
+    layer.release();
+    TEST_ASSERT_FALSE(layer.isValid());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_normal_opaque_span_is_a_copy);
+    RUN_TEST(test_keyed_span_skips_key_pixels);
+    RUN_TEST(test_alpha_matches_per_channel_reference);
+    RUN_TEST(test_blending_across_byte_orders);
+    RUN_TEST(test_invalidation_bookkeeping);
+
+    return UNITY_END();
+}
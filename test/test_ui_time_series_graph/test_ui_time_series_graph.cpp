@@ -9,6 +9,7 @@
 #include "../../src/ui_time_series_graph.h"
 #include "../../src/relative_display.h"
 #include "../../hal/display.h"
+#include <vector>
 
 // RGB565 color definitions for testing
 #define RGB565_BLACK       0x0000
@@ -580,6 +581,77 @@ void test_independent_refresh(void) {
     TEST_ASSERT_TRUE(true);
 }
 
+/**
+ * Test: Time-sliced redraw (features/ui_themeable_time_series_graph.md, Time-Sliced Redraws)
+ * Given a fully drawn graph
+ * When new data is requested as a sliced redraw and stepped with no budget
+ * Then each step runs one slice, the composite keeps the previous frame until
+ * the redraw completes, and the new frame is swapped in once
+ */
+void test_time_sliced_redraw(void) {
+    GraphTheme theme = {};
+    theme.backgroundColor = RGB565_BLACK;
+    theme.lineColor = RGB565_CYAN;
+    theme.axisColor = RGB565_WHITE;
+    theme.useBackgroundGradient = true;
+    theme.backgroundGradient.angle_deg = 45.0f;
+    theme.backgroundGradient.color_stops[0] = RGB565_DARK_PURPLE;
+    theme.backgroundGradient.color_stops[1] = RGB565_BLACK;
+    theme.backgroundGradient.num_stops = 2;
+    theme.lineThickness = 0.5f;
+
+    TimeSeriesGraph graph(theme,
+                         (Arduino_GFX*)hal_display_get_gfx(),
+                         hal_display_get_width_pixels(),
+                         hal_display_get_height_pixels());
+    TEST_ASSERT_FALSE(graph.stepRedraw(0));  // Nothing pending
+    if (!graph.begin()) {
+        TEST_IGNORE_MESSAGE("No PSRAM for the graph layers");
+    }
+
+    GraphData data;
+    data.x_values = {1, 2, 3};
+    data.y_values = {10.0, 20.0, 30.0};
+    graph.setData(data);
+    graph.drawBackground();
+    graph.drawData();
+    graph.render();
+
+    hal_surface_t surface;
+    TEST_ASSERT_TRUE(graph.composite(&surface));
+    const size_t pixels = static_cast<size_t>(surface.width) * surface.height;
+    const uint16_t* composited = static_cast<const uint16_t*>(surface.pixels);
+    std::vector<uint16_t> before(composited, composited + pixels);
+
+    data.x_values = {1, 2, 3, 4, 5};
+    data.y_values = {15.0, 25.0, 20.0, 30.0, 35.0};
+    graph.setData(data);
+    TEST_ASSERT_TRUE(graph.requestRedraw(true, true));
+    TEST_ASSERT_TRUE(graph.isRedrawPending());
+
+    int steps = 0;
+    while (!graph.stepRedraw(0)) {
+        TEST_ASSERT_TRUE(graph.isRedrawPending());
+        // The previous frame stays presentable meanwhile
+        TEST_ASSERT_TRUE(graph.composite(&surface));
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(before.data(), surface.pixels, pixels);
+        TEST_ASSERT_TRUE(++steps < 10000);
+    }
+    TEST_ASSERT_TRUE(steps > 1);
+    TEST_ASSERT_FALSE(graph.isRedrawPending());
+    TEST_ASSERT_FALSE(graph.stepRedraw(0));
+
+    // Matches drawing the same data in place
+    TEST_ASSERT_TRUE(graph.composite(&surface));
+    std::vector<uint16_t> sliced(composited, composited + pixels);
+    TEST_ASSERT_TRUE(sliced != before);
+    graph.drawBackground();
+    graph.drawData();
+    TEST_ASSERT_TRUE(graph.composite(&surface));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(sliced.data(), surface.pixels, pixels);
+    graph.render();
+}
+
 int main(int argc, char **argv) {
     UNITY_BEGIN();
 
@@ -598,6 +670,7 @@ int main(int argc, char **argv) {
     RUN_TEST(test_axis_tick_marks);
     RUN_TEST(test_animate_live_indicator);
     RUN_TEST(test_independent_refresh);
+    RUN_TEST(test_time_sliced_redraw);
 
     // Behavioral assertion tests (public API)
     RUN_TEST(test_format_value_zero);
@@ -24,8 +24,8 @@ void tearDown(void) {
 
 // Test: Generated assets are available
 void test_vector_assets_available(void) {
-    TEST_ASSERT_NOT_NULL(VectorAssets::Lpadlogo.paths);
-    TEST_ASSERT_GREATER_THAN(0, VectorAssets::Lpadlogo.num_paths);
+    TEST_ASSERT_NOT_NULL(VectorAssets::Lpadlogo.meshes);
+    TEST_ASSERT_GREATER_THAN(0, VectorAssets::Lpadlogo.num_meshes);
     TEST_ASSERT_FLOAT_WITHIN(1.0f, 245.0f, VectorAssets::Lpadlogo.original_width);
     TEST_ASSERT_FLOAT_WITHIN(1.0f, 370.0f, VectorAssets::Lpadlogo.original_height);
 }
@@ -34,19 +34,20 @@ void test_vector_assets_available(void) {
 void test_vector_assets_triangles(void) {
     const VectorShape& logo = VectorAssets::Lpadlogo;
 
-    // LPadLogo has 10 paths (triangles)
-    TEST_ASSERT_EQUAL(10, logo.num_paths);
+    // LPadLogo has 10 single-triangle paths, all different colors
+    TEST_ASSERT_EQUAL(10, logo.num_meshes);
 
-    // Check first path
-    TEST_ASSERT_EQUAL(1, logo.paths[0].num_tris);
-    TEST_ASSERT_NOT_NULL(logo.paths[0].tris);
+    // Check first mesh
+    TEST_ASSERT_EQUAL(3, logo.meshes[0].num_indices);
+    TEST_ASSERT_NOT_NULL(logo.meshes[0].vertices);
+    TEST_ASSERT_NOT_NULL(logo.meshes[0].indices);
 
-    // Verify vertices are normalized [0,1]
-    const VectorTriangle& tri = logo.paths[0].tris[0];
-    TEST_ASSERT_GREATER_OR_EQUAL(0.0f, tri.v1.x);
-    TEST_ASSERT_LESS_OR_EQUAL(1.0f, tri.v1.x);
-    TEST_ASSERT_GREATER_OR_EQUAL(0.0f, tri.v1.y);
-    TEST_ASSERT_LESS_OR_EQUAL(1.0f, tri.v1.y);
+    // Verify vertices are quantized to [0, VECTOR_COORD_ONE]
+    const VectorVertex& v = logo.meshes[0].vertices[logo.meshes[0].indices[0]];
+    TEST_ASSERT_GREATER_OR_EQUAL(0, v.x);
+    TEST_ASSERT_LESS_OR_EQUAL(VECTOR_COORD_ONE, v.x);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, v.y);
+    TEST_ASSERT_LESS_OR_EQUAL(VECTOR_COORD_ONE, v.y);
 }
 
 // Test: Basic rendering call (smoke test)
@@ -87,12 +88,12 @@ void test_vector_renderer_positioning(void) {
 void test_vector_assets_colors(void) {
     const VectorShape& logo = VectorAssets::Lpadlogo;
 
-    // First path should have color #6A6556 -> RGB565
+    // First mesh should have color #6A6556 -> RGB565
     // R=0x6A (106) -> 106>>3 = 13 (0xD)
     // G=0x65 (101) -> 101>>2 = 25 (0x19)
     // B=0x56 (86)  -> 86>>3  = 10 (0xA)
     // RGB565 = 0xD<<11 | 0x19<<5 | 0xA = 0x6B2A
-    TEST_ASSERT_EQUAL_HEX16(0x6B2A, logo.paths[0].color);
+    TEST_ASSERT_EQUAL_HEX16(0x6B2A, logo.meshes[0].color);
 }
 
 void process(void) {
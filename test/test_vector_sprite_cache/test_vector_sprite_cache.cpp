@@ -0,0 +1,242 @@
+/**
+ * @file test_vector_sprite_cache.cpp
+ * @brief Unity tests for RleSprite and VectorSpriteCache
+ *
+ * Verifies run-length encoding round trips, clipped blits into a surface,
+ * and that vector assets are rasterized once per cache key.
+ */
+
+#include <unity.h>
+#include "../../src/rle_sprite.h"
+#include "../../src/vector_sprite_cache.h"
+#include "../../src/vector_renderer.h"
+#include "../../src/generated/vector_assets.h"
+#include <vector>
+
+static constexpr uint16_t KEY = 0xF81F;
+
+// Simple two-triangle square covering the full unit box (shared diagonal)
+static const VectorVertex kSquareVerts[] = {
+    {0, 0}, {VECTOR_COORD_ONE, 0}, {VECTOR_COORD_ONE, VECTOR_COORD_ONE}, {0, VECTOR_COORD_ONE},
+};
+static const uint16_t kSquareIndices[] = { 0, 1, 2, 0, 2, 3 };
+static const VectorMesh kSquareMeshes[] = {
+    { 0x07E0, 4, 6, kSquareVerts, kSquareIndices, { 0, 0, VECTOR_COORD_ONE, VECTOR_COORD_ONE } },
+};
+static const VectorShape kSquare = { 1, kSquareMeshes, 10.0f, 10.0f,
+                                     { 0, 0, VECTOR_COORD_ONE, VECTOR_COORD_ONE } };
+
+static hal_surface_t makeSurface(std::vector<uint16_t>& buf, int32_t w, int32_t h, uint16_t fill) {
+    buf.assign(static_cast<size_t>(w) * h, fill);
+    hal_surface_t s = { buf.data(), w, h, w, HAL_PIXEL_FORMAT_RGB565 };
+    return s;
+}
+
+void setUp(void) {
+    VectorSpriteCache::getInstance().clear();
+}
+
+void tearDown(void) {
+}
+
+// ---------------------------------------------------------------------------
+// RleSprite
+// ---------------------------------------------------------------------------
+
+void test_rle_round_trip_preserves_pixels(void) {
+    const int16_t W = 6, H = 3;
+    const uint16_t src[W * H] = {
+        KEY,    0x1111, 0x2222, KEY,    KEY,    0x3333,
+        KEY,    KEY,    KEY,    KEY,    KEY,    KEY,
+        0x4444, 0x5555, 0x6666, 0x7777, 0x8888, 0x9999,
+    };
+
+    RleSprite sprite;
+    TEST_ASSERT_TRUE(sprite.encode(src, W, H, W, KEY));
+    TEST_ASSERT_EQUAL_INT16(W, sprite.getWidth());
+    TEST_ASSERT_EQUAL_INT16(H, sprite.getHeight());
+    TEST_ASSERT_EQUAL_INT32(9, sprite.getOpaquePixelCount());
+
+    std::vector<uint16_t> buf;
+    hal_surface_t dst = makeSurface(buf, W, H, 0xAAAA);
+    sprite.blitTo(dst, 0, 0);
+
+    for (int i = 0; i < W * H; i++) {
+        uint16_t expected = (src[i] == KEY) ? 0xAAAA : src[i];
+        TEST_ASSERT_EQUAL_HEX16(expected, buf[i]);
+    }
+}
+
+void test_rle_encode_respects_stride(void) {
+    // 2x2 sprite embedded in a 4-wide buffer
+    const uint16_t src[8] = {
+        0x0001, KEY, 0xFFFF, 0xFFFF,
+        KEY, 0x0002, 0xFFFF, 0xFFFF,
+    };
+
+    RleSprite sprite;
+    TEST_ASSERT_TRUE(sprite.encode(src, 2, 2, 4, KEY));
+    TEST_ASSERT_EQUAL_INT32(2, sprite.getOpaquePixelCount());
+}
+
+void test_rle_encode_rejects_invalid_input(void) {
+    uint16_t px = 0;
+    RleSprite sprite;
+    TEST_ASSERT_FALSE(sprite.encode(nullptr, 1, 1, 1, KEY));
+    TEST_ASSERT_FALSE(sprite.encode(&px, 0, 1, 1, KEY));
+    TEST_ASSERT_FALSE(sprite.encode(&px, 2, 1, 1, KEY));  // stride < width
+    TEST_ASSERT_TRUE(sprite.isEmpty());
+}
+
+void test_rle_blit_clips_to_surface(void) {
+    const uint16_t src[9] = {
+        0x0001, 0x0002, 0x0003,
+        0x0004, 0x0005, 0x0006,
+        0x0007, 0x0008, 0x0009,
+    };
+    RleSprite sprite;
+    sprite.encode(src, 3, 3, 3, KEY);
+
+    std::vector<uint16_t> buf;
+    hal_surface_t dst = makeSurface(buf, 4, 4, 0);
+
+    // Hangs off the top-left: only the bottom-right 2x2 lands
+    sprite.blitTo(dst, -1, -1);
+    TEST_ASSERT_EQUAL_HEX16(0x0005, buf[0]);
+    TEST_ASSERT_EQUAL_HEX16(0x0006, buf[1]);
+    TEST_ASSERT_EQUAL_HEX16(0x0008, buf[4]);
+    TEST_ASSERT_EQUAL_HEX16(0x0009, buf[5]);
+    TEST_ASSERT_EQUAL_HEX16(0x0000, buf[2]);
+
+    // Hangs off the bottom-right: only the top-left pixel lands
+    buf.assign(16, 0);
+    sprite.blitTo(dst, 3, 3);
+    TEST_ASSERT_EQUAL_HEX16(0x0001, buf[15]);
+    TEST_ASSERT_EQUAL_HEX16(0x0000, buf[14]);
+}
+
+// ---------------------------------------------------------------------------
+// VectorRenderer::rasterize
+// ---------------------------------------------------------------------------
+
+void test_rasterize_square_fills_box(void) {
+    std::vector<uint16_t> buf;
+    hal_surface_t dst = makeSurface(buf, 12, 12, KEY);
+    VectorRenderer::rasterize(kSquare, dst, 0.0f, 0.0f, 8.0f, 8.0f);
+
+    for (int32_t y = 0; y < 12; y++) {
+        for (int32_t x = 0; x < 12; x++) {
+            uint16_t expected = (x < 8 && y < 8) ? 0x07E0 : KEY;
+            TEST_ASSERT_EQUAL_HEX16(expected, buf[y * 12 + x]);
+        }
+    }
+}
+
+void test_rasterize_uses_palette(void) {
+    static const uint16_t palette[] = { 0x001F };
+    std::vector<uint16_t> buf;
+    hal_surface_t dst = makeSurface(buf, 4, 4, KEY);
+    VectorRenderer::rasterize(kSquare, dst, 0.0f, 0.0f, 4.0f, 4.0f, palette);
+    TEST_ASSERT_EQUAL_HEX16(0x001F, buf[5]);
+}
+
+void test_rasterize_skips_offscreen_meshes(void) {
+    std::vector<uint16_t> buf;
+    hal_surface_t dst = makeSurface(buf, 4, 4, KEY);
+    VectorRenderer::rasterize(kSquare, dst, 10.0f, 0.0f, 4.0f, 4.0f);
+    for (size_t i = 0; i < buf.size(); i++) {
+        TEST_ASSERT_EQUAL_HEX16(KEY, buf[i]);
+    }
+}
+
+void test_generated_meshes_are_consistent(void) {
+    const VectorShape& logo = VectorAssets::Lpadlogo;
+    TEST_ASSERT_EQUAL(VectorAssets::LpadlogoInfo.num_meshes, logo.num_meshes);
+
+    size_t vertices = 0, triangles = 0;
+    for (size_t m = 0; m < logo.num_meshes; m++) {
+        const VectorMesh& mesh = logo.meshes[m];
+        TEST_ASSERT_EQUAL(0, mesh.num_indices % 3);
+        for (uint16_t i = 0; i < mesh.num_indices; i++) {
+            TEST_ASSERT_LESS_THAN(mesh.num_vertices, mesh.indices[i]);
+        }
+        // Every vertex lies inside the mesh bounds, which lie inside the shape's
+        for (uint16_t v = 0; v < mesh.num_vertices; v++) {
+            TEST_ASSERT_TRUE(mesh.vertices[v].x >= mesh.bounds.min_x && mesh.vertices[v].x <= mesh.bounds.max_x);
+            TEST_ASSERT_TRUE(mesh.vertices[v].y >= mesh.bounds.min_y && mesh.vertices[v].y <= mesh.bounds.max_y);
+        }
+        TEST_ASSERT_TRUE(mesh.bounds.min_x >= logo.bounds.min_x && mesh.bounds.max_x <= logo.bounds.max_x);
+        TEST_ASSERT_TRUE(mesh.bounds.min_y >= logo.bounds.min_y && mesh.bounds.max_y <= logo.bounds.max_y);
+        vertices += mesh.num_vertices;
+        triangles += mesh.num_indices / 3;
+    }
+    TEST_ASSERT_EQUAL(VectorAssets::LpadlogoInfo.num_vertices, vertices);
+    TEST_ASSERT_EQUAL(VectorAssets::LpadlogoInfo.num_triangles, triangles);
+}
+
+// ---------------------------------------------------------------------------
+// VectorSpriteCache
+// ---------------------------------------------------------------------------
+
+void test_cache_rasterizes_once_per_key(void) {
+    auto& cache = VectorSpriteCache::getInstance();
+
+    const RleSprite* a = cache.get(VectorAssets::Lpadlogo, 30, 45);
+    const RleSprite* b = cache.get(VectorAssets::Lpadlogo, 30, 45);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_PTR(a, b);
+    TEST_ASSERT_EQUAL_UINT32(1, cache.getMissCount());
+    TEST_ASSERT_EQUAL_UINT32(1, cache.getHitCount());
+    TEST_ASSERT_GREATER_THAN(0, a->getOpaquePixelCount());
+}
+
+void test_cache_key_includes_size_and_palette(void) {
+    static const uint16_t palette[10] = {};
+    auto& cache = VectorSpriteCache::getInstance();
+
+    cache.get(VectorAssets::Lpadlogo, 30, 45);
+    cache.get(VectorAssets::Lpadlogo, 31, 45);
+    cache.get(VectorAssets::Lpadlogo, 30, 45, palette);
+    TEST_ASSERT_EQUAL_UINT32(3, cache.getMissCount());
+    TEST_ASSERT_EQUAL_INT(3, cache.getEntryCount());
+}
+
+void test_cache_evicts_least_recently_used(void) {
+    auto& cache = VectorSpriteCache::getInstance();
+
+    for (int16_t i = 0; i < VectorSpriteCache::MAX_ENTRIES; i++) {
+        cache.get(kSquare, 4 + i, 4 + i);
+    }
+    cache.get(kSquare, 4, 4);   // Refresh the oldest
+    cache.get(kSquare, 20, 20); // Evicts 5x5, not 4x4
+    TEST_ASSERT_EQUAL_INT(VectorSpriteCache::MAX_ENTRIES, cache.getEntryCount());
+
+    uint32_t misses = cache.getMissCount();
+    cache.get(kSquare, 4, 4);
+    TEST_ASSERT_EQUAL_UINT32(misses, cache.getMissCount());
+    cache.get(kSquare, 5, 5);
+    TEST_ASSERT_EQUAL_UINT32(misses + 1, cache.getMissCount());
+}
+
+void test_cache_rejects_empty_size(void) {
+    TEST_ASSERT_NULL(VectorSpriteCache::getInstance().get(kSquare, 0, 10));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_rle_round_trip_preserves_pixels);
+    RUN_TEST(test_rle_encode_respects_stride);
+    RUN_TEST(test_rle_encode_rejects_invalid_input);
+    RUN_TEST(test_rle_blit_clips_to_surface);
+    RUN_TEST(test_rasterize_square_fills_box);
+    RUN_TEST(test_rasterize_uses_palette);
+    RUN_TEST(test_rasterize_skips_offscreen_meshes);
+    RUN_TEST(test_generated_meshes_are_consistent);
+    RUN_TEST(test_cache_rasterizes_once_per_key);
+    RUN_TEST(test_cache_key_includes_size_and_palette);
+    RUN_TEST(test_cache_evicts_least_recently_used);
+    RUN_TEST(test_cache_rejects_empty_size);
+
+    return UNITY_END();
+}
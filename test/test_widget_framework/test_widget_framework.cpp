@@ -3,7 +3,8 @@
  * @brief Unit tests for the Widget Framework
  *
  * Tests GridWidgetLayout anchor math, cell subdivision,
- * WidgetLayoutEngine coordination, and ScrollableListWidget logic.
+ * WidgetLayoutEngine coordination, and ScrollableListWidget logic
+ * (including drag and fling scrolling, on a virtual clock).
  *
  * Specification: features/ui_widget_framework.md
  */
@@ -13,6 +14,13 @@
 #include "ui/widgets/text_widget.h"
 #include "ui/widgets/scrollable_list_widget.h"
 
+// Virtual clock for fling timing (overrides the weak stub in hal/timer_stub.cpp)
+static uint64_t mock_now = 0;
+
+extern "C" uint64_t hal_timer_get_micros(void) {
+    return mock_now;
+}
+
 // ============================================================================
 // Concrete test widget for layout verification
 // ============================================================================
@@ -246,6 +254,111 @@ void test_scrollable_list_selection() {
     TEST_ASSERT_EQUAL_INT(1, list.getSelectedIndex());
 }
 
+static touch_gesture_event_t makeScrollEvent(touch_gesture_type_t type, int16_t delta_y,
+                                             float velocity_y = 0.0f) {
+    touch_gesture_event_t event = {};
+    event.type = type;
+    event.x_px = 50;
+    event.y_px = 50;
+    event.delta_y = delta_y;
+    event.velocity_y = velocity_y;
+    return event;
+}
+
+void test_scrollable_list_drag_follows_finger() {
+    ScrollableListWidget list;
+    for (int i = 0; i < 20; i++) {
+        list.addItem("Item");
+    }
+
+    // Finger moves up 45 px: the list scrolls 45 px, drawn at the nearest item
+    list.handleInput(makeScrollEvent(TOUCH_DRAG, -25), 0, 0, 100, 200);
+    list.handleInput(makeScrollEvent(TOUCH_DRAG, -20), 0, 0, 100, 200);
+    TEST_ASSERT_EQUAL_INT(2, list.getScrollOffset());
+
+    // The SWIPE ending the drag doesn't scroll again
+    touch_gesture_event_t swipe = makeScrollEvent(TOUCH_SWIPE, 0);
+    swipe.direction = TOUCH_DIR_UP;
+    list.handleInput(swipe, 0, 0, 100, 200);
+    TEST_ASSERT_EQUAL_INT(2, list.getScrollOffset());
+
+    // Dragging down past the top stops at the first item
+    list.handleInput(makeScrollEvent(TOUCH_DRAG, 500), 0, 0, 100, 200);
+    TEST_ASSERT_EQUAL_INT(0, list.getScrollOffset());
+}
+
+void test_scrollable_list_fling_decays_and_stops() {
+    ScrollableListWidget list;
+    for (int i = 0; i < 100; i++) {
+        list.addItem("Item");
+    }
+    mock_now = 1000000;
+
+    // Finger flicked up at 600 px/s
+    list.handleInput(makeScrollEvent(TOUCH_FLING, 0, -600.0f), 0, 0, 100, 200);
+    TEST_ASSERT_TRUE(list.isFlinging());
+
+    int last = list.getScrollOffset();
+    int frames = 0;
+    while (list.isFlinging() && frames < 1000) {
+        mock_now += 16667;
+        list.update();
+        TEST_ASSERT_TRUE(list.getScrollOffset() >= last);
+        last = list.getScrollOffset();
+        frames++;
+    }
+    TEST_ASSERT_FALSE(list.isFlinging());
+
+    // Travels v0 / k = 200 px (less the tail below the stop speed): ~10 items
+    TEST_ASSERT_INT_WITHIN(1, 9, list.getScrollOffset());
+
+    // Frame rate doesn't change the distance
+    ScrollableListWidget coarse;
+    for (int i = 0; i < 100; i++) {
+        coarse.addItem("Item");
+    }
+    coarse.handleInput(makeScrollEvent(TOUCH_FLING, 0, -600.0f), 0, 0, 100, 200);
+    while (coarse.isFlinging()) {
+        mock_now += 100000;
+        coarse.update();
+    }
+    TEST_ASSERT_INT_WITHIN(1, list.getScrollOffset(), coarse.getScrollOffset());
+}
+
+void test_scrollable_list_fling_stops_at_end_and_on_tap() {
+    ScrollableListWidget list;
+    for (int i = 0; i < 20; i++) {
+        list.addItem("Item");
+    }
+    mock_now = 1000000;
+
+    // 20 items, 10 visible: a hard fling stops at the last page
+    list.handleInput(makeScrollEvent(TOUCH_FLING, 0, -5000.0f), 0, 0, 100, 200);
+    for (int i = 0; i < 30 && list.isFlinging(); i++) {
+        mock_now += 16667;
+        list.update();
+    }
+    TEST_ASSERT_FALSE(list.isFlinging());
+    TEST_ASSERT_EQUAL_INT(10, list.getScrollOffset());
+
+    // A tap catches a moving list without losing the selection logic
+    list.handleInput(makeScrollEvent(TOUCH_FLING, 0, 2000.0f), 0, 0, 100, 200);
+    mock_now += 16667;
+    list.update();
+    TEST_ASSERT_TRUE(list.isFlinging());
+    int caught = list.getScrollOffset();
+
+    touch_gesture_event_t tap = makeScrollEvent(TOUCH_TAP, 0);
+    tap.y_px = 10;
+    list.handleInput(tap, 0, 0, 100, 200);
+    TEST_ASSERT_FALSE(list.isFlinging());
+    TEST_ASSERT_EQUAL_INT(caught, list.getSelectedIndex());
+
+    mock_now += 16667;
+    list.update();
+    TEST_ASSERT_EQUAL_INT(caught, list.getScrollOffset());
+}
+
 // ============================================================================
 // Hit Testing - Layout Input Routing
 // ============================================================================
@@ -318,6 +431,9 @@ int main(int argc, char** argv) {
     RUN_TEST(test_scrollable_list_clear);
     RUN_TEST(test_scrollable_list_scroll_bounds);
     RUN_TEST(test_scrollable_list_selection);
+    RUN_TEST(test_scrollable_list_drag_follows_finger);
+    RUN_TEST(test_scrollable_list_fling_decays_and_stops);
+    RUN_TEST(test_scrollable_list_fling_stops_at_end_and_on_tap);
 
     // Hit testing
     RUN_TEST(test_layout_input_hit_test);